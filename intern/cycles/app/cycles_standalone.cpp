@@ -7,10 +7,12 @@
 #include "device/device.h"
 #include "scene/camera.h"
 #include "scene/integrator.h"
+#include "scene/pass.h"
 #include "scene/scene.h"
 #include "session/buffers.h"
 #include "session/session.h"
 
+#include "util/algorithm.h"
 #include "util/args.h"
 #include "util/foreach.h"
 #include "util/function.h"
@@ -48,7 +50,7 @@ struct Options {
   bool quiet;
   bool show_help, interactive, pause;
   string output_filepath;
-  string output_pass;
+  string output_passes;
 } options;
 
 static void session_print(const string &str)
@@ -128,7 +130,24 @@ static void scene_init()
 
 static void session_init()
 {
-  options.output_pass = "combined";
+  /* Passes to write, the combined pass always comes first. */
+  vector<string> pass_names;
+  string_split(pass_names, options.output_passes, ",");
+  pass_names.erase(remove(pass_names.begin(), pass_names.end(), "combined"),
+                   pass_names.end());
+  pass_names.insert(pass_names.begin(), "combined");
+
+  vector<OIIOOutputDriver::Pass> output_passes;
+  const NodeEnum *pass_type_enum = Pass::get_type_enum();
+  for (const string &pass_name : pass_names) {
+    if (!pass_type_enum->exists(ustring(pass_name))) {
+      fprintf(stderr, "Unknown pass type: %s\n", pass_name.c_str());
+      continue;
+    }
+    const PassType type = (PassType)(*pass_type_enum)[ustring(pass_name)];
+    output_passes.push_back({pass_name, Pass::get_info(type).num_components});
+  }
+
   options.session = new Session(options.session_params, options.scene_params);
 
 #ifdef WITH_CYCLES_STANDALONE_GUI
@@ -139,8 +158,8 @@ static void session_init()
 #endif
 
   if (!options.output_filepath.empty()) {
-    options.session->set_output_driver(make_unique<OIIOOutputDriver>(
-        options.output_filepath, options.output_pass, session_print));
+    options.session->set_output_driver(
+        make_unique<OIIOOutputDriver>(options.output_filepath, output_passes, session_print));
   }
 
   if (options.session_params.background && !options.quiet) {
@@ -154,10 +173,12 @@ static void session_init()
   /* load scene */
   scene_init();
 
-  /* add pass for output. */
-  Pass *pass = options.scene->create_node<Pass>();
-  pass->set_name(ustring(options.output_pass.c_str()));
-  pass->set_type(PASS_COMBINED);
+  /* add passes for output. */
+  for (const OIIOOutputDriver::Pass &output_pass : output_passes) {
+    Pass *pass = options.scene->create_node<Pass>();
+    pass->set_name(ustring(output_pass.name));
+    pass->set_type((PassType)(*pass_type_enum)[ustring(output_pass.name)]);
+  }
 
   options.session->reset(options.session_params, session_buffer_params());
   options.session->start();
@@ -414,6 +435,10 @@ static void options_parse(int argc, const char **argv)
              "--output %s",
              &options.output_filepath,
              "File path to write output image",
+             "--passes %s",
+             &options.output_passes,
+             "Comma separated list of passes to write as layers of an EXR output image, for "
+             "example depth,normal,denoising_albedo. The combined pass is always written",
              "--threads %d",
              &options.session_params.threads,
              "CPU Rendering Threads",
@@ -426,6 +451,9 @@ static void options_parse(int argc, const char **argv)
              "--tile-size %d",
              &options.session_params.tile_size,
              "Tile size in pixels",
+             "--tile-streaming",
+             &options.session_params.use_tile_streaming,
+             "Write finished tiles to the output image and resume interrupted renders",
              "--list-devices",
              &list,
              "List information about all available devices",
@@ -498,6 +526,14 @@ static void options_parse(int argc, const char **argv)
     options.session_params.use_auto_tile = true;
   }
 
+  /* Tiles of an interrupted render are found again by the output file path. */
+  if (options.session_params.use_tile_streaming && !options.output_filepath.empty()) {
+    options.session_params.tile_stream_id = options.output_filepath;
+    if (options.session_params.temp_dir.empty()) {
+      options.session_params.temp_dir = path_dirname(options.output_filepath);
+    }
+  }
+
   /* find matching device */
   DeviceType device_type = Device::type_from_string(devicename.c_str());
   vector<DeviceInfo> devices = Device::available_devices(DEVICE_MASK(device_type));
@@ -6,27 +6,96 @@
 
 #include "scene/colorspace.h"
 
+#include "util/math.h"
+
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 
 CCL_NAMESPACE_BEGIN
 
 OIIOOutputDriver::OIIOOutputDriver(const string_view filepath,
-                                   const string_view pass,
+                                   const vector<Pass> &passes,
                                    LogFunction log)
-    : filepath_(filepath), pass_(pass), log_(log)
+    : filepath_(filepath), passes_(passes), log_(log)
 {
 }
 
-OIIOOutputDriver::~OIIOOutputDriver() {}
+OIIOOutputDriver::~OIIOOutputDriver()
+{
+  close_tiled_output();
+}
 
 void OIIOOutputDriver::write_render_tile(const Tile &tile)
 {
-  /* Only write the full buffer, no intermediate tiles. */
-  if (!(tile.size == tile.full_size)) {
+  if (tile.size == tile.full_size) {
+    write_full_image(tile);
     return;
   }
 
+  /* Intermediate tiles are only received when the session streams tiles, since otherwise only
+   * the full buffer is written. */
+  write_partial_tile(tile);
+}
+
+void OIIOOutputDriver::setup_channels(const ImageOutput *image_output)
+{
+  write_passes_.clear();
+  channel_names_.clear();
+
+  const bool is_multilayer = strcmp(image_output->format_name(), "openexr") == 0 &&
+                             passes_.size() > 1;
+  if (!is_multilayer) {
+    write_passes_.push_back({passes_[0].name, 4});
+    channel_names_ = {"R", "G", "B", "A"};
+  }
+  else {
+    for (const Pass &pass : passes_) {
+      const char *channel_ids = (pass.num_channels < 3) ? "XY" : "RGBA";
+      for (int i = 0; i < pass.num_channels; i++) {
+        channel_names_.push_back(pass.name + "." + channel_ids[i]);
+      }
+      write_passes_.push_back(pass);
+    }
+  }
+
+  /* Apply gamma correction for (some) non-linear file formats.
+   * TODO: use OpenColorIO view transform if available. */
+  apply_gamma_ = ColorSpaceManager::detect_known_colorspace(
+                     u_colorspace_auto, "", image_output->format_name(), true) ==
+                 u_colorspace_srgb;
+}
+
+bool OIIOOutputDriver::get_tile_pixels(const Tile &tile, vector<float> &pixels) const
+{
+  const int64_t num_pixels = int64_t(tile.size.x) * tile.size.y;
+  const int num_channels = channel_names_.size();
+  pixels.resize(num_pixels * num_channels);
+
+  if (write_passes_.size() == 1) {
+    return tile.get_pass_pixels(write_passes_[0].name, num_channels, pixels.data());
+  }
+
+  vector<float> pass_pixels;
+  int channel_offset = 0;
+  for (const Pass &pass : write_passes_) {
+    pass_pixels.resize(num_pixels * pass.num_channels);
+    if (!tile.get_pass_pixels(pass.name, pass.num_channels, pass_pixels.data())) {
+      return false;
+    }
+
+    for (int64_t i = 0; i < num_pixels; i++) {
+      for (int c = 0; c < pass.num_channels; c++) {
+        pixels[i * num_channels + channel_offset + c] = pass_pixels[i * pass.num_channels + c];
+      }
+    }
+    channel_offset += pass.num_channels;
+  }
+
+  return true;
+}
+
+void OIIOOutputDriver::write_full_image(const Tile &tile)
+{
   log_(string_printf("Writing image %s", filepath_.c_str()));
 
   unique_ptr<ImageOutput> image_output(ImageOutput::create(filepath_));
@@ -38,30 +107,30 @@ void OIIOOutputDriver::write_render_tile(const Tile &tile)
   const int width = tile.size.x;
   const int height = tile.size.y;
 
-  ImageSpec spec(width, height, 4, TypeDesc::FLOAT);
+  setup_channels(image_output.get());
+  const int num_channels = channel_names_.size();
+
+  ImageSpec spec(width, height, num_channels, TypeDesc::FLOAT);
+  spec.channelnames = channel_names_;
   if (!image_output->open(filepath_, spec)) {
     log_("Failed to create image file");
     return;
   }
 
-  vector<float> pixels(width * height * 4);
-  if (!tile.get_pass_pixels(pass_, 4, pixels.data())) {
+  vector<float> pixels;
+  if (!get_tile_pixels(tile, pixels)) {
     log_("Failed to read render pass pixels");
     return;
   }
 
   /* Manipulate offset and stride to convert from bottom-up to top-down convention. */
   ImageBuf image_buffer(spec,
-                        pixels.data() + (height - 1) * width * 4,
+                        pixels.data() + (height - 1) * width * num_channels,
                         AutoStride,
-                        -width * 4 * sizeof(float),
+                        -width * num_channels * sizeof(float),
                         AutoStride);
 
-  /* Apply gamma correction for (some) non-linear file formats.
-   * TODO: use OpenColorIO view transform if available. */
-  if (ColorSpaceManager::detect_known_colorspace(
-          u_colorspace_auto, "", image_output->format_name(), true) == u_colorspace_srgb)
-  {
+  if (apply_gamma_) {
     const float g = 1.0f / 2.2f;
     ImageBufAlgo::pow(image_buffer, image_buffer, {g, g, g, 1.0f});
   }
@@ -72,4 +141,120 @@ void OIIOOutputDriver::write_render_tile(const Tile &tile)
   image_output->close();
 }
 
+bool OIIOOutputDriver::open_tiled_output(const Tile &tile)
+{
+  log_(string_printf("Writing tiled image %s", filepath_.c_str()));
+
+  unique_ptr<ImageOutput> image_output(ImageOutput::create(filepath_));
+  if (image_output == nullptr || !image_output->supports("tiles")) {
+    log_("Failed to create tiled image file, format does not support tiles");
+    return false;
+  }
+
+  /* Tiles are streamed in the order they are rendered, starting with the first one which has the
+   * full tile size. */
+  const int width = tile.full_size.x;
+  const int height = tile.full_size.y;
+  const int tile_width = min(tile.size.x, width);
+  const int tile_height = min(tile.size.y, height);
+
+  /* Tiles are rendered bottom-up while the image is stored top-down. Extend the data window above
+   * the display window, so that the flipped tiles remain aligned to the tile grid. */
+  const int aligned_height = int(divide_up(height, tile_height)) * tile_height;
+
+  setup_channels(image_output.get());
+
+  ImageSpec spec(width, aligned_height, channel_names_.size(), TypeDesc::FLOAT);
+  spec.channelnames = channel_names_;
+  spec.y = height - aligned_height;
+  spec.full_x = 0;
+  spec.full_y = 0;
+  spec.full_width = width;
+  spec.full_height = height;
+  spec.tile_width = tile_width;
+  spec.tile_height = tile_height;
+  spec.attribute("openexr:lineOrder", "randomY");
+
+  if (!image_output->open(filepath_, spec)) {
+    log_("Failed to create image file");
+    return false;
+  }
+
+  tiled_.image_output = std::move(image_output);
+  tiled_.spec = spec;
+  tiled_.num_pixels_written = 0;
+
+  return true;
+}
+
+void OIIOOutputDriver::close_tiled_output()
+{
+  if (!tiled_.image_output) {
+    return;
+  }
+
+  if (!tiled_.image_output->close()) {
+    log_(string_printf("Failed to close image file: %s", tiled_.image_output->geterror().c_str()));
+  }
+
+  tiled_.image_output = nullptr;
+}
+
+void OIIOOutputDriver::write_partial_tile(const Tile &tile)
+{
+  if (!tiled_.image_output && !open_tiled_output(tile)) {
+    return;
+  }
+
+  const ImageSpec &spec = tiled_.spec;
+  const int width = tile.size.x;
+  const int height = tile.size.y;
+  const int num_channels = spec.nchannels;
+
+  vector<float> pixels;
+  if (!get_tile_pixels(tile, pixels)) {
+    log_("Failed to read render pass pixels");
+    return;
+  }
+
+  /* Range of rows covered by the tile in the top-down convention, extended to the tile grid of
+   * the image. Rows outside of the tile are only written for the topmost tiles, and they are
+   * outside of the display window. */
+  const int y_end = spec.full_height - tile.offset.y;
+  const int y_begin = spec.y + ((y_end - height - spec.y) / spec.tile_height) * spec.tile_height;
+  const int x_begin = tile.offset.x;
+  const int x_end = tile.offset.x + width;
+
+  const int64_t row_size = int64_t(width) * num_channels;
+  vector<float> tile_pixels((y_end - y_begin) * row_size, 0.0f);
+  for (int y = 0; y < height; y++) {
+    const float *src = pixels.data() + y * row_size;
+    float *dst = tile_pixels.data() + (y_end - y_begin - 1 - y) * row_size;
+    memcpy(dst, src, sizeof(float) * row_size);
+  }
+
+  /* Apply gamma correction for (some) non-linear file formats, which only get RGBA. */
+  if (apply_gamma_) {
+    const float g = 1.0f / 2.2f;
+    for (size_t i = 0; i < tile_pixels.size(); i += num_channels) {
+      tile_pixels[i + 0] = powf(max(tile_pixels[i + 0], 0.0f), g);
+      tile_pixels[i + 1] = powf(max(tile_pixels[i + 1], 0.0f), g);
+      tile_pixels[i + 2] = powf(max(tile_pixels[i + 2], 0.0f), g);
+    }
+  }
+
+  if (!tiled_.image_output->write_tiles(
+          x_begin, x_end, y_begin, y_end, 0, 1, TypeDesc::FLOAT, tile_pixels.data()))
+  {
+    log_(string_printf("Failed to write tile: %s", tiled_.image_output->geterror().c_str()));
+    return;
+  }
+
+  /* Close the file as soon as the full frame is written, so that it is valid on disk. */
+  tiled_.num_pixels_written += int64_t(width) * height;
+  if (tiled_.num_pixels_written >= int64_t(spec.full_width) * spec.full_height) {
+    close_tiled_output();
+  }
+}
+
 CCL_NAMESPACE_END
@@ -16,15 +16,48 @@ class OIIOOutputDriver : public OutputDriver {
  public:
   typedef function<void(const string &)> LogFunction;
 
-  OIIOOutputDriver(const string_view filepath, const string_view pass, LogFunction log);
+  /* Render pass to write to the image. */
+  struct Pass {
+    string name;
+    int num_channels;
+  };
+
+  /* When the file format is OpenEXR all passes are written as layers, named after the pass.
+   * Other formats only get the first pass, as RGBA. */
+  OIIOOutputDriver(const string_view filepath, const vector<Pass> &passes, LogFunction log);
   virtual ~OIIOOutputDriver();
 
   void write_render_tile(const Tile &tile) override;
 
  protected:
+  /* Set up channels of the image for the passes which are written to the given output. */
+  void setup_channels(const ImageOutput *image_output);
+  /* Read pixels of all written passes, interleaved in the channel order of the image. */
+  bool get_tile_pixels(const Tile &tile, vector<float> &pixels) const;
+
+  void write_full_image(const Tile &tile);
+
+  /* Write a tile which is a part of the full frame into a tiled image, keeping the memory usage
+   * bounded by the size of the tile. Used when the session streams tiles. */
+  void write_partial_tile(const Tile &tile);
+  bool open_tiled_output(const Tile &tile);
+  void close_tiled_output();
+
   string filepath_;
-  string pass_;
+  vector<Pass> passes_;
   LogFunction log_;
+
+  /* Passes and channel names of the image which is being written. */
+  vector<Pass> write_passes_;
+  vector<string> channel_names_;
+  bool apply_gamma_ = false;
+
+  /* State of the tiled image while tiles are streamed into it. */
+  struct {
+    unique_ptr<ImageOutput> image_output;
+    ImageSpec spec;
+    int64_t num_pixels_written = 0;
+  } tiled_;
 };
 
 CCL_NAMESPACE_END
@@ -919,6 +919,19 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         default=0,
         min=0, max=16,
     )
+    debug_use_bvh_refit: BoolProperty(
+        name="Refit BVH",
+        description="Refit the BVH instead of rebuilding it when only vertex positions change between frames, "
+        "mostly useful together with persistent data for deforming animation (CPU only, not used with spatial splits)",
+        default=False,
+    )
+    debug_bvh_refit_sah_threshold: FloatProperty(
+        name="Refit Threshold",
+        description="Rebuild the refitted BVH once its estimated traversal cost grows past this factor "
+        "of the cost right after building",
+        default=1.5,
+        min=1.0, soft_max=4.0,
+    )
 
     bake_type: EnumProperty(
         name="Bake Type",
@@ -1040,6 +1053,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="",
         min=8, max=8192,
     )
+    use_tile_streaming: BoolProperty(
+        name="Stream Tiles",
+        description="Pass finished tiles to the render result right away instead of caching them to disk until the "
+        "frame is done. Finished tiles are kept in the cache directory, so that an interrupted render of the same "
+        "output file and frame resumes from them. Tiles are denoised individually with an overlap",
+        default=False,
+    )
 
     # Various fine-tuning debug flags
 
@@ -832,6 +832,7 @@ class CYCLES_RENDER_PT_performance_memory(CyclesButtonsPanel, Panel):
         sub = col.column()
         sub.active = cscene.use_auto_tile
         sub.prop(cscene, "tile_size")
+        sub.prop(cscene, "use_tile_streaming")
 
 
 class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Panel):
@@ -858,6 +859,12 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
 
         if use_cpu(context):
             col.prop(cscene, "debug_use_spatial_splits")
+            sub = col.column()
+            sub.active = not cscene.debug_use_spatial_splits
+            sub.prop(cscene, "debug_use_bvh_refit")
+            sub = col.column()
+            sub.active = cscene.debug_use_bvh_refit and not cscene.debug_use_spatial_splits
+            sub.prop(cscene, "debug_bvh_refit_sah_threshold")
             if use_embree:
                 col.prop(cscene, "debug_use_compact_bvh")
             else:
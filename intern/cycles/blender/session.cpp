@@ -441,6 +441,16 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
       effective_session_params.samples = samples;
     }
 
+    /* Streamed tiles of an interrupted render are found again by the output path and frame, the
+     * view layer and view are part of the tile file names. They are kept in the cache directory
+     * since the temporary directory is removed when Blender exits. */
+    if (effective_session_params.use_tile_streaming) {
+      const string output_path = blender_absolute_path(b_data, b_scene, b_render.filepath());
+      effective_session_params.tile_stream_id = output_path + "|" + b_scene.name() + "|" +
+                                                to_string(b_scene.frame_current());
+      effective_session_params.temp_dir = path_cache_get("tiles");
+    }
+
     /* Update session itself. */
     session->reset(effective_session_params, buffer_params);
 
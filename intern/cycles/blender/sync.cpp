@@ -855,6 +855,8 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
   params.use_bvh_compact_structure = RNA_boolean_get(&cscene, "debug_use_compact_bvh");
   params.use_bvh_unaligned_nodes = RNA_boolean_get(&cscene, "debug_use_hair_bvh");
   params.num_bvh_time_steps = RNA_int_get(&cscene, "debug_bvh_time_steps");
+  params.use_bvh_refit = RNA_boolean_get(&cscene, "debug_use_bvh_refit");
+  params.bvh_refit_sah_threshold = RNA_float_get(&cscene, "debug_bvh_refit_sah_threshold");
 
   PointerRNA csscene = RNA_pointer_get(&b_scene.ptr, "cycles_curves");
   params.hair_subdivisions = get_int(csscene, "subdivisions");
@@ -977,6 +979,8 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
   if (background) {
     params.use_auto_tile = RNA_boolean_get(&cscene, "use_auto_tile");
     params.tile_size = max(get_int(cscene, "tile_size"), 8);
+    params.use_tile_streaming = params.use_auto_tile && !b_engine.is_preview() &&
+                                RNA_boolean_get(&cscene, "use_tile_streaming");
   }
   else {
     params.use_auto_tile = false;
@@ -69,6 +69,11 @@ class BVH {
   vector<Geometry *> geometry;
   vector<Object *> objects;
 
+  /* SAH cost of the BVH right after it was built and after the last refit, normalized to the
+   * root bounds. Zero when the BVH type does not track it. */
+  float build_sah_cost;
+  float refit_sah_cost;
+
   static BVH *create(const BVHParams &params,
                      const vector<Geometry *> &geometry,
                      const vector<Object *> &objects,
@@ -70,6 +70,12 @@ void BVH2::build(Progress &progress, Stats *)
     return;
   }
 
+  build_sah_cost = root->computeSubtreeSAHCost(params);
+  refit_sah_cost = build_sah_cost;
+
+  /* Primitives of instanced geometry are appended after these by pack_instances(). */
+  num_own_prims = pack.prim_index.size();
+
   /* pack triangles */
   progress.set_substatus("Packing BVH triangles and strands");
   pack_primitives();
@@ -305,14 +311,18 @@ void BVH2::pack_nodes(const BVHNode *root)
 
 void BVH2::refit_nodes()
 {
-  assert(!params.top_level);
-
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
-  refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
+  float sah_cost = 0.0f;
+  refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility, sah_cost);
+
+  /* Same normalization as BVHNode::computeSubtreeSAHCost(), so the cost can be compared against
+   * the one of the freshly built tree. */
+  const float root_area = bbox.safe_area();
+  refit_sah_cost = (root_area > 0.0f) ? sah_cost / root_area : 0.0f;
 }
 
-void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
+void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility, float &sah_cost)
 {
   if (leaf) {
     /* refit leaf node */
@@ -321,7 +331,15 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     const int c0 = data[0].x;
     const int c1 = data[0].y;
 
-    refit_primitives(c0, c1, bbox, visibility);
+    if (c0 < 0) {
+      /* Object instance in the top level BVH, see pack_leaf(). */
+      refit_primitives(~c0, ~c0 + 1, bbox, visibility);
+      sah_cost += bbox.safe_area() * params.primitive_cost(1);
+    }
+    else {
+      refit_primitives(c0, c1, bbox, visibility);
+      sah_cost += bbox.safe_area() * params.primitive_cost(c1 - c0);
+    }
 
     /* TODO(sergey): De-duplicate with pack_leaf(). */
     float4 leaf_data[BVH_NODE_LEAF_SIZE];
@@ -342,8 +360,8 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     BoundBox bbox0 = BoundBox::empty, bbox1 = BoundBox::empty;
     uint visibility0 = 0, visibility1 = 0;
 
-    refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0);
-    refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1);
+    refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0, sah_cost);
+    refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1, sah_cost);
 
     if (is_unaligned) {
       Transform aligned_space = transform_identity();
@@ -357,6 +375,7 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     bbox.grow(bbox0);
     bbox.grow(bbox1);
     visibility = visibility0 | visibility1;
+    sah_cost += bbox.safe_area() * params.node_cost(2);
   }
 }
 
@@ -458,10 +477,12 @@ void BVH2::refit_primitives(int start, int end, BoundBox &bbox, uint &visibility
 
 void BVH2::pack_primitives()
 {
-  const size_t tidx_size = pack.prim_index.size();
+  /* When refitting the top level BVH, the arrays also contain the primitives of instanced geometry
+   * that were merged by pack_instances(). Their visibility was copied from the instanced BVH and
+   * their object index is unused, so leave them as they are. */
+  const size_t tidx_size = num_own_prims;
   /* Reserve size for arrays. */
-  pack.prim_visibility.clear();
-  pack.prim_visibility.resize(tidx_size);
+  pack.prim_visibility.resize(pack.prim_index.size());
   /* Fill in all the arrays. */
   for (unsigned int i = 0; i < tidx_size; i++) {
     if (pack.prim_index[i] != -1) {
@@ -41,6 +41,9 @@ class BVH2 : public BVH {
   PackedBVH pack;
 
  protected:
+  /* Number of primitives of this BVH itself, without the ones of instanced geometry. */
+  size_t num_own_prims = 0;
+
   /* constructor */
   friend class BVH;
   BVH2(const BVHParams &params,
@@ -82,7 +85,7 @@ class BVH2 : public BVH {
 
   /* refit */
   void refit_nodes();
-  void refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility);
+  void refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility, float &sah_cost);
 
   /* Refit range of primitives. */
   void refit_primitives(int start, int end, BoundBox &bbox, uint &visibility);
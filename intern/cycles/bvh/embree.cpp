@@ -35,6 +35,7 @@
 #  include "scene/object.h"
 #  include "scene/pointcloud.h"
 
+#  include "util/algorithm.h"
 #  include "util/foreach.h"
 #  include "util/log.h"
 #  include "util/progress.h"
@@ -112,6 +113,72 @@ BVHEmbree::~BVHEmbree()
   }
 }
 
+/* Order of the triangles of a mesh along a Morton curve through their centroids. */
+static vector<int> mesh_triangle_morton_order(const Mesh *mesh)
+{
+  const size_t num_triangles = mesh->num_triangles();
+  const float3 *verts = mesh->get_verts().data();
+
+  vector<float3> centroids(num_triangles);
+  BoundBox centroid_bounds = BoundBox::empty;
+  for (size_t i = 0; i < num_triangles; i++) {
+    const Mesh::Triangle t = mesh->get_triangle(i);
+    centroids[i] = (verts[t.v[0]] + verts[t.v[1]] + verts[t.v[2]]) * (1.0f / 3.0f);
+    centroid_bounds.grow(centroids[i]);
+  }
+
+  /* Spread the lower 10 bits of a value to every third bit. */
+  auto expand_bits = [](uint v) {
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+  };
+
+  const float3 scale = safe_divide(make_float3(1023.0f), centroid_bounds.size());
+  vector<pair<uint, int>> codes(num_triangles);
+  for (size_t i = 0; i < num_triangles; i++) {
+    const float3 p = (centroids[i] - centroid_bounds.min) * scale;
+    codes[i] = {(expand_bits((uint)p.x) << 2) | (expand_bits((uint)p.y) << 1) |
+                    expand_bits((uint)p.z),
+                (int)i};
+  }
+  sort(codes.begin(), codes.end());
+
+  vector<int> order(num_triangles);
+  for (size_t i = 0; i < num_triangles; i++) {
+    order[i] = codes[i].second;
+  }
+  return order;
+}
+
+/* SAH cost of the binary tree that halves the given triangles until they fit in a leaf, not
+ * normalized by the root area. */
+static float mesh_proxy_sah_cost(const BVHParams &params,
+                                 const float3 *verts,
+                                 const Mesh *mesh,
+                                 const int *order,
+                                 const size_t num,
+                                 BoundBox &r_bounds)
+{
+  if (num <= (size_t)params.max_triangle_leaf_size) {
+    for (size_t i = 0; i < num; i++) {
+      mesh->get_triangle(order[i]).bounds_grow(verts, r_bounds);
+    }
+    return r_bounds.safe_area() * params.primitive_cost(num);
+  }
+
+  const size_t half = num / 2;
+  BoundBox bounds0 = BoundBox::empty, bounds1 = BoundBox::empty;
+  const float sah_cost = mesh_proxy_sah_cost(params, verts, mesh, order, half, bounds0) +
+                         mesh_proxy_sah_cost(
+                             params, verts, mesh, order + half, num - half, bounds1);
+  r_bounds.grow(bounds0);
+  r_bounds.grow(bounds1);
+  return sah_cost + r_bounds.safe_area() * params.node_cost(2);
+}
+
 void BVHEmbree::build(Progress &progress,
                       Stats *stats,
                       RTCDevice rtc_device_,
@@ -135,7 +202,10 @@ void BVHEmbree::build(Progress &progress,
   const bool compact = params.use_compact_structure;
 
   scene = rtcNewScene(rtc_device);
-  const RTCSceneFlags scene_flags = (dynamic ? RTC_SCENE_FLAG_DYNAMIC : RTC_SCENE_FLAG_NONE) |
+  /* Geometry is only refitted by Embree in a two-level scene, which it builds for dynamic scenes.
+   * The top level is still built with the quality requested for the scene. */
+  const RTCSceneFlags scene_flags = (dynamic || params.use_refit ? RTC_SCENE_FLAG_DYNAMIC :
+                                                                   RTC_SCENE_FLAG_NONE) |
                                     (compact ? RTC_SCENE_FLAG_COMPACT : RTC_SCENE_FLAG_NONE) |
                                     RTC_SCENE_FLAG_ROBUST
 #  if EMBREE_MAJOR_VERSION >= 4
@@ -148,6 +218,14 @@ void BVHEmbree::build(Progress &progress,
                                                         RTC_BUILD_QUALITY_MEDIUM);
   rtcSetSceneBuildQuality(scene, build_quality);
 
+  /* Form the proxy trees of deforming meshes from their current positions, like Embree does for
+   * the BVHs it refits later. */
+  for (auto &it : deforming_geometry) {
+    if (it.first->geometry_type == Geometry::MESH) {
+      it.second = mesh_triangle_morton_order(static_cast<const Mesh *>(it.first));
+    }
+  }
+
   int i = 0;
   foreach (Object *ob, objects) {
     if (params.top_level) {
@@ -176,6 +254,69 @@ void BVHEmbree::build(Progress &progress,
 
   rtcSetSceneProgressMonitorFunction(scene, rtc_progress_func, &progress);
   rtcCommitScene(scene);
+
+  if (params.top_level) {
+    build_sah_cost = compute_sah_cost();
+    refit_sah_cost = build_sah_cost;
+  }
+}
+
+RTCBuildQuality BVHEmbree::geometry_build_quality(const Geometry *geom) const
+{
+  if (params.use_refit && deforming_geometry.find(geom) != deforming_geometry.end()) {
+    return RTC_BUILD_QUALITY_REFIT;
+  }
+  return build_quality;
+}
+
+float BVHEmbree::compute_sah_cost() const
+{
+  /* Embree does not expose its nodes. For deforming meshes, compute the cost of a proxy tree that
+   * is formed at build time and refitted along with the Embree BVH, so that its node areas grow
+   * the same way. Static geometry is estimated from its object bounds, which only serves to
+   * weigh it against the deforming geometry since its cost does not change. */
+  BoundBox bounds = BoundBox::empty;
+  float sah_cost = 0.0f;
+
+  foreach (Object *ob, objects) {
+    if (!ob->is_traceable()) {
+      continue;
+    }
+
+    const Geometry *geom = ob->get_geometry();
+    bounds.grow(ob->bounds);
+
+    const auto deforming = deforming_geometry.find(geom);
+    if (deforming != deforming_geometry.end() && !deforming->second.empty()) {
+      const Mesh *mesh = static_cast<const Mesh *>(geom);
+      BoundBox mesh_bounds = BoundBox::empty;
+      sah_cost += mesh_proxy_sah_cost(params,
+                                      mesh->get_verts().data(),
+                                      mesh,
+                                      deforming->second.data(),
+                                      deforming->second.size(),
+                                      mesh_bounds);
+      continue;
+    }
+
+    size_t num_primitives = 1;
+    if (!geom->is_instanced()) {
+      if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
+        num_primitives = static_cast<const Mesh *>(geom)->num_triangles();
+      }
+      else if (geom->geometry_type == Geometry::HAIR) {
+        num_primitives = static_cast<const Hair *>(geom)->num_segments();
+      }
+      else if (geom->geometry_type == Geometry::POINTCLOUD) {
+        num_primitives = static_cast<const PointCloud *>(geom)->num_points();
+      }
+    }
+
+    sah_cost += ob->bounds.safe_area() * params.primitive_cost(num_primitives);
+  }
+
+  const float root_area = bounds.safe_area();
+  return (root_area > 0.0f) ? sah_cost / root_area : 0.0f;
 }
 
 const char *BVHEmbree::get_last_error_message()
@@ -312,7 +453,7 @@ void BVHEmbree::add_triangles(const Object *ob, const Mesh *mesh, int i)
   const size_t num_triangles = mesh->num_triangles();
 
   RTCGeometry geom_id = rtcNewGeometry(rtc_device, RTC_GEOMETRY_TYPE_TRIANGLE);
-  rtcSetGeometryBuildQuality(geom_id, build_quality);
+  rtcSetGeometryBuildQuality(geom_id, geometry_build_quality(mesh));
   rtcSetGeometryTimeStepCount(geom_id, num_motion_steps);
 
   const int *triangles = mesh->get_triangles().data();
@@ -591,7 +732,7 @@ void BVHEmbree::add_points(const Object *ob, const PointCloud *pointcloud, int i
 
   RTCGeometry geom_id = rtcNewGeometry(rtc_device, type);
 
-  rtcSetGeometryBuildQuality(geom_id, build_quality);
+  rtcSetGeometryBuildQuality(geom_id, geometry_build_quality(pointcloud));
   rtcSetGeometryTimeStepCount(geom_id, num_motion_steps);
 
   set_point_vertex_buffer(geom_id, pointcloud, false);
@@ -654,7 +795,7 @@ void BVHEmbree::add_curves(const Object *ob, const Hair *hair, int i)
     }
   }
 
-  rtcSetGeometryBuildQuality(geom_id, build_quality);
+  rtcSetGeometryBuildQuality(geom_id, geometry_build_quality(hair));
   rtcSetGeometryTimeStepCount(geom_id, num_motion_steps);
 
   set_curve_vertex_buffer(geom_id, hair, false);
@@ -684,16 +825,31 @@ void BVHEmbree::refit(Progress &progress)
 {
   progress.set_substatus("Refitting BVH nodes");
 
-  /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs. */
+  /* Update the vertex buffers of changed geometry, then tell Embree to rebuild/-fit the BVHs.
+   * Geometry that deforms for the first time is switched to refit quality, which makes Embree
+   * rebuild its BVH once with a builder that supports refitting. */
+  bool new_deforming_geometry = false;
   unsigned geom_id = 0;
   foreach (Object *ob, objects) {
-    if (!params.top_level || (ob->is_traceable() && !ob->get_geometry()->is_instanced())) {
-      Geometry *geom = ob->get_geometry();
+    Geometry *geom = ob->get_geometry();
+    if ((!params.top_level || (ob->is_traceable() && !geom->is_instanced())) &&
+        geom->is_modified())
+    {
+      const bool is_new = deforming_geometry.find(geom) == deforming_geometry.end();
+      if (is_new) {
+        deforming_geometry[geom] = (geom->geometry_type == Geometry::MESH) ?
+                                       mesh_triangle_morton_order(static_cast<Mesh *>(geom)) :
+                                       vector<int>();
+        new_deforming_geometry = true;
+      }
 
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
         Mesh *mesh = static_cast<Mesh *>(geom);
         if (mesh->num_triangles() > 0) {
           RTCGeometry geom = rtcGetGeometry(scene, geom_id);
+          if (is_new) {
+            rtcSetGeometryBuildQuality(geom, RTC_BUILD_QUALITY_REFIT);
+          }
           set_tri_vertex_buffer(geom, mesh, true);
           rtcSetGeometryUserData(geom, (void *)mesh->prim_offset);
           rtcCommitGeometry(geom);
@@ -703,6 +859,9 @@ void BVHEmbree::refit(Progress &progress)
         Hair *hair = static_cast<Hair *>(geom);
         if (hair->num_curves() > 0) {
           RTCGeometry geom = rtcGetGeometry(scene, geom_id + 1);
+          if (is_new) {
+            rtcSetGeometryBuildQuality(geom, RTC_BUILD_QUALITY_REFIT);
+          }
           set_curve_vertex_buffer(geom, hair, true);
           rtcSetGeometryUserData(geom, (void *)hair->curve_segment_offset);
           rtcCommitGeometry(geom);
@@ -712,6 +871,9 @@ void BVHEmbree::refit(Progress &progress)
         PointCloud *pointcloud = static_cast<PointCloud *>(geom);
         if (pointcloud->num_points() > 0) {
           RTCGeometry geom = rtcGetGeometry(scene, geom_id);
+          if (is_new) {
+            rtcSetGeometryBuildQuality(geom, RTC_BUILD_QUALITY_REFIT);
+          }
           set_point_vertex_buffer(geom, pointcloud, true);
           rtcCommitGeometry(geom);
         }
@@ -721,6 +883,14 @@ void BVHEmbree::refit(Progress &progress)
   }
 
   rtcCommitScene(scene);
+
+  if (params.top_level) {
+    refit_sah_cost = compute_sah_cost();
+    /* Newly deforming geometry was just rebuilt, so this is the new reference cost. */
+    if (new_deforming_geometry) {
+      build_sah_cost = refit_sah_cost;
+    }
+  }
 }
 
 CCL_NAMESPACE_END
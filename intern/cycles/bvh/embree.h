@@ -18,6 +18,7 @@
 #  include "bvh/bvh.h"
 #  include "bvh/params.h"
 
+#  include "util/map.h"
 #  include "util/string.h"
 #  include "util/thread.h"
 #  include "util/types.h"
@@ -58,7 +59,10 @@ class BVHEmbree : public BVH {
   void add_points(const Object *ob, const PointCloud *pointcloud, int i);
   void add_triangles(const Object *ob, const Mesh *mesh, int i);
 
+  float compute_sah_cost() const;
+
  private:
+  enum RTCBuildQuality geometry_build_quality(const Geometry *geom) const;
   void set_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh, const bool update);
   void set_curve_vertex_buffer(RTCGeometry geom_id, const Hair *hair, const bool update);
   void set_point_vertex_buffer(RTCGeometry geom_id,
@@ -68,6 +72,12 @@ class BVHEmbree : public BVH {
   RTCDevice rtc_device;
   bool rtc_device_is_sycl;
   enum RTCBuildQuality build_quality;
+
+  /* Geometry whose vertices changed in a refit. Only these are built with refit quality, other
+   * geometry keeps the quality of the scene. For meshes, the value is the order of the triangles
+   * along a Morton curve at build time, which forms the proxy tree used to estimate the SAH cost
+   * of the refitted Embree BVH, whose nodes are not accessible. */
+  map<const Geometry *, vector<int>> deforming_geometry;
 };
 
 CCL_NAMESPACE_END
@@ -105,6 +105,9 @@ class BVHParams {
   /* Same as in SceneParams. */
   int bvh_type;
 
+  /* Top level BVH is going to be refitted on following updates. */
+  bool use_refit;
+
   /* These are needed for Embree. */
   int curve_subdivisions;
 
@@ -141,6 +144,7 @@ class BVHParams {
     num_motion_point_steps = 0;
 
     bvh_type = 0;
+    use_refit = false;
 
     curve_subdivisions = 4;
   }
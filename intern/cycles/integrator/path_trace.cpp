@@ -798,6 +798,16 @@ void PathTrace::write_tile_buffer(const RenderWork &render_work)
     VLOG_WORK << "Write tile result via buffer write callback.";
     tile_buffer_write();
   }
+  /* Pass the tile to the software right away when streaming tiles. Store it on disk only if it
+   * can be used to resume the render and is fully rendered, so that resuming an interrupted render
+   * never picks up a partial tile. */
+  else if (tile_manager_.use_tile_streaming()) {
+    VLOG_WORK << "Stream tile result via buffer write callback.";
+    if (tile_manager_.use_tile_stream_storage() && render_scheduler_.done()) {
+      tile_buffer_write_to_disk();
+    }
+    tile_buffer_write();
+  }
   /* Write tile to disk, so that the render work's render buffer can be re-used for the next tile.
    */
   else {
@@ -1069,6 +1079,52 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
   full_frame_state_.render_buffers = nullptr;
 }
 
+void PathTrace::process_stored_tile()
+{
+  const Tile &tile = tile_manager_.get_current_tile();
+
+  VLOG_WORK << "Processing stored tile at " << tile.x + tile.window_x << ", "
+            << tile.y + tile.window_y;
+
+  RenderBuffers tile_buffers(cpu_device_.get());
+
+  DenoiseParams denoise_params;
+  if (!tile_manager_.read_stored_tile(&tile_buffers, &denoise_params)) {
+    const string error_message = "Error reading stored tile from file";
+    if (progress_) {
+      progress_->set_error(error_message);
+      progress_->set_cancel(error_message);
+    }
+    else {
+      LOG(ERROR) << error_message;
+    }
+    return;
+  }
+
+  /* The stored buffers do not necessarily hold the denoised result, for example when denoising
+   * happened on a separate device, so denoise again. */
+  render_state_.has_denoised_result = false;
+
+  if (denoise_params.use) {
+    progress_set_status(get_layer_view_name(tile_buffers), "Denoising");
+
+    denoise_params.use_gpu = render_scheduler_.is_denoiser_gpu_used();
+    set_denoiser_params(denoise_params);
+
+    denoiser_->denoise_buffer(tile_buffers.params, &tile_buffers, 0, false);
+
+    render_state_.has_denoised_result = true;
+  }
+
+  full_frame_state_.render_buffers = &tile_buffers;
+  full_frame_state_.offset = make_int2(tile.x + tile.window_x, tile.y + tile.window_y);
+
+  tile_buffer_write();
+
+  full_frame_state_.render_buffers = nullptr;
+  full_frame_state_.offset = make_int2(0, 0);
+}
+
 int PathTrace::get_num_render_tile_samples() const
 {
   if (full_frame_state_.render_buffers) {
@@ -1139,7 +1195,7 @@ int2 PathTrace::get_render_tile_size() const
 int2 PathTrace::get_render_tile_offset() const
 {
   if (full_frame_state_.render_buffers) {
-    return make_int2(0, 0);
+    return full_frame_state_.offset;
   }
 
   const Tile &tile = tile_manager_.get_current_tile();
@@ -139,6 +139,10 @@ class PathTrace {
    * via the write callback. */
   void process_full_buffer_from_disk(string_view filename);
 
+  /* Read the current tile which was stored on disk by an earlier render with tile streaming,
+   * perform needed processing and write it to the software via the write callback. */
+  void process_stored_tile();
+
   /* Get number of samples in the current big tile render buffers. */
   int get_num_render_tile_samples() const;
 
@@ -354,6 +358,8 @@ class PathTrace {
   /* State of the full frame processing and writing to the software. */
   struct {
     RenderBuffers *render_buffers = nullptr;
+    /* Offset of the buffers in the full frame, non-zero when writing a single stored tile. */
+    int2 offset = make_int2(0, 0);
   } full_frame_state_;
 };
 
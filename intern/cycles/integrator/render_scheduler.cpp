@@ -408,7 +408,8 @@ bool RenderScheduler::set_postprocess_render_work(RenderWork *render_work)
   }
 
   if (denoiser_params_.use && !state_.last_work_tile_was_denoised) {
-    render_work->tile.denoise = !tile_manager_.has_multiple_tiles();
+    render_work->tile.denoise = !tile_manager_.has_multiple_tiles() ||
+                                tile_manager_.use_tile_streaming();
     any_scheduled = true;
   }
 
@@ -981,8 +982,9 @@ bool RenderScheduler::work_need_denoise(bool &delayed, bool &ready_to_display)
   }
 
   /* When multiple tiles are used the full frame will be denoised.
-   * Avoid per-tile denoising to save up render time. */
-  if (tile_manager_.has_multiple_tiles()) {
+   * Avoid per-tile denoising to save up render time. Streamed tiles are passed to the software
+   * one by one, so those are denoised at the last sample of every tile. */
+  if (tile_manager_.has_multiple_tiles() && !tile_manager_.use_tile_streaming()) {
     return false;
   }
 
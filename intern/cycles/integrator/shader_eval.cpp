@@ -91,30 +91,37 @@ bool ShaderEval::eval_cpu(Device *device,
   float *output_data = output.data();
   bool success = true;
 
+  /* Evaluate in chunks, so that cancellation checks and task scheduling overhead are
+   * amortized over many points. */
+  static const int64_t WORK_ITEMS_PER_TASK = 1024;
+
   tbb::task_arena local_arena(device->info.cpu_threads);
   local_arena.execute([&]() {
-    parallel_for(int64_t(0), work_size, [&](int64_t work_index) {
-      /* TODO: is this fast enough? */
-      if (progress_.get_cancel()) {
-        success = false;
-        return;
-      }
-
-      const int thread_index = tbb::this_task_arena::current_thread_index();
-      const KernelGlobalsCPU *kg = &kernel_thread_globals[thread_index];
-
-      switch (type) {
-        case SHADER_EVAL_DISPLACE:
-          kernels.shader_eval_displace(kg, input_data, output_data, work_index);
-          break;
-        case SHADER_EVAL_BACKGROUND:
-          kernels.shader_eval_background(kg, input_data, output_data, work_index);
-          break;
-        case SHADER_EVAL_CURVE_SHADOW_TRANSPARENCY:
-          kernels.shader_eval_curve_shadow_transparency(kg, input_data, output_data, work_index);
-          break;
-      }
-    });
+    parallel_for(blocked_range<int64_t>(0, work_size, WORK_ITEMS_PER_TASK),
+                 [&](const blocked_range<int64_t> &r) {
+                   if (progress_.get_cancel()) {
+                     success = false;
+                     return;
+                   }
+
+                   const int thread_index = tbb::this_task_arena::current_thread_index();
+                   const KernelGlobalsCPU *kg = &kernel_thread_globals[thread_index];
+
+                   for (int64_t work_index = r.begin(); work_index != r.end(); work_index++) {
+                     switch (type) {
+                       case SHADER_EVAL_DISPLACE:
+                         kernels.shader_eval_displace(kg, input_data, output_data, work_index);
+                         break;
+                       case SHADER_EVAL_BACKGROUND:
+                         kernels.shader_eval_background(kg, input_data, output_data, work_index);
+                         break;
+                       case SHADER_EVAL_CURVE_SHADOW_TRANSPARENCY:
+                         kernels.shader_eval_curve_shadow_transparency(
+                             kg, input_data, output_data, work_index);
+                         break;
+                     }
+                   }
+                 });
   });
 
   return success;
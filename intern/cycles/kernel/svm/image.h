@@ -42,6 +42,15 @@ ccl_device_noinline int svm_node_tex_image(
   svm_unpack_node_uchar4(node.z, &co_offset, &out_offset, &alpha_offset, &flags);
 
   float3 co = stack_load_float3(stack, co_offset);
+  if (flags & NODE_IMAGE_VECTOR_MAPPING) {
+    /* Constant Mapping node fused into the lookup, see ShaderGraph::fuse_image_mappings(). */
+    Transform tfm;
+    tfm.x = read_node_float(kg, &offset);
+    tfm.y = read_node_float(kg, &offset);
+    tfm.z = read_node_float(kg, &offset);
+    co = transform_point(&tfm, co);
+  }
+
   float2 tex_co;
   if (node.w == NODE_IMAGE_PROJ_SPHERE) {
     co = texco_remap_square(co);
@@ -32,4 +32,21 @@ ccl_device int svm_node_value_v(KernelGlobals kg,
   return offset;
 }
 
+/* Block of constant values gathered by the compiler, so that all constant inputs of a node are
+ * written with a single dispatch. Each data node holds two (stack offset, value) pairs, an odd
+ * number of values is padded by repeating the last pair. */
+ccl_device int svm_node_value_block(KernelGlobals kg,
+                                    ccl_private ShaderData *sd,
+                                    ccl_private float *stack,
+                                    uint num_values,
+                                    int offset)
+{
+  for (uint i = 0; i < num_values; i += 2) {
+    uint4 node1 = read_node(kg, &offset);
+    stack_store_float(stack, node1.x, __uint_as_float(node1.y));
+    stack_store_float(stack, node1.z, __uint_as_float(node1.w));
+  }
+  return offset;
+}
+
 CCL_NAMESPACE_END
@@ -29,10 +29,12 @@
 #  include "kernel/osl/globals.h"
 #endif
 
+#include "util/atomic.h"
 #include "util/foreach.h"
 #include "util/log.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -183,6 +185,11 @@ GeometryManager::GeometryManager()
 {
   update_flags = UPDATE_ALL;
   need_flags_update = true;
+  num_scene_bvh_builds = 0;
+  num_scene_bvh_refits = 0;
+  num_scene_bvh_refit_rebuilds = 0;
+  scene_bvh_build_time = 0.0;
+  scene_bvh_refit_time = 0.0;
 }
 
 GeometryManager::~GeometryManager() {}
@@ -784,34 +791,60 @@ void GeometryManager::device_update(Device *device,
                                    dicing_camera->get_full_height());
     dicing_camera->update(scene);
 
-    size_t i = 0;
+    vector<Mesh *> tess_meshes;
+    tess_meshes.reserve(total_tess_needed);
     foreach (Geometry *geom, scene->geometry) {
-      if (!(geom->is_modified() && geom->is_mesh())) {
-        continue;
-      }
-
-      Mesh *mesh = static_cast<Mesh *>(geom);
-      if (mesh->need_tesselation()) {
-        string msg = "Tessellating ";
-        if (mesh->name == "") {
-          msg += string_printf("%u/%u", (uint)(i + 1), (uint)total_tess_needed);
-        }
-        else {
-          msg += string_printf(
-              "%s %u/%u", mesh->name.c_str(), (uint)(i + 1), (uint)total_tess_needed);
+      if (geom->is_modified() && geom->is_mesh()) {
+        Mesh *mesh = static_cast<Mesh *>(geom);
+        if (mesh->need_tesselation()) {
+          tess_meshes.push_back(mesh);
         }
+      }
+    }
 
-        progress.set_status("Updating Mesh", msg);
-
-        mesh->subd_params->camera = dicing_camera;
-        DiagSplit dsplit(*mesh->subd_params);
-        mesh->tessellate(&dsplit);
+    /* Meshes are tessellated independently of each other, so run them in parallel. Dicing of
+     * each individual mesh is threaded as well, the task scheduler balances both levels. */
+    vector<double> tess_times(tess_meshes.size(), 0.0);
+    TaskPool pool;
 
-        i++;
+    /* Report the number of finished meshes, since they are not finished in order. */
+    uint32_t num_tessellated = 0;
+    progress.set_status("Updating Mesh",
+                        string_printf("Tessellating 0/%u", (uint)total_tess_needed));
 
+    for (size_t i = 0; i < tess_meshes.size(); i++) {
+      pool.push([&, i]() {
         if (progress.get_cancel()) {
           return;
         }
+
+        Mesh *mesh = tess_meshes[i];
+
+        {
+          scoped_timer timer(&tess_times[i]);
+
+          mesh->subd_params->camera = dicing_camera;
+          DiagSplit dsplit(*mesh->subd_params);
+          mesh->tessellate(&dsplit);
+        }
+
+        const uint32_t num_done = atomic_add_and_fetch_uint32(&num_tessellated, 1);
+        progress.set_status(
+            "Updating Mesh",
+            string_printf("Tessellating %u/%u", (uint)num_done, (uint)total_tess_needed));
+      });
+    }
+
+    TaskPool::Summary summary;
+    pool.wait_work(&summary);
+    VLOG_WORK << "Tessellation pool statistics:\n" << summary.full_report();
+
+    if (scene->update_stats) {
+      for (size_t i = 0; i < tess_meshes.size(); i++) {
+        const Mesh *mesh = tess_meshes[i];
+        const string name = (mesh->name == "") ? string_printf("Mesh %u", (uint)i) :
+                                                 mesh->name.string();
+        scene->update_stats->subdivision.times.add_entry({name, tess_times[i]});
       }
     }
 
@@ -878,13 +911,12 @@ void GeometryManager::device_update(Device *device,
       }
     });
 
+    vector<Mesh *> displace_meshes;
+
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_modified()) {
         if (geom->is_mesh()) {
-          Mesh *mesh = static_cast<Mesh *>(geom);
-          if (displace(device, scene, mesh, progress)) {
-            displacement_done = true;
-          }
+          displace_meshes.push_back(static_cast<Mesh *>(geom));
         }
         else if (geom->geometry_type == Geometry::HAIR) {
           Hair *hair = static_cast<Hair *>(geom);
@@ -904,6 +936,10 @@ void GeometryManager::device_update(Device *device,
         return;
       }
     }
+
+    if (displace(device, scene, displace_meshes, progress)) {
+      displacement_done = true;
+    }
   }
 
   if (progress.get_cancel()) {
@@ -1120,6 +1156,12 @@ void GeometryManager::collect_statistics(const Scene *scene, RenderStats *stats)
     stats->mesh.geometry.add_entry(
         NamedSizeEntry(string(geometry->name.c_str()), geometry->get_total_size_in_bytes()));
   }
+
+  stats->bvh.num_builds = num_scene_bvh_builds;
+  stats->bvh.num_refits = num_scene_bvh_refits;
+  stats->bvh.num_refit_rebuilds = num_scene_bvh_refit_rebuilds;
+  stats->bvh.build_time = scene_bvh_build_time;
+  stats->bvh.refit_time = scene_bvh_refit_time;
 }
 
 CCL_NAMESPACE_END
@@ -247,7 +247,17 @@ class GeometryManager {
   void collect_statistics(const Scene *scene, RenderStats *stats);
 
  protected:
-  bool displace(Device *device, Scene *scene, Mesh *mesh, Progress &progress);
+  /* Scene BVH updates done by this manager, reported in the render statistics. */
+  int num_scene_bvh_builds;
+  int num_scene_bvh_refits;
+  int num_scene_bvh_refit_rebuilds;
+  double scene_bvh_build_time;
+  double scene_bvh_refit_time;
+
+  /* Evaluate true displacement for all given meshes, batching shader evaluation across meshes.
+   * Returns true if any mesh was displaced. */
+  bool displace(Device *device, Scene *scene, const vector<Mesh *> &meshes, Progress &progress);
+  void displace_finalize(const Scene *scene, Mesh *mesh);
 
   void create_volume_mesh(const Scene *scene, Volume *volume, Progress &progress);
 
@@ -272,6 +282,7 @@ class GeometryManager {
                                 Progress &progress);
 
   void device_update_bvh(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
+  bool can_refit_scene_bvh(const Scene *scene, BVHLayout bvh_layout) const;
 
   void device_update_displacement_images(Device *device, Scene *scene, Progress &progress);
 
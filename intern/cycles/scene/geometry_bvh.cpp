@@ -30,6 +30,7 @@
 #include "util/log.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -123,6 +124,11 @@ void GeometryManager::device_update_bvh(Device *device,
   bparams.num_motion_point_steps = scene->params.num_bvh_time_steps;
   bparams.bvh_type = scene->params.bvh_type;
   bparams.curve_subdivisions = scene->params.curve_subdivisions();
+  /* Spatial splits clip primitive references to the split planes, which a refit has to undo by
+   * growing the leaves to the full primitive bounds. */
+  bparams.use_refit = scene->params.use_bvh_refit && !bparams.use_spatial_split &&
+                      (bparams.bvh_layout == BVH_LAYOUT_BVH2 ||
+                       bparams.bvh_layout == BVH_LAYOUT_EMBREE);
 
   VLOG_INFO << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
@@ -130,12 +136,73 @@ void GeometryManager::device_update_bvh(Device *device,
                          (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX ||
                           bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL);
 
+  bool can_refit_cpu = scene->bvh != nullptr && scene->bvh->params.use_refit &&
+                       can_refit_scene_bvh(scene, bparams.bvh_layout);
+
+  if (can_refit_cpu && bparams.bvh_layout == BVH_LAYOUT_BVH2) {
+    /* The packed BVH was handed over to the device arrays after the previous update, take it
+     * back to refit it in place instead of keeping a second copy around. */
+    PackedBVH &pack = static_cast<BVH2 *>(scene->bvh)->pack;
+    dscene->bvh_nodes.give_data(pack.nodes);
+    dscene->bvh_leaf_nodes.give_data(pack.leaf_nodes);
+    dscene->object_node.give_data(pack.object_node);
+    dscene->prim_type.give_data(pack.prim_type);
+    dscene->prim_visibility.give_data(pack.prim_visibility);
+    dscene->prim_index.give_data(pack.prim_index);
+    dscene->prim_object.give_data(pack.prim_object);
+    dscene->prim_time.give_data(pack.prim_time);
+
+    /* The device arrays were freed in the meantime. */
+    if (pack.nodes.empty() && pack.leaf_nodes.empty()) {
+      can_refit_cpu = false;
+    }
+  }
+
   BVH *bvh = scene->bvh;
   if (!scene->bvh) {
     bvh = scene->bvh = BVH::create(bparams, scene->geometry, scene->objects, device);
   }
 
-  device->build_bvh(bvh, progress, can_refit);
+  if (can_refit_cpu) {
+    progress.set_status("Updating Scene BVH", "Refitting");
+
+    const double start_time = time_dt();
+    device->build_bvh(bvh, progress, true);
+    scene_bvh_refit_time += time_dt() - start_time;
+    num_scene_bvh_refits++;
+
+    if (progress.get_cancel()) {
+      return;
+    }
+
+    /* Deformation can make the nodes of the refitted BVH overlap to the point where tracing
+     * rays through it costs more than building a new one. */
+    const float max_sah_cost = bvh->build_sah_cost * scene->params.bvh_refit_sah_threshold;
+    if (bvh->refit_sah_cost > max_sah_cost) {
+      VLOG_INFO << "Rebuilding scene BVH, SAH cost after refit " << bvh->refit_sah_cost
+                << " exceeds " << max_sah_cost << ".";
+
+      progress.set_status("Updating Scene BVH", "Building");
+
+      const double rebuild_start_time = time_dt();
+      device->build_bvh(bvh, progress, false);
+      scene_bvh_build_time += time_dt() - rebuild_start_time;
+      num_scene_bvh_builds++;
+      num_scene_bvh_refit_rebuilds++;
+    }
+  }
+  else {
+    const double start_time = time_dt();
+    device->build_bvh(bvh, progress, can_refit);
+    if (can_refit) {
+      scene_bvh_refit_time += time_dt() - start_time;
+      num_scene_bvh_refits++;
+    }
+    else {
+      scene_bvh_build_time += time_dt() - start_time;
+      num_scene_bvh_builds++;
+    }
+  }
 
   if (progress.get_cancel()) {
     return;
@@ -143,13 +210,11 @@ void GeometryManager::device_update_bvh(Device *device,
 
   const bool has_bvh2_layout = (bparams.bvh_layout == BVH_LAYOUT_BVH2);
 
-  PackedBVH pack;
-  if (has_bvh2_layout) {
-    pack = std::move(static_cast<BVH2 *>(bvh)->pack);
-  }
-  else {
-    pack.root_index = -1;
-  }
+  /* The device arrays steal the packed BVH arrays without copying them, a refit takes them back
+   * from the device arrays. */
+  PackedBVH empty_pack;
+  empty_pack.root_index = -1;
+  PackedBVH &pack = has_bvh2_layout ? static_cast<BVH2 *>(bvh)->pack : empty_pack;
 
   /* copy to device */
   progress.set_status("Updating Scene BVH", "Copying BVH to device");
@@ -197,4 +262,36 @@ void GeometryManager::device_update_bvh(Device *device,
   dscene->data.device_bvh = 0;
 }
 
+bool GeometryManager::can_refit_scene_bvh(const Scene *scene, BVHLayout bvh_layout) const
+{
+  /* The scene BVH is deleted whenever geometry is added, removed or changes topology, so what is
+   * left to check is that the primitives and objects are still the ones it was built for. */
+  const BVH *bvh = scene->bvh;
+  if (bvh->geometry != scene->geometry || bvh->objects != scene->objects) {
+    return false;
+  }
+
+  /* Embree instance transforms and visibility masks are only set when building. */
+  if (bvh_layout == BVH_LAYOUT_EMBREE && (update_flags & VISIBILITY_MODIFIED)) {
+    return false;
+  }
+
+  foreach (const Geometry *geom, scene->geometry) {
+    if (!geom->need_build_bvh(bvh_layout)) {
+      continue;
+    }
+
+    /* Instanced geometry BVHs are merged into the packed BVH2 nodes. */
+    if (bvh_layout == BVH_LAYOUT_BVH2 && geom->is_modified()) {
+      return false;
+    }
+
+    if (bvh_layout == BVH_LAYOUT_EMBREE && (update_flags & TRANSFORM_MODIFIED)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 CCL_NAMESPACE_END
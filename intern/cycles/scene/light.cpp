@@ -25,6 +25,7 @@
 #include "util/path.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/time.h"
 #include <stack>
 
 CCL_NAMESPACE_BEGIN
@@ -813,12 +814,15 @@ void LightManager::device_update_tree(Device *,
 
   /* TODO: For now, we'll start with a smaller number of max lights in a node.
    * More benchmarking is needed to determine what number works best. */
+  const double build_start_time = time_dt();
   LightTree light_tree(scene, dscene, progress, 8);
   LightTreeNode *root = light_tree.build(scene, dscene);
   if (progress.get_cancel()) {
     return;
   }
 
+  VLOG_INFO << "Light tree build time: " << time_dt() - build_start_time;
+
   /* Create arguments for recursive tree flatten. */
   LightTreeFlatten flatten;
   flatten.scene = scene;
@@ -7,6 +7,7 @@
 #include "scene/object.h"
 
 #include "util/progress.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -472,17 +473,21 @@ void LightTree::recursive_build(const Child child,
 
   /* Find the best place to split the emitters into 2 nodes.
    * If the best split cost is no better than making a leaf node, make a leaf instead. */
-  int split_dim = -1, middle;
-  if (should_split(emitters, start, middle, end, node->measure, node->light_link, split_dim)) {
-
-    if (split_dim != -1) {
-      /* Partition the emitters between start and end based on the centroids. */
-      std::nth_element(emitters + start,
-                       emitters + middle,
-                       emitters + end,
-                       [split_dim](const LightTreeEmitter &l, const LightTreeEmitter &r) {
-                         return l.centroid[split_dim] < r.centroid[split_dim];
-                       });
+  LightTreeSplit split;
+  if (should_split(emitters, start, end, node->measure, node->light_link, split)) {
+    const int middle = split.middle;
+
+    if (split.dim != -1) {
+      /* Partition the emitters between start and end based on the buckets of their centroids,
+       * matching the emitter counts the split was chosen with. */
+      const int dim = split.dim;
+      const int bucket = split.bucket;
+      const LightTreeBucketing &bucketing = split.bucketing;
+      std::partition(emitters + start,
+                     emitters + end,
+                     [dim, bucket, &bucketing](const LightTreeEmitter &emitter) {
+                       return bucketing.get(emitter.centroid)[dim] <= bucket;
+                     });
     }
 
     /* Recursively build the left branch. */
@@ -510,13 +515,39 @@ void LightTree::recursive_build(const Child child,
   }
 }
 
+using LightTreeBuckets =
+    std::array<std::array<LightTreeBucket, LightTreeBucket::num_buckets>, 3>;
+
+static BoundBox centroid_bounds(const LightTreeEmitter *emitters, const int start, const int end)
+{
+  BoundBox centroid_bbox = BoundBox::empty;
+  for (int i = start; i < end; i++) {
+    centroid_bbox.grow(emitters[i].centroid);
+  }
+  return centroid_bbox;
+}
+
+static void fill_buckets(const LightTreeEmitter *emitters,
+                         const int start,
+                         const int end,
+                         const LightTreeBucketing &bucketing,
+                         LightTreeBuckets &buckets)
+{
+  for (int i = start; i < end; i++) {
+    const LightTreeEmitter &emitter = emitters[i];
+    const int3 bucket_idx = bucketing.get(emitter.centroid);
+    buckets[0][bucket_idx.x].add(emitter);
+    buckets[1][bucket_idx.y].add(emitter);
+    buckets[2][bucket_idx.z].add(emitter);
+  }
+}
+
 bool LightTree::should_split(LightTreeEmitter *emitters,
                              const int start,
-                             int &middle,
                              const int end,
                              LightTreeMeasure &measure,
                              LightTreeLightLink &light_link,
-                             int &split_dim)
+                             LightTreeSplit &split)
 {
   const int num_emitters = end - start;
   if (num_emitters < 2) {
@@ -528,61 +559,89 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
     return false;
   }
 
-  middle = (start + end) / 2;
+  split.middle = (start + end) / 2;
+
+  /* Nodes with many emitters are only found near the root, where there are not enough subtrees
+   * to keep all threads busy. Process their emitters in blocks in parallel, and merge the results
+   * of the blocks in order so that the tree does not depend on the scheduling of the threads. */
+  const int num_blocks = divide_up(num_emitters, MIN_EMITTERS_PER_THREAD);
+  const auto block_range = [&](const int block) {
+    return std::make_pair(start + block * MIN_EMITTERS_PER_THREAD,
+                          min(start + (block + 1) * MIN_EMITTERS_PER_THREAD, end));
+  };
 
   BoundBox centroid_bbox = BoundBox::empty;
-  for (int i = start; i < end; i++) {
-    centroid_bbox.grow((emitters + i)->centroid);
+  if (num_blocks > 1) {
+    vector<BoundBox> block_bbox(num_blocks);
+    parallel_for(0, num_blocks, [&](const int block) {
+      const auto [block_start, block_end] = block_range(block);
+      block_bbox[block] = centroid_bounds(emitters, block_start, block_end);
+    });
+    for (const BoundBox &bbox : block_bbox) {
+      centroid_bbox.grow(bbox);
+    }
+  }
+  else {
+    centroid_bbox = centroid_bounds(emitters, start, end);
   }
 
   const float3 extent = centroid_bbox.size();
   const float max_extent = max4(extent.x, extent.y, extent.z, 0.0f);
 
+  /* Fill in buckets with emitters for all dimensions at once. */
+  split.bucketing = LightTreeBucketing(centroid_bbox);
+  LightTreeBuckets buckets;
+  if (num_blocks > 1) {
+    vector<LightTreeBuckets> block_buckets(num_blocks);
+    parallel_for(0, num_blocks, [&](const int block) {
+      const auto [block_start, block_end] = block_range(block);
+      fill_buckets(emitters, block_start, block_end, split.bucketing, block_buckets[block]);
+    });
+    buckets = block_buckets[0];
+    for (int block = 1; block < num_blocks; block++) {
+      for (int dim = 0; dim < 3; dim++) {
+        for (int i = 0; i < LightTreeBucket::num_buckets; i++) {
+          buckets[dim][i] = buckets[dim][i] + block_buckets[block][dim][i];
+        }
+      }
+    }
+  }
+  else {
+    fill_buckets(emitters, start, end, split.bucketing, buckets);
+  }
+
   /* Check each dimension to find the minimum splitting cost. */
   float total_cost = 0.0f;
   float min_cost = FLT_MAX;
   for (int dim = 0; dim < 3; dim++) {
     /* If the centroid bounding box is 0 along a given dimension and the node measure is already
      * computed, skip it. */
-    if (centroid_bbox.size()[dim] == 0.0f && dim != 0) {
+    if (extent[dim] == 0.0f && dim != 0) {
       continue;
     }
 
-    const float inv_extent = 1 / (centroid_bbox.size()[dim]);
-
-    /* Fill in buckets with emitters. */
-    std::array<LightTreeBucket, LightTreeBucket::num_buckets> buckets;
-    for (int i = start; i < end; i++) {
-      const LightTreeEmitter *emitter = emitters + i;
-
-      /* Place emitter into the appropriate bucket, where the centroid box is split into equal
-       * partitions. */
-      int bucket_idx = LightTreeBucket::num_buckets *
-                       (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
-      bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
-
-      buckets[bucket_idx].add(*emitter);
-    }
+    const float inv_extent = 1 / extent[dim];
+    const std::array<LightTreeBucket, LightTreeBucket::num_buckets> &dim_buckets = buckets[dim];
 
     /* Precompute the left bucket measure cumulatively. */
     std::array<LightTreeBucket, LightTreeBucket::num_buckets - 1> left_buckets;
-    left_buckets.front() = buckets.front();
+    left_buckets.front() = dim_buckets.front();
     for (int i = 1; i < LightTreeBucket::num_buckets - 1; i++) {
-      left_buckets[i] = left_buckets[i - 1] + buckets[i];
+      left_buckets[i] = left_buckets[i - 1] + dim_buckets[i];
     }
 
     if (dim == 0) {
       /* Calculate node measure by summing up the bucket measure. */
-      measure = left_buckets.back().measure + buckets.back().measure;
-      light_link = left_buckets.back().light_link + buckets.back().light_link;
+      measure = left_buckets.back().measure + dim_buckets.back().measure;
+      light_link = left_buckets.back().light_link + dim_buckets.back().light_link;
 
       /* Degenerate case with co-located emitters. */
-      if (is_zero(centroid_bbox.size())) {
+      if (is_zero(extent)) {
         break;
       }
 
       /* If the centroid bounding box is 0 along a given dimension, skip it. */
-      if (centroid_bbox.size()[dim] == 0.0f) {
+      if (extent[dim] == 0.0f) {
         continue;
       }
 
@@ -594,22 +653,23 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
 
     /* Precompute the right bucket measure cumulatively. */
     std::array<LightTreeBucket, LightTreeBucket::num_buckets - 1> right_buckets;
-    right_buckets.back() = buckets.back();
+    right_buckets.back() = dim_buckets.back();
     for (int i = LightTreeBucket::num_buckets - 3; i >= 0; i--) {
-      right_buckets[i] = right_buckets[i + 1] + buckets[i + 1];
+      right_buckets[i] = right_buckets[i + 1] + dim_buckets[i + 1];
     }
 
     /* Calculate the cost of splitting at each point between partitions. */
     const float regularization = max_extent * inv_extent;
-    for (int split = 0; split < LightTreeBucket::num_buckets - 1; split++) {
-      const float left_cost = left_buckets[split].measure.calculate();
-      const float right_cost = right_buckets[split].measure.calculate();
+    for (int split_bucket = 0; split_bucket < LightTreeBucket::num_buckets - 1; split_bucket++) {
+      const float left_cost = left_buckets[split_bucket].measure.calculate();
+      const float right_cost = right_buckets[split_bucket].measure.calculate();
       const float cost = regularization * (left_cost + right_cost);
 
       if (cost < total_cost && cost < min_cost) {
         min_cost = cost;
-        split_dim = dim;
-        middle = start + left_buckets[split].count;
+        split.dim = dim;
+        split.bucket = split_bucket;
+        split.middle = start + left_buckets[split_bucket].count;
       }
     }
   }
@@ -237,6 +237,47 @@ struct LightTreeBucket {
 
 LightTreeBucket operator+(const LightTreeBucket &a, const LightTreeBucket &b);
 
+/* Light Tree Bucketing
+ * Places emitters into buckets along all three dimensions of the centroid bounds at once, so
+ * that every emitter is only visited once to evaluate the splitting costs. */
+struct LightTreeBucketing {
+  float3 min;
+  float3 scale;
+
+  LightTreeBucketing() = default;
+
+  LightTreeBucketing(const BoundBox &centroid_bbox) : min(centroid_bbox.min)
+  {
+    /* Dimensions with zero extent place all emitters into the first bucket. */
+    const float3 extent = centroid_bbox.size();
+    scale = make_float3(extent.x == 0.0f ? 0.0f : 1.0f / extent.x,
+                        extent.y == 0.0f ? 0.0f : 1.0f / extent.y,
+                        extent.z == 0.0f ? 0.0f : 1.0f / extent.z);
+  }
+
+  __forceinline int3 get(const float3 centroid) const
+  {
+    /* Split the centroid box into equal partitions. */
+    const float3 index = float(LightTreeBucket::num_buckets) * (centroid - min) * scale;
+    return clamp(make_int3(int(index.x), int(index.y), int(index.z)),
+                 0,
+                 LightTreeBucket::num_buckets - 1);
+  }
+};
+
+/* Split of the emitters of a node between its two children. */
+struct LightTreeSplit {
+  /* Dimension along which the emitters are partitioned, or -1 to split in the middle of the
+   * emitters without partitioning them. */
+  int dim = -1;
+  /* Emitters in buckets up to and including this one go to the left child. */
+  int bucket = 0;
+  /* Index of the first emitter of the right child. */
+  int middle = 0;
+
+  LightTreeBucketing bucketing;
+};
+
 /* Light Tree Node */
 struct LightTreeNode {
   LightTreeMeasure measure;
@@ -429,7 +470,8 @@ class LightTree {
  private:
   /* Thread. */
   TaskPool task_pool;
-  /* Do not spawn a thread if less than this amount of emitters are to be processed. */
+  /* Do not spawn a thread if less than this amount of emitters are to be processed. This is also
+   * the block size in which the emitters of large nodes are bucketed in parallel. */
   enum { MIN_EMITTERS_PER_THREAD = 4096 };
 
   void recursive_build(Child child,
@@ -442,11 +484,10 @@ class LightTree {
 
   bool should_split(LightTreeEmitter *emitters,
                     const int start,
-                    int &middle,
                     const int end,
                     LightTreeMeasure &measure,
                     LightTreeLightLink &light_link,
-                    int &split_dim);
+                    LightTreeSplit &split);
 
   /* Check whether the light tree can use this triangle as light-emissive. */
   bool triangle_usable_as_light(Mesh *mesh, int prim_id);
@@ -15,6 +15,7 @@
 #include "util/map.h"
 #include "util/progress.h"
 #include "util/set.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -34,14 +35,14 @@ static float3 compute_face_normal(const Mesh::Triangle &t, float3 *verts)
   return norm / normlen;
 }
 
-/* Fill in coordinates for mesh displacement shader evaluation on device. */
+/* Fill in coordinates for mesh displacement shader evaluation on device.
+ * Returns the number of inputs written. */
 static int fill_shader_input(const Scene *scene,
                              const Mesh *mesh,
                              const size_t object_index,
-                             device_vector<KernelShaderEvalInput> &d_input)
+                             KernelShaderEvalInput *d_input_data)
 {
   int d_input_size = 0;
-  KernelShaderEvalInput *d_input_data = d_input.data();
 
   const array<int> &mesh_shaders = mesh->get_shader();
   const array<Node *> &mesh_used_shaders = mesh->get_used_shaders();
@@ -102,10 +103,9 @@ static int fill_shader_input(const Scene *scene,
   return d_input_size;
 }
 
-/* Read back mesh displacement shader output. */
-static void read_shader_output(const Scene *scene,
-                               Mesh *mesh,
-                               const device_vector<float> &d_output)
+/* Read back mesh displacement shader output.
+ * Returns the number of floats consumed. */
+static int read_shader_output(const Scene *scene, Mesh *mesh, const float *d_output_data)
 {
   const array<int> &mesh_shaders = mesh->get_shader();
   const array<Node *> &mesh_used_shaders = mesh->get_used_shaders();
@@ -115,7 +115,6 @@ static void read_shader_output(const Scene *scene,
   const int num_motion_steps = mesh->get_motion_steps();
   vector<bool> done(num_verts, false);
 
-  const float *d_output_data = d_output.data();
   int d_output_index = 0;
 
   Attribute *attr_mP = mesh->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
@@ -151,46 +150,16 @@ static void read_shader_output(const Scene *scene,
       }
     }
   }
+
+  return d_output_index;
 }
 
-bool GeometryManager::displace(Device *device, Scene *scene, Mesh *mesh, Progress &progress)
+/* Stitch displaced vertices and recompute normals after the displacement shader ran. */
+void GeometryManager::displace_finalize(const Scene *scene, Mesh *mesh)
 {
-  /* verify if we have a displacement shader */
-  if (!mesh->has_true_displacement()) {
-    return false;
-  }
-
   const size_t num_verts = mesh->verts.size();
   const size_t num_triangles = mesh->num_triangles();
 
-  if (num_triangles == 0) {
-    return false;
-  }
-
-  string msg = string_printf("Computing Displacement %s", mesh->name.c_str());
-  progress.set_status("Updating Mesh", msg);
-
-  /* find object index. todo: is arbitrary */
-  size_t object_index = OBJECT_NONE;
-
-  for (size_t i = 0; i < scene->objects.size(); i++) {
-    if (scene->objects[i]->get_geometry() == mesh) {
-      object_index = i;
-      break;
-    }
-  }
-
-  /* Evaluate shader on device. */
-  ShaderEval shader_eval(device, progress);
-  if (!shader_eval.eval(SHADER_EVAL_DISPLACE,
-                        num_verts,
-                        3,
-                        function_bind(&fill_shader_input, scene, mesh, object_index, _1),
-                        function_bind(&read_shader_output, scene, mesh, _1)))
-  {
-    return false;
-  }
-
   /* stitch */
   unordered_set<int> stitch_keys;
   for (pair<int, int> i : mesh->vert_to_stitching_key_map) {
@@ -396,6 +365,93 @@ bool GeometryManager::displace(Device *device, Scene *scene, Mesh *mesh, Progres
       }
     }
   }
+}
+
+bool GeometryManager::displace(Device *device,
+                               Scene *scene,
+                               const vector<Mesh *> &meshes,
+                               Progress &progress)
+{
+  /* Maximum number of shader evaluation points in a single batch, to bound the size of the
+   * input and output buffers while still giving the device large amounts of work. */
+  static const size_t DISPLACE_BATCH_SIZE = 1 << 22;
+
+  vector<Mesh *> displace_meshes;
+  foreach (Mesh *mesh, meshes) {
+    /* verify if we have a displacement shader */
+    if (mesh->has_true_displacement() && mesh->num_triangles() != 0) {
+      displace_meshes.push_back(mesh);
+    }
+  }
+
+  if (displace_meshes.empty()) {
+    return false;
+  }
+
+  /* find object index. todo: is arbitrary */
+  map<const Geometry *, size_t> object_indices;
+  for (size_t i = 0; i < scene->objects.size(); i++) {
+    object_indices.insert({scene->objects[i]->get_geometry(), i});
+  }
+
+  /* Evaluate shader on device, packing as many meshes as fit into each batch. */
+  ShaderEval shader_eval(device, progress);
+
+  for (size_t batch_begin = 0; batch_begin < displace_meshes.size();) {
+    size_t batch_end = batch_begin;
+    size_t batch_num_verts = 0;
+
+    do {
+      batch_num_verts += displace_meshes[batch_end]->verts.size();
+      batch_end++;
+    } while (batch_end < displace_meshes.size() &&
+             batch_num_verts + displace_meshes[batch_end]->verts.size() <= DISPLACE_BATCH_SIZE);
+
+    string msg;
+    if (batch_end - batch_begin == 1) {
+      msg = string_printf("Computing Displacement %s",
+                          displace_meshes[batch_begin]->name.c_str());
+    }
+    else {
+      msg = string_printf("Computing Displacement %u/%u",
+                          (uint)batch_end,
+                          (uint)displace_meshes.size());
+    }
+    progress.set_status("Updating Mesh", msg);
+
+    auto fill_input = [&](device_vector<KernelShaderEvalInput> &d_input) {
+      int d_input_size = 0;
+      for (size_t i = batch_begin; i < batch_end; i++) {
+        const Mesh *mesh = displace_meshes[i];
+        const auto it = object_indices.find(mesh);
+        const size_t object_index = (it != object_indices.end()) ? it->second : OBJECT_NONE;
+        d_input_size += fill_shader_input(
+            scene, mesh, object_index, d_input.data() + d_input_size);
+      }
+      return d_input_size;
+    };
+
+    auto read_output = [&](device_vector<float> &d_output) {
+      int d_output_index = 0;
+      for (size_t i = batch_begin; i < batch_end; i++) {
+        d_output_index += read_shader_output(
+            scene, displace_meshes[i], d_output.data() + d_output_index);
+      }
+    };
+
+    if (!shader_eval.eval(
+            SHADER_EVAL_DISPLACE, int(batch_num_verts), 3, fill_input, read_output))
+    {
+      return false;
+    }
+
+    batch_begin = batch_end;
+  }
+
+  /* Stitching and normals only touch the mesh itself. */
+  parallel_for_each(displace_meshes.begin(), displace_meshes.end(), [&](Mesh *mesh) {
+    displace_finalize(scene, mesh);
+  });
 
   return true;
 }
@@ -68,6 +68,10 @@ class SceneParams {
   bool use_bvh_compact_structure;
   bool use_bvh_unaligned_nodes;
   int num_bvh_time_steps;
+  /* Refit the scene BVH on the CPU instead of rebuilding it when only vertex positions
+   * change, rebuilding once its SAH cost grows past the given factor of the built one. */
+  bool use_bvh_refit;
+  float bvh_refit_sah_threshold;
   int hair_subdivisions;
   CurveShapeType hair_shape;
   int texture_limit;
@@ -83,6 +87,8 @@ class SceneParams {
     use_bvh_compact_structure = true;
     use_bvh_unaligned_nodes = true;
     num_bvh_time_steps = 0;
+    use_bvh_refit = false;
+    bvh_refit_sah_threshold = 1.5f;
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     texture_limit = 0;
@@ -97,6 +103,8 @@ class SceneParams {
              use_bvh_compact_structure == params.use_bvh_compact_structure &&
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
+             use_bvh_refit == params.use_bvh_refit &&
+             bvh_refit_sah_threshold == params.bvh_refit_sah_threshold &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
              texture_limit == params.texture_limit);
   }
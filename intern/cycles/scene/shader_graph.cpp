@@ -680,6 +680,43 @@ void ShaderGraph::deduplicate_nodes()
   }
 }
 
+/* Fuse constant Mapping nodes into the image textures they feed, so the texture lookup applies
+ * the transform itself. This saves a node and a stack round-trip of the vector per evaluation
+ * for the common Texture Coordinate -> Mapping -> Image Texture chain. Mapping nodes that end up
+ * unused are removed afterwards. Only the SVM image node supports this. */
+void ShaderGraph::fuse_image_mappings()
+{
+  foreach (ShaderNode *node, nodes) {
+    if (node->type != ImageTextureNode::get_node_type()) {
+      continue;
+    }
+
+    ImageTextureNode *image = static_cast<ImageTextureNode *>(node);
+    ShaderInput *vector_in = image->input("Vector");
+    if (image->use_vector_mapping || image->get_projection() == NODE_IMAGE_PROJ_BOX ||
+        !image->tex_mapping.skip() || !vector_in->link ||
+        vector_in->link->parent->type != MappingNode::get_node_type())
+    {
+      continue;
+    }
+
+    MappingNode *mapping = static_cast<MappingNode *>(vector_in->link->parent);
+    ShaderInput *mapping_vector_in = mapping->input("Vector");
+    if (mapping->get_mapping_type() == NODE_MAPPING_TYPE_NORMAL ||
+        !mapping->has_constant_transform() || !mapping_vector_in->link)
+    {
+      continue;
+    }
+
+    image->use_vector_mapping = true;
+    image->vector_mapping = mapping->constant_transform();
+
+    ShaderOutput *source = mapping_vector_in->link;
+    disconnect(vector_in);
+    connect(source, vector_in);
+  }
+}
+
 /* Check whether volume output has meaningful nodes, otherwise
  * disconnect the output.
  */
@@ -788,6 +825,9 @@ void ShaderGraph::clean(Scene *scene)
   constant_fold(scene);
   simplify_settings(scene);
   deduplicate_nodes();
+  if (!scene->shader_manager->use_osl()) {
+    fuse_image_mappings();
+  }
   verify_volume_output();
 
   /* we do two things here: find cycles and break them, and remove unused
@@ -358,6 +358,7 @@ class ShaderGraph : public NodeOwner {
   void constant_fold(Scene *scene);
   void simplify_settings(Scene *scene);
   void deduplicate_nodes();
+  void fuse_image_mappings();
   void verify_volume_output();
 };
 
@@ -395,6 +395,10 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
   }
 
   if (projection != NODE_IMAGE_PROJ_BOX) {
+    if (use_vector_mapping) {
+      flags |= NODE_IMAGE_VECTOR_MAPPING;
+    }
+
     /* If there only is one image (a very common case), we encode it as a negative value. */
     int num_nodes;
     if (handle.num_tiles() == 1) {
@@ -412,6 +416,12 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
                                              flags),
                       projection);
 
+    if (use_vector_mapping) {
+      compiler.add_node(vector_mapping.x);
+      compiler.add_node(vector_mapping.y);
+      compiler.add_node(vector_mapping.z);
+    }
+
     if (num_nodes > 0) {
       for (int i = 0; i < num_nodes; i++) {
         int4 node;
@@ -2077,6 +2087,31 @@ void MappingNode::constant_fold(const ConstantFolder &folder)
   }
 }
 
+bool MappingNode::has_constant_transform()
+{
+  return !input("Location")->link && !input("Rotation")->link && !input("Scale")->link;
+}
+
+Transform MappingNode::constant_transform() const
+{
+  const Transform rmat = euler_to_transform(rotation);
+
+  switch (mapping_type) {
+    case NODE_MAPPING_TYPE_POINT:
+      return transform_translate(location) * rmat * transform_scale(scale);
+    case NODE_MAPPING_TYPE_TEXTURE:
+      /* Rotation is orthonormal, so its inverse is the transpose used by svm_mapping(). */
+      return transform_scale(safe_divide(one_float3(), scale)) * transform_inverse(rmat) *
+             transform_translate(-location);
+    case NODE_MAPPING_TYPE_VECTOR:
+      return rmat * transform_scale(scale);
+    case NODE_MAPPING_TYPE_NORMAL:
+      return rmat * transform_scale(safe_divide(one_float3(), scale));
+    default:
+      return transform_zero();
+  }
+}
+
 void MappingNode::compile(SVMCompiler &compiler)
 {
   ShaderInput *vector_in = input("Vector");
@@ -2086,6 +2121,29 @@ void MappingNode::compile(SVMCompiler &compiler)
   ShaderOutput *vector_out = output("Vector");
 
   int vector_stack_offset = compiler.stack_assign(vector_in);
+
+  /* Specialize for constant transforms, which is the common case for texture coordinates. This
+   * avoids loading the transform inputs to the stack and building the rotation matrix for every
+   * evaluation, at the cost of a single matrix node. */
+  if (has_constant_transform()) {
+    int result_stack_offset = compiler.stack_assign(vector_out);
+    Transform tfm = constant_transform();
+
+    compiler.add_node(NODE_TEXTURE_MAPPING, vector_stack_offset, result_stack_offset);
+    compiler.add_node(tfm.x);
+    compiler.add_node(tfm.y);
+    compiler.add_node(tfm.z);
+
+    if (mapping_type == NODE_MAPPING_TYPE_NORMAL) {
+      compiler.add_node(NODE_VECTOR_MATH,
+                        NODE_VECTOR_MATH_NORMALIZE,
+                        compiler.encode_uchar4(
+                            result_stack_offset, result_stack_offset, result_stack_offset),
+                        compiler.encode_uchar4(SVM_STACK_INVALID, result_stack_offset));
+    }
+    return;
+  }
+
   int location_stack_offset = compiler.stack_assign(location_in);
   int rotation_stack_offset = compiler.stack_assign(rotation_in);
   int scale_stack_offset = compiler.stack_assign(scale_in);
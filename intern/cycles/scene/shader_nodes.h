@@ -99,11 +99,18 @@ class ImageTextureNode : public ImageSlotTextureNode {
   virtual bool equals(const ShaderNode &other)
   {
     const ImageTextureNode &other_node = (const ImageTextureNode &)other;
-    return ImageSlotTextureNode::equals(other) && animated == other_node.animated;
+    return ImageSlotTextureNode::equals(other) && animated == other_node.animated &&
+           use_vector_mapping == other_node.use_vector_mapping &&
+           (!use_vector_mapping || vector_mapping == other_node.vector_mapping);
   }
 
   ImageParams image_params() const;
 
+  /* Transform of a constant Mapping node that was fused into the texture lookup, applied to the
+   * vector before the texture mapping. See ShaderGraph::fuse_image_mappings(). */
+  bool use_vector_mapping = false;
+  Transform vector_mapping;
+
   /* Parameters. */
   NODE_SOCKET_API(ustring, filename)
   NODE_SOCKET_API(ustring, colorspace)
@@ -414,6 +421,12 @@ class MappingNode : public ShaderNode {
   SHADER_NODE_CLASS(MappingNode)
   void constant_fold(const ConstantFolder &folder);
 
+  /* Whether location, rotation and scale are not linked. */
+  bool has_constant_transform();
+  /* Affine transform equivalent to svm_mapping() for constant location, rotation and scale.
+   * For normals the result still needs to be normalized. */
+  Transform constant_transform() const;
+
   NODE_SOCKET_API(float3, vector)
   NODE_SOCKET_API(float3, location)
   NODE_SOCKET_API(float3, rotation)
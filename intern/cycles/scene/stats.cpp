@@ -222,6 +222,23 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+/* BVH statistics. */
+
+BVHStats::BVHStats()
+    : num_builds(0), num_refits(0), num_refit_rebuilds(0), build_time(0.0), refit_time(0.0)
+{
+}
+
+string BVHStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  string result = "";
+  result += string_printf("%sBuilds: %d (%.2fs)\n", indent.c_str(), num_builds, build_time);
+  result += string_printf("%sRefits: %d (%.2fs)\n", indent.c_str(), num_refits, refit_time);
+  result += string_printf("%sRebuilds after refit: %d\n", indent.c_str(), num_refit_rebuilds);
+  return result;
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
@@ -287,6 +304,7 @@ string RenderStats::full_report()
   string result = "";
   result += "Mesh statistics:\n" + mesh.full_report(1);
   result += "Image statistics:\n" + image.full_report(1);
+  result += "BVH statistics:\n" + bvh.full_report(1);
   if (has_profiling) {
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
@@ -312,6 +330,7 @@ string SceneUpdateStats::full_report()
   string result = "";
   result += "Scene:\n" + scene.full_report(1);
   result += "Geometry:\n" + geometry.full_report(1);
+  result += "Subdivision:\n" + subdivision.full_report(1);
   result += "Light:\n" + light.full_report(1);
   result += "Object:\n" + object.full_report(1);
   result += "Image:\n" + image.full_report(1);
@@ -331,6 +350,7 @@ string SceneUpdateStats::full_report()
 void SceneUpdateStats::clear()
 {
   geometry.times.clear();
+  subdivision.times.clear();
   image.times.clear();
   light.times.clear();
   object.times.clear();
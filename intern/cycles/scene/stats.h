@@ -161,6 +161,23 @@ class ImageStats {
   NamedSizeStats textures;
 };
 
+/* Statistics about scene BVH builds and refits. */
+class BVHStats {
+ public:
+  BVHStats();
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  int num_builds;
+  int num_refits;
+  /* Refits which were followed by a rebuild because the BVH quality degraded too much. */
+  int num_refit_rebuilds;
+
+  double build_time;
+  double refit_time;
+};
+
 /* Render process statistics. */
 class RenderStats {
  public:
@@ -176,6 +193,7 @@ class RenderStats {
 
   MeshStats mesh;
   ImageStats image;
+  BVHStats bvh;
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
@@ -194,6 +212,7 @@ class SceneUpdateStats {
   SceneUpdateStats();
 
   UpdateTimeStats geometry;
+  UpdateTimeStats subdivision; /* Per-mesh adaptive subdivision time. */
   UpdateTimeStats image;
   UpdateTimeStats light;
   UpdateTimeStats object;
@@ -261,19 +261,15 @@ int SVMCompiler::stack_assign(ShaderInput *input)
       input->stack_offset = stack_find_offset(input->type());
 
       if (input->type() == SocketType::FLOAT) {
-        add_node(NODE_VALUE_F,
-                 __float_as_int(node->get_float(input->socket_type)),
-                 input->stack_offset);
+        add_constant(input->stack_offset, __float_as_uint(node->get_float(input->socket_type)));
       }
       else if (input->type() == SocketType::INT) {
-        add_node(NODE_VALUE_F, node->get_int(input->socket_type), input->stack_offset);
+        add_constant(input->stack_offset, node->get_int(input->socket_type));
       }
       else if (input->type() == SocketType::VECTOR || input->type() == SocketType::NORMAL ||
                input->type() == SocketType::POINT || input->type() == SocketType::COLOR)
       {
-
-        add_node(NODE_VALUE_V, input->stack_offset);
-        add_node(NODE_VALUE_V, node->get_float3(input->socket_type));
+        add_constant(input->stack_offset, node->get_float3(input->socket_type));
       }
       else { /* should not get called for closure */
         assert(0);
@@ -387,17 +383,20 @@ uint SVMCompiler::encode_uchar4(uint x, uint y, uint z, uint w)
 
 void SVMCompiler::add_node(int a, int b, int c, int d)
 {
+  flush_constants();
   current_svm_nodes.push_back_slow(make_int4(a, b, c, d));
 }
 
 void SVMCompiler::add_node(ShaderNodeType type, int a, int b, int c)
 {
+  flush_constants();
   svm_node_types_used[type] = true;
   current_svm_nodes.push_back_slow(make_int4(type, a, b, c));
 }
 
 void SVMCompiler::add_node(ShaderNodeType type, const float3 &f)
 {
+  flush_constants();
   svm_node_types_used[type] = true;
   current_svm_nodes.push_back_slow(
       make_int4(type, __float_as_int(f.x), __float_as_int(f.y), __float_as_int(f.z)));
@@ -405,10 +404,52 @@ void SVMCompiler::add_node(ShaderNodeType type, const float3 &f)
 
 void SVMCompiler::add_node(const float4 &f)
 {
+  flush_constants();
   current_svm_nodes.push_back_slow(make_int4(
       __float_as_int(f.x), __float_as_int(f.y), __float_as_int(f.z), __float_as_int(f.w)));
 }
 
+void SVMCompiler::add_constant(int stack_offset, uint value)
+{
+  pending_constants.push_back({stack_offset, value});
+}
+
+void SVMCompiler::add_constant(int stack_offset, const float3 &f)
+{
+  pending_constants.push_back({stack_offset + 0, __float_as_uint(f.x)});
+  pending_constants.push_back({stack_offset + 1, __float_as_uint(f.y)});
+  pending_constants.push_back({stack_offset + 2, __float_as_uint(f.z)});
+}
+
+void SVMCompiler::flush_constants()
+{
+  if (pending_constants.empty()) {
+    return;
+  }
+
+  /* Constants are only gathered between two nodes, so writing them all right before the next
+   * node gives the same result as writing each of them where it was requested. */
+  const int num_values = pending_constants.size();
+
+  if (num_values == 1) {
+    svm_node_types_used[NODE_VALUE_F] = true;
+    current_svm_nodes.push_back_slow(make_int4(
+        NODE_VALUE_F, pending_constants[0].second, pending_constants[0].first, 0));
+  }
+  else {
+    svm_node_types_used[NODE_VALUE_BLOCK] = true;
+    current_svm_nodes.push_back_slow(make_int4(NODE_VALUE_BLOCK, num_values, 0, 0));
+
+    for (int i = 0; i < num_values; i += 2) {
+      const pair<int, uint> &a = pending_constants[i];
+      const pair<int, uint> &b = pending_constants[min(i + 1, num_values - 1)];
+      current_svm_nodes.push_back_slow(make_int4(a.first, a.second, b.first, b.second));
+    }
+  }
+
+  pending_constants.clear();
+}
+
 uint SVMCompiler::attribute(ustring name)
 {
   return scene->shader_manager->get_attribute_id(name);
@@ -685,11 +726,11 @@ void SVMCompiler::generate_multi_closure(ShaderNode *root_node,
         /* Add instruction to skip closure and its dependencies if mix
          * weight is zero.
          */
-        svm_node_types_used[NODE_JUMP_IF_ONE] = true;
-        current_svm_nodes.push_back_slow(make_int4(NODE_JUMP_IF_ONE, 0, stack_assign(facin), 0));
+        add_node(NODE_JUMP_IF_ONE, 0, stack_assign(facin), 0);
         int node_jump_skip_index = current_svm_nodes.size() - 1;
 
         generate_multi_closure(root_node, cl1in->link->parent, state);
+        flush_constants();
 
         /* Fill in jump instruction location to be after closure. */
         current_svm_nodes[node_jump_skip_index].y = current_svm_nodes.size() -
@@ -701,11 +742,11 @@ void SVMCompiler::generate_multi_closure(ShaderNode *root_node,
         /* Add instruction to skip closure and its dependencies if mix
          * weight is zero.
          */
-        svm_node_types_used[NODE_JUMP_IF_ZERO] = true;
-        current_svm_nodes.push_back_slow(make_int4(NODE_JUMP_IF_ZERO, 0, stack_assign(facin), 0));
+        add_node(NODE_JUMP_IF_ZERO, 0, stack_assign(facin), 0);
         int node_jump_skip_index = current_svm_nodes.size() - 1;
 
         generate_multi_closure(root_node, cl2in->link->parent, state);
+        flush_constants();
 
         /* Fill in jump instruction location to be after closure. */
         current_svm_nodes[node_jump_skip_index].y = current_svm_nodes.size() -
@@ -781,6 +822,7 @@ void SVMCompiler::compile_type(Shader *shader, ShaderGraph *graph, ShaderType ty
   /* clear all compiler state */
   memset((void *)&active_stack, 0, sizeof(active_stack));
   current_svm_nodes.clear();
+  pending_constants.clear();
 
   foreach (ShaderNode *node, graph->nodes) {
     foreach (ShaderInput *input, node->inputs)
@@ -854,6 +896,8 @@ void SVMCompiler::compile_type(Shader *shader, ShaderGraph *graph, ShaderType ty
     bump_state_offset = SVM_STACK_INVALID;
   }
 
+  flush_constants();
+
   /* if compile failed, generate empty shader */
   if (compile_failed) {
     current_svm_nodes.clear();
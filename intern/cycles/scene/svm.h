@@ -99,6 +99,8 @@ class SVMCompiler {
   void add_node(int a = 0, int b = 0, int c = 0, int d = 0);
   void add_node(ShaderNodeType type, const float3 &f);
   void add_node(const float4 &f);
+  void add_constant(int stack_offset, uint value);
+  void add_constant(int stack_offset, const float3 &f);
   uint attribute(ustring name);
   uint attribute(AttributeStandard std);
   uint attribute_standard(ustring name);
@@ -217,11 +219,16 @@ class SVMCompiler {
   /* multi closure */
   void generate_multi_closure(ShaderNode *root_node, ShaderNode *node, CompilerState *state);
 
+  /* Constant values are not emitted right away but gathered until the next node is added, and
+   * then written as a single NODE_VALUE_BLOCK instead of one node per value. */
+  void flush_constants();
+
   /* compile */
   void compile_type(Shader *shader, ShaderGraph *graph, ShaderType type);
 
   std::atomic_int *svm_node_types_used;
   array<int4> current_svm_nodes;
+  vector<pair<int, uint>> pending_constants;
   ShaderType current_type;
   Shader *current_shader;
   Stack active_stack;
@@ -321,7 +321,7 @@ RenderWork Session::run_update_for_next_iteration()
       do_delayed_reset();
 
       /* After reset make sure the tile manager is at the first big tile. */
-      have_tiles = tile_manager_.next();
+      have_tiles = next_tile_to_render();
       switched_to_new_tile = true;
     }
   }
@@ -366,7 +366,7 @@ RenderWork Session::run_update_for_next_iteration()
 
     progress.add_finished_tile(false);
 
-    have_tiles = tile_manager_.next();
+    have_tiles = next_tile_to_render();
     if (have_tiles) {
       render_scheduler_.reset_for_next_tile();
       switched_to_new_tile = true;
@@ -489,6 +489,27 @@ void Session::draw()
   path_trace_->draw();
 }
 
+bool Session::next_tile_to_render()
+{
+  while (tile_manager_.next()) {
+    if (!tile_manager_.has_stored_tile()) {
+      return true;
+    }
+
+    /* The tile was finished by an earlier render which got interrupted, pass it to the software
+     * without rendering it again. */
+    path_trace_->process_stored_tile();
+    progress.add_finished_tile(false);
+  }
+
+  /* Stored tiles of the frame are not needed anymore once all tiles are streamed. */
+  if (tile_manager_.use_tile_streaming()) {
+    tile_manager_.finish_write_tiles();
+  }
+
+  return false;
+}
+
 int2 Session::get_effective_tile_size() const
 {
   const int image_width = buffer_params_.width;
@@ -545,6 +566,7 @@ void Session::do_delayed_reset()
 
   /* Update for new state of scene and passes. */
   buffer_params_.update_passes(scene->passes);
+  tile_manager_.set_tile_streaming(params.use_tile_streaming, params.tile_stream_id);
   tile_manager_.update(buffer_params_, scene);
 
   /* Update temp directory on reset.
@@ -66,6 +66,17 @@ class SessionParams {
   /* Session-specific temporary directory to store in-progress EXR files in. */
   string temp_dir;
 
+  /* Write finished tiles to the output driver as soon as they are rendered, instead of merging
+   * them into a full-frame buffer at the end. Avoids having all passes of the full frame in
+   * memory, at the cost of full-frame denoising: tiles are denoised individually. */
+  bool use_tile_streaming;
+
+  /* Identifier of the frame which is rendered with tile streaming, for example the output file
+   * path. When not empty, finished tiles are stored on disk and starting a render with the same
+   * identifier resumes from the tiles which were finished by an interrupted render. It is picked
+   * up on reset, so that it can change for every frame of an animation. */
+  string tile_stream_id;
+
   SessionParams()
   {
     headless = false;
@@ -85,6 +96,8 @@ class SessionParams {
 
     use_resolution_divider = true;
 
+    use_tile_streaming = false;
+
     shadingsystem = SHADINGSYSTEM_SVM;
   }
 
@@ -96,7 +109,8 @@ class SessionParams {
              background == params.background && experimental == params.experimental &&
              pixel_size == params.pixel_size && threads == params.threads &&
              use_profiling == params.use_profiling && shadingsystem == params.shadingsystem &&
-             use_auto_tile == params.use_auto_tile && tile_size == params.tile_size);
+             use_auto_tile == params.use_auto_tile && tile_size == params.tile_size &&
+             use_tile_streaming == params.use_tile_streaming);
   }
 };
 
@@ -206,6 +220,12 @@ class Session {
 
   void do_delayed_reset();
 
+  /* Advance the tile manager to the next tile which needs to be rendered. Tiles which are stored
+   * on disk by an interrupted render are written to the software on the way.
+   *
+   * Returns false when there are no more tiles to be rendered. */
+  bool next_tile_to_render();
+
   int2 get_effective_tile_size() const;
 
   /* Session thread that performs rendering tasks decoupled from the thread
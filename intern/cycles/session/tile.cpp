@@ -15,6 +15,7 @@
 #include "session/session.h"
 #include "util/algorithm.h"
 #include "util/foreach.h"
+#include "util/hash.h"
 #include "util/log.h"
 #include "util/path.h"
 #include "util/string.h"
@@ -22,6 +23,8 @@
 #include "util/time.h"
 #include "util/types.h"
 
+#include <OpenImageIO/filesystem.h>
+
 CCL_NAMESPACE_BEGIN
 
 /* --------------------------------------------------------------------
@@ -303,6 +306,45 @@ static bool configure_image_spec_from_buffer(ImageSpec *image_spec,
   return true;
 }
 
+/* Get pixels of the tile window as a continuous block of memory.
+ *
+ * If there is an overscan used for the tile copy pixels into single continuous block of memory
+ * without any "gaps".
+ * This is a workaround for bug in OIIO (https://github.com/OpenImageIO/oiio/pull/3176).
+ * Our task reference: #93008. */
+static const float *get_tile_window_pixels(const RenderBuffers &tile_buffers,
+                                           vector<float> &pixel_storage)
+{
+  const BufferParams &tile_params = tile_buffers.params;
+
+  const int64_t pass_stride = tile_params.pass_stride;
+  const int64_t tile_row_stride = tile_params.width * pass_stride;
+
+  const float *pixels = tile_buffers.buffer.data() + tile_params.window_x * pass_stride +
+                        tile_params.window_y * tile_row_stride;
+
+  if (tile_params.window_x || tile_params.window_y ||
+      tile_params.window_width != tile_params.width ||
+      tile_params.window_height != tile_params.height)
+  {
+    pixel_storage.resize(pass_stride * tile_params.window_width * tile_params.window_height);
+    float *pixels_continuous = pixel_storage.data();
+
+    const int64_t pixels_row_stride = pass_stride * tile_params.width;
+    const int64_t pixels_continuous_row_stride = pass_stride * tile_params.window_width;
+
+    for (int i = 0; i < tile_params.window_height; ++i) {
+      memcpy(pixels_continuous, pixels, sizeof(float) * pixels_continuous_row_stride);
+      pixels += pixels_row_stride;
+      pixels_continuous += pixels_continuous_row_stride;
+    }
+
+    pixels = pixel_storage.data();
+  }
+
+  return pixels;
+}
+
 /* --------------------------------------------------------------------
  * Tile Manager.
  */
@@ -367,6 +409,24 @@ void TileManager::update(const BufferParams &params, const Scene *scene)
     node_to_image_spec_atttributes(
         &write_state_.image_spec, &denoise_params, ATTR_DENOISE_SOCKET_PREFIX);
 
+    if (use_tile_stream_storage()) {
+      /* Tiles stored by another session can only be re-used when they have the exact same layout,
+       * so include everything which affects it in the file name. */
+      string key = stream_state_.id + "|" + buffer_params_.layer.string() + "|" +
+                   buffer_params_.view.string() +
+                   string_printf("|%d %d %d %d|%d %d|",
+                                 buffer_params_.full_x,
+                                 buffer_params_.full_y,
+                                 buffer_params_.width,
+                                 buffer_params_.height,
+                                 tile_size_.x,
+                                 tile_size_.y);
+      for (const std::string &channel_name : write_state_.image_spec.channelnames) {
+        key += channel_name + ",";
+      }
+      stream_state_.file_part = string_printf("%08x", hash_string(key.c_str()));
+    }
+
     /* Not adaptive sampling overscan yet for baking, would need overscan also
      * for buffers read from the output driver. */
     if (adaptive_sampling.use && !scene->bake_manager->get_baking()) {
@@ -375,6 +435,13 @@ void TileManager::update(const BufferParams &params, const Scene *scene)
     else {
       overscan_ = 0;
     }
+
+    /* Streamed tiles are denoised one by one. Render them with an overlap which the denoiser sees
+     * but which is not written, so that the denoiser has the same context on both sides of the
+     * border between two tiles and no seams appear. */
+    if (stream_state_.use && denoise_params.use) {
+      overscan_ = max(overscan_, STREAM_DENOISE_OVERLAP);
+    }
   }
   else {
     write_state_.image_spec = ImageSpec();
@@ -387,6 +454,12 @@ void TileManager::set_temp_dir(const string &temp_dir)
   temp_dir_ = temp_dir;
 }
 
+void TileManager::set_tile_streaming(bool use_tile_streaming, const string &stream_id)
+{
+  stream_state_.use = use_tile_streaming;
+  stream_state_.id = stream_id;
+}
+
 bool TileManager::done()
 {
   return tile_state_.next_tile_index == tile_state_.num_tiles;
@@ -494,6 +567,10 @@ bool TileManager::close_tile_output()
 
 bool TileManager::write_tile(const RenderBuffers &tile_buffers)
 {
+  if (stream_state_.use) {
+    return write_stream_tile(tile_buffers);
+  }
+
   if (!write_state_.tile_out) {
     if (!open_tile_output()) {
       return false;
@@ -510,34 +587,9 @@ bool TileManager::write_tile(const RenderBuffers &tile_buffers)
   const int tile_y = tile_params.full_y - buffer_params_.full_y + tile_params.window_y;
 
   const int64_t pass_stride = tile_params.pass_stride;
-  const int64_t tile_row_stride = tile_params.width * pass_stride;
 
   vector<float> pixel_storage;
-  const float *pixels = tile_buffers.buffer.data() + tile_params.window_x * pass_stride +
-                        tile_params.window_y * tile_row_stride;
-
-  /* If there is an overscan used for the tile copy pixels into single continuous block of memory
-   * without any "gaps".
-   * This is a workaround for bug in OIIO (https://github.com/OpenImageIO/oiio/pull/3176).
-   * Our task reference: #93008. */
-  if (tile_params.window_x || tile_params.window_y ||
-      tile_params.window_width != tile_params.width ||
-      tile_params.window_height != tile_params.height)
-  {
-    pixel_storage.resize(pass_stride * tile_params.window_width * tile_params.window_height);
-    float *pixels_continuous = pixel_storage.data();
-
-    const int64_t pixels_row_stride = pass_stride * tile_params.width;
-    const int64_t pixels_continuous_row_stride = pass_stride * tile_params.window_width;
-
-    for (int i = 0; i < tile_params.window_height; ++i) {
-      memcpy(pixels_continuous, pixels, sizeof(float) * pixels_continuous_row_stride);
-      pixels += pixels_row_stride;
-      pixels_continuous += pixels_continuous_row_stride;
-    }
-
-    pixels = pixel_storage.data();
-  }
+  const float *pixels = get_tile_window_pixels(tile_buffers, pixel_storage);
 
   VLOG_WORK << "Write tile at " << tile_x << ", " << tile_y;
 
@@ -578,6 +630,11 @@ bool TileManager::write_tile(const RenderBuffers &tile_buffers)
 
 void TileManager::finish_write_tiles()
 {
+  if (stream_state_.use) {
+    finish_stream_tiles();
+    return;
+  }
+
   if (!write_state_.tile_out) {
     /* None of the tiles were written hence the file was not created.
      * Avoid creation of fully empty file since it is redundant. */
@@ -626,6 +683,116 @@ void TileManager::finish_write_tiles()
   write_state_.filename = "";
 }
 
+string TileManager::get_stream_tile_filename(const int index) const
+{
+  return path_join(temp_dir_,
+                   "cycles-tile-stream-" + stream_state_.file_part + "-" + to_string(index) +
+                       ".exr");
+}
+
+bool TileManager::write_stream_tile(const RenderBuffers &tile_buffers)
+{
+  const double time_start = time_dt();
+
+  DCHECK_EQ(tile_buffers.params.pass_stride, buffer_params_.pass_stride);
+
+  const BufferParams &tile_params = tile_buffers.params;
+
+  /* Store the whole tile including its overscan, with buffer parameters describing its position
+   * in the full frame. This way the file can be read back the same way as a full-frame buffer
+   * file, and a resumed tile is denoised with the same overlap as a rendered one. */
+  ImageSpec image_spec = write_state_.image_spec;
+  image_spec.width = image_spec.full_width = tile_params.width;
+  image_spec.height = image_spec.full_height = tile_params.height;
+  image_spec.tile_width = 0;
+  image_spec.tile_height = 0;
+  if (!buffer_params_to_image_spec_atttributes(&image_spec, tile_params)) {
+    return false;
+  }
+
+  const float *pixels = tile_buffers.buffer.data();
+
+  /* Write to a temporary file first, so that a render which gets interrupted while writing does
+   * not leave a partial tile behind which would be picked up when resuming. */
+  const int tile_index = tile_state_.next_tile_index - 1;
+  const string filename = get_stream_tile_filename(tile_index);
+  const string temp_filename = filename + ".incomplete.exr";
+  path_create_directories(temp_filename);
+
+  unique_ptr<ImageOutput> tile_out = ImageOutput::create(temp_filename);
+  if (!tile_out) {
+    LOG(ERROR) << "Error creating image output for " << temp_filename;
+    return false;
+  }
+
+  if (!tile_out->open(temp_filename, image_spec)) {
+    LOG(ERROR) << "Error opening tile file: " << tile_out->geterror();
+    return false;
+  }
+
+  bool success = tile_out->write_image(TypeDesc::FLOAT, pixels);
+  if (!success) {
+    LOG(ERROR) << "Error writing tile " << tile_out->geterror();
+  }
+
+  if (!tile_out->close()) {
+    LOG(ERROR) << "Error closing tile file " << tile_out->geterror();
+    success = false;
+  }
+  tile_out = nullptr;
+
+  string rename_error;
+  if (success && !OIIO::Filesystem::rename(temp_filename, filename, rename_error)) {
+    LOG(ERROR) << "Error renaming tile file: " << rename_error;
+    success = false;
+  }
+
+  if (!success) {
+    path_remove(temp_filename);
+    return false;
+  }
+
+  ++write_state_.num_tiles_written;
+
+  VLOG_WORK << "Tile " << tile_index << " stored in " << time_dt() - time_start << " seconds.";
+
+  return true;
+}
+
+bool TileManager::has_stored_tile() const
+{
+  if (!use_tile_stream_storage()) {
+    return false;
+  }
+
+  return path_exists(get_stream_tile_filename(tile_state_.next_tile_index - 1));
+}
+
+bool TileManager::read_stored_tile(RenderBuffers *buffers, DenoiseParams *denoise_params)
+{
+  return read_full_buffer_from_disk(
+      get_stream_tile_filename(tile_state_.next_tile_index - 1), buffers, denoise_params);
+}
+
+void TileManager::finish_stream_tiles()
+{
+  /* Keep tiles of an unfinished frame on disk, so that the render can be resumed. */
+  for (int tile_index = 0; tile_index < tile_state_.num_tiles; ++tile_index) {
+    if (!path_exists(get_stream_tile_filename(tile_index))) {
+      return;
+    }
+  }
+
+  for (int tile_index = 0; tile_index < tile_state_.num_tiles; ++tile_index) {
+    path_remove(get_stream_tile_filename(tile_index));
+  }
+
+  VLOG_WORK << "Removed stored tiles of the finished frame.";
+
+  write_state_.num_tiles_written = 0;
+  ++write_state_.tile_file_index;
+}
+
 bool TileManager::read_full_buffer_from_disk(const string_view filename,
                                              RenderBuffers *buffers,
                                              DenoiseParams *denoise_params)
@@ -59,6 +59,26 @@ class TileManager {
 
   void set_temp_dir(const string &temp_dir);
 
+  /* Stream finished tiles to the software instead of merging them into a full-frame file on disk,
+   * keeping memory usage bounded by the tile size.
+   *
+   * When the stream identifier is not empty, every finished tile is also stored in its own file in
+   * the temporary directory until the whole frame is done. The file names are stable across
+   * sessions, so that a render which got interrupted resumes from the tiles it already finished.
+   * Without an identifier nothing is written to disk. */
+  void set_tile_streaming(bool use_tile_streaming, const string &stream_id);
+
+  inline bool use_tile_streaming() const
+  {
+    return stream_state_.use;
+  }
+
+  /* Whether finished tiles are stored on disk to resume an interrupted render. */
+  inline bool use_tile_stream_storage() const
+  {
+    return stream_state_.use && !stream_state_.id.empty();
+  }
+
   inline int get_num_tiles() const
   {
     return tile_state_.num_tiles;
@@ -97,6 +117,15 @@ class TileManager {
     return write_state_.num_tiles_written != 0;
   }
 
+  /* Check whether the current tile has been stored on disk by an earlier session which used the
+   * same tile stream identifier. */
+  bool has_stored_tile() const;
+
+  /* Read the current tile stored on disk when tile streaming is used.
+   *
+   * Returns true on success. */
+  bool read_stored_tile(RenderBuffers *buffers, DenoiseParams *denoise_params);
+
   /* Read full frame render buffer from tiles file on disk.
    *
    * Returns true on success. */
@@ -110,6 +139,9 @@ class TileManager {
   /* Tile size in the image file. */
   static const int IMAGE_TILE_SIZE = 128;
 
+  /* Overlap between streamed tiles which are denoised individually. */
+  static const int STREAM_DENOISE_OVERLAP = 64;
+
   /* Maximum supported tile size.
    * Needs to be safe from allocation on a GPU point of view: the display driver needs to be able
    * to allocate texture with the side size of this value.
@@ -124,6 +156,12 @@ class TileManager {
   bool open_tile_output();
   bool close_tile_output();
 
+  /* File name of the streamed tile with the given index. */
+  string get_stream_tile_filename(int index) const;
+
+  bool write_stream_tile(const RenderBuffers &tile_buffers);
+  void finish_stream_tiles();
+
   string temp_dir_;
 
   /* Part of an on-disk tile file name which avoids conflicts between several Cycles instances or
@@ -173,6 +211,17 @@ class TileManager {
 
     int num_tiles_written = 0;
   } write_state_;
+
+  /* State of tiles streaming. */
+  struct {
+    bool use = false;
+    string id;
+
+    /* Part of the stored tile file names which is shared by all tiles of the current frame.
+     * Derived from the stream identifier and buffer parameters, so that it matches between
+     * sessions rendering the same frame. */
+    string file_part;
+  } stream_state_;
 };
 
 CCL_NAMESPACE_END
@@ -8,6 +8,8 @@
 #include "subd/dice.h"
 #include "subd/patch.h"
 
+#include "util/tbb.h"
+
 CCL_NAMESPACE_BEGIN
 
 /* EdgeDice Base */
@@ -17,6 +19,7 @@ EdgeDice::EdgeDice(const SubdParams &params_) : params(params_)
   mesh_P = NULL;
   mesh_N = NULL;
   vert_offset = 0;
+  tri_offset = 0;
 
   params.mesh->attributes.add(ATTR_STD_VERTEX_NORMAL);
 
@@ -33,14 +36,19 @@ void EdgeDice::reserve(int num_verts, int num_triangles)
   vert_offset = mesh->get_verts().size();
   tri_offset = mesh->num_triangles();
 
-  mesh->resize_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles());
-  mesh->reserve_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles() + num_triangles);
+  /* Allocate all vertices and triangles up front, dicing fills them in by index. */
+  mesh->resize_mesh(vert_offset + num_verts, tri_offset + num_triangles);
 
   Attribute *attr_vN = mesh->attributes.add(ATTR_STD_VERTEX_NORMAL);
 
   mesh_P = mesh->verts.data() + vert_offset;
   mesh_N = attr_vN->data_float3() + vert_offset;
 
+  mesh->tag_triangles_modified();
+  mesh->tag_shader_modified();
+  mesh->tag_smooth_modified();
+  mesh->tag_triangle_patch_modified();
+
   params.mesh->num_subd_verts += num_verts;
 }
 
@@ -57,17 +65,22 @@ void EdgeDice::set_vert(Patch *patch, int index, float2 uv)
   params.mesh->vert_patch_uv[index + vert_offset] = make_float2(uv.x, uv.y);
 }
 
-void EdgeDice::add_triangle(Patch *patch, int v0, int v1, int v2)
+void EdgeDice::set_triangle(Patch *patch, int index, int v0, int v1, int v2)
 {
   Mesh *mesh = params.mesh;
+  const size_t tri = tri_offset + index;
 
-  mesh->add_triangle(v0 + vert_offset, v1 + vert_offset, v2 + vert_offset, patch->shader, true);
-  params.mesh->triangle_patch[params.mesh->num_triangles() - 1] = patch->patch_index;
+  assert(tri < mesh->num_triangles());
 
-  tri_offset++;
+  mesh->triangles[tri * 3 + 0] = v0 + vert_offset;
+  mesh->triangles[tri * 3 + 1] = v1 + vert_offset;
+  mesh->triangles[tri * 3 + 2] = v2 + vert_offset;
+  mesh->shader[tri] = patch->shader;
+  mesh->smooth[tri] = true;
+  mesh->triangle_patch[tri] = patch->patch_index;
 }
 
-void EdgeDice::stitch_triangles(Subpatch &sub, int edge)
+void EdgeDice::stitch_triangles(Subpatch &sub, int edge, int tri_index)
 {
   int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
   int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
@@ -113,7 +126,7 @@ void EdgeDice::stitch_triangles(Subpatch &sub, int edge)
       }
     }
 
-    add_triangle(sub.patch, v1, v0, v2);
+    set_triangle(sub.patch, tri_index++, v1, v0, v2);
   }
 }
 
@@ -216,7 +229,7 @@ float QuadDice::scale_factor(Subpatch &sub, int Mu, int Mv)
   return S;
 }
 
-void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
+void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset, int tri_index)
 {
   /* create inner grid */
   float du = 1.0f / (float)Mu;
@@ -235,41 +248,64 @@ void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
         int i3 = offset + i + j * (Mu - 1);
         int i4 = offset + (i - 1) + j * (Mu - 1);
 
-        add_triangle(sub.patch, i1, i2, i3);
-        add_triangle(sub.patch, i1, i3, i4);
+        set_triangle(sub.patch, tri_index++, i1, i2, i3);
+        set_triangle(sub.patch, tri_index++, i1, i3, i4);
       }
     }
   }
 }
 
-void QuadDice::dice(Subpatch &sub)
+void QuadDice::dice(vector<Subpatch> &subpatches)
 {
-  /* compute inner grid size with scale factor */
-  int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
-  int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
+  /* Grain size to avoid threading overhead for small subpatches. */
+  static const int SUBPATCHES_PER_TASK = 16;
+
+  /* Inner grids only touch vertices and triangles owned by their own subpatch. */
+  parallel_for(blocked_range<size_t>(0, subpatches.size(), SUBPATCHES_PER_TASK),
+               [&](const blocked_range<size_t> &r) {
+                 for (size_t i = r.begin(); i != r.end(); i++) {
+                   Subpatch &sub = subpatches[i];
+
+                   /* compute inner grid size with scale factor */
+                   int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
+                   int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
 
 #if 0 /* Doesn't work very well, especially at grazing angles. */
-  float S = scale_factor(sub, ef, Mu, Mv);
+                   float S = scale_factor(sub, ef, Mu, Mv);
 #else
-  float S = 1.0f;
+                   float S = 1.0f;
 #endif
 
-  Mu = max((int)ceilf(S * Mu), 2);  // XXX handle 0 & 1?
-  Mv = max((int)ceilf(S * Mv), 2);  // XXX handle 0 & 1?
-
-  /* inner grid */
-  add_grid(sub, Mu, Mv, sub.inner_grid_vert_offset);
-
-  /* sides */
-  set_side(sub, 0);
-  set_side(sub, 1);
-  set_side(sub, 2);
-  set_side(sub, 3);
+                   Mu = max((int)ceilf(S * Mu), 2);  // XXX handle 0 & 1?
+                   Mv = max((int)ceilf(S * Mv), 2);  // XXX handle 0 & 1?
+
+                   /* inner grid */
+                   add_grid(sub, Mu, Mv, sub.inner_grid_vert_offset, sub.triangle_offset);
+                 }
+               });
+
+  /* Sides are shared between neighboring subpatches, evaluate them in a fixed order so the
+   * result does not depend on thread scheduling. */
+  for (Subpatch &sub : subpatches) {
+    set_side(sub, 0);
+    set_side(sub, 1);
+    set_side(sub, 2);
+    set_side(sub, 3);
+  }
 
-  stitch_triangles(sub, 0);
-  stitch_triangles(sub, 1);
-  stitch_triangles(sub, 2);
-  stitch_triangles(sub, 3);
+  /* Stitching only reads the shared side vertices. */
+  parallel_for(blocked_range<size_t>(0, subpatches.size(), SUBPATCHES_PER_TASK),
+               [&](const blocked_range<size_t> &r) {
+                 for (size_t i = r.begin(); i != r.end(); i++) {
+                   Subpatch &sub = subpatches[i];
+                   int tri_index = sub.triangle_offset + sub.calc_num_inner_triangles();
+
+                   for (int edge = 0; edge < 4; edge++) {
+                     stitch_triangles(sub, edge, tri_index);
+                     tri_index += sub.calc_num_stitch_triangles(edge);
+                   }
+                 }
+               });
 }
 
 CCL_NAMESPACE_END
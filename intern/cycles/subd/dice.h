@@ -45,7 +45,10 @@ struct SubdParams {
   }
 };
 
-/* EdgeDice Base */
+/* EdgeDice Base
+ *
+ * Vertices and triangles are written to pre-allocated slots of the mesh, so that
+ * subpatches with known offsets can be diced from multiple threads at once. */
 
 class EdgeDice {
  public:
@@ -60,9 +63,9 @@ class EdgeDice {
   void reserve(int num_verts, int num_triangles);
 
   void set_vert(Patch *patch, int index, float2 uv);
-  void add_triangle(Patch *patch, int v0, int v1, int v2);
+  void set_triangle(Patch *patch, int index, int v0, int v1, int v2);
 
-  void stitch_triangles(Subpatch &sub, int edge);
+  void stitch_triangles(Subpatch &sub, int edge, int tri_index);
 };
 
 /* Quad EdgeDice */
@@ -76,14 +79,15 @@ class QuadDice : public EdgeDice {
   float2 map_uv(Subpatch &sub, float u, float v);
   void set_vert(Subpatch &sub, int index, float u, float v);
 
-  void add_grid(Subpatch &sub, int Mu, int Mv, int offset);
+  void add_grid(Subpatch &sub, int Mu, int Mv, int offset, int tri_index);
 
   void set_side(Subpatch &sub, int edge);
 
   float quad_area(const float3 &a, const float3 &b, const float3 &c, const float3 &d);
   float scale_factor(Subpatch &sub, int Mu, int Mv);
 
-  void dice(Subpatch &sub);
+  /* Dice all subpatches, inner grids and stitching run in parallel. */
+  void dice(vector<Subpatch> &subpatches);
 };
 
 CCL_NAMESPACE_END
@@ -16,6 +16,7 @@ class Subpatch {
  public:
   class Patch *patch; /* Patch this is a subpatch of. */
   int inner_grid_vert_offset;
+  int triangle_offset; /* Index of the first triangle written when dicing this subpatch. */
 
   struct edge_t {
     int T;
@@ -77,6 +78,24 @@ class Subpatch {
     return (Mu - 1) * (Mv - 1);
   }
 
+  int calc_num_inner_triangles() const
+  {
+    int Mu = max(edge_u0.T, edge_u1.T);
+    int Mv = max(edge_v0.T, edge_v1.T);
+    Mu = max(Mu, 2);
+    Mv = max(Mv, 2);
+    return (Mu - 2) * (Mv - 2) * 2;
+  }
+
+  int calc_num_stitch_triangles(int edge) const
+  {
+    int Mu = max(edge_u0.T, edge_u1.T);
+    int Mv = max(edge_v0.T, edge_v1.T);
+    Mu = max(Mu, 2);
+    Mv = max(Mv, 2);
+    return edges[edge].T + (((edge % 2) == 0) ? Mv - 2 : Mu - 2);
+  }
+
   int calc_num_triangles() const
   {
     int Mu = max(edge_u0.T, edge_u1.T);
@@ -1135,6 +1135,12 @@ class CompositorPerformanceButtonsPanel:
         row.prop(rd, "compositor_device", text="Device", expand=True)
         col.prop(rd, "compositor_precision", text="Precision")
 
+        sub = col.column()
+        sub.active = rd.compositor_device == 'CPU'
+        sub.prop(rd, "compositor_memory_limit", text="Memory Limit")
+        sub.prop(rd, "compositor_cache_memory_limit", text="Cache Memory")
+        sub.prop(rd, "compositor_cache_disk_limit", text="Cache Disk")
+
 
 class RENDER_PT_eevee_performance_compositor(RenderButtonsPanel, CompositorPerformanceButtonsPanel, Panel):
     bl_options = {'DEFAULT_CLOSED'}
@@ -853,6 +853,12 @@ class NODE_PT_quality(bpy.types.Panel):
         col.prop(rd, "compositor_device", text="Device")
         col.prop(rd, "compositor_precision", text="Precision")
 
+        sub = col.column()
+        sub.active = rd.compositor_device == 'CPU'
+        sub.prop(rd, "compositor_memory_limit", text="Memory Limit")
+        sub.prop(rd, "compositor_cache_memory_limit", text="Cache Memory")
+        sub.prop(rd, "compositor_cache_disk_limit", text="Cache Disk")
+
         col = layout.column()
         col.prop(tree, "use_viewer_border")
 
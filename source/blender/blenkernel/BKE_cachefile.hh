@@ -8,6 +8,8 @@
  * \ingroup bke
  */
 
+#include <cstdint>
+
 struct CacheFile;
 struct CacheFileLayer;
 struct CacheReader;
@@ -15,6 +17,9 @@ struct Depsgraph;
 struct Main;
 struct Object;
 struct Scene;
+namespace blender::bke {
+class GeometrySet;
+}
 
 void BKE_cachefiles_init();
 void BKE_cachefiles_exit();
@@ -39,6 +44,40 @@ void BKE_cachefile_reader_open(CacheFile *cache_file,
                                const char *object_path);
 void BKE_cachefile_reader_free(CacheFile *cache_file, CacheReader **reader);
 
+/** Settings for reading the geometry of an object with #BKE_cachefile_read_geometry. */
+struct CacheFileReadParams {
+  /** Scene frame, mapped to the time in the file with #BKE_cachefile_time_offset. */
+  double frame;
+  double fps;
+  int read_flags;
+  float velocity_scale;
+};
+
+/**
+ * Read the geometry of the object at the given frame into the geometry set, replacing the data
+ * that is read.
+ *
+ * When reading ahead is enabled for the cache file, the following frames in the playback direction
+ * are read ahead on a background thread with a reader of its own, and the frame is taken from
+ * those when it was read for the same input geometry. \a owner identifies the modifier doing the
+ * read and must be passed to #BKE_cachefile_prefetch_free before it is freed.
+ */
+void BKE_cachefile_read_geometry(CacheFile *cache_file,
+                                 CacheReader *reader,
+                                 const void *owner,
+                                 Object *object,
+                                 const char *object_path,
+                                 blender::bke::GeometrySet &geometry_set,
+                                 const CacheFileReadParams &params,
+                                 const char **r_err_str);
+/** Stop reading ahead for the owner and free the frames read for it. */
+void BKE_cachefile_prefetch_free(CacheFile *cache_file, const void *owner);
+/**
+ * Number of reads by #BKE_cachefile_read_geometry that were served from frames read ahead, and
+ * of those that had to be read on the spot, for all cache files since startup.
+ */
+void BKE_cachefile_prefetch_stats_get(int64_t *r_hits, int64_t *r_misses);
+
 /**
  * Determine whether the #CacheFile should use a render engine procedural. If so, data is not read
  * from the file and bounding boxes are used to represent the objects in the Scene.
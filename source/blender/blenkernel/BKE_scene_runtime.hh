@@ -5,6 +5,7 @@
 #pragma once
 
 #include "BLI_map.hh"
+#include "BLI_set.hh"
 #include "BLI_timeit.hh"
 #include "BLI_utility_mixins.hh"
 
@@ -19,6 +20,10 @@ class CompositorRuntime {
    * evaluation. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> per_node_execution_time;
 
+  /* Node instances whose result was reused from a previous evaluation during the last tree
+   * evaluation. */
+  Set<bNodeInstanceKey> cached_nodes;
+
   /* A dependency graph used for interactive compositing. This is initialized the first time it is
    * needed, and then kept persistent for the lifetime of the scene. This is done to allow the
    * compositor to track changes to resources its uses as well as reduce the overhead of creating
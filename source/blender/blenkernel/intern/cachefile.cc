@@ -6,28 +6,42 @@
  * \ingroup bke
  */
 
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
 
 #include "DNA_cachefile_types.h"
+#include "DNA_mesh_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
 #include "BLI_fileops.h"
 #include "BLI_ghash.h"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
+#include "BLI_memory_counter.hh"
 #include "BLI_path_util.h"
+#include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_struct_equality_utils.hh"
+#include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.hh"
 
 #include "BKE_bpath.hh"
 #include "BKE_cachefile.hh"
+#include "BKE_geometry_set.hh"
 #include "BKE_idtype.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_main.hh"
+#include "BKE_mesh_types.hh"
 #include "BKE_scene.hh"
 
 #include "DEG_depsgraph_query.hh"
@@ -70,6 +84,7 @@ static void cache_file_copy_data(Main * /*bmain*/,
 
   cache_file_dst->handle = nullptr;
   cache_file_dst->handle_readers = nullptr;
+  cache_file_dst->prefetch = nullptr;
   BLI_duplicatelist(&cache_file_dst->object_paths, &cache_file_src->object_paths);
   BLI_duplicatelist(&cache_file_dst->layers, &cache_file_src->layers);
 }
@@ -98,6 +113,7 @@ static void cache_file_blend_write(BlendWriter *writer, ID *id, const void *id_a
   cache_file->handle = nullptr;
   memset(cache_file->handle_filepath, 0, sizeof(cache_file->handle_filepath));
   cache_file->handle_readers = nullptr;
+  cache_file->prefetch = nullptr;
 
   BLO_write_id_struct(writer, CacheFile, id_address, &cache_file->id);
   BKE_id_blend_write(writer, &cache_file->id);
@@ -115,6 +131,7 @@ static void cache_file_blend_read_data(BlendDataReader *reader, ID *id)
   cache_file->handle = nullptr;
   cache_file->handle_filepath[0] = '\0';
   cache_file->handle_readers = nullptr;
+  cache_file->prefetch = nullptr;
 
   /* relink layers */
   BLO_read_struct_list(reader, CacheFileLayer, &cache_file->layers);
@@ -252,10 +269,459 @@ void BKE_cachefile_reader_free(CacheFile *cache_file, CacheReader **reader)
 #endif
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Read-Ahead
+ *
+ * Playback of caches is often limited by reading and decoding the frames on the thread that
+ * evaluates the modifier. With reading ahead enabled, every modifier reading through
+ * #BKE_cachefile_read_geometry gets a stream with a reader of its own, which reads the next frames
+ * in the playback direction on a background thread. The modifier then only has to copy the frame
+ * once playback gets there.
+ * \{ */
+
+/** Number of frames that are read ahead of the current frame. */
+static constexpr int PREFETCH_FRAMES_NUM = 8;
+
+static std::atomic<int64_t> prefetch_hits = 0;
+static std::atomic<int64_t> prefetch_misses = 0;
+
+namespace blender::bke::cachefile_prefetch {
+
+struct ReadSettings {
+  int read_flags = 0;
+  float velocity_scale = 0.0f;
+  std::string velocity_name;
+  double fps = 0.0;
+
+  BLI_STRUCT_EQUALITY_OPERATORS_4(ReadSettings, read_flags, velocity_scale, velocity_name, fps)
+};
+
+struct Frame {
+  /** Time in the file, which changes with the frame offset of the cache file. */
+  double time;
+  GeometrySet geometry;
+  const char *err_str;
+  int64_t memory_bytes;
+};
+
+/** Frames read ahead for one modifier. */
+struct Stream {
+  /** Reader for the background thread, misses are read with the reader of the modifier. */
+  CacheReader *reader = nullptr;
+  Object *object = nullptr;
+  std::string object_path;
+
+  ReadSettings settings;
+  /**
+   * Copy of the geometry that the frames are read into, and the sharing info of its data to detect
+   * when the modifier reads into a different geometry. The copy shares the data, which keeps it
+   * from being freed and reused for other data while the stream exists.
+   */
+  GeometrySet input;
+  Vector<const ImplicitSharingInfo *> input_key;
+  /** Incremented when the frames are invalidated, so that reads in progress are discarded. */
+  int64_t generation = 0;
+
+  /** Frames by scene frame, and the scene frames that are being read. */
+  Map<double, Frame> frames;
+  Set<double> scheduled_frames;
+  std::optional<double> last_frame;
+  double frame_step = 1.0;
+};
+
+struct ReadTask {
+  const void *owner;
+  int64_t generation;
+  double frame;
+  double time;
+};
+
+}  // namespace blender::bke::cachefile_prefetch
+
+struct CacheFilePrefetch {
+  /** Serial background pool, so that the readers of the streams are used by one thread only. */
+  TaskPool *task_pool = nullptr;
+  /** Modifiers push tasks from multiple threads, which the task pool doesn't support. */
+  std::mutex task_pool_mutex;
+
+  /** Protects the streams and everything in them. */
+  std::mutex mutex;
+  blender::Map<const void *, std::unique_ptr<blender::bke::cachefile_prefetch::Stream>> streams;
+  int64_t memory_bytes = 0;
+  int64_t memory_limit = 0;
+  /** Type of the cache file, for the background thread. */
+  char type = CACHE_FILE_TYPE_INVALID;
+};
+
+namespace blender::bke::cachefile_prefetch {
+
+static void read_geometry(const char type,
+                          CacheReader *reader,
+                          Object *object,
+                          GeometrySet &geometry_set,
+                          const ReadSettings &settings,
+                          const double time,
+                          const char **r_err_str)
+{
+  switch (type) {
+    case CACHEFILE_TYPE_ALEMBIC: {
+#ifdef WITH_ALEMBIC
+      ABCReadParams params;
+      params.time = time;
+      params.read_flags = settings.read_flags;
+      params.velocity_name = settings.velocity_name.c_str();
+      params.velocity_scale = settings.velocity_scale;
+      ABC_read_geometry(reader, object, geometry_set, &params, r_err_str);
+#endif
+      break;
+    }
+    case CACHEFILE_TYPE_USD: {
+#ifdef WITH_USD
+      const io::usd::USDMeshReadParams params = io::usd::create_mesh_read_params(
+          time * settings.fps, settings.read_flags);
+      io::usd::USD_read_geometry(reader, object, geometry_set, params, r_err_str);
+#endif
+      break;
+    }
+    case CACHE_FILE_TYPE_INVALID:
+      break;
+  }
+#if !defined(WITH_ALEMBIC) && !defined(WITH_USD)
+  UNUSED_VARS(reader, object, geometry_set, settings, time, r_err_str);
+#endif
+}
+
+/**
+ * Identify the data of a geometry by the sharing info of its attributes. Returns nothing when
+ * some of the data is not shared, which would make the frames read ahead depend on a copy.
+ */
+static std::optional<Vector<const ImplicitSharingInfo *>> geometry_data_key(
+    const GeometrySet &geometry_set)
+{
+  Vector<const ImplicitSharingInfo *> key;
+  for (const GeometryComponent *component : geometry_set.get_components()) {
+    const std::optional<AttributeAccessor> attributes = component->attributes();
+    if (!attributes) {
+      continue;
+    }
+    bool all_shared = true;
+    attributes->for_all([&](const StringRefNull attribute_id, const AttributeMetaData & /*meta*/) {
+      const GAttributeReader attribute = attributes->lookup(attribute_id);
+      if (!attribute.sharing_info) {
+        all_shared = false;
+        return false;
+      }
+      key.append(attribute.sharing_info);
+      return true;
+    });
+    if (!all_shared) {
+      return std::nullopt;
+    }
+  }
+  if (const Mesh *mesh = geometry_set.get_mesh()) {
+    if (mesh->faces_num > 0) {
+      if (!mesh->runtime->face_offsets_sharing_info) {
+        return std::nullopt;
+      }
+      key.append(mesh->runtime->face_offsets_sharing_info);
+    }
+  }
+  return key;
+}
+
+/** Copy the geometry without sharing the components, which the modifier owns. */
+static GeometrySet copy_geometry(const GeometrySet &geometry_set)
+{
+  GeometrySet copy;
+  for (const GeometryComponent *component : geometry_set.get_components()) {
+    copy.add(*component->copy());
+  }
+  return copy;
+}
+
+static void clear_frames(CacheFilePrefetch &prefetch, Stream &stream)
+{
+  for (const Frame &frame : stream.frames.values()) {
+    prefetch.memory_bytes -= frame.memory_bytes;
+  }
+  stream.frames.clear();
+  stream.scheduled_frames.clear();
+  stream.generation++;
+}
+
+static Stream *find_stream(CacheFilePrefetch &prefetch, const ReadTask &task)
+{
+  const std::unique_ptr<Stream> *stream = prefetch.streams.lookup_ptr(task.owner);
+  if (stream == nullptr || (*stream)->generation != task.generation) {
+    return nullptr;
+  }
+  return stream->get();
+}
+
+static void read_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  CacheFilePrefetch &prefetch = *static_cast<CacheFilePrefetch *>(BLI_task_pool_user_data(pool));
+  const ReadTask &task = *static_cast<const ReadTask *>(taskdata);
+
+  CacheReader *reader;
+  Object *object;
+  ReadSettings settings;
+  GeometrySet geometry_set;
+  {
+    std::lock_guard lock{prefetch.mutex};
+    Stream *stream = find_stream(prefetch, task);
+    /* The frame is not scheduled anymore when playback moved elsewhere in the meantime. */
+    if (stream == nullptr || !stream->scheduled_frames.contains(task.frame)) {
+      return;
+    }
+    reader = stream->reader;
+    object = stream->object;
+    settings = stream->settings;
+    geometry_set = stream->input;
+  }
+
+  if (BLI_task_pool_current_canceled(pool)) {
+    return;
+  }
+
+  const char *err_str = nullptr;
+  read_geometry(prefetch.type, reader, object, geometry_set, settings, task.time, &err_str);
+
+  memory_counter::MemoryCount memory;
+  memory_counter::MemoryCounter memory_counter{memory};
+  geometry_set.count_memory(memory_counter);
+
+  std::lock_guard lock{prefetch.mutex};
+  Stream *stream = find_stream(prefetch, task);
+  if (stream == nullptr || !stream->scheduled_frames.remove(task.frame)) {
+    return;
+  }
+  /* Frames that don't fit are read again by the modifier when playback gets there. */
+  if (prefetch.memory_bytes + memory.total_bytes > prefetch.memory_limit) {
+    return;
+  }
+  Frame frame{task.time, std::move(geometry_set), err_str, memory.total_bytes};
+  if (stream->frames.add(task.frame, std::move(frame))) {
+    prefetch.memory_bytes += memory.total_bytes;
+  }
+}
+
+static void read_task_free(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  MEM_delete(static_cast<ReadTask *>(taskdata));
+}
+
+static void task_pool_create(CacheFilePrefetch &prefetch)
+{
+  prefetch.task_pool = BLI_task_pool_create_background_serial(&prefetch, TASK_PRIORITY_LOW);
+}
+
+/**
+ * Cancel the reads that did not start yet and wait for the one in progress. The pool is created
+ * again because a background pool doesn't start its thread anymore once it was canceled.
+ */
+static void cancel_reads(CacheFilePrefetch &prefetch)
+{
+  {
+    std::lock_guard lock{prefetch.task_pool_mutex};
+    BLI_task_pool_cancel(prefetch.task_pool);
+    BLI_task_pool_free(prefetch.task_pool);
+    task_pool_create(prefetch);
+  }
+  std::lock_guard lock{prefetch.mutex};
+  for (std::unique_ptr<Stream> &stream : prefetch.streams.values()) {
+    stream->scheduled_frames.clear();
+  }
+}
+
+}  // namespace blender::bke::cachefile_prefetch
+
+static void cachefile_prefetch_create(CacheFile *cache_file)
+{
+  BLI_assert(cache_file->prefetch == nullptr);
+  cache_file->prefetch = MEM_new<CacheFilePrefetch>(__func__);
+  cache_file->prefetch->type = cache_file->type;
+  blender::bke::cachefile_prefetch::task_pool_create(*cache_file->prefetch);
+}
+
+void BKE_cachefile_read_geometry(CacheFile *cache_file,
+                                 CacheReader *reader,
+                                 const void *owner,
+                                 Object *object,
+                                 const char *object_path,
+                                 blender::bke::GeometrySet &geometry_set,
+                                 const CacheFileReadParams &params,
+                                 const char **r_err_str)
+{
+  using namespace blender;
+  using namespace blender::bke::cachefile_prefetch;
+
+  ReadSettings settings;
+  settings.read_flags = params.read_flags;
+  settings.velocity_scale = params.velocity_scale;
+  settings.velocity_name = cache_file->velocity_name;
+  settings.fps = params.fps;
+  const double time = BKE_cachefile_time_offset(cache_file, params.frame, params.fps);
+
+  CacheFilePrefetch *prefetch = cache_file->prefetch;
+  std::optional<Vector<const ImplicitSharingInfo *>> input_key;
+  if (prefetch && cache_file->use_read_ahead) {
+    input_key = geometry_data_key(geometry_set);
+  }
+  if (!input_key) {
+    read_geometry(cache_file->type, reader, object, geometry_set, settings, time, r_err_str);
+    return;
+  }
+
+  /* Open a stream for the modifier, or open it again when the modifier reads another object. */
+  bool stream_is_valid;
+  {
+    std::lock_guard lock{prefetch->mutex};
+    const std::unique_ptr<Stream> *stream = prefetch->streams.lookup_ptr(owner);
+    stream_is_valid = stream && (*stream)->object == object &&
+                      (*stream)->object_path == object_path;
+  }
+  if (!stream_is_valid) {
+    BKE_cachefile_prefetch_free(cache_file, owner);
+    std::unique_ptr<Stream> stream = std::make_unique<Stream>();
+    stream->object = object;
+    stream->object_path = object_path;
+    BKE_cachefile_reader_open(cache_file, &stream->reader, object, object_path);
+    if (stream->reader == nullptr) {
+      read_geometry(cache_file->type, reader, object, geometry_set, settings, time, r_err_str);
+      return;
+    }
+    std::lock_guard lock{prefetch->mutex};
+    prefetch->streams.add_new(owner, std::move(stream));
+  }
+
+  bool is_hit = false;
+  Vector<ReadTask> tasks;
+  {
+    std::lock_guard lock{prefetch->mutex};
+    Stream &stream = *prefetch->streams.lookup(owner);
+    prefetch->memory_limit = int64_t(cache_file->read_ahead_cache_size) * 1024 * 1024;
+
+    /* Frames read into a different geometry or with different settings can't be used. Nothing
+     * is read ahead until the input is the same for two frames in a row, because it is usually
+     * different for every frame when it comes from other modifiers that are animated. */
+    const bool input_changed = stream.input_key != *input_key || stream.settings != settings;
+    if (input_changed) {
+      clear_frames(*prefetch, stream);
+      stream.settings = settings;
+      stream.input = copy_geometry(geometry_set);
+      stream.input_key = std::move(*input_key);
+    }
+
+    if (const Frame *frame = stream.frames.lookup_ptr(params.frame)) {
+      if (frame->time == time) {
+        geometry_set = frame->geometry;
+        if (r_err_str && frame->err_str) {
+          *r_err_str = frame->err_str;
+        }
+        is_hit = true;
+      }
+    }
+
+    /* Follow the playback direction, and forget the frames that it left behind. */
+    if (stream.last_frame && *stream.last_frame != params.frame) {
+      stream.frame_step = params.frame - *stream.last_frame;
+    }
+    stream.last_frame = params.frame;
+    const auto is_in_window = [&](const double frame) {
+      const double step = (frame - params.frame) / stream.frame_step;
+      return step >= 0.0 && step <= double(PREFETCH_FRAMES_NUM);
+    };
+    stream.frames.remove_if([&](const auto item) {
+      if (is_in_window(item.key)) {
+        return false;
+      }
+      prefetch->memory_bytes -= item.value.memory_bytes;
+      return true;
+    });
+    stream.scheduled_frames.remove_if([&](const double frame) { return !is_in_window(frame); });
+
+    if (!input_changed) {
+      for (const int i : IndexRange(1, PREFETCH_FRAMES_NUM)) {
+        const double frame = params.frame + stream.frame_step * i;
+        if (stream.frames.contains(frame) || stream.scheduled_frames.contains(frame)) {
+          continue;
+        }
+        if (prefetch->memory_bytes >= prefetch->memory_limit) {
+          break;
+        }
+        stream.scheduled_frames.add_new(frame);
+        tasks.append({owner,
+                      stream.generation,
+                      frame,
+                      BKE_cachefile_time_offset(cache_file, frame, params.fps)});
+      }
+    }
+  }
+
+  (is_hit ? prefetch_hits : prefetch_misses).fetch_add(1, std::memory_order_relaxed);
+
+  if (!tasks.is_empty()) {
+    std::lock_guard lock{prefetch->task_pool_mutex};
+    for (const ReadTask &task : tasks) {
+      BLI_task_pool_push(prefetch->task_pool,
+                         read_task_run,
+                         MEM_new<ReadTask>(__func__, task),
+                         true,
+                         read_task_free);
+    }
+  }
+
+  if (!is_hit) {
+    read_geometry(cache_file->type, reader, object, geometry_set, settings, time, r_err_str);
+  }
+}
+
+void BKE_cachefile_prefetch_free(CacheFile *cache_file, const void *owner)
+{
+  using namespace blender::bke::cachefile_prefetch;
+  CacheFilePrefetch *prefetch = cache_file ? cache_file->prefetch : nullptr;
+  if (prefetch == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard lock{prefetch->mutex};
+    if (!prefetch->streams.contains(owner)) {
+      return;
+    }
+  }
+
+  /* Wait for a read that may be using the reader of the stream. */
+  cancel_reads(*prefetch);
+
+  std::unique_ptr<Stream> stream;
+  {
+    std::lock_guard lock{prefetch->mutex};
+    stream = prefetch->streams.pop(owner);
+    clear_frames(*prefetch, *stream);
+  }
+  BKE_cachefile_reader_free(cache_file, &stream->reader);
+}
+
+void BKE_cachefile_prefetch_stats_get(int64_t *r_hits, int64_t *r_misses)
+{
+  *r_hits = prefetch_hits.load(std::memory_order_relaxed);
+  *r_misses = prefetch_misses.load(std::memory_order_relaxed);
+}
+
+/** \} */
+
 static void cachefile_handle_free(CacheFile *cache_file)
 {
 #if defined(WITH_ALEMBIC) || defined(WITH_USD)
 
+  /* Stop reading ahead, the readers of the streams are freed below with the others. */
+  if (cache_file->prefetch) {
+    BLI_task_pool_cancel(cache_file->prefetch->task_pool);
+    BLI_task_pool_free(cache_file->prefetch->task_pool);
+    cache_file->prefetch->task_pool = nullptr;
+  }
+
   /* Free readers in all modifiers and constraints that use the handle, before
    * we free the handle itself. */
   BLI_spin_lock(&spin);
@@ -288,6 +754,9 @@ static void cachefile_handle_free(CacheFile *cache_file)
   }
   BLI_spin_unlock(&spin);
 
+  MEM_delete(cache_file->prefetch);
+  cache_file->prefetch = nullptr;
+
   /* Free handle. */
   if (cache_file->handle) {
 
@@ -371,6 +840,11 @@ void BKE_cachefile_eval(Main *bmain, Depsgraph *depsgraph, CacheFile *cache_file
   }
 #endif
 
+  /* File sequences open another handle for every frame, which reading ahead can't follow. */
+  if (cache_file->handle && !cache_file->is_sequence) {
+    cachefile_prefetch_create(cache_file);
+  }
+
   if (DEG_is_active(depsgraph)) {
     /* Flush object paths back to original data-block for UI. */
     CacheFile *cache_file_orig = (CacheFile *)DEG_get_original_id(&cache_file->id);
@@ -19,6 +19,7 @@
 #  include <io.h>
 #endif
 
+#include <atomic>
 #include <regex>
 #include <string>
 
@@ -117,12 +118,20 @@ static void copy_image_packedfiles(ListBase *lb_dst, const ListBase *lb_src);
 /** \name Image #IDTypeInfo API
  * \{ */
 
+/** Give the buffers of the image a new identifier, never used by any image before. */
+static void image_runtime_update_id(Image *image)
+{
+  static std::atomic<uint64_t> last_update_id = 0;
+  image->runtime.update_id = ++last_update_id;
+}
+
 /** Reset runtime image fields when data-block is being initialized. */
 static void image_runtime_reset(Image *image)
 {
   memset(&image->runtime, 0, sizeof(image->runtime));
   image->runtime.cache_mutex = MEM_mallocN(sizeof(ThreadMutex), "image runtime cache_mutex");
   BLI_mutex_init(static_cast<ThreadMutex *>(image->runtime.cache_mutex));
+  image_runtime_update_id(image);
 }
 
 /** Reset runtime image fields when data-block is being copied. */
@@ -136,6 +145,8 @@ static void image_runtime_reset_on_copy(Image *image)
 
   image->runtime.backdrop_offset[0] = 0.0f;
   image->runtime.backdrop_offset[1] = 0.0f;
+
+  image_runtime_update_id(image);
 }
 
 static void image_runtime_free_data(Image *image)
@@ -637,6 +648,9 @@ void BKE_image_free_buffers_ex(Image *ima, bool do_lock)
 
   BKE_image_free_gputextures(ima);
 
+  /* Reloaded buffers may differ, for example after the file was changed on disk. */
+  image_runtime_update_id(ima);
+
   if (do_lock) {
     BLI_mutex_unlock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
   }
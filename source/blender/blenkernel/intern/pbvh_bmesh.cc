@@ -9,13 +9,16 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_bounds.hh"
+#include "BLI_function_ref.hh"
 #include "BLI_ghash.h"
 #include "BLI_heap_simple.h"
+#include "BLI_listbase.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
 #include "BLI_memarena.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 
@@ -694,6 +697,22 @@ struct EdgeQueue {
 #endif
 };
 
+/** An edge to add to the queue, see #EdgeQueueContext::candidates. */
+struct EdgeQueueCandidate {
+  BMEdge *edge;
+  float priority;
+};
+
+/**
+ * The vertices of an edge left for the nodes to be modified one after another,
+ * see #EdgeQueueContext::deferred.
+ */
+struct EdgeQueueDeferred {
+  BMVert *v1;
+  BMVert *v2;
+  float priority;
+};
+
 struct EdgeQueueContext {
   EdgeQueue *q;
   BLI_mempool *pool;
@@ -701,6 +720,18 @@ struct EdgeQueueContext {
   int cd_vert_mask_offset;
   int cd_vert_node_offset;
   int cd_face_node_offset;
+  /**
+   * When set, edges are gathered here instead of being added to the queue. Used to gather the
+   * edges of the nodes in parallel, see #edge_queue_add_nodes.
+   */
+  Vector<EdgeQueueCandidate> *candidates;
+  /**
+   * The node modified on a thread of its own, see #edge_queue_update_nodes_parallel. Only edges
+   * whose faces all belong to this node are queued, other edges are added to #deferred.
+   * #DYNTOPO_NODE_NONE when the nodes are modified one after another.
+   */
+  int node_index;
+  Vector<EdgeQueueDeferred> *deferred;
 };
 
 /* Only tagged edges are in the queue. */
@@ -775,12 +806,80 @@ static bool edge_queue_tri_in_circle(const EdgeQueue *q, BMFace *f)
   return len_squared_v3v3(q->center_proj, c) <= q->radius_squared;
 }
 
+/**
+ * Return true if the vertex and all of its faces belong to the node of \a eq_ctx. The faces,
+ * edges and vertices around such vertices are only accessed by the thread of that node.
+ */
+static bool vert_is_node_interior(const EdgeQueueContext *eq_ctx, BMVert *v)
+{
+  if (BM_ELEM_CD_GET_INT(v, eq_ctx->cd_vert_node_offset) != eq_ctx->node_index) {
+    return false;
+  }
+  BMFace *f;
+  BM_FACES_OF_VERT_ITER_BEGIN (f, v) {
+    if (BM_ELEM_CD_GET_INT(f, eq_ctx->cd_face_node_offset) != eq_ctx->node_index) {
+      return false;
+    }
+  }
+  BM_FACES_OF_VERT_ITER_END;
+  return true;
+}
+
+/** Splitting an edge also adds edges to the vertices opposite of it. */
+static bool edge_split_is_node_interior(const EdgeQueueContext *eq_ctx, BMEdge *e)
+{
+  if (!vert_is_node_interior(eq_ctx, e->v1) || !vert_is_node_interior(eq_ctx, e->v2)) {
+    return false;
+  }
+  if (BMLoop *l_first = e->l) {
+    BMLoop *l_iter = l_first;
+    do {
+      if (!vert_is_node_interior(eq_ctx, l_iter->prev->v)) {
+        return false;
+      }
+    } while ((l_iter = l_iter->radial_next) != l_first);
+  }
+  return true;
+}
+
+/** Collapsing an edge replaces the faces around both of its vertices. */
+static bool edge_collapse_is_node_interior(const EdgeQueueContext *eq_ctx, BMVert *v1, BMVert *v2)
+{
+  for (BMVert *v : {v1, v2}) {
+    if (!vert_is_node_interior(eq_ctx, v)) {
+      return false;
+    }
+    BMLoop *l;
+    BM_LOOPS_OF_VERT_ITER_BEGIN (l, v) {
+      if (!vert_is_node_interior(eq_ctx, l->next->v) ||
+          !vert_is_node_interior(eq_ctx, l->prev->v))
+      {
+        return false;
+      }
+    }
+    BM_LOOPS_OF_VERT_ITER_END;
+  }
+  return true;
+}
+
 /** Return true if the vertex mask is less than 1.0, false otherwise. */
 static bool check_mask(EdgeQueueContext *eq_ctx, BMVert *v)
 {
   return BM_ELEM_CD_GET_FLOAT(v, eq_ctx->cd_vert_mask_offset) < 1.0f;
 }
 
+static void edge_queue_push(EdgeQueueContext *eq_ctx, BMEdge *e, float priority)
+{
+  BMVert **pair = static_cast<BMVert **>(BLI_mempool_alloc(eq_ctx->pool));
+  pair[0] = e->v1;
+  pair[1] = e->v2;
+  BLI_heapsimple_insert(eq_ctx->q->heap, priority, pair);
+#ifdef USE_EDGEQUEUE_TAG
+  BLI_assert(EDGE_QUEUE_TEST(e) == false);
+  EDGE_QUEUE_ENABLE(e);
+#endif
+}
+
 static void edge_queue_insert(EdgeQueueContext *eq_ctx, BMEdge *e, float priority)
 {
   /* Don't let topology update affect fully masked vertices. This used to
@@ -794,14 +893,18 @@ static void edge_queue_insert(EdgeQueueContext *eq_ctx, BMEdge *e, float priorit
       !(BM_elem_flag_test_bool(e->v1, BM_ELEM_HIDDEN) ||
         BM_elem_flag_test_bool(e->v2, BM_ELEM_HIDDEN)))
   {
-    BMVert **pair = static_cast<BMVert **>(BLI_mempool_alloc(eq_ctx->pool));
-    pair[0] = e->v1;
-    pair[1] = e->v2;
-    BLI_heapsimple_insert(eq_ctx->q->heap, priority, pair);
-#ifdef USE_EDGEQUEUE_TAG
-    BLI_assert(EDGE_QUEUE_TEST(e) == false);
-    EDGE_QUEUE_ENABLE(e);
-#endif
+    if (eq_ctx->candidates) {
+      eq_ctx->candidates->append({e, priority});
+      return;
+    }
+    if (eq_ctx->deferred &&
+        !(vert_is_node_interior(eq_ctx, e->v1) && vert_is_node_interior(eq_ctx, e->v2)))
+    {
+      /* Other threads may access the edge, so it's not tagged either. */
+      eq_ctx->deferred->append({e->v1, e->v2, priority});
+      return;
+    }
+    edge_queue_push(eq_ctx, e, priority);
   }
 }
 
@@ -924,6 +1027,13 @@ static void long_edge_queue_edge_add_recursive(
     return;
   }
 
+  /* Faces of other nodes may be modified on other threads. */
+  if ((eq_ctx->node_index != DYNTOPO_NODE_NONE) &&
+      (BM_ELEM_CD_GET_INT(l_edge->f, eq_ctx->cd_face_node_offset) != eq_ctx->node_index))
+  {
+    return;
+  }
+
   if (l_edge->radial_next != l_edge) {
     /* How much longer we need to be to consider for subdividing
      * (avoids subdividing faces which are only *slightly* skinny). */
@@ -939,6 +1049,11 @@ static void long_edge_queue_edge_add_recursive(
 
     BMLoop *l_iter = l_edge;
     do {
+      if ((eq_ctx->node_index != DYNTOPO_NODE_NONE) &&
+          (BM_ELEM_CD_GET_INT(l_iter->f, eq_ctx->cd_face_node_offset) != eq_ctx->node_index))
+      {
+        continue;
+      }
       BMLoop *l_adjacent[2] = {l_iter->next, l_iter->prev};
       for (int i = 0; i < ARRAY_SIZE(l_adjacent); i++) {
         float len_sq_other = BM_edge_calc_length_squared(l_adjacent[i]->e);
@@ -1020,18 +1135,58 @@ static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
 }
 
 /**
- * Create a priority queue containing vertex pairs connected by a long
+ * Add the edges of the faces of all leaf nodes marked for topology update to the queue.
+ *
+ * The faces of the nodes are checked in parallel, since only the queue and the edge tags are
+ * modified when adding edges. The gathered edges are added to the queue in the order of the nodes
+ * afterwards, so the queue is the same as when checking the nodes one after another.
+ */
+static void edge_queue_add_nodes(EdgeQueueContext *eq_ctx,
+                                 MutableSpan<BMeshNode> nodes,
+                                 void (*face_add)(EdgeQueueContext *eq_ctx, BMFace *f))
+{
+  Array<Vector<EdgeQueueCandidate>> candidates(nodes.size());
+  threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      const BMeshNode &node = nodes[i];
+      /* Check leaf nodes marked for topology update. */
+      if ((node.flag_ & PBVH_Leaf) && (node.flag_ & PBVH_UpdateTopology) &&
+          !(node.flag_ & PBVH_FullyHidden))
+      {
+        EdgeQueueContext eq_ctx_node = *eq_ctx;
+        eq_ctx_node.candidates = &candidates[i];
+        for (BMFace *f : node.bm_faces_) {
+          face_add(&eq_ctx_node, f);
+        }
+      }
+    }
+  });
+
+  for (const Span<EdgeQueueCandidate> node_candidates : candidates) {
+    for (const EdgeQueueCandidate &candidate : node_candidates) {
+#ifdef USE_EDGEQUEUE_TAG
+      /* Edges can be shared by faces of the same node and of other nodes. */
+      if (EDGE_QUEUE_TEST(candidate.edge)) {
+        continue;
+      }
+#endif
+      edge_queue_push(eq_ctx, candidate.edge, candidate.priority);
+    }
+  }
+}
+
+/**
+ * Create a priority queue for vertex pairs connected by a long
  * edge as defined by Tree.bm_max_edge_len.
  *
  * Only nodes marked for topology update are checked, and in those
  * nodes only edges used by a face intersecting the (center, radius)
- * sphere are checked.
+ * sphere are checked, see #long_edge_queue_face_add.
  *
  * The highest priority (lowest number) is given to the longest edge.
  */
 static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
                                    const float max_edge_len,
-                                   MutableSpan<BMeshNode> nodes,
                                    const float center[3],
                                    const float view_normal[3],
                                    float radius,
@@ -1065,32 +1220,20 @@ static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
 #ifdef USE_EDGEQUEUE_TAG_VERIFY
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
-
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update. */
-    if ((node.flag_ & PBVH_Leaf) && (node.flag_ & PBVH_UpdateTopology) &&
-        !(node.flag_ & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        long_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
 }
 
 /**
- * Create a priority queue containing vertex pairs connected by a
+ * Create a priority queue for vertex pairs connected by a
  * short edge as defined by Tree.bm_min_edge_len.
  *
  * Only nodes marked for topology update are checked, and in those
  * nodes only edges used by a face intersecting the (center, radius)
- * sphere are checked.
+ * sphere are checked, see #short_edge_queue_face_add.
  *
  * The highest priority (lowest number) is given to the shortest edge.
  */
 static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
                                     const float min_edge_len,
-                                    MutableSpan<BMeshNode> nodes,
                                     const float center[3],
                                     const float view_normal[3],
                                     float radius,
@@ -1120,17 +1263,6 @@ static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
   else {
     eq_ctx->q->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
-
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update */
-    if ((node.flag_ & PBVH_Leaf) && (node.flag_ & PBVH_UpdateTopology) &&
-        !(node.flag_ & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        short_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
 }
 
 /*************************** Topology update **************************/
@@ -1289,11 +1421,10 @@ static bool pbvh_bmesh_subdivide_long_edges(EdgeQueueContext *eq_ctx,
                                             const int cd_face_node_offset,
                                             BMLog &bm_log)
 {
-  const double start_time = BLI_time_now_seconds();
-
   bool any_subdivided = false;
 
   while (!BLI_heapsimple_is_empty(eq_ctx->q->heap)) {
+    const float priority = BLI_heapsimple_top_value(eq_ctx->q->heap);
     BMVert **pair = static_cast<BMVert **>(BLI_heapsimple_pop_min(eq_ctx->q->heap));
     BMVert *v1 = pair[0];
     BMVert *v2 = pair[1];
@@ -1322,6 +1453,11 @@ static bool pbvh_bmesh_subdivide_long_edges(EdgeQueueContext *eq_ctx,
       continue;
     }
 
+    if (eq_ctx->deferred && !edge_split_is_node_interior(eq_ctx, e)) {
+      eq_ctx->deferred->append({v1, v2, priority});
+      continue;
+    }
+
     any_subdivided = true;
 
     pbvh_bmesh_split_edge(
@@ -1332,9 +1468,6 @@ static bool pbvh_bmesh_subdivide_long_edges(EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
 
-  CLOG_INFO(
-      &LOG, 2, "Long edge subdivision took %f seconds.", BLI_time_now_seconds() - start_time);
-
   return any_subdivided;
 }
 
@@ -1776,6 +1909,10 @@ static void pbvh_bmesh_collapse_edge(BMesh &bm,
   BM_vert_kill(&bm, v_del);
 }
 
+/**
+ * \param deleted_verts: Deleted verts point to vertices they were merged into,
+ * or nullptr when removed.
+ */
 static bool pbvh_bmesh_collapse_short_edges(EdgeQueueContext *eq_ctx,
                                             const float min_edge_len,
                                             BMesh &bm,
@@ -1783,16 +1920,14 @@ static bool pbvh_bmesh_collapse_short_edges(EdgeQueueContext *eq_ctx,
                                             MutableSpan<bool> node_changed,
                                             const int cd_vert_node_offset,
                                             const int cd_face_node_offset,
-                                            BMLog &bm_log)
+                                            BMLog &bm_log,
+                                            GHash *deleted_verts)
 {
-  const double start_time = BLI_time_now_seconds();
-
   const float min_len_squared = min_edge_len * min_edge_len;
   bool any_collapsed = false;
-  /* Deleted verts point to vertices they were merged into, or nullptr when removed. */
-  GHash *deleted_verts = BLI_ghash_ptr_new("deleted_verts");
 
   while (!BLI_heapsimple_is_empty(eq_ctx->q->heap)) {
+    const float priority = BLI_heapsimple_top_value(eq_ctx->q->heap);
     BMVert **pair = static_cast<BMVert **>(BLI_heapsimple_pop_min(eq_ctx->q->heap));
     BMVert *v1 = pair[0];
     BMVert *v2 = pair[1];
@@ -1828,6 +1963,11 @@ static bool pbvh_bmesh_collapse_short_edges(EdgeQueueContext *eq_ctx,
       continue;
     }
 
+    if (eq_ctx->deferred && !edge_collapse_is_node_interior(eq_ctx, v1, v2)) {
+      eq_ctx->deferred->append({v1, v2, priority});
+      continue;
+    }
+
     any_collapsed = true;
 
     pbvh_bmesh_collapse_edge(bm,
@@ -1843,11 +1983,105 @@ static bool pbvh_bmesh_collapse_short_edges(EdgeQueueContext *eq_ctx,
                              eq_ctx);
   }
 
-  BLI_ghash_free(deleted_verts, nullptr, nullptr);
+  return any_collapsed;
+}
+
+/**
+ * Split or collapse the edges of the nodes marked for topology update on a thread per node.
+ *
+ * Every node has a queue of its own, only containing edges whose vertices, and the faces around
+ * them, all belong to the node. Modifying such edges only changes elements that no other node
+ * uses. Edges that other nodes use too are added to the queue of \a eq_ctx afterwards, to be
+ * modified one after another along with the elements around them.
+ *
+ * \note Every node still handles its edges in order of their priority, but unlike modifying all
+ * nodes one after another the order isn't global. The result is equally valid though may differ.
+ */
+static bool edge_queue_update_nodes_parallel(
+    EdgeQueueContext *eq_ctx,
+    BMesh &bm,
+    MutableSpan<BMeshNode> nodes,
+    const Span<int> node_indices,
+    void (*face_add)(EdgeQueueContext *eq_ctx, BMFace *f),
+    const FunctionRef<bool(EdgeQueueContext *eq_ctx, GHash *deleted_verts)> update_fn,
+    GHash *deleted_verts)
+{
+  struct NodeQueue {
+    EdgeQueue q;
+    Vector<EdgeQueueDeferred> deferred;
+    GHash *deleted_verts = nullptr;
+    bool modified = false;
+  };
+  Array<NodeQueue> node_queues(node_indices.size());
 
-  CLOG_INFO(&LOG, 2, "Short edge collapse took %f seconds.", BLI_time_now_seconds() - start_time);
+  BM_mesh_threaded_alloc_begin(&bm);
+  threading::parallel_for(node_indices.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      NodeQueue &node_queue = node_queues[i];
+      node_queue.q = *eq_ctx->q;
+      node_queue.q.heap = BLI_heapsimple_new();
+      if (deleted_verts) {
+        node_queue.deleted_verts = BLI_ghash_ptr_new(__func__);
+      }
 
-  return any_collapsed;
+      EdgeQueueContext eq_ctx_node = *eq_ctx;
+      eq_ctx_node.q = &node_queue.q;
+      eq_ctx_node.pool = BLI_mempool_create(sizeof(BMVert *) * 2, 0, 128, BLI_MEMPOOL_NOP);
+      eq_ctx_node.node_index = node_indices[i];
+      eq_ctx_node.deferred = &node_queue.deferred;
+
+      for (BMFace *f : nodes[node_indices[i]].bm_faces_) {
+        face_add(&eq_ctx_node, f);
+      }
+      node_queue.modified = update_fn(&eq_ctx_node, node_queue.deleted_verts);
+
+      BLI_heapsimple_free(node_queue.q.heap, nullptr);
+      BLI_mempool_destroy(eq_ctx_node.pool);
+    }
+  });
+  BM_mesh_threaded_alloc_end(&bm);
+
+  bool modified = false;
+  for (NodeQueue &node_queue : node_queues) {
+    modified |= node_queue.modified;
+    if (node_queue.deleted_verts) {
+      GHashIterator gh_iter;
+      GHASH_ITER (gh_iter, node_queue.deleted_verts) {
+        BLI_ghash_insert(deleted_verts,
+                         BLI_ghashIterator_getKey(&gh_iter),
+                         BLI_ghashIterator_getValue(&gh_iter));
+      }
+      BLI_ghash_free(node_queue.deleted_verts, nullptr, nullptr);
+    }
+  }
+
+  /* Queue the remaining edges in the order of the nodes, like #edge_queue_add_nodes. */
+  for (const NodeQueue &node_queue : node_queues) {
+    for (const EdgeQueueDeferred &deferred : node_queue.deferred) {
+      BMVert *v1 = deferred.v1;
+      BMVert *v2 = deferred.v2;
+      if (deleted_verts) {
+        if (!(v1 = bm_vert_hash_lookup_chain(deleted_verts, v1)) ||
+            !(v2 = bm_vert_hash_lookup_chain(deleted_verts, v2)) || (v1 == v2))
+        {
+          continue;
+        }
+      }
+      BMEdge *e = BM_edge_exists(v1, v2);
+      if (e == nullptr) {
+        continue;
+      }
+#ifdef USE_EDGEQUEUE_TAG
+      /* Edges can be added by multiple faces and nodes. */
+      if (EDGE_QUEUE_TEST(e)) {
+        continue;
+      }
+#endif
+      edge_queue_push(eq_ctx, e, deferred.priority);
+    }
+  }
+
+  return modified;
 }
 
 /************************* Called from pbvh.cc *************************/
@@ -2319,7 +2553,23 @@ bool bmesh_update_topology(BMesh &bm,
   MutableSpan<BMeshNode> nodes = pbvh.nodes<BMeshNode>();
   Array<bool> node_changed(nodes.size(), false);
 
+  Vector<int> update_nodes;
+  for (const int i : nodes.index_range()) {
+    const BMeshNode &node = nodes[i];
+    if ((node.flag_ & PBVH_Leaf) && (node.flag_ & PBVH_UpdateTopology) &&
+        !(node.flag_ & PBVH_FullyHidden))
+    {
+      update_nodes.append(i);
+    }
+  }
+  /* The interior of separate nodes can be modified in parallel, see
+   * #edge_queue_update_nodes_parallel. Removing elements from the select history isn't
+   * thread-safe, it's normally empty in sculpt mode. */
+  const bool use_parallel = update_nodes.size() > 1 && BLI_listbase_is_empty(&bm.selected);
+
   if (mode & PBVH_Collapse) {
+    const double start_time = BLI_time_now_seconds();
+
     EdgeQueue q;
     BLI_mempool *queue_pool = BLI_mempool_create(sizeof(BMVert *) * 2, 0, 128, BLI_MEMPOOL_NOP);
     EdgeQueueContext eq_ctx = {
@@ -2329,10 +2579,37 @@ bool bmesh_update_topology(BMesh &bm,
         cd_vert_mask_offset,
         cd_vert_node_offset,
         cd_face_node_offset,
+        nullptr,
+        DYNTOPO_NODE_NONE,
+        nullptr,
     };
+    GHash *deleted_verts = BLI_ghash_ptr_new("deleted_verts");
 
     short_edge_queue_create(
-        &eq_ctx, min_edge_len, nodes, center, view_normal, radius, use_frontface, use_projected);
+        &eq_ctx, min_edge_len, center, view_normal, radius, use_frontface, use_projected);
+    if (use_parallel) {
+      modified |= edge_queue_update_nodes_parallel(
+          &eq_ctx,
+          bm,
+          nodes,
+          update_nodes,
+          short_edge_queue_face_add,
+          [&](EdgeQueueContext *eq_ctx_node, GHash *node_deleted_verts) {
+            return pbvh_bmesh_collapse_short_edges(eq_ctx_node,
+                                                   min_edge_len,
+                                                   bm,
+                                                   nodes,
+                                                   node_changed,
+                                                   cd_vert_node_offset,
+                                                   cd_face_node_offset,
+                                                   bm_log,
+                                                   node_deleted_verts);
+          },
+          deleted_verts);
+    }
+    else {
+      edge_queue_add_nodes(&eq_ctx, nodes, short_edge_queue_face_add);
+    }
     modified |= pbvh_bmesh_collapse_short_edges(&eq_ctx,
                                                 min_edge_len,
                                                 bm,
@@ -2340,12 +2617,19 @@ bool bmesh_update_topology(BMesh &bm,
                                                 node_changed,
                                                 cd_vert_node_offset,
                                                 cd_face_node_offset,
-                                                bm_log);
+                                                bm_log,
+                                                deleted_verts);
+    BLI_ghash_free(deleted_verts, nullptr, nullptr);
     BLI_heapsimple_free(q.heap, nullptr);
     BLI_mempool_destroy(queue_pool);
+
+    CLOG_INFO(
+        &LOG, 2, "Short edge collapse took %f seconds.", BLI_time_now_seconds() - start_time);
   }
 
   if (mode & PBVH_Subdivide) {
+    const double start_time = BLI_time_now_seconds();
+
     EdgeQueue q;
     BLI_mempool *queue_pool = BLI_mempool_create(sizeof(BMVert *) * 2, 0, 128, BLI_MEMPOOL_NOP);
     EdgeQueueContext eq_ctx = {
@@ -2355,14 +2639,41 @@ bool bmesh_update_topology(BMesh &bm,
         cd_vert_mask_offset,
         cd_vert_node_offset,
         cd_face_node_offset,
+        nullptr,
+        DYNTOPO_NODE_NONE,
+        nullptr,
     };
 
     long_edge_queue_create(
-        &eq_ctx, max_edge_len, nodes, center, view_normal, radius, use_frontface, use_projected);
+        &eq_ctx, max_edge_len, center, view_normal, radius, use_frontface, use_projected);
+    if (use_parallel) {
+      modified |= edge_queue_update_nodes_parallel(
+          &eq_ctx,
+          bm,
+          nodes,
+          update_nodes,
+          long_edge_queue_face_add,
+          [&](EdgeQueueContext *eq_ctx_node, GHash * /*node_deleted_verts*/) {
+            return pbvh_bmesh_subdivide_long_edges(eq_ctx_node,
+                                                   bm,
+                                                   nodes,
+                                                   node_changed,
+                                                   cd_vert_node_offset,
+                                                   cd_face_node_offset,
+                                                   bm_log);
+          },
+          nullptr);
+    }
+    else {
+      edge_queue_add_nodes(&eq_ctx, nodes, long_edge_queue_face_add);
+    }
     modified |= pbvh_bmesh_subdivide_long_edges(
         &eq_ctx, bm, nodes, node_changed, cd_vert_node_offset, cd_face_node_offset, bm_log);
     BLI_heapsimple_free(q.heap, nullptr);
     BLI_mempool_destroy(queue_pool);
+
+    CLOG_INFO(
+        &LOG, 2, "Long edge subdivision took %f seconds.", BLI_time_now_seconds() - start_time);
   }
 
   IndexMaskMemory memory;
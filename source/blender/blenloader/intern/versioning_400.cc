@@ -16,6 +16,7 @@
 
 #include "DNA_anim_types.h"
 #include "DNA_brush_types.h"
+#include "DNA_cachefile_types.h"
 #include "DNA_camera_types.h"
 #include "DNA_collection_types.h"
 #include "DNA_constraint_types.h"
@@ -4625,6 +4626,12 @@ void blo_do_versions_400(FileData *fd, Library * /*lib*/, Main *bmain)
     add_bevel_modifier_attribute_name_defaults(*bmain);
   }
 
+  if (!MAIN_VERSION_FILE_ATLEAST(bmain, 403, 24)) {
+    LISTBASE_FOREACH (CacheFile *, cache_file, &bmain->cachefiles) {
+      cache_file->read_ahead_cache_size = DNA_struct_default_get(CacheFile)->read_ahead_cache_size;
+    }
+  }
+
   /**
    * Always bump subversion in BKE_blender_version.h when adding versioning
    * code here, and wrap it inside a MAIN_VERSION_FILE_ATLEAST check.
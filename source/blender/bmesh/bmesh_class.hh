@@ -380,6 +380,12 @@ typedef struct BMesh {
    * Doesn't hold a #PyObject reference, cleared when the last object is de-referenced.
    */
   void *py_handle;
+
+  /**
+   * Set while elements are created and removed on multiple threads,
+   * see #BM_mesh_threaded_alloc_begin.
+   */
+  struct BMThreadedAlloc *threaded_alloc;
 } BMesh;
 
 /** #BMHeader.htype (char) */
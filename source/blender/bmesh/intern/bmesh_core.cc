@@ -40,12 +40,126 @@ using blender::Vector;
 
 #endif
 
+/* -------------------------------------------------------------------- */
+/** \name Element Memory
+ *
+ * While elements are created and removed on multiple threads (see #BM_mesh_threaded_alloc_begin),
+ * memory is taken from the reserve of every thread and element counts are gathered at the end.
+ * \{ */
+
+BLI_INLINE void *bm_pool_alloc(BMesh *bm, BLI_mempool *pool, const eBMThreadedPool pool_type)
+{
+  if (UNLIKELY(bm->threaded_alloc)) {
+    return bm_threaded_pool_alloc(bm, pool_type);
+  }
+  return BLI_mempool_alloc(pool);
+}
+
+BLI_INLINE void bm_pool_free(BMesh *bm,
+                             BLI_mempool *pool,
+                             const eBMThreadedPool pool_type,
+                             void *elem)
+{
+  if (UNLIKELY(bm->threaded_alloc)) {
+    bm_threaded_pool_free(bm, pool_type, elem);
+    return;
+  }
+  BLI_mempool_free(pool, elem);
+}
+
+BLI_INLINE BMFlagLayer *bm_toolflags_alloc(BMesh *bm,
+                                           BLI_mempool *pool,
+                                           const eBMThreadedPool pool_type)
+{
+  if (pool == nullptr) {
+    return nullptr;
+  }
+  if (UNLIKELY(bm->threaded_alloc)) {
+    void *oflags = bm_threaded_pool_alloc(bm, pool_type);
+    memset(oflags, 0, sizeof(BMFlagLayer) * size_t(bm->totflags));
+    return static_cast<BMFlagLayer *>(oflags);
+  }
+  return static_cast<BMFlagLayer *>(BLI_mempool_calloc(pool));
+}
+
+/**
+ * Custom-data functions take missing blocks from the pool directly,
+ * so while threaded the blocks of new elements are allocated up-front.
+ */
+BLI_INLINE void bm_elem_cd_threaded_alloc(BMesh *bm,
+                                          const CustomData *data,
+                                          const eBMThreadedPool pool_type,
+                                          void **block)
+{
+  if (UNLIKELY(bm->threaded_alloc) && data->totsize) {
+    *block = bm_threaded_pool_alloc(bm, pool_type);
+    memset(*block, 0, size_t(data->totsize));
+  }
+}
+
+BLI_INLINE void bm_elem_cd_free(BMesh *bm,
+                                CustomData *data,
+                                const eBMThreadedPool pool_type,
+                                void **block)
+{
+  if (UNLIKELY(bm->threaded_alloc)) {
+    CustomData_bmesh_free_block_data(data, *block);
+    if (data->totsize) {
+      bm_threaded_pool_free(bm, pool_type, *block);
+    }
+    *block = nullptr;
+    return;
+  }
+  CustomData_bmesh_free_block(data, block);
+}
+
+/** Count created or removed elements and tag the indices and tables as dirty. */
+BLI_INLINE void bm_elem_count_add(BMesh *bm, const char htype, const int delta)
+{
+  if (UNLIKELY(bm->threaded_alloc)) {
+    /* The mesh is tagged when threaded allocation begins. */
+    bm_threaded_elem_count_add(bm, htype, delta);
+    return;
+  }
+
+  switch (htype) {
+    case BM_VERT:
+      bm->totvert += delta;
+      break;
+    case BM_EDGE:
+      bm->totedge += delta;
+      break;
+    case BM_LOOP:
+      bm->totloop += delta;
+      break;
+    case BM_FACE:
+      bm->totface += delta;
+      break;
+  }
+
+  bm->elem_index_dirty |= htype;
+  if (htype != BM_LOOP) {
+    bm->elem_table_dirty |= htype;
+  }
+  bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
+}
+
+/** The select history is only read while threaded, elements stored in it can't be removed. */
+BLI_INLINE void bm_elem_select_history_remove(BMesh *bm, BMHeader *ele)
+{
+  const bool removed = _bm_select_history_remove(bm, ele);
+  BLI_assert(!(removed && bm->threaded_alloc));
+  UNUSED_VARS_NDEBUG(removed);
+}
+
+/** \} */
+
 BMVert *BM_vert_create(BMesh *bm,
                        const float co[3],
                        const BMVert *v_example,
                        const eBMCreateFlag create_flag)
 {
-  BMVert *v = static_cast<BMVert *>(BLI_mempool_alloc(bm->vpool));
+  BMVert *v = static_cast<BMVert *>(bm_pool_alloc(bm, bm->vpool, BM_THREADED_POOL_VERT));
 
   BLI_assert((v_example == nullptr) || (v_example->head.htype == BM_VERT));
   BLI_assert(!(create_flag & 1));
@@ -65,8 +179,8 @@ BMVert *BM_vert_create(BMesh *bm,
 
   /* allocate flags */
   if (bm->use_toolflags) {
-    ((BMVert_OFlag *)v)->oflags = static_cast<BMFlagLayer *>(
-        bm->vtoolflagpool ? BLI_mempool_calloc(bm->vtoolflagpool) : nullptr);
+    ((BMVert_OFlag *)v)->oflags = bm_toolflags_alloc(
+        bm, bm->vtoolflagpool, BM_THREADED_POOL_VERT_TOOLFLAG);
   }
 
   /* 'v->no' is handled by BM_elem_attrs_copy */
@@ -85,13 +199,10 @@ BMVert *BM_vert_create(BMesh *bm,
   BLI_assert((create_flag & BM_CREATE_NO_DOUBLE) == 0);
 
   /* may add to middle of the pool */
-  bm->elem_index_dirty |= BM_VERT;
-  bm->elem_table_dirty |= BM_VERT;
-  bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
-
-  bm->totvert++;
+  bm_elem_count_add(bm, BM_VERT, 1);
 
   if (!(create_flag & BM_CREATE_SKIP_CD)) {
+    bm_elem_cd_threaded_alloc(bm, &bm->vdata, BM_THREADED_POOL_VERT_DATA, &v->head.data);
     if (v_example) {
       int *keyi;
 
@@ -137,7 +248,7 @@ BMEdge *BM_edge_create(
     return e;
   }
 
-  e = static_cast<BMEdge *>(BLI_mempool_alloc(bm->epool));
+  e = static_cast<BMEdge *>(bm_pool_alloc(bm, bm->epool, BM_THREADED_POOL_EDGE));
 
   /* --- assign all members --- */
   e->head.data = nullptr;
@@ -154,8 +265,8 @@ BMEdge *BM_edge_create(
 
   /* allocate flags */
   if (bm->use_toolflags) {
-    ((BMEdge_OFlag *)e)->oflags = static_cast<BMFlagLayer *>(
-        bm->etoolflagpool ? BLI_mempool_calloc(bm->etoolflagpool) : nullptr);
+    ((BMEdge_OFlag *)e)->oflags = bm_toolflags_alloc(
+        bm, bm->etoolflagpool, BM_THREADED_POOL_EDGE_TOOLFLAG);
   }
 
   e->v1 = v1;
@@ -169,13 +280,10 @@ BMEdge *BM_edge_create(
   bmesh_disk_edge_append(e, e->v2);
 
   /* may add to middle of the pool */
-  bm->elem_index_dirty |= BM_EDGE;
-  bm->elem_table_dirty |= BM_EDGE;
-  bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
-
-  bm->totedge++;
+  bm_elem_count_add(bm, BM_EDGE, 1);
 
   if (!(create_flag & BM_CREATE_SKIP_CD)) {
+    bm_elem_cd_threaded_alloc(bm, &bm->edata, BM_THREADED_POOL_EDGE_DATA, &e->head.data);
     if (e_example) {
       BM_elem_attrs_copy(bm, e_example, e);
     }
@@ -203,7 +311,7 @@ static BMLoop *bm_loop_create(BMesh *bm,
 {
   BMLoop *l = nullptr;
 
-  l = static_cast<BMLoop *>(BLI_mempool_alloc(bm->lpool));
+  l = static_cast<BMLoop *>(bm_pool_alloc(bm, bm->lpool, BM_THREADED_POOL_LOOP));
 
   BLI_assert((l_example == nullptr) || (l_example->head.htype == BM_LOOP));
   BLI_assert(!(create_flag & 1));
@@ -240,12 +348,10 @@ static BMLoop *bm_loop_create(BMesh *bm,
   /* --- done --- */
 
   /* may add to middle of the pool */
-  bm->elem_index_dirty |= BM_LOOP;
-  bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
-
-  bm->totloop++;
+  bm_elem_count_add(bm, BM_LOOP, 1);
 
   if (!(create_flag & BM_CREATE_SKIP_CD)) {
+    bm_elem_cd_threaded_alloc(bm, &bm->ldata, BM_THREADED_POOL_LOOP_DATA, &l->head.data);
     if (l_example) {
       /* no need to copy attrs, just handle customdata */
       CustomData_bmesh_copy_block(bm->ldata, l_example->head.data, &l->head.data);
@@ -379,7 +485,7 @@ BLI_INLINE BMFace *bm_face_create__internal(BMesh *bm)
 {
   BMFace *f;
 
-  f = static_cast<BMFace *>(BLI_mempool_alloc(bm->fpool));
+  f = static_cast<BMFace *>(bm_pool_alloc(bm, bm->fpool, BM_THREADED_POOL_FACE));
 
   /* --- assign all members --- */
   f->head.data = nullptr;
@@ -395,8 +501,8 @@ BLI_INLINE BMFace *bm_face_create__internal(BMesh *bm)
 
   /* allocate flags */
   if (bm->use_toolflags) {
-    ((BMFace_OFlag *)f)->oflags = static_cast<BMFlagLayer *>(
-        bm->ftoolflagpool ? BLI_mempool_calloc(bm->ftoolflagpool) : nullptr);
+    ((BMFace_OFlag *)f)->oflags = bm_toolflags_alloc(
+        bm, bm->ftoolflagpool, BM_THREADED_POOL_FACE_TOOLFLAG);
   }
 
 #ifdef USE_BMESH_HOLES
@@ -411,11 +517,7 @@ BLI_INLINE BMFace *bm_face_create__internal(BMesh *bm)
   /* --- done --- */
 
   /* may add to middle of the pool */
-  bm->elem_index_dirty |= BM_FACE;
-  bm->elem_table_dirty |= BM_FACE;
-  bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
-
-  bm->totface++;
+  bm_elem_count_add(bm, BM_FACE, 1);
 
 #ifdef USE_BMESH_HOLES
   f->totbounds = 0;
@@ -471,6 +573,7 @@ BMFace *BM_face_create(BMesh *bm,
   f->len = len;
 
   if (!(create_flag & BM_CREATE_SKIP_CD)) {
+    bm_elem_cd_threaded_alloc(bm, &bm->pdata, BM_THREADED_POOL_FACE_DATA, &f->head.data);
     if (f_example) {
       BM_elem_attrs_copy(bm, f_example, f);
     }
@@ -745,21 +848,19 @@ int bmesh_elem_check(void *element, const char htype)
  */
 static void bm_kill_only_vert(BMesh *bm, BMVert *v)
 {
-  bm->totvert--;
-  bm->elem_index_dirty |= BM_VERT;
-  bm->elem_table_dirty |= BM_VERT;
-  bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
+  bm_elem_count_add(bm, BM_VERT, -1);
 
-  BM_select_history_remove(bm, v);
+  bm_elem_select_history_remove(bm, &v->head);
 
   if (v->head.data) {
-    CustomData_bmesh_free_block(&bm->vdata, &v->head.data);
+    bm_elem_cd_free(bm, &bm->vdata, BM_THREADED_POOL_VERT_DATA, &v->head.data);
   }
 
   if (bm->vtoolflagpool) {
-    BLI_mempool_free(bm->vtoolflagpool, ((BMVert_OFlag *)v)->oflags);
+    bm_pool_free(
+        bm, bm->vtoolflagpool, BM_THREADED_POOL_VERT_TOOLFLAG, ((BMVert_OFlag *)v)->oflags);
   }
-  BLI_mempool_free(bm->vpool, v);
+  bm_pool_free(bm, bm->vpool, BM_THREADED_POOL_VERT, v);
 }
 
 /**
@@ -768,21 +869,19 @@ static void bm_kill_only_vert(BMesh *bm, BMVert *v)
  */
 static void bm_kill_only_edge(BMesh *bm, BMEdge *e)
 {
-  bm->totedge--;
-  bm->elem_index_dirty |= BM_EDGE;
-  bm->elem_table_dirty |= BM_EDGE;
-  bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
+  bm_elem_count_add(bm, BM_EDGE, -1);
 
-  BM_select_history_remove(bm, (BMElem *)e);
+  bm_elem_select_history_remove(bm, &e->head);
 
   if (e->head.data) {
-    CustomData_bmesh_free_block(&bm->edata, &e->head.data);
+    bm_elem_cd_free(bm, &bm->edata, BM_THREADED_POOL_EDGE_DATA, &e->head.data);
   }
 
   if (bm->etoolflagpool) {
-    BLI_mempool_free(bm->etoolflagpool, ((BMEdge_OFlag *)e)->oflags);
+    bm_pool_free(
+        bm, bm->etoolflagpool, BM_THREADED_POOL_EDGE_TOOLFLAG, ((BMEdge_OFlag *)e)->oflags);
   }
-  BLI_mempool_free(bm->epool, e);
+  bm_pool_free(bm, bm->epool, BM_THREADED_POOL_EDGE, e);
 }
 
 /**
@@ -795,21 +894,19 @@ static void bm_kill_only_face(BMesh *bm, BMFace *f)
     bm->act_face = nullptr;
   }
 
-  bm->totface--;
-  bm->elem_index_dirty |= BM_FACE;
-  bm->elem_table_dirty |= BM_FACE;
-  bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
+  bm_elem_count_add(bm, BM_FACE, -1);
 
-  BM_select_history_remove(bm, (BMElem *)f);
+  bm_elem_select_history_remove(bm, &f->head);
 
   if (f->head.data) {
-    CustomData_bmesh_free_block(&bm->pdata, &f->head.data);
+    bm_elem_cd_free(bm, &bm->pdata, BM_THREADED_POOL_FACE_DATA, &f->head.data);
   }
 
   if (bm->ftoolflagpool) {
-    BLI_mempool_free(bm->ftoolflagpool, ((BMFace_OFlag *)f)->oflags);
+    bm_pool_free(
+        bm, bm->ftoolflagpool, BM_THREADED_POOL_FACE_TOOLFLAG, ((BMFace_OFlag *)f)->oflags);
   }
-  BLI_mempool_free(bm->fpool, f);
+  bm_pool_free(bm, bm->fpool, BM_THREADED_POOL_FACE, f);
 }
 
 /**
@@ -818,15 +915,13 @@ static void bm_kill_only_face(BMesh *bm, BMFace *f)
  */
 static void bm_kill_only_loop(BMesh *bm, BMLoop *l)
 {
-  bm->totloop--;
-  bm->elem_index_dirty |= BM_LOOP;
-  bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
+  bm_elem_count_add(bm, BM_LOOP, -1);
 
   if (l->head.data) {
-    CustomData_bmesh_free_block(&bm->ldata, &l->head.data);
+    bm_elem_cd_free(bm, &bm->ldata, BM_THREADED_POOL_LOOP_DATA, &l->head.data);
   }
 
-  BLI_mempool_free(bm->lpool, l);
+  bm_pool_free(bm, bm->lpool, BM_THREADED_POOL_LOOP, l);
 }
 
 void BM_face_edges_kill(BMesh *bm, BMFace *f)
@@ -2005,21 +2100,20 @@ BMFace *bmesh_kernel_join_face_kill_edge(BMesh *bm, BMFace *f1, BMFace *f2, BMEd
 
   /* deallocate edge and its two loops as well as f2 */
   if (bm->etoolflagpool) {
-    BLI_mempool_free(bm->etoolflagpool, ((BMEdge_OFlag *)l_f1->e)->oflags);
-  }
-  BLI_mempool_free(bm->epool, l_f1->e);
-  bm->totedge--;
-  BLI_mempool_free(bm->lpool, l_f1);
-  bm->totloop--;
-  BLI_mempool_free(bm->lpool, l_f2);
-  bm->totloop--;
+    bm_pool_free(
+        bm, bm->etoolflagpool, BM_THREADED_POOL_EDGE_TOOLFLAG, ((BMEdge_OFlag *)l_f1->e)->oflags);
+  }
+  bm_pool_free(bm, bm->epool, BM_THREADED_POOL_EDGE, l_f1->e);
+  bm_elem_count_add(bm, BM_EDGE, -1);
+  bm_pool_free(bm, bm->lpool, BM_THREADED_POOL_LOOP, l_f1);
+  bm_pool_free(bm, bm->lpool, BM_THREADED_POOL_LOOP, l_f2);
+  bm_elem_count_add(bm, BM_LOOP, -2);
   if (bm->ftoolflagpool) {
-    BLI_mempool_free(bm->ftoolflagpool, ((BMFace_OFlag *)f2)->oflags);
+    bm_pool_free(
+        bm, bm->ftoolflagpool, BM_THREADED_POOL_FACE_TOOLFLAG, ((BMFace_OFlag *)f2)->oflags);
   }
-  BLI_mempool_free(bm->fpool, f2);
-  bm->totface--;
-  /* account for both above */
-  bm->elem_index_dirty |= BM_EDGE | BM_LOOP | BM_FACE;
+  bm_pool_free(bm, bm->fpool, BM_THREADED_POOL_FACE, f2);
+  bm_elem_count_add(bm, BM_FACE, -1);
 
   BM_CHECK_ELEMENT(f1);
 
@@ -17,6 +17,8 @@
  * - Setting vertex hflags
  */
 
+#include <mutex>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_ghash.h"
@@ -65,7 +67,7 @@ struct BMLogEntry {
 
 struct BMLog {
   /** Tree of free IDs */
-  RangeTreeUInt *unused_ids;
+  RangeTreeUInt *unused_ids = nullptr;
 
   /**
    * Mapping from unique IDs to vertices and faces
@@ -77,11 +79,11 @@ struct BMLog {
    * The ID is needed because element pointers will change as they
    * are created and deleted.
    */
-  GHash *id_to_elem;
-  GHash *elem_to_id;
+  GHash *id_to_elem = nullptr;
+  GHash *elem_to_id = nullptr;
 
   /** All #BMLogEntrys, ordered from earliest to most recent. */
-  ListBase entries;
+  ListBase entries = {nullptr, nullptr};
 
   /**
    * The current log entry from entries list
@@ -92,7 +94,10 @@ struct BMLog {
    * If equal to the last entry in the entries list, then all log
    * entries have been applied (i.e. there is nothing left to redo.)
    */
-  BMLogEntry *current_entry;
+  BMLogEntry *current_entry = nullptr;
+
+  /** Locked when logging added, removed and modified vertices and faces from multiple threads. */
+  std::mutex mutex;
 };
 
 struct BMLogVert {
@@ -466,7 +471,7 @@ static void bm_log_id_ghash_release(BMLog *log, GHash *id_ghash)
 
 BMLog *BM_log_create(BMesh *bm)
 {
-  BMLog *log = static_cast<BMLog *>(MEM_callocN(sizeof(*log), __func__));
+  BMLog *log = MEM_new<BMLog>(__func__);
   const uint reserve_num = uint(bm->totvert + bm->totface);
 
   log->unused_ids = range_tree_uint_alloc(0, uint(-1));
@@ -562,7 +567,7 @@ void BM_log_free(BMLog *log)
     entry->log = nullptr;
   }
 
-  MEM_freeN(log);
+  MEM_delete(log);
 }
 
 int BM_log_length(const BMLog *log)
@@ -771,6 +776,7 @@ void BM_log_redo(BMesh *bm, BMLog *log)
 
 void BM_log_vert_before_modified(BMLog *log, BMVert *v, const int cd_vert_mask_offset)
 {
+  std::lock_guard lock{log->mutex};
   BMLogEntry *entry = log->current_entry;
   BMLogVert *lv;
   uint v_id = bm_log_vert_id_get(log, v);
@@ -789,6 +795,7 @@ void BM_log_vert_before_modified(BMLog *log, BMVert *v, const int cd_vert_mask_o
 
 void BM_log_vert_added(BMLog *log, BMVert *v, const int cd_vert_mask_offset)
 {
+  std::lock_guard lock{log->mutex};
   BMLogVert *lv;
   uint v_id = range_tree_uint_take_any(log->unused_ids);
   void *key = POINTER_FROM_UINT(v_id);
@@ -810,6 +817,7 @@ void BM_log_face_modified(BMLog *log, BMFace *f)
 
 void BM_log_face_added(BMLog *log, BMFace *f)
 {
+  std::lock_guard lock{log->mutex};
   BMLogFace *lf;
   uint f_id = range_tree_uint_take_any(log->unused_ids);
   void *key = POINTER_FROM_UINT(f_id);
@@ -824,6 +832,7 @@ void BM_log_face_added(BMLog *log, BMFace *f)
 
 void BM_log_vert_removed(BMLog *log, BMVert *v, const int cd_vert_mask_offset)
 {
+  std::lock_guard lock{log->mutex};
   BMLogEntry *entry = log->current_entry;
   uint v_id = bm_log_vert_id_get(log, v);
   void *key = POINTER_FROM_UINT(v_id);
@@ -852,6 +861,7 @@ void BM_log_vert_removed(BMLog *log, BMVert *v, const int cd_vert_mask_offset)
 
 void BM_log_face_removed(BMLog *log, BMFace *f)
 {
+  std::lock_guard lock{log->mutex};
   BMLogEntry *entry = log->current_entry;
   uint f_id = bm_log_face_id_get(log, f);
   void *key = POINTER_FROM_UINT(f_id);
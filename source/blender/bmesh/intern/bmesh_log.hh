@@ -88,6 +88,8 @@ void BM_log_redo(BMesh *bm, BMLog *log);
 /**
  * Log a vertex before it is modified.
  *
+ * \note This and the functions logging added and removed vertices and faces are thread-safe.
+ *
  * Before modifying vertex coordinates, masks, or hflags, call this
  * function to log its current values. This is better than logging
  * after the coordinates have been modified, because only those
@@ -8,10 +8,14 @@
  * BM mesh level functions.
  */
 
+#include <array>
+#include <mutex>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_listBase.h"
 
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
@@ -21,10 +25,12 @@
 #include "BKE_mesh.hh"
 
 #include "bmesh.hh"
+#include "intern/bmesh_private.hh"
 
 using blender::Array;
 using blender::float3;
 using blender::MutableSpan;
+using blender::Vector;
 
 const BMAllocTemplate bm_mesh_allocsize_default = {512, 1024, 2048, 512};
 const BMAllocTemplate bm_mesh_chunksize_default = {512, 1024, 2048, 512};
@@ -159,6 +165,8 @@ void BM_mesh_data_free(BMesh *bm)
   BMIter iter;
   BMIter itersub;
 
+  BLI_assert(bm->threaded_alloc == nullptr);
+
   const bool is_ldata_free = CustomData_bmesh_has_free(&bm->ldata);
   const bool is_pdata_free = CustomData_bmesh_has_free(&bm->pdata);
 
@@ -275,6 +283,126 @@ void BM_mesh_free(BMesh *bm)
   MEM_freeN(bm);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Threaded Allocation
+ * \{ */
+
+/** Number of elements taken from a pool at once when the reserve of a thread runs out. */
+#define BM_THREADED_POOL_BATCH_SIZE 256
+
+struct BMThreadedPools {
+  std::array<Vector<void *>, BM_THREADED_POOL_NUM> reserve;
+  std::array<Vector<void *>, BM_THREADED_POOL_NUM> removed;
+  int totvert = 0;
+  int totedge = 0;
+  int totloop = 0;
+  int totface = 0;
+};
+
+struct BMThreadedAlloc {
+  std::array<BLI_mempool *, BM_THREADED_POOL_NUM> pools;
+  /** Locked while refilling a reserve from #pools. */
+  std::mutex mutex;
+  blender::threading::EnumerableThreadSpecific<BMThreadedPools> thread_pools;
+};
+
+void BM_mesh_threaded_alloc_begin(BMesh *bm)
+{
+  BLI_assert(bm->threaded_alloc == nullptr);
+
+  BMThreadedAlloc *alloc = MEM_new<BMThreadedAlloc>(__func__);
+  alloc->pools = {bm->vpool,
+                  bm->epool,
+                  bm->lpool,
+                  bm->fpool,
+                  bm->vdata.pool,
+                  bm->edata.pool,
+                  bm->ldata.pool,
+                  bm->pdata.pool,
+                  bm->vtoolflagpool,
+                  bm->etoolflagpool,
+                  bm->ftoolflagpool};
+
+  /* May add to the middle of the pools, this isn't done for every element meanwhile. */
+  bm->elem_index_dirty |= BM_ALL;
+  bm->elem_table_dirty |= BM_ALL_NOLOOP;
+  bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
+
+  bm->threaded_alloc = alloc;
+}
+
+void BM_mesh_threaded_alloc_end(BMesh *bm)
+{
+  BMThreadedAlloc *alloc = bm->threaded_alloc;
+  BLI_assert(alloc != nullptr);
+  bm->threaded_alloc = nullptr;
+
+  for (BMThreadedPools &thread_pools : alloc->thread_pools) {
+    for (const int i : blender::IndexRange(BM_THREADED_POOL_NUM)) {
+      for (void *elem : thread_pools.reserve[i]) {
+        BLI_mempool_free(alloc->pools[i], elem);
+      }
+      for (void *elem : thread_pools.removed[i]) {
+        BLI_mempool_free(alloc->pools[i], elem);
+      }
+    }
+    bm->totvert += thread_pools.totvert;
+    bm->totedge += thread_pools.totedge;
+    bm->totloop += thread_pools.totloop;
+    bm->totface += thread_pools.totface;
+  }
+
+  MEM_delete(alloc);
+}
+
+void *bm_threaded_pool_alloc(BMesh *bm, const eBMThreadedPool pool)
+{
+  BMThreadedAlloc &alloc = *bm->threaded_alloc;
+  BMThreadedPools &thread_pools = alloc.thread_pools.local();
+
+  /* Reuse elements removed by the same thread first. */
+  if (!thread_pools.removed[pool].is_empty()) {
+    return thread_pools.removed[pool].pop_last();
+  }
+
+  Vector<void *> &reserve = thread_pools.reserve[pool];
+  if (reserve.is_empty()) {
+    BLI_assert(alloc.pools[pool] != nullptr);
+    reserve.reserve(BM_THREADED_POOL_BATCH_SIZE);
+    std::lock_guard lock{alloc.mutex};
+    for (int i = 0; i < BM_THREADED_POOL_BATCH_SIZE; i++) {
+      reserve.append_unchecked(BLI_mempool_alloc(alloc.pools[pool]));
+    }
+  }
+  return reserve.pop_last();
+}
+
+void bm_threaded_pool_free(BMesh *bm, const eBMThreadedPool pool, void *elem)
+{
+  bm->threaded_alloc->thread_pools.local().removed[pool].append(elem);
+}
+
+void bm_threaded_elem_count_add(BMesh *bm, const char htype, const int delta)
+{
+  BMThreadedPools &thread_pools = bm->threaded_alloc->thread_pools.local();
+  switch (htype) {
+    case BM_VERT:
+      thread_pools.totvert += delta;
+      break;
+    case BM_EDGE:
+      thread_pools.totedge += delta;
+      break;
+    case BM_LOOP:
+      thread_pools.totloop += delta;
+      break;
+    case BM_FACE:
+      thread_pools.totface += delta;
+      break;
+  }
+}
+
+/** \} */
+
 void bmesh_edit_begin(BMesh * /*bm*/, BMOpTypeFlag /*type_flag*/)
 {
   /* Most operators seem to be using BMO_OPTYPE_FLAG_UNTAN_MULTIRES to change the MDisps to
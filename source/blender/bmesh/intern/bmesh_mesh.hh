@@ -55,6 +55,22 @@ void BM_mesh_data_free(BMesh *bm);
  */
 void BM_mesh_clear(BMesh *bm);
 
+/**
+ * Allow creating and removing elements of \a bm on multiple threads, until
+ * #BM_mesh_threaded_alloc_end is called.
+ *
+ * The element and custom-data pools aren't thread-safe, so meanwhile every thread takes memory
+ * from a reserve of its own, refilled from the pools in batches. Removed elements are kept for
+ * reuse by the same thread and only returned to the pools at the end. Element counts are updated
+ * at the end too, the element indices and tables are tagged dirty right away.
+ *
+ * \note Threads must modify separate parts of the mesh. Elements in the select history must not
+ * be removed and the mesh elements must not be iterated over meanwhile. Custom-data is only
+ * allocated for elements created without #BM_CREATE_SKIP_CD.
+ */
+void BM_mesh_threaded_alloc_begin(BMesh *bm);
+void BM_mesh_threaded_alloc_end(BMesh *bm);
+
 /**
  * \brief BMesh Begin Edit
  *
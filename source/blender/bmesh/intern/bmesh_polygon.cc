@@ -15,6 +15,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_array.hh"
 #include "BLI_linklist.h"
 #include "BLI_math_base.hh"
 #include "BLI_math_geom.h"
@@ -32,6 +33,7 @@
 #include "intern/bmesh_private.hh"
 
 using blender::float3;
+using blender::MutableSpan;
 using blender::Span;
 
 /**
@@ -948,144 +950,156 @@ bool BM_face_point_inside_test(const BMFace *f, const float co[3])
   return isect_point_poly_v2(co_2d, projverts, f->len);
 }
 
-void BM_face_triangulate(BMesh *bm,
-                         BMFace *f,
-                         BMFace **r_faces_new,
-                         int *r_faces_new_tot,
-                         BMEdge **r_edges_new,
-                         int *r_edges_new_tot,
-                         LinkNode **r_faces_double,
-                         const int quad_method,
-                         const int ngon_method,
-                         const bool use_tag,
-                         /* use for ngons only! */
-                         MemArena *pf_arena,
-
-                         /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
-                         Heap *pf_heap)
+void BM_face_calc_triangulate(const BMFace *f,
+                              const int quad_method,
+                              const int ngon_method,
+                              MemArena *pf_arena,
+                              Heap *pf_heap,
+                              MutableSpan<std::array<BMLoop *, 3>> r_looptris)
 {
-  const int cd_loop_mdisp_offset = CustomData_get_offset(&bm->ldata, CD_MDISPS);
   const bool use_beauty = (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY);
-  BMLoop *l_first, *l_new;
-  BMFace *f_new;
-  int nf_i = 0;
-  int ne_i = 0;
-
-  BLI_assert(BM_face_is_normal_valid(f));
-
-  /* ensure both are valid or nullptr */
-  BLI_assert((r_faces_new == nullptr) == (r_faces_new_tot == nullptr));
+  BMLoop **loops = BLI_array_alloca(loops, f->len);
+  uint(*tris)[3] = BLI_array_alloca(tris, f->len);
+  const int totfilltri = f->len - 2;
+  int i;
 
   BLI_assert(f->len > 3);
-
-  {
-    BMLoop **loops = BLI_array_alloca(loops, f->len);
-    uint(*tris)[3] = BLI_array_alloca(tris, f->len);
-    const int totfilltri = f->len - 2;
-    const int last_tri = f->len - 3;
-    int i;
-    /* for mdisps */
-    float f_center[3];
-
-    if (f->len == 4) {
-      /* even though we're not using BLI_polyfill, fill in 'tris' and 'loops'
-       * so we can share code to handle face creation afterwards. */
-      BMLoop *l_v1, *l_v2;
-
-      l_first = BM_FACE_FIRST_LOOP(f);
-
-      switch (quad_method) {
-        case MOD_TRIANGULATE_QUAD_FIXED: {
-          l_v1 = l_first;
-          l_v2 = l_first->next->next;
-          break;
+  BLI_assert(r_looptris.size() == totfilltri);
+
+  if (f->len == 4) {
+    /* even though we're not using BLI_polyfill, fill in 'tris' and 'loops'
+     * so we can share code to handle face creation afterwards. */
+    BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+    BMLoop *l_v1, *l_v2;
+
+    switch (quad_method) {
+      case MOD_TRIANGULATE_QUAD_FIXED: {
+        l_v1 = l_first;
+        l_v2 = l_first->next->next;
+        break;
+      }
+      case MOD_TRIANGULATE_QUAD_ALTERNATE: {
+        l_v1 = l_first->next;
+        l_v2 = l_first->prev;
+        break;
+      }
+      case MOD_TRIANGULATE_QUAD_SHORTEDGE:
+      case MOD_TRIANGULATE_QUAD_LONGEDGE:
+      case MOD_TRIANGULATE_QUAD_BEAUTY:
+      default: {
+        BMLoop *l_v3, *l_v4;
+        bool split_24;
+
+        l_v1 = l_first->next;
+        l_v2 = l_first->next->next;
+        l_v3 = l_first->prev;
+        l_v4 = l_first;
+
+        if (quad_method == MOD_TRIANGULATE_QUAD_SHORTEDGE) {
+          float d1, d2;
+          d1 = len_squared_v3v3(l_v4->v->co, l_v2->v->co);
+          d2 = len_squared_v3v3(l_v1->v->co, l_v3->v->co);
+          split_24 = ((d2 - d1) > 0.0f);
         }
-        case MOD_TRIANGULATE_QUAD_ALTERNATE: {
-          l_v1 = l_first->next;
-          l_v2 = l_first->prev;
-          break;
+        else if (quad_method == MOD_TRIANGULATE_QUAD_LONGEDGE) {
+          float d1, d2;
+          d1 = len_squared_v3v3(l_v4->v->co, l_v2->v->co);
+          d2 = len_squared_v3v3(l_v1->v->co, l_v3->v->co);
+          split_24 = ((d2 - d1) < 0.0f);
         }
-        case MOD_TRIANGULATE_QUAD_SHORTEDGE:
-        case MOD_TRIANGULATE_QUAD_LONGEDGE:
-        case MOD_TRIANGULATE_QUAD_BEAUTY:
-        default: {
-          BMLoop *l_v3, *l_v4;
-          bool split_24;
-
-          l_v1 = l_first->next;
-          l_v2 = l_first->next->next;
-          l_v3 = l_first->prev;
-          l_v4 = l_first;
-
-          if (quad_method == MOD_TRIANGULATE_QUAD_SHORTEDGE) {
-            float d1, d2;
-            d1 = len_squared_v3v3(l_v4->v->co, l_v2->v->co);
-            d2 = len_squared_v3v3(l_v1->v->co, l_v3->v->co);
-            split_24 = ((d2 - d1) > 0.0f);
+        else {
+          /* first check if the quad is concave on either diagonal */
+          const int flip_flag = is_quad_flip_v3(
+              l_v1->v->co, l_v2->v->co, l_v3->v->co, l_v4->v->co);
+          if (UNLIKELY(flip_flag & (1 << 0))) {
+            split_24 = true;
           }
-          else if (quad_method == MOD_TRIANGULATE_QUAD_LONGEDGE) {
-            float d1, d2;
-            d1 = len_squared_v3v3(l_v4->v->co, l_v2->v->co);
-            d2 = len_squared_v3v3(l_v1->v->co, l_v3->v->co);
-            split_24 = ((d2 - d1) < 0.0f);
+          else if (UNLIKELY(flip_flag & (1 << 1))) {
+            split_24 = false;
           }
           else {
-            /* first check if the quad is concave on either diagonal */
-            const int flip_flag = is_quad_flip_v3(
-                l_v1->v->co, l_v2->v->co, l_v3->v->co, l_v4->v->co);
-            if (UNLIKELY(flip_flag & (1 << 0))) {
-              split_24 = true;
-            }
-            else if (UNLIKELY(flip_flag & (1 << 1))) {
-              split_24 = false;
-            }
-            else {
-              split_24 = (BM_verts_calc_rotate_beauty(l_v1->v, l_v2->v, l_v3->v, l_v4->v, 0, 0) >
-                          0.0f);
-            }
+            split_24 = (BM_verts_calc_rotate_beauty(l_v1->v, l_v2->v, l_v3->v, l_v4->v, 0, 0) >
+                        0.0f);
           }
+        }
 
-          /* named confusingly, l_v1 is in fact the second vertex */
-          if (split_24) {
-            l_v1 = l_v4;
-            // l_v2 = l_v2;
-          }
-          else {
-            // l_v1 = l_v1;
-            l_v2 = l_v3;
-          }
-          break;
+        /* named confusingly, l_v1 is in fact the second vertex */
+        if (split_24) {
+          l_v1 = l_v4;
+          // l_v2 = l_v2;
         }
+        else {
+          // l_v1 = l_v1;
+          l_v2 = l_v3;
+        }
+        break;
       }
+    }
 
-      loops[0] = l_v1;
-      loops[1] = l_v1->next;
-      loops[2] = l_v2;
-      loops[3] = l_v2->next;
+    loops[0] = l_v1;
+    loops[1] = l_v1->next;
+    loops[2] = l_v2;
+    loops[3] = l_v2->next;
 
-      ARRAY_SET_ITEMS(tris[0], 0, 1, 2);
-      ARRAY_SET_ITEMS(tris[1], 0, 2, 3);
+    ARRAY_SET_ITEMS(tris[0], 0, 1, 2);
+    ARRAY_SET_ITEMS(tris[1], 0, 2, 3);
+  }
+  else {
+    BMLoop *l_iter;
+    float axis_mat[3][3];
+    float(*projverts)[2] = BLI_array_alloca(projverts, f->len);
+
+    axis_dominant_v3_to_m3_negate(axis_mat, f->no);
+
+    for (i = 0, l_iter = BM_FACE_FIRST_LOOP(f); i < f->len; i++, l_iter = l_iter->next) {
+      loops[i] = l_iter;
+      mul_v2_m3v3(projverts[i], axis_mat, l_iter->v->co);
     }
-    else {
-      BMLoop *l_iter;
-      float axis_mat[3][3];
-      float(*projverts)[2] = BLI_array_alloca(projverts, f->len);
 
-      axis_dominant_v3_to_m3_negate(axis_mat, f->no);
+    BLI_polyfill_calc_arena(projverts, f->len, 1, tris, pf_arena);
 
-      for (i = 0, l_iter = BM_FACE_FIRST_LOOP(f); i < f->len; i++, l_iter = l_iter->next) {
-        loops[i] = l_iter;
-        mul_v2_m3v3(projverts[i], axis_mat, l_iter->v->co);
-      }
+    if (use_beauty) {
+      BLI_polyfill_beautify(projverts, f->len, tris, pf_arena, pf_heap);
+    }
 
-      BLI_polyfill_calc_arena(projverts, f->len, 1, tris, pf_arena);
+    BLI_memarena_clear(pf_arena);
+  }
 
-      if (use_beauty) {
-        BLI_polyfill_beautify(projverts, f->len, tris, pf_arena, pf_heap);
-      }
+  for (i = 0; i < totfilltri; i++) {
+    r_looptris[i] = {loops[tris[i][0]], loops[tris[i][1]], loops[tris[i][2]]};
+  }
+}
 
-      BLI_memarena_clear(pf_arena);
-    }
+void BM_face_triangulate_from_looptris(BMesh *bm,
+                                       BMFace *f,
+                                       const Span<std::array<BMLoop *, 3>> looptris,
+                                       BMFace **r_faces_new,
+                                       int *r_faces_new_tot,
+                                       BMEdge **r_edges_new,
+                                       int *r_edges_new_tot,
+                                       LinkNode **r_faces_double,
+                                       const bool use_tag)
+{
+  const int cd_loop_mdisp_offset = CustomData_get_offset(&bm->ldata, CD_MDISPS);
+  BMLoop *l_first, *l_new;
+  BMFace *f_new;
+  int nf_i = 0;
+  int ne_i = 0;
+
+  BLI_assert(BM_face_is_normal_valid(f));
+
+  /* ensure both are valid or nullptr */
+  BLI_assert((r_faces_new == nullptr) == (r_faces_new_tot == nullptr));
+
+  BLI_assert(f->len > 3);
+  BLI_assert(looptris.size() == f->len - 2);
+
+  {
+    const int totfilltri = f->len - 2;
+    const int last_tri = f->len - 3;
+    int i;
+    /* for mdisps */
+    float f_center[3];
 
     if (cd_loop_mdisp_offset != -1) {
       BM_face_calc_center_median(f, f_center);
@@ -1093,7 +1107,7 @@ void BM_face_triangulate(BMesh *bm,
 
     /* loop over calculated triangles and create new geometry */
     for (i = 0; i < totfilltri; i++) {
-      BMLoop *ltri[3] = {loops[tris[i][0]], loops[tris[i][1]], loops[tris[i][2]]};
+      const std::array<BMLoop *, 3> &ltri = looptris[i];
 
       BMVert *v_tri[3] = {ltri[0]->v, ltri[1]->v, ltri[2]->v};
 
@@ -1166,7 +1180,10 @@ void BM_face_triangulate(BMesh *bm,
       BM_face_kill(bm, f_new);
     }
   }
-  bm->elem_index_dirty |= BM_FACE;
+  if (bm->threaded_alloc == nullptr) {
+    /* Otherwise tagged when threaded allocation begins. */
+    bm->elem_index_dirty |= BM_FACE;
+  }
 
   if (r_faces_new_tot) {
     *r_faces_new_tot = nf_i;
@@ -1177,6 +1194,37 @@ void BM_face_triangulate(BMesh *bm,
   }
 }
 
+void BM_face_triangulate(BMesh *bm,
+                         BMFace *f,
+                         BMFace **r_faces_new,
+                         int *r_faces_new_tot,
+                         BMEdge **r_edges_new,
+                         int *r_edges_new_tot,
+                         LinkNode **r_faces_double,
+                         const int quad_method,
+                         const int ngon_method,
+                         const bool use_tag,
+                         /* use for ngons only! */
+                         MemArena *pf_arena,
+
+                         /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
+                         Heap *pf_heap)
+{
+  BLI_assert(f->len > 3);
+
+  blender::Array<std::array<BMLoop *, 3>, BM_DEFAULT_NGON_STACK_SIZE> looptris(f->len - 2);
+  BM_face_calc_triangulate(f, quad_method, ngon_method, pf_arena, pf_heap, looptris);
+  BM_face_triangulate_from_looptris(bm,
+                                    f,
+                                    looptris,
+                                    r_faces_new,
+                                    r_faces_new_tot,
+                                    r_edges_new,
+                                    r_edges_new_tot,
+                                    r_faces_double,
+                                    use_tag);
+}
+
 void BM_face_splits_check_legal(BMesh *bm, BMFace *f, BMLoop *(*loops)[2], int len)
 {
   float out[2] = {-FLT_MAX, -FLT_MAX};
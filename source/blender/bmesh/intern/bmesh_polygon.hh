@@ -10,6 +10,8 @@
 
 struct Heap;
 
+#include <array>
+
 #include "BLI_compiler_attrs.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_span.hh"
@@ -192,6 +194,37 @@ void BM_face_normal_flip(BMesh *bm, BMFace *f) ATTR_NONNULL();
 bool BM_face_point_inside_test(const BMFace *f, const float co[3]) ATTR_WARN_UNUSED_RESULT
     ATTR_NONNULL();
 
+/**
+ * Calculate the triangles #BM_face_triangulate would create for \a f, without modifying the mesh.
+ * This only reads the face, so it may run on many faces in parallel as long as each thread
+ * passes its own \a pf_arena and \a pf_heap.
+ *
+ * \param r_looptris: Store the loops of every triangle, `(f->len - 2)`.
+ */
+void BM_face_calc_triangulate(const BMFace *f,
+                              int quad_method,
+                              int ngon_method,
+                              struct MemArena *pf_arena,
+                              struct Heap *pf_heap,
+                              blender::MutableSpan<std::array<BMLoop *, 3>> r_looptris)
+    ATTR_NONNULL(1);
+/**
+ * Create the triangles calculated by #BM_face_calc_triangulate,
+ * see #BM_face_triangulate for a description of the arguments.
+ *
+ * Faces that don't share any vertices can be triangulated on multiple threads,
+ * between #BM_mesh_threaded_alloc_begin and #BM_mesh_threaded_alloc_end.
+ */
+void BM_face_triangulate_from_looptris(BMesh *bm,
+                                       BMFace *f,
+                                       blender::Span<std::array<BMLoop *, 3>> looptris,
+                                       BMFace **r_faces_new,
+                                       int *r_faces_new_tot,
+                                       BMEdge **r_edges_new,
+                                       int *r_edges_new_tot,
+                                       struct LinkNode **r_faces_double,
+                                       bool use_tag) ATTR_NONNULL(1, 2);
+
 /**
  * \brief BMESH TRIANGULATE FACE
  *
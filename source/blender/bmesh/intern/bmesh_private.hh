@@ -85,5 +85,31 @@ enum {
  */
 void poly_rotate_plane(const float normal[3], float (*verts)[3], uint nverts);
 
+/**
+ * The pools that elements and their data are taken from while #BMesh.threaded_alloc is set,
+ * see #BM_mesh_threaded_alloc_begin.
+ */
+enum eBMThreadedPool {
+  BM_THREADED_POOL_VERT = 0,
+  BM_THREADED_POOL_EDGE,
+  BM_THREADED_POOL_LOOP,
+  BM_THREADED_POOL_FACE,
+  BM_THREADED_POOL_VERT_DATA,
+  BM_THREADED_POOL_EDGE_DATA,
+  BM_THREADED_POOL_LOOP_DATA,
+  BM_THREADED_POOL_FACE_DATA,
+  BM_THREADED_POOL_VERT_TOOLFLAG,
+  BM_THREADED_POOL_EDGE_TOOLFLAG,
+  BM_THREADED_POOL_FACE_TOOLFLAG,
+};
+#define BM_THREADED_POOL_NUM (BM_THREADED_POOL_FACE_TOOLFLAG + 1)
+
+/** Take an element from the reserve of the current thread. */
+void *bm_threaded_pool_alloc(BMesh *bm, eBMThreadedPool pool);
+/** Keep a removed element for reuse by the current thread. */
+void bm_threaded_pool_free(BMesh *bm, eBMThreadedPool pool, void *elem);
+/** Count created (positive \a delta) or removed elements, added to the mesh at the end. */
+void bm_threaded_elem_count_add(BMesh *bm, char htype, int delta);
+
 /* include the rest of our private declarations */
 #include "bmesh_structure.hh"
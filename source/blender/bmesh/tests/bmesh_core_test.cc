@@ -5,8 +5,11 @@
 #include "testing/testing.h"
 
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "DNA_modifier_types.h"
 #include "bmesh.hh"
+#include "bmesh_tools.hh"
 
 TEST(bmesh_core, BMVertCreate)
 {
@@ -42,3 +45,114 @@ TEST(bmesh_core, BMVertCreate)
   EXPECT_EQ(BM_mesh_elem_count(bm, BM_VERT), 3);
   BM_mesh_free(bm);
 }
+
+TEST(bmesh_core, BMThreadedAlloc)
+{
+  BMeshCreateParams bmesh_create_params{};
+  BMesh *bm = BM_mesh_create(&bm_mesh_allocsize_default, &bmesh_create_params);
+  BM_data_layer_add(bm, &bm->vdata, CD_PROP_FLOAT);
+
+  /* Every task creates a triangle and removes one of its vertices, leaving an edge. */
+  const int tasks_num = 1000;
+  BM_mesh_threaded_alloc_begin(bm);
+  blender::threading::parallel_for(blender::IndexRange(tasks_num), 1, [&](const auto range) {
+    for (const int i : range) {
+      const float co[3] = {float(i), 0.0f, 0.0f};
+      BMVert *verts[3];
+      for (int j = 0; j < 3; j++) {
+        verts[j] = BM_vert_create(bm, co, nullptr, BM_CREATE_NOP);
+        BM_elem_float_data_set(&bm->vdata, verts[j], CD_PROP_FLOAT, float(i));
+      }
+      BMFace *f = BM_face_create_verts(bm, verts, 3, nullptr, BM_CREATE_NOP, true);
+      ASSERT_TRUE(f != nullptr);
+      BM_vert_kill(bm, verts[2]);
+    }
+  });
+  BM_mesh_threaded_alloc_end(bm);
+
+  EXPECT_EQ(bm->totvert, tasks_num * 2);
+  EXPECT_EQ(bm->totedge, tasks_num);
+  EXPECT_EQ(bm->totloop, 0);
+  EXPECT_EQ(bm->totface, 0);
+
+  /* Only the remaining elements are left in the pools. */
+  BMIter iter;
+  BMVert *v;
+  int verts_num = 0;
+  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
+    EXPECT_EQ(BM_elem_float_data_get(&bm->vdata, v, CD_PROP_FLOAT), v->co[0]);
+    verts_num++;
+  }
+  EXPECT_EQ(verts_num, tasks_num * 2);
+  BMEdge *e;
+  int edges_num = 0;
+  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
+    EXPECT_EQ(e->v1->co[0], e->v2->co[0]);
+    edges_num++;
+  }
+  EXPECT_EQ(edges_num, tasks_num);
+  BM_mesh_free(bm);
+}
+
+TEST(bmesh_core, BMTriangulateThreaded)
+{
+  BMeshCreateParams bmesh_create_params{};
+  bmesh_create_params.use_toolflags = true;
+  BMesh *bm = BM_mesh_create(&bm_mesh_allocsize_default, &bmesh_create_params);
+  BM_data_layer_add(bm, &bm->ldata, CD_PROP_FLOAT);
+
+  /* A grid with enough quads for the triangles to be created on multiple threads. */
+  const int size = 48;
+  blender::Array<BMVert *> verts((size + 1) * (size + 1));
+  for (int y = 0; y <= size; y++) {
+    for (int x = 0; x <= size; x++) {
+      const float co[3] = {float(x), float(y), 0.0f};
+      verts[y * (size + 1) + x] = BM_vert_create(bm, co, nullptr, BM_CREATE_NOP);
+    }
+  }
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      BMVert *quad[4] = {verts[y * (size + 1) + x],
+                         verts[y * (size + 1) + x + 1],
+                         verts[(y + 1) * (size + 1) + x + 1],
+                         verts[(y + 1) * (size + 1) + x]};
+      BMFace *f = BM_face_create_verts(bm, quad, 4, nullptr, BM_CREATE_NOP, true);
+      BMIter iter;
+      BMLoop *l;
+      BM_ITER_ELEM (l, &iter, f, BM_LOOPS_OF_FACE) {
+        BM_elem_float_data_set(&bm->ldata, l, CD_PROP_FLOAT, float(x + y));
+      }
+    }
+  }
+  BM_mesh_normals_update(bm);
+  /* Faces in the select history are kept while threaded. */
+  BM_select_history_store(bm, BM_face_at_index_find(bm, 0));
+  const int edges_num = bm->totedge;
+
+  BM_mesh_triangulate(bm,
+                      MOD_TRIANGULATE_QUAD_FIXED,
+                      MOD_TRIANGULATE_NGON_EARCLIP,
+                      4,
+                      false,
+                      nullptr,
+                      nullptr,
+                      nullptr);
+
+  EXPECT_EQ(bm->totvert, verts.size());
+  EXPECT_EQ(bm->totedge, edges_num + size * size);
+  EXPECT_EQ(bm->totface, size * size * 2);
+  EXPECT_EQ(bm->totloop, size * size * 6);
+  EXPECT_TRUE(BM_mesh_validate(bm));
+
+  BMIter iter;
+  BMFace *f;
+  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+    EXPECT_EQ(f->len, 3);
+    /* Loop data is copied from the quad the triangle was created from. */
+    BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+    const float value = BM_elem_float_data_get(&bm->ldata, l_first, CD_PROP_FLOAT);
+    EXPECT_EQ(BM_elem_float_data_get(&bm->ldata, l_first->next, CD_PROP_FLOAT), value);
+    EXPECT_EQ(BM_elem_float_data_get(&bm->ldata, l_first->prev, CD_PROP_FLOAT), value);
+  }
+  BM_mesh_free(bm);
+}
@@ -12,11 +12,17 @@
 
 #include "MEM_guardedalloc.h"
 
-#include "BLI_alloca.h"
+#include "BLI_array.hh"
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_function_ref.hh"
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
+#include "BLI_math_bits.h"
 #include "BLI_memarena.h"
+#include "BLI_offset_indices.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 /* only for defines */
 #include "BLI_polyfill_2d.h"
@@ -26,45 +32,42 @@
 
 #include "bmesh_triangulate.hh" /* own include */
 
+using blender::Array;
+using blender::FunctionRef;
+using blender::IndexRange;
+using blender::OffsetIndices;
+using blender::Span;
+using blender::Vector;
+
+/**
+ * Number of faces that are triangulated at once. The triangles of a chunk are calculated in
+ * parallel before the faces are created, this limits the memory used to store them.
+ */
+#define BM_TRIANGULATE_CHUNK_SIZE 65536
+
+/**
+ * Chunks with fewer faces create the triangles on a single thread, in the same order as the
+ * faces are iterated over.
+ */
+#define BM_TRIANGULATE_PARALLEL_MIN 1024
+
+/** Number of groups of faces that don't share vertices, see #bm_triangulate_groups_calc. */
+#define BM_TRIANGULATE_GROUPS_NUM 32
+
 /**
- * a version of #BM_face_triangulate that maps to #BMOpSlot
+ * Map the faces created for \a face to #BMOpSlot.
  */
-static void bm_face_triangulate_mapping(BMesh *bm,
-                                        BMFace *face,
-                                        const int quad_method,
-                                        const int ngon_method,
-                                        const bool use_tag,
+static void bm_face_triangulate_mapping(BMFace *face,
+                                        const Span<BMFace *> faces_new,
+                                        LinkNode *faces_double,
                                         BMOperator *op,
                                         BMOpSlot *slot_facemap_out,
-                                        BMOpSlot *slot_facemap_double_out,
-
-                                        MemArena *pf_arena,
-                                        /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
-                                        Heap *pf_heap)
+                                        BMOpSlot *slot_facemap_double_out)
 {
-  int faces_array_tot = face->len - 3;
-  BMFace **faces_array = BLI_array_alloca(faces_array, faces_array_tot);
-  LinkNode *faces_double = nullptr;
-  BLI_assert(face->len > 3);
-
-  BM_face_triangulate(bm,
-                      face,
-                      faces_array,
-                      &faces_array_tot,
-                      nullptr,
-                      nullptr,
-                      &faces_double,
-                      quad_method,
-                      ngon_method,
-                      use_tag,
-                      pf_arena,
-                      pf_heap);
-
-  if (faces_array_tot) {
-    int i;
+  if (!faces_new.is_empty()) {
     BMO_slot_map_elem_insert(op, slot_facemap_out, face, face);
-    for (i = 0; i < faces_array_tot; i++) {
-      BMO_slot_map_elem_insert(op, slot_facemap_out, faces_array[i], face);
+    for (BMFace *face_new : faces_new) {
+      BMO_slot_map_elem_insert(op, slot_facemap_out, face_new, face);
     }
 
     while (faces_double) {
@@ -76,6 +79,201 @@ static void bm_face_triangulate_mapping(BMesh *bm,
   }
 }
 
+/**
+ * Sort \a faces into groups in which no two faces share a vertex, so the triangles of a group
+ * can be created on multiple threads without modifying the same elements. Every face is put in
+ * the first group none of its vertices are used by yet, vertex indices store the groups a vertex
+ * is used by. Faces that don't fit in any group are put in a last group, which is triangulated on
+ * a single thread.
+ *
+ * \return The offsets of the groups in \a r_group_faces, which stores indices into \a faces.
+ */
+static OffsetIndices<int> bm_triangulate_groups_calc(BMesh *bm,
+                                                     const Span<BMFace *> faces,
+                                                     Array<int> &r_group_offset_data,
+                                                     Array<int> &r_group_faces)
+{
+  for (BMFace *face : faces) {
+    BMLoop *l_iter, *l_first;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(face);
+    do {
+      BM_elem_index_set(l_iter->v, 0); /* set_dirty! */
+    } while ((l_iter = l_iter->next) != l_first);
+  }
+  bm->elem_index_dirty |= BM_VERT;
+
+  Array<int> face_groups(faces.size());
+  r_group_offset_data.reinitialize(BM_TRIANGULATE_GROUPS_NUM + 2);
+  r_group_offset_data.fill(0);
+  for (const int i : faces.index_range()) {
+    BMLoop *l_iter, *l_first;
+    uint used_groups = 0;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(faces[i]);
+    do {
+      used_groups |= uint(BM_elem_index_get(l_iter->v));
+    } while ((l_iter = l_iter->next) != l_first);
+
+    const int group = (used_groups == UINT_MAX) ? BM_TRIANGULATE_GROUPS_NUM :
+                                                   int(bitscan_forward_uint(~used_groups));
+    if (group != BM_TRIANGULATE_GROUPS_NUM) {
+      do {
+        BM_elem_index_set(l_iter->v, int(uint(BM_elem_index_get(l_iter->v)) | (1u << group)));
+      } while ((l_iter = l_iter->next) != l_first);
+    }
+    face_groups[i] = group;
+    r_group_offset_data[group]++;
+  }
+
+  const OffsetIndices<int> group_offsets = blender::offset_indices::accumulate_counts_to_offsets(
+      r_group_offset_data);
+  Array<int> group_sizes(group_offsets.size(), 0);
+  r_group_faces.reinitialize(faces.size());
+  for (const int i : faces.index_range()) {
+    const int group = face_groups[i];
+    r_group_faces[group_offsets[group][group_sizes[group]++]] = i;
+  }
+  return group_offsets;
+}
+
+struct TriangulateLocalData {
+  MemArena *pf_arena = nullptr;
+  /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
+  Heap *pf_heap = nullptr;
+
+  ~TriangulateLocalData()
+  {
+    if (pf_arena) {
+      BLI_memarena_free(pf_arena);
+    }
+    if (pf_heap) {
+      BLI_heap_free(pf_heap, nullptr);
+    }
+  }
+};
+
+/**
+ * Triangulate every face that should be, then call \a face_fn with the new faces and the
+ * duplicate faces in the same order as the faces are iterated over.
+ *
+ * Calculating the triangles only reads the face, so it's done in parallel for a chunk of faces,
+ * with a memory arena and heap per thread. For large chunks the triangles are created in parallel
+ * too, for groups of faces that don't share vertices, using threaded allocation. The topology of
+ * the result doesn't depend on threading, the order of the new elements in memory does.
+ */
+static void bm_mesh_triangulate_faces(
+    BMesh *bm,
+    const int quad_method,
+    const int ngon_method,
+    const int min_vertices,
+    const bool tag_only,
+    const FunctionRef<void(BMFace *face, Span<BMFace *> faces_new, LinkNode *faces_double)>
+        face_fn)
+{
+  blender::threading::EnumerableThreadSpecific<TriangulateLocalData> all_local_data;
+  Vector<BMFace *> faces;
+  Vector<int> tri_offset_data;
+  Vector<std::array<BMLoop *, 3>> looptris;
+  Array<BMFace *> faces_new;
+  Array<LinkNode *> faces_double;
+  Array<int> group_offset_data;
+  Array<int> group_faces;
+
+  auto triangulate_chunk = [&]() {
+    tri_offset_data.resize(faces.size() + 1);
+    for (const int i : faces.index_range()) {
+      tri_offset_data[i] = faces[i]->len - 2;
+    }
+    const OffsetIndices<int> tri_offsets = blender::offset_indices::accumulate_counts_to_offsets(
+        tri_offset_data);
+    looptris.resize(tri_offsets.total_size());
+
+    blender::threading::parallel_for(faces.index_range(), 256, [&](const IndexRange range) {
+      TriangulateLocalData &local_data = all_local_data.local();
+      if (local_data.pf_arena == nullptr) {
+        local_data.pf_arena = BLI_memarena_new(BLI_POLYFILL_ARENA_SIZE, __func__);
+        if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
+          local_data.pf_heap = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
+        }
+      }
+      for (const int i : range) {
+        BM_face_calc_triangulate(faces[i],
+                                 quad_method,
+                                 ngon_method,
+                                 local_data.pf_arena,
+                                 local_data.pf_heap,
+                                 looptris.as_mutable_span().slice(tri_offsets[i]));
+      }
+    });
+
+    /* The last triangle of a face reuses the face, so one less is created. */
+    faces_new.reinitialize(tri_offsets.total_size());
+    faces_double.reinitialize(faces.size());
+    faces_double.fill(nullptr);
+    auto triangulate_face = [&](const int i) {
+      int faces_new_tot;
+      BM_face_triangulate_from_looptris(bm,
+                                        faces[i],
+                                        looptris.as_span().slice(tri_offsets[i]),
+                                        &faces_new[tri_offsets[i].start()],
+                                        &faces_new_tot,
+                                        nullptr,
+                                        nullptr,
+                                        &faces_double[i],
+                                        tag_only);
+      BLI_assert(faces_new_tot == tri_offsets[i].size() - 1);
+    };
+
+    if (faces.size() < BM_TRIANGULATE_PARALLEL_MIN) {
+      for (const int i : faces.index_range()) {
+        triangulate_face(i);
+      }
+    }
+    else {
+      const OffsetIndices<int> group_offsets = bm_triangulate_groups_calc(
+          bm, faces, group_offset_data, group_faces);
+      BM_mesh_threaded_alloc_begin(bm);
+      for (const int group : IndexRange(BM_TRIANGULATE_GROUPS_NUM)) {
+        const Span<int> faces_in_group = group_faces.as_span().slice(group_offsets[group]);
+        blender::threading::parallel_for(
+            faces_in_group.index_range(), 64, [&](const IndexRange range) {
+              for (const int i : faces_in_group.slice(range)) {
+                triangulate_face(i);
+              }
+            });
+      }
+      for (const int i : group_faces.as_span().slice(group_offsets[BM_TRIANGULATE_GROUPS_NUM])) {
+        triangulate_face(i);
+      }
+      BM_mesh_threaded_alloc_end(bm);
+    }
+
+    for (const int i : faces.index_range()) {
+      face_fn(faces[i],
+              faces_new.as_span().slice(tri_offsets[i].drop_back(1)),
+              faces_double[i]);
+    }
+    faces.clear();
+  };
+
+  /* Faces created while triangulating a chunk may be visited by the iterator,
+   * they are triangles so they are skipped like they would be without chunks. */
+  BMIter iter;
+  BMFace *face;
+  BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
+    if (face->len >= min_vertices) {
+      if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
+        faces.append(face);
+        if (faces.size() == BM_TRIANGULATE_CHUNK_SIZE) {
+          triangulate_chunk();
+        }
+      }
+    }
+  }
+  if (!faces.is_empty()) {
+    triangulate_chunk();
+  }
+}
+
 void BM_mesh_triangulate(BMesh *bm,
                          const int quad_method,
                          const int ngon_method,
@@ -85,60 +283,36 @@ void BM_mesh_triangulate(BMesh *bm,
                          BMOpSlot *slot_facemap_out,
                          BMOpSlot *slot_facemap_double_out)
 {
-  BMIter iter;
-  BMFace *face;
-  MemArena *pf_arena;
-  Heap *pf_heap;
-
-  pf_arena = BLI_memarena_new(BLI_POLYFILL_ARENA_SIZE, __func__);
-
-  if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
-    pf_heap = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
-  }
-  else {
-    pf_heap = nullptr;
-  }
-
   if (slot_facemap_out) {
     /* same as below but call: bm_face_triangulate_mapping() */
-    BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
-      if (face->len >= min_vertices) {
-        if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
-          bm_face_triangulate_mapping(bm,
-                                      face,
-                                      quad_method,
-                                      ngon_method,
-                                      tag_only,
-                                      op,
-                                      slot_facemap_out,
-                                      slot_facemap_double_out,
-                                      pf_arena,
-                                      pf_heap);
-        }
-      }
-    }
+    bm_mesh_triangulate_faces(
+        bm,
+        quad_method,
+        ngon_method,
+        min_vertices,
+        tag_only,
+        [&](BMFace *face, const Span<BMFace *> faces_new, LinkNode *faces_double) {
+          bm_face_triangulate_mapping(
+              face, faces_new, faces_double, op, slot_facemap_out, slot_facemap_double_out);
+        });
   }
   else {
     LinkNode *faces_double = nullptr;
 
-    BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
-      if (face->len >= min_vertices) {
-        if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
-          BM_face_triangulate(bm,
-                              face,
-                              nullptr,
-                              nullptr,
-                              nullptr,
-                              nullptr,
-                              &faces_double,
-                              quad_method,
-                              ngon_method,
-                              tag_only,
-                              pf_arena,
-                              pf_heap);
-        }
-      }
-    }
+    bm_mesh_triangulate_faces(
+        bm,
+        quad_method,
+        ngon_method,
+        min_vertices,
+        tag_only,
+        [&](BMFace * /*face*/, const Span<BMFace *> /*faces_new*/, LinkNode *face_doubles) {
+          while (face_doubles) {
+            LinkNode *next = face_doubles->next;
+            face_doubles->next = faces_double;
+            faces_double = face_doubles;
+            face_doubles = next;
+          }
+        });
 
     while (faces_double) {
       LinkNode *next = faces_double->next;
@@ -147,10 +321,4 @@ void BM_mesh_triangulate(BMesh *bm,
       faces_double = next;
     }
   }
-
-  BLI_memarena_free(pf_arena);
-
-  if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
-    BLI_heap_free(pf_heap, nullptr);
-  }
 }
@@ -0,0 +1,218 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <complex>
+#include <cstring>
+
+#if defined(WITH_FFTW3)
+#  include <fftw3.h>
+#endif
+
+#include "BLI_fftw.hh"
+#include "BLI_index_range.hh"
+#include "BLI_math_base.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rect.h"
+#include "BLI_task.hh"
+
+#include "BKE_global.hh"
+
+#include "COM_FFTConvolutionAlgorithm.h"
+
+namespace blender::compositor {
+
+bool use_fft_convolution(const int radius)
+{
+#if defined(WITH_FFTW3)
+  return radius >= FFT_CONVOLUTION_MIN_RADIUS &&
+         G.debug_value != FFT_CONVOLUTION_DISABLE_DEBUG_VALUE;
+#else
+  UNUSED_VARS(radius);
+  return false;
+#endif
+}
+
+int64_t FFTConvolution::get_spatial_pixels_per_channel() const
+{
+  return int64_t(spatial_size_.x) * spatial_size_.y;
+}
+
+int64_t FFTConvolution::get_frequency_pixels_per_channel() const
+{
+  return int64_t(frequency_size_.x) * frequency_size_.y;
+}
+
+FFTConvolution::FFTConvolution(const MemoryBuffer &image, const rcti &area, const int max_radius)
+    : area_(area), max_radius_(max_radius)
+{
+#if defined(WITH_FFTW3)
+  BLI_assert(image.get_num_channels() == COM_DATA_TYPE_COLOR_CHANNELS);
+  fftw::initialize_float();
+
+  /* Since we will be doing a circular convolution, we need to pad the area by the maximum radius
+   * on all sides to avoid the kernel affecting the pixels at the other side of the area. The
+   * padding is extended from the image instead of being zero, to match the direct convolutions.
+   */
+  const int2 area_size = int2(BLI_rcti_size_x(&area), BLI_rcti_size_y(&area));
+  const int2 needed_spatial_size = area_size + max_radius * 2;
+  spatial_size_ = fftw::optimal_size_for_real_transform(needed_spatial_size);
+
+  /* The FFTW real to complex transforms utilizes the hermitian symmetry of real transforms and
+   * stores only half the output since the other half is redundant, so we only allocate half of the
+   * first dimension. See Section 4.3.4 Real-data DFT Array Format in the FFTW manual for more
+   * information. */
+  frequency_size_ = int2(spatial_size_.x / 2 + 1, spatial_size_.y);
+
+  const int channels_count = COM_DATA_TYPE_COLOR_CHANNELS;
+  const int64_t spatial_pixels_per_channel = get_spatial_pixels_per_channel();
+  const int64_t frequency_pixels_per_channel = get_frequency_pixels_per_channel();
+
+  spatial_domain_ = fftwf_alloc_real(spatial_pixels_per_channel * channels_count);
+  image_frequency_domain_ = reinterpret_cast<std::complex<float> *>(
+      fftwf_alloc_complex(frequency_pixels_per_channel * channels_count));
+  frequency_domain_ = reinterpret_cast<std::complex<float> *>(
+      fftwf_alloc_complex(frequency_pixels_per_channel * channels_count));
+
+  /* The plans are created for the first channel, but are used for all channels of both the image
+   * and the kernels since they all have the same dimensions. */
+  forward_plan_ = fftwf_plan_dft_r2c_2d(spatial_size_.y,
+                                        spatial_size_.x,
+                                        spatial_domain_,
+                                        reinterpret_cast<fftwf_complex *>(image_frequency_domain_),
+                                        FFTW_ESTIMATE);
+  backward_plan_ = fftwf_plan_dft_c2r_2d(spatial_size_.y,
+                                         spatial_size_.x,
+                                         reinterpret_cast<fftwf_complex *>(frequency_domain_),
+                                         spatial_domain_,
+                                         FFTW_ESTIMATE);
+
+  /* Pad the image to the spatial domain size, storing each channel in planar format for better
+   * cache locality. */
+  const int2 origin = int2(area.xmin, area.ymin) - max_radius;
+  threading::parallel_for(IndexRange(spatial_size_.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : IndexRange(spatial_size_.x)) {
+        const float *color = image.get_elem_clamped(origin.x + x, origin.y + y);
+        for (const int64_t channel : IndexRange(channels_count)) {
+          const int64_t base_index = x + y * spatial_size_.x;
+          spatial_domain_[base_index + spatial_pixels_per_channel * channel] = color[channel];
+        }
+      }
+    }
+  });
+
+  threading::parallel_for(IndexRange(channels_count), 1, [&](const IndexRange sub_range) {
+    for (const int64_t channel : sub_range) {
+      fftwf_execute_dft_r2c(forward_plan_,
+                            spatial_domain_ + spatial_pixels_per_channel * channel,
+                            reinterpret_cast<fftwf_complex *>(image_frequency_domain_) +
+                                frequency_pixels_per_channel * channel);
+    }
+  });
+#else
+  UNUSED_VARS(image);
+#endif
+}
+
+FFTConvolution::~FFTConvolution()
+{
+#if defined(WITH_FFTW3)
+  fftwf_destroy_plan(forward_plan_);
+  fftwf_destroy_plan(backward_plan_);
+  fftwf_free(spatial_domain_);
+  fftwf_free(image_frequency_domain_);
+  fftwf_free(frequency_domain_);
+#endif
+}
+
+void FFTConvolution::convolve(Span<float4> kernel,
+                              const int radius,
+                              MemoryBuffer &output,
+                              const bool normalize)
+{
+#if defined(WITH_FFTW3)
+  const int kernel_size = radius * 2 + 1;
+  BLI_assert(radius <= max_radius_);
+  BLI_assert(kernel.size() == int64_t(kernel_size) * kernel_size);
+
+  const int channels_count = COM_DATA_TYPE_COLOR_CHANNELS;
+  const int64_t spatial_pixels_per_channel = get_spatial_pixels_per_channel();
+  const int64_t frequency_pixels_per_channel = get_frequency_pixels_per_channel();
+
+  /* Zero pad the kernel to the spatial domain size. The kernel is mirrored and offset with wrap
+   * around such that it is centered at the zero point, which turns the circular convolution into
+   * the correlation computed by the direct convolutions. */
+  memset(spatial_domain_, 0, sizeof(float) * spatial_pixels_per_channel * channels_count);
+  double4 sum = double4(0.0);
+  for (const int y : IndexRange(kernel_size)) {
+    for (const int x : IndexRange(kernel_size)) {
+      const float4 weight = kernel[x + y * kernel_size];
+      const int64_t output_x = mod_i(radius - x, spatial_size_.x);
+      const int64_t output_y = mod_i(radius - y, spatial_size_.y);
+      const int64_t base_index = output_x + output_y * spatial_size_.x;
+      for (const int64_t channel : IndexRange(channels_count)) {
+        spatial_domain_[base_index + spatial_pixels_per_channel * channel] = weight[channel];
+      }
+      sum += double4(weight);
+    }
+  }
+
+  threading::parallel_for(IndexRange(channels_count), 1, [&](const IndexRange sub_range) {
+    for (const int64_t channel : sub_range) {
+      fftwf_execute_dft_r2c(forward_plan_,
+                            spatial_domain_ + spatial_pixels_per_channel * channel,
+                            reinterpret_cast<fftwf_complex *>(frequency_domain_) +
+                                frequency_pixels_per_channel * channel);
+    }
+  });
+
+  /* Multiply the kernel and the image in the frequency domain to perform the convolution. The
+   * FFT is not normalized, so we divide by the size of the transform in addition to the kernel
+   * sum. Channels whose kernel sums to zero are zero, like the safe division of the direct
+   * convolutions. */
+  const float4 kernel_sum = normalize ? float4(sum) : float4(1.0f);
+  const float4 normalization_scale = kernel_sum * (float(spatial_size_.x) * spatial_size_.y);
+  threading::parallel_for(IndexRange(frequency_size_.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t channel : IndexRange(channels_count)) {
+      const float scale = normalization_scale[channel] == 0.0f ?
+                              0.0f :
+                              1.0f / normalization_scale[channel];
+      for (const int64_t y : sub_y_range) {
+        for (const int64_t x : IndexRange(frequency_size_.x)) {
+          const int64_t index = x + y * frequency_size_.x +
+                                frequency_pixels_per_channel * channel;
+          frequency_domain_[index] *= image_frequency_domain_[index] * scale;
+        }
+      }
+    }
+  });
+
+  threading::parallel_for(IndexRange(channels_count), 1, [&](const IndexRange sub_range) {
+    for (const int64_t channel : sub_range) {
+      fftwf_execute_dft_c2r(backward_plan_,
+                            reinterpret_cast<fftwf_complex *>(frequency_domain_) +
+                                frequency_pixels_per_channel * channel,
+                            spatial_domain_ + spatial_pixels_per_channel * channel);
+    }
+  });
+
+  /* Copy the result to the output, skipping the padding. */
+  const int2 area_size = int2(BLI_rcti_size_x(&area_), BLI_rcti_size_y(&area_));
+  threading::parallel_for(IndexRange(area_size.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : IndexRange(area_size.x)) {
+        float *color = output.get_elem(area_.xmin + x, area_.ymin + y);
+        const int64_t base_index = (x + max_radius_) + (y + max_radius_) * spatial_size_.x;
+        for (const int64_t channel : IndexRange(channels_count)) {
+          color[channel] = spatial_domain_[base_index + spatial_pixels_per_channel * channel];
+        }
+      }
+    }
+  });
+#else
+  UNUSED_VARS(kernel, radius, output, normalize);
+#endif
+}
+
+}  // namespace blender::compositor
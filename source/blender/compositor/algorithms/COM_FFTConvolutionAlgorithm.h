@@ -0,0 +1,80 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <complex>
+
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+#include "BLI_utility_mixins.hh"
+
+#include "DNA_vec_types.h"
+
+#include "COM_MemoryBuffer.h"
+
+struct fftwf_plan_s;
+
+namespace blender::compositor {
+
+/* Kernels whose radius is at least this number of pixels are convolved in the frequency domain by
+ * the operations that support it. The cost of the direct convolution grows with the square of the
+ * radius, while the cost of the FFT convolution mostly depends on the size of the image, and this
+ * is roughly where they break even. */
+constexpr int FFT_CONVOLUTION_MIN_RADIUS = 16;
+
+/* Setting the debug value to this disables the FFT convolution, so that its result and performance
+ * can be compared against the direct convolution. */
+constexpr int FFT_CONVOLUTION_DISABLE_DEBUG_VALUE = 5100;
+
+/* Returns true if a kernel of the given radius should be convolved using #FFTConvolution, which
+ * requires Blender to be built with FFTW. */
+bool use_fft_convolution(int radius);
+
+/**
+ * Convolves an area of an image with kernels in the frequency domain. The image is transformed
+ * once on construction, so that it can be convolved with any number of kernels whose radius is
+ * less than or equal to the given maximum radius.
+ *
+ * Pixels outside of the image are extended from its edges, as done by
+ * #MemoryBuffer::get_elem_clamped in the direct convolutions. Each channel of the image is
+ * convolved with the same channel of the kernel, and the kernel is normalized per channel unless
+ * requested otherwise.
+ */
+class FFTConvolution : NonCopyable, NonMovable {
+ private:
+  rcti area_;
+  int max_radius_;
+  int2 spatial_size_;
+  int2 frequency_size_;
+
+  /* Planar channels of the padded image in the spatial domain, that is, RRRR...GGGG...BBBB...,
+   * and the same in the frequency domain. The image is kept in the frequency domain, while the
+   * kernels are transformed into a separate buffer that gets multiplied by the image. */
+  float *spatial_domain_ = nullptr;
+  std::complex<float> *image_frequency_domain_ = nullptr;
+  std::complex<float> *frequency_domain_ = nullptr;
+
+  fftwf_plan_s *forward_plan_ = nullptr;
+  fftwf_plan_s *backward_plan_ = nullptr;
+
+ public:
+  FFTConvolution(const MemoryBuffer &image, const rcti &area, int max_radius);
+  ~FFTConvolution();
+
+  /**
+   * Convolve the image with the given kernel and write the result to the area of the output. The
+   * kernel has a size of 2 * radius + 1 in both dimensions and its element at (radius + x,
+   * radius + y) is the weight of the image pixel at an offset of (x, y) from the output pixel.
+   * Without normalization, the output is the weighted sum of the image pixels instead of their
+   * weighted average.
+   */
+  void convolve(Span<float4> kernel, int radius, MemoryBuffer &output, bool normalize = true);
+
+ private:
+  int64_t get_spatial_pixels_per_channel() const;
+  int64_t get_frequency_pixels_per_channel() const;
+};
+
+}  // namespace blender::compositor
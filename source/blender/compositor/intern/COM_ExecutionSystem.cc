@@ -38,9 +38,6 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
 
   context_.set_render_data(rd);
 
-  BLI_mutex_init(&work_mutex_);
-  BLI_condition_init(&work_finished_cond_);
-
   {
     NodeOperationBuilder builder(&context_, editingtree, this);
     builder.convert_to_operations(this);
@@ -51,9 +48,6 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
 
 ExecutionSystem::~ExecutionSystem()
 {
-  BLI_condition_end(&work_finished_cond_);
-  BLI_mutex_end(&work_mutex_);
-
   delete execution_model_;
 
   for (NodeOperation *operation : operations_) {
@@ -94,7 +88,6 @@ void ExecutionSystem::execute_work(const rcti &work_rect,
 
   Vector<WorkPackage> sub_works(num_sub_works);
   int sub_work_y = work_rect.ymin;
-  int num_sub_works_finished = 0;
   for (int i = 0; i < num_sub_works; i++) {
     int sub_work_height = split_height;
 
@@ -114,29 +107,12 @@ void ExecutionSystem::execute_work(const rcti &work_rect,
           &split_rect, work_rect.xmin, work_rect.xmax, sub_work_y, sub_work_y + sub_work_height);
       work_func(split_rect);
     };
-    sub_work.executed_fn = [&]() {
-      BLI_mutex_lock(&work_mutex_);
-      num_sub_works_finished++;
-      if (num_sub_works_finished == num_sub_works) {
-        BLI_condition_notify_one(&work_finished_cond_);
-      }
-      BLI_mutex_unlock(&work_mutex_);
-    };
-    WorkScheduler::schedule(&sub_work);
     sub_work_y += sub_work_height;
   }
   BLI_assert(sub_work_y == work_rect.ymax);
 
-  WorkScheduler::finish();
-
-  /* Ensure all sub-works finished.
-   * TODO: This a workaround for WorkScheduler::finish() not waiting all works on queue threading
-   * model. Sync code should be removed once it's fixed. */
-  BLI_mutex_lock(&work_mutex_);
-  if (num_sub_works_finished < num_sub_works) {
-    BLI_condition_wait(&work_finished_cond_, &work_mutex_);
-  }
-  BLI_mutex_unlock(&work_mutex_);
+  /* Only wait for the work of this operation, independent operations are rendered concurrently. */
+  WorkScheduler::execute_and_wait(sub_works);
 }
 
 bool ExecutionSystem::is_breaked() const
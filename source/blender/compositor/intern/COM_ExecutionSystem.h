@@ -118,9 +118,6 @@ class ExecutionSystem {
    */
   int num_work_threads_;
 
-  ThreadMutex work_mutex_;
-  ThreadCondition work_finished_cond_;
-
  public:
   /**
    * \brief Create a new ExecutionSystem and initialize it with the
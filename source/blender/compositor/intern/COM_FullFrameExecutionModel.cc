@@ -4,11 +4,14 @@
 
 #include "COM_FullFrameExecutionModel.h"
 
+#include "BLI_multi_value_map.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.hh"
 
 #include "COM_Debug.h"
+#include "COM_ResultsCache.h"
 #include "COM_ViewerOperation.h"
 #include "COM_WorkScheduler.h"
 
@@ -27,7 +30,8 @@ FullFrameExecutionModel::FullFrameExecutionModel(CompositorContext &context,
                                                  Span<NodeOperation *> operations)
     : ExecutionModel(context, operations),
       active_buffers_(shared_buffers),
-      num_operations_finished_(0)
+      num_operations_finished_(0),
+      num_tiles_(1)
 {
   priorities_.append(eCompositorPriority::High);
   priorities_.append(eCompositorPriority::Medium);
@@ -42,11 +46,179 @@ void FullFrameExecutionModel::execute(ExecutionSystem &exec_system)
 
   DebugInfo::graphviz(&exec_system, "compositor_prior_rendering");
 
-  determine_areas_to_render_and_reads();
-  render_operations();
+  const RenderData *rd = context_.get_render_data();
+  const int64_t memory_limit = int64_t(rd->compositor_memory_limit) * 1024 * 1024;
+  if (memory_limit > 0) {
+    const bool is_rendering = context_.is_rendering();
+    whole_buffer_operations_ = find_whole_buffer_operations(operations_, is_rendering);
+    num_tiles_ = calc_num_tiles(operations_, whole_buffer_operations_, memory_limit, is_rendering);
+  }
+  /* Buffers covering the whole canvas of their operation are kept between tiles, they already
+   * contain the areas any other tile may need. */
+  active_buffers_.set_keep_whole_buffers(num_tiles_ > 1);
+
+  /* As a memory saving fallback, buffers waiting for their readers are compressed to half
+   * precision when there is a memory limit. Automatic precision only uses full precision for final
+   * renders. */
+  active_buffers_.set_compress_idle_buffers(
+      rd->compositor_memory_limit > 0 &&
+      rd->compositor_precision == SCE_COMPOSITOR_PRECISION_AUTO && !context_.is_rendering());
+
+  ResultsCache::set_limits(int64_t(rd->compositor_cache_memory_limit) * 1024 * 1024,
+                           int64_t(rd->compositor_cache_disk_limit) * 1024 * 1024);
+  if (ResultsCache::is_enabled()) {
+    lookup_cached_buffers();
+  }
+
+  WorkScheduler::start();
+  for (int tile = 0; tile < num_tiles_ && !exec_system.is_breaked(); tile++) {
+    if (tile > 0) {
+      active_buffers_.clear_partial_buffers();
+    }
+    use_cached_buffers();
+    determine_areas_to_render_and_reads(tile);
+    render_operations();
+  }
+  WorkScheduler::stop();
+}
+
+static int64_t operation_buffer_size(NodeOperation *op)
+{
+  const DataType data_type = op->get_output_socket(0)->get_data_type();
+  return int64_t(op->get_width()) * op->get_height() * COM_data_type_num_channels(data_type) *
+         sizeof(float);
+}
+
+Set<NodeOperation *> FullFrameExecutionModel::find_whole_buffer_operations(
+    Span<NodeOperation *> operations, const bool is_rendering)
+{
+  Set<NodeOperation *> whole_buffer_operations;
+  for (NodeOperation *op : operations) {
+    const NodeOperationFlags flags = op->get_flags();
+    if (flags.can_be_fused ||
+        (op->is_output_operation(is_rendering) && !flags.is_preview_operation))
+    {
+      continue;
+    }
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperation *input_op = op->get_input_operation(i);
+      if (input_op && !input_op->get_flags().is_constant_operation) {
+        whole_buffer_operations.add(input_op);
+      }
+    }
+  }
+  return whole_buffer_operations;
+}
+
+int FullFrameExecutionModel::calc_num_tiles(Span<NodeOperation *> operations,
+                                            const Set<NodeOperation *> &whole_buffer_operations,
+                                            const int64_t memory_limit,
+                                            const bool is_rendering)
+{
+  int64_t whole_buffers_size = 0;
+  int64_t partial_buffers_size = 0;
+  int max_output_height = 1;
+  for (NodeOperation *op : operations) {
+    if (op->is_output_operation(is_rendering)) {
+      max_output_height = std::max(max_output_height, int(op->get_height()));
+    }
+    if (op->get_number_of_output_sockets() == 0 || op->get_flags().is_constant_operation) {
+      continue;
+    }
+    if (whole_buffer_operations.contains(op)) {
+      whole_buffers_size += operation_buffer_size(op);
+    }
+    else {
+      partial_buffers_size += operation_buffer_size(op);
+    }
+  }
+  if (partial_buffers_size == 0) {
+    return 1;
+  }
+
+  /* This is an upper bound, buffers are freed once read by all the operations depending on them.
+   * Only partial buffers get smaller with more tiles. */
+  const int64_t available_size = memory_limit - whole_buffers_size;
+  if (available_size <= 0) {
+    return max_output_height;
+  }
+  const int64_t num_tiles = (partial_buffers_size + available_size - 1) / available_size;
+  return int(std::clamp(num_tiles, int64_t(1), int64_t(max_output_height)));
 }
 
-void FullFrameExecutionModel::determine_areas_to_render_and_reads()
+/** Generates the cache key of the given operation after the ones of its inputs. */
+static void generate_cache_key_recursive(NodeOperation *op,
+                                         Set<NodeOperation *> &visited,
+                                         Map<NodeOperation *, uint64_t> &r_keys)
+{
+  if (!visited.add(op)) {
+    return;
+  }
+  for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+    generate_cache_key_recursive(op->get_input_operation(i), visited, r_keys);
+  }
+  if (op->get_flags().is_constant_operation) {
+    return;
+  }
+  if (const std::optional<uint64_t> key = op->generate_cache_key(r_keys)) {
+    r_keys.add_new(op, *key);
+  }
+}
+
+void FullFrameExecutionModel::lookup_cached_buffers()
+{
+  Set<NodeOperation *> visited;
+  for (NodeOperation *op : operations_) {
+    generate_cache_key_recursive(op, visited, cache_keys_);
+  }
+
+  for (NodeOperation *op : operations_) {
+    if (cache_keys_.contains(op)) {
+      continue;
+    }
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperation *input_op = op->get_input_operation(i);
+      if (cache_keys_.contains(input_op)) {
+        operations_to_cache_.add(input_op);
+      }
+    }
+  }
+
+  realtime_compositor::Profiler *profiler = context_.get_profiler();
+  for (NodeOperation *op : operations_to_cache_) {
+    const timeit::TimePoint before_time = timeit::Clock::now();
+    std::shared_ptr<MemoryBuffer> buffer = ResultsCache::lookup(cache_keys_.lookup(op));
+    if (buffer == nullptr) {
+      continue;
+    }
+    cached_buffers_.add_new(op, std::move(buffer));
+
+    const bNodeInstanceKey node_instance_key = op->get_node_instance_key();
+    if (profiler && node_instance_key != bke::NODE_INSTANCE_KEY_NONE) {
+      profiler->set_node_evaluation_time(node_instance_key, timeit::Clock::now() - before_time);
+      profiler->set_node_cached(node_instance_key);
+    }
+  }
+}
+
+void FullFrameExecutionModel::use_cached_buffers()
+{
+  for (MapItem<NodeOperation *, std::shared_ptr<MemoryBuffer>> item : cached_buffers_.items()) {
+    NodeOperation *op = item.key;
+    if (active_buffers_.is_operation_rendered(op)) {
+      continue;
+    }
+    /* The cache keeps ownership of the buffer. */
+    MemoryBuffer &buffer = *item.value;
+    active_buffers_.register_area(op, op->get_canvas());
+    active_buffers_.set_rendered_buffer(
+        op,
+        std::make_unique<MemoryBuffer>(
+            buffer.get_buffer(), buffer.get_num_channels(), buffer.get_rect()));
+  }
+}
+
+void FullFrameExecutionModel::determine_areas_to_render_and_reads(const int tile)
 {
   const bool is_rendering = context_.is_rendering();
   const bNodeTree *node_tree = context_.get_bnodetree();
@@ -56,7 +228,7 @@ void FullFrameExecutionModel::determine_areas_to_render_and_reads()
     for (NodeOperation *op : operations_) {
       op->set_bnodetree(node_tree);
       if (op->is_output_operation(is_rendering) && op->get_render_priority() == priority) {
-        get_output_render_area(op, area);
+        get_output_tile_area(op, tile, area);
         determine_areas_to_render(op, area);
         determine_reads(op);
       }
@@ -64,9 +236,23 @@ void FullFrameExecutionModel::determine_areas_to_render_and_reads()
   }
 }
 
-Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(NodeOperation *op,
-                                                                  const int output_x,
-                                                                  const int output_y)
+Vector<MemoryBuffer *> FullFrameExecutionModel::start_input_reads(
+    NodeOperation *op, Vector<IdleBufferCompression *> &r_compressions)
+{
+  const int num_inputs = op->get_number_of_input_sockets();
+  Vector<MemoryBuffer *> read_buffers(num_inputs);
+  for (int i = 0; i < num_inputs; i++) {
+    NodeOperation *input = op->get_input_operation(i);
+    read_buffers[i] = active_buffers_.read_started(input);
+    if (IdleBufferCompression *compression = active_buffers_.get_buffer_compression(input)) {
+      r_compressions.append_non_duplicates(compression);
+    }
+  }
+  return read_buffers;
+}
+
+Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(
+    NodeOperation *op, Span<MemoryBuffer *> read_buffers, const int output_x, const int output_y)
 {
   const int num_inputs = op->get_number_of_input_sockets();
   Vector<MemoryBuffer *> inputs_buffers(num_inputs);
@@ -74,7 +260,7 @@ Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(NodeOperation
     NodeOperation *input = op->get_input_operation(i);
     const int offset_x = (input->get_canvas().xmin - op->get_canvas().xmin) + output_x;
     const int offset_y = (input->get_canvas().ymin - op->get_canvas().ymin) + output_y;
-    MemoryBuffer *buf = active_buffers_.get_rendered_buffer(input);
+    MemoryBuffer *buf = read_buffers[i];
 
     rcti rect = buf->get_rect();
     BLI_rcti_translate(&rect, offset_x, offset_y);
@@ -94,7 +280,26 @@ MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op
 
   const DataType data_type = op->get_output_socket(0)->get_data_type();
   const bool is_a_single_elem = op->get_flags().is_constant_operation;
-  return new MemoryBuffer(data_type, rect, is_a_single_elem);
+  if (num_tiles_ == 1 || is_a_single_elem || whole_buffer_operations_.contains(op)) {
+    return new MemoryBuffer(data_type, rect, is_a_single_elem);
+  }
+
+  /* Only allocate the areas to render for the current tile. */
+  rcti areas_bounds;
+  BLI_rcti_init_minmax(&areas_bounds);
+  for (const rcti &area : active_buffers_.get_areas_to_render(
+           op, output_x - op->get_canvas().xmin, output_y - op->get_canvas().ymin))
+  {
+    BLI_rcti_union(&areas_bounds, &area);
+  }
+  if (BLI_rcti_is_empty(&areas_bounds)) {
+    /* Nothing is rendered for the current tile, readers may still sample it out of their
+     * areas of interest. */
+    MemoryBuffer *buf = new MemoryBuffer(data_type, rect, true);
+    buf->clear();
+    return buf;
+  }
+  return new MemoryBuffer(data_type, areas_bounds);
 }
 
 void FullFrameExecutionModel::render_operation(NodeOperation *op)
@@ -106,19 +311,49 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
   const timeit::TimePoint before_time = timeit::Clock::now();
 
   const bool has_outputs = op->get_number_of_output_sockets() > 0;
-  MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr;
-  if (op->get_width() > 0 && op->get_height() > 0) {
-    Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, output_x, output_y);
-    const int op_offset_x = output_x - op->get_canvas().xmin;
-    const int op_offset_y = output_y - op->get_canvas().ymin;
-    Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
+  const bool has_resolution = op->get_width() > 0 && op->get_height() > 0;
+  MemoryBuffer *op_buf = nullptr;
+  Vector<MemoryBuffer *> read_bufs;
+  Vector<IdleBufferCompression *> read_compressions;
+  Vector<rcti> areas;
+  bool use_results_cache = false;
+  {
+    std::scoped_lock lock(mutex_);
+    if (has_outputs) {
+      op_buf = create_operation_buffer(op, output_x, output_y);
+      use_results_cache = operations_to_cache_.contains(op) &&
+                          active_buffers_.is_area_registered(op, op->get_canvas());
+    }
+    /* Inputs reads are started even without resolution, they are finished along with the
+     * operation. */
+    read_bufs = start_input_reads(op, read_compressions);
+    if (has_resolution) {
+      const int op_offset_x = output_x - op->get_canvas().xmin;
+      const int op_offset_y = output_y - op->get_canvas().ymin;
+      areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
+    }
+  }
+  /* Compressed inputs are decompressed without holding the lock. */
+  for (IdleBufferCompression *compression : read_compressions) {
+    compression->decompress();
+  }
+  Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, read_bufs, output_x, output_y);
+  if (has_resolution) {
     op->render(op_buf, areas, input_bufs);
-    DebugInfo::operation_rendered(op, op_buf);
 
-    for (MemoryBuffer *buf : input_bufs) {
-      delete buf;
+    if (use_results_cache && !op->is_braked()) {
+      ResultsCache::add(cache_keys_.lookup(op), *op_buf);
     }
   }
+  for (MemoryBuffer *buf : input_bufs) {
+    delete buf;
+  }
+
+  std::scoped_lock lock(mutex_);
+  if (has_resolution) {
+    DebugInfo::operation_rendered(op, op_buf);
+  }
+
   /* Even if operation has no resolution set the empty buffer. It will be clipped with a
    * TranslateOperation from convert resolutions if linked to an operation with resolution. */
   active_buffers_.set_rendered_buffer(op, std::unique_ptr<MemoryBuffer>(op_buf));
@@ -138,7 +373,6 @@ void FullFrameExecutionModel::render_operations()
 {
   const bool is_rendering = context_.is_rendering();
 
-  WorkScheduler::start();
   for (eCompositorPriority priority : priorities_) {
     for (NodeOperation *op : operations_) {
       const bool has_size = op->get_width() > 0 && op->get_height() > 0;
@@ -147,51 +381,136 @@ void FullFrameExecutionModel::render_operations()
       if (is_priority_output && has_size) {
         render_output_dependencies(op);
         render_operation(op);
+        compress_idle_buffers(op);
       }
       else if (is_priority_output && !has_size && op->is_active_viewer_output()) {
         static_cast<ViewerOperation *>(op)->clear_display_buffer();
       }
     }
   }
-  WorkScheduler::stop();
 }
 
 /**
- * Returns all dependencies from inputs to outputs. A dependency may be repeated when
- * several operations depend on it.
+ * Operations which are yet to be rendered for an output operation, linked to the operations
+ * reading them.
  */
-static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation)
+struct DependenciesGraph {
+  /**
+   * Every operation being rendered keeps its output and input buffers alive, so limit how many
+   * run at the same time to bound peak memory usage. Concurrency only helps while a single
+   * operation does not scale to all devices, which a few operations are enough for.
+   */
+  static constexpr int max_running_operations = 4;
+
+  FullFrameExecutionModel *model;
+  std::mutex mutex;
+  /** Number of inputs of every operation which are not rendered yet. */
+  Map<NodeOperation *, int> num_pending_inputs;
+  /** Operations reading every operation, repeated when reading it from several inputs. */
+  MultiValueMap<NodeOperation *, NodeOperation *> readers;
+  /**
+   * Operations whose inputs are all rendered, waiting for a free slot. The last one is rendered
+   * first, so that readers are rendered right after their inputs and those can be freed early.
+   */
+  Vector<NodeOperation *> ready;
+  int num_running = 0;
+};
+
+void FullFrameExecutionModel::push_ready_operations(TaskPool *pool)
 {
-  /* Get dependencies from outputs to inputs. */
-  Vector<NodeOperation *> dependencies;
-  Vector<NodeOperation *> next_outputs;
-  next_outputs.append(operation);
-  while (next_outputs.size() > 0) {
-    Vector<NodeOperation *> outputs(next_outputs);
-    next_outputs.clear();
-    for (NodeOperation *output : outputs) {
-      for (int i = 0; i < output->get_number_of_input_sockets(); i++) {
-        next_outputs.append(output->get_input_operation(i));
-      }
+  DependenciesGraph &graph = *static_cast<DependenciesGraph *>(BLI_task_pool_user_data(pool));
+  Vector<NodeOperation *> ops;
+  {
+    std::scoped_lock lock(graph.mutex);
+    while (graph.num_running < DependenciesGraph::max_running_operations &&
+           !graph.ready.is_empty())
+    {
+      ops.append(graph.ready.pop_last());
+      graph.num_running++;
     }
-    dependencies.extend(next_outputs);
   }
+  for (NodeOperation *op : ops) {
+    BLI_task_pool_push(pool, render_dependency_task, op, false, nullptr);
+  }
+}
 
-  /* Reverse to get dependencies from inputs to outputs. */
-  std::reverse(dependencies.begin(), dependencies.end());
+void FullFrameExecutionModel::render_dependency_task(TaskPool *__restrict pool, void *task_data)
+{
+  DependenciesGraph &graph = *static_cast<DependenciesGraph *>(BLI_task_pool_user_data(pool));
+  NodeOperation *op = static_cast<NodeOperation *>(task_data);
+
+  graph.model->render_operation(op);
+
+  /* Readers of which this was the last input to be rendered are ready. */
+  Vector<NodeOperation *> ready_readers;
+  {
+    std::scoped_lock lock(graph.mutex);
+    for (NodeOperation *reader : graph.readers.lookup(op)) {
+      int &num_pending_inputs = graph.num_pending_inputs.lookup(reader);
+      num_pending_inputs--;
+      if (num_pending_inputs == 0) {
+        ready_readers.append(reader);
+      }
+    }
+  }
+  graph.model->schedule_reads(ready_readers);
+  {
+    std::scoped_lock lock(graph.mutex);
+    graph.ready.extend(ready_readers);
+    graph.num_running--;
+  }
+  push_ready_operations(pool);
 
-  return dependencies;
+  graph.model->compress_idle_buffers(op);
 }
 
 void FullFrameExecutionModel::render_output_dependencies(NodeOperation *output_op)
 {
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
-  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op);
-  for (NodeOperation *op : dependencies) {
-    if (!active_buffers_.is_operation_rendered(op)) {
-      render_operation(op);
+
+  /* Gather operations to render. Inputs of rendered operations are not needed, they are either
+   * rendered too or their readers buffers were kept from a previous tile. */
+  DependenciesGraph graph;
+  graph.model = this;
+  Vector<NodeOperation *> stack;
+  stack.append(output_op);
+  while (stack.size() > 0) {
+    NodeOperation *operation = stack.pop_last();
+    for (int i = 0; i < operation->get_number_of_input_sockets(); i++) {
+      NodeOperation *input_op = operation->get_input_operation(i);
+      if (!active_buffers_.is_operation_rendered(input_op) &&
+          graph.num_pending_inputs.add(input_op, 0))
+      {
+        stack.append(input_op);
+      }
     }
   }
+  for (MutableMapItem<NodeOperation *, int> item : graph.num_pending_inputs.items()) {
+    NodeOperation *op = item.key;
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperation *input_op = op->get_input_operation(i);
+      if (graph.num_pending_inputs.contains(input_op)) {
+        item.value++;
+        graph.readers.add(input_op, op);
+      }
+    }
+  }
+
+  /* Operations are rendered in worker threads, while their work is split between the compositor
+   * devices as usual. This keeps the devices busy with independent operations, when a single
+   * operation does not scale to all of them. */
+  Vector<NodeOperation *> ready_ops;
+  for (MapItem<NodeOperation *, int> item : graph.num_pending_inputs.items()) {
+    if (item.value == 0) {
+      ready_ops.append(item.key);
+    }
+  }
+  schedule_reads(ready_ops);
+  graph.ready = std::move(ready_ops);
+  TaskPool *pool = BLI_task_pool_create(&graph, TASK_PRIORITY_HIGH);
+  push_ready_operations(pool);
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
 }
 
 void FullFrameExecutionModel::determine_areas_to_render(NodeOperation *output_op,
@@ -238,7 +557,9 @@ void FullFrameExecutionModel::determine_reads(NodeOperation *output_op)
     const int num_inputs = operation->get_number_of_input_sockets();
     for (int i = 0; i < num_inputs; i++) {
       NodeOperation *input_op = operation->get_input_operation(i);
-      if (!active_buffers_.has_registered_reads(input_op)) {
+      if (!active_buffers_.has_registered_reads(input_op) &&
+          !active_buffers_.is_operation_rendered(input_op))
+      {
         stack.append(input_op);
       }
       active_buffers_.register_read(input_op);
@@ -272,6 +593,22 @@ void FullFrameExecutionModel::get_output_render_area(NodeOperation *output_op, r
   }
 }
 
+void FullFrameExecutionModel::get_output_tile_area(NodeOperation *output_op,
+                                                   const int tile,
+                                                   rcti &r_area)
+{
+  get_output_render_area(output_op, r_area);
+  if (num_tiles_ == 1) {
+    return;
+  }
+
+  /* Split in rows to keep buffers memory continuous. */
+  const int64_t height = BLI_rcti_size_y(&r_area);
+  const int ymin = r_area.ymin;
+  r_area.ymin = ymin + int(height * tile / num_tiles_);
+  r_area.ymax = ymin + int(height * (tile + 1) / num_tiles_);
+}
+
 void FullFrameExecutionModel::operation_finished(NodeOperation *operation)
 {
   /* Report inputs reads so that buffers may be freed/reused. */
@@ -284,18 +621,49 @@ void FullFrameExecutionModel::operation_finished(NodeOperation *operation)
   update_progress_bar();
 }
 
+void FullFrameExecutionModel::schedule_reads(Span<NodeOperation *> ops)
+{
+  std::scoped_lock lock(mutex_);
+  for (NodeOperation *op : ops) {
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      active_buffers_.read_scheduled(op->get_input_operation(i));
+    }
+  }
+}
+
+void FullFrameExecutionModel::compress_idle_buffers(NodeOperation *op)
+{
+  Vector<IdleBufferCompression *> compressions;
+  {
+    std::scoped_lock lock(mutex_);
+    auto add_idle_buffer = [&](NodeOperation *buffer_op) {
+      IdleBufferCompression *compression = active_buffers_.get_idle_buffer_compression(buffer_op);
+      if (compression) {
+        compressions.append_non_duplicates(compression);
+      }
+    };
+    add_idle_buffer(op);
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      add_idle_buffer(op->get_input_operation(i));
+    }
+  }
+  for (IdleBufferCompression *compression : compressions) {
+    compression->compress_if_unread();
+  }
+}
+
 void FullFrameExecutionModel::update_progress_bar()
 {
   const bNodeTree *tree = context_.get_bnodetree();
   if (tree) {
-    const float progress = num_operations_finished_ / float(operations_.size());
+    const float progress = num_operations_finished_ / float(operations_.size() * num_tiles_);
     tree->runtime->progress(tree->runtime->prh, progress);
 
     char buf[128];
     SNPRINTF(buf,
              RPT_("Compositing | Operation %i-%li"),
              num_operations_finished_ + 1,
-             operations_.size());
+             operations_.size() * num_tiles_);
     tree->runtime->stats_draw(tree->runtime->sdh, buf);
   }
 }
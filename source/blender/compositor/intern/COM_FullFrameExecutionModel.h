@@ -4,6 +4,11 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+
+#include "BLI_map.hh"
+#include "BLI_set.hh"
 #include "BLI_vector.hh"
 
 #include "COM_Enums.h"
@@ -13,9 +18,12 @@
 #  include "MEM_guardedalloc.h"
 #endif
 
+struct TaskPool;
+
 namespace blender::compositor {
 
 /* Forward declarations. */
+class IdleBufferCompression;
 class CompositorContext;
 class ExecutionSystem;
 class MemoryBuffer;
@@ -43,6 +51,44 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<eCompositorPriority> priorities_;
 
+  /**
+   * Number of tiles output operations are split into to stay within the compositor memory limit.
+   * Tiles are rendered one after another, allocating operations buffers for the areas needed by
+   * the current tile only.
+   */
+  int num_tiles_;
+
+  /**
+   * Operations read by operations that may sample them outside of their areas of interest, see
+   * #find_whole_buffer_operations. Their buffers cover their whole canvas in every tile.
+   */
+  Set<NodeOperation *> whole_buffer_operations_;
+
+  /**
+   * Keys identifying operations results across executions, for operations whose result can be
+   * cached. See #ResultsCache.
+   */
+  Map<NodeOperation *, uint64_t> cache_keys_;
+
+  /**
+   * Operations whose buffers are added to the results cache once rendered. These are the
+   * operations with a key read by operations without one, so the last operations of branches
+   * that may not change between executions.
+   */
+  Set<NodeOperation *> operations_to_cache_;
+
+  /**
+   * Buffers found in the results cache, used instead of rendering their operations.
+   */
+  Map<NodeOperation *, std::shared_ptr<MemoryBuffer>> cached_buffers_;
+
+  /**
+   * Guards active buffers, progress and profiler updates while independent operations are
+   * rendered concurrently. Idle buffers are compressed and decompressed without holding it,
+   * see #IdleBufferCompression.
+   */
+  std::mutex mutex_;
+
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
@@ -50,28 +96,91 @@ class FullFrameExecutionModel : public ExecutionModel {
 
   void execute(ExecutionSystem &exec_system) override;
 
+  /**
+   * Finds the operations having a reader that doesn't compute its output pixels from the input
+   * pixels at the same positions only. Such readers (transforms, distortions, filters...) may
+   * read their inputs outside of their areas of interest, so the buffers of these operations
+   * can't be restricted to the areas needed by a tile. Output operations other than previews
+   * write their input pixels as they are.
+   */
+  static Set<NodeOperation *> find_whole_buffer_operations(Span<NodeOperation *> operations,
+                                                           bool is_rendering);
+
+  /**
+   * Calculates the number of tiles needed for the operations buffers to fit the given memory
+   * limit in bytes. Buffers of \a whole_buffer_operations are not split into tiles, when they
+   * alone exceed the limit the maximum number of tiles is used, the limit can't be met.
+   */
+  static int calc_num_tiles(Span<NodeOperation *> operations,
+                            const Set<NodeOperation *> &whole_buffer_operations,
+                            int64_t memory_limit,
+                            bool is_rendering);
+
  private:
-  void determine_areas_to_render_and_reads();
+  /**
+   * Generates cache keys of operations and looks up their buffers in the results cache.
+   */
+  void lookup_cached_buffers();
+  /**
+   * Sets buffers found in the results cache as rendered, so that their operations and inputs are
+   * not rendered.
+   */
+  void use_cached_buffers();
+  void determine_areas_to_render_and_reads(int tile);
   /**
    * Render output operations in order of priority.
    */
   void render_operations();
+  /**
+   * Render all operations the output operation depends on. Operations which do not depend on each
+   * other are rendered concurrently, as soon as all their inputs are rendered.
+   */
   void render_output_dependencies(NodeOperation *output_op);
+  static void render_dependency_task(TaskPool *__restrict pool, void *task_data);
+  /**
+   * Push operations which are ready to be rendered to the pool, as long as the number of
+   * operations rendered at the same time allows it.
+   */
+  static void push_ready_operations(TaskPool *pool);
+  /**
+   * Starts the reads of the inputs of given operation and returns their buffers. Buffers that may
+   * be compressed have their compression added to \a r_compressions, to be decompressed once the
+   * lock is released. Must be called with the lock held.
+   */
+  Vector<MemoryBuffer *> start_input_reads(NodeOperation *op,
+                                           Vector<IdleBufferCompression *> &r_compressions);
   /**
    * Returns input buffers with an offset relative to given output coordinates.
    * Returned memory buffers must be deleted.
    */
-  Vector<MemoryBuffer *> get_input_buffers(NodeOperation *op, int output_x, int output_y);
+  Vector<MemoryBuffer *> get_input_buffers(NodeOperation *op,
+                                           Span<MemoryBuffer *> read_buffers,
+                                           int output_x,
+                                           int output_y);
   MemoryBuffer *create_operation_buffer(NodeOperation *op, int output_x, int output_y);
   void render_operation(NodeOperation *op);
 
   void operation_finished(NodeOperation *operation);
 
+  /**
+   * Reports the reads of the inputs of the given operations, which are ready to render.
+   */
+  void schedule_reads(Span<NodeOperation *> ops);
+  /**
+   * Compresses the buffers of the given rendered operation and of its inputs to half precision, if
+   * they wait for readers which are not ready to render. Must be called without the lock held.
+   */
+  void compress_idle_buffers(NodeOperation *op);
+
   /**
    * Calculates given output operation area to be rendered taking into account viewer and render
    * borders.
    */
   void get_output_render_area(NodeOperation *output_op, rcti &r_area);
+  /**
+   * Calculates the area of the given tile within the output operation render area.
+   */
+  void get_output_tile_area(NodeOperation *output_op, int tile, rcti &r_area);
   /**
    * Determines all operations areas needed to render given output area.
    */
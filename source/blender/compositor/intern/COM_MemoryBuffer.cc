@@ -2,8 +2,14 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <atomic>
+#include <cmath>
+
 #include "COM_MemoryBuffer.h"
 
+#include "BLI_math_half.hh"
+#include "BLI_task.hh"
+
 #include "IMB_colormanagement.hh"
 #include "IMB_imbuf_types.hh"
 
@@ -36,6 +42,7 @@ MemoryBuffer::MemoryBuffer(DataType data_type, int width, int height)
   buffer_ = (float *)MEM_mallocN_aligned(
       sizeof(float) * buffer_len() * num_channels_, 16, "COM_MemoryBuffer");
   owns_data_ = true;
+  half_buffer_ = nullptr;
   datatype_ = data_type;
 
   set_strides();
@@ -49,6 +56,7 @@ MemoryBuffer::MemoryBuffer(DataType data_type, const rcti &rect, bool is_a_singl
   buffer_ = (float *)MEM_mallocN_aligned(
       sizeof(float) * buffer_len() * num_channels_, 16, "COM_MemoryBuffer");
   owns_data_ = true;
+  half_buffer_ = nullptr;
   datatype_ = data_type;
 
   set_strides();
@@ -71,6 +79,7 @@ MemoryBuffer::MemoryBuffer(float *buffer,
   datatype_ = COM_num_channels_data_type(num_channels);
   buffer_ = buffer;
   owns_data_ = false;
+  half_buffer_ = nullptr;
 
   set_strides();
 }
@@ -163,6 +172,76 @@ MemoryBuffer::~MemoryBuffer()
     MEM_freeN(buffer_);
     buffer_ = nullptr;
   }
+  if (half_buffer_) {
+    MEM_freeN(half_buffer_);
+    half_buffer_ = nullptr;
+  }
+}
+
+static constexpr int64_t HALF_FLOAT_CONVERSION_GRAIN_SIZE = 4096;
+/** Largest finite value of a half float. */
+static constexpr float HALF_FLOAT_MAX = 65504.0f;
+
+bool MemoryBuffer::convert_to_half_float()
+{
+  if (is_half_float()) {
+    return true;
+  }
+  if (!owns_data_) {
+    return false;
+  }
+
+  const int64_t size = buffer_len() * num_channels_;
+  half_buffer_ = (uint16_t *)MEM_mallocN_aligned(
+      sizeof(uint16_t) * size, 16, "COM_MemoryBuffer half");
+  std::atomic<bool> is_out_of_range = false;
+  /* Callers may be holding locks, so the conversion is isolated from other tasks which could
+   * otherwise be executed by the waiting threads and try to acquire them. */
+  threading::isolate_task([&]() {
+    threading::parallel_for(
+        IndexRange(size), HALF_FLOAT_CONVERSION_GRAIN_SIZE, [&](const IndexRange range) {
+          bool is_range_out_of_range = false;
+          for (const int64_t i : range) {
+            const float value = buffer_[i];
+            is_range_out_of_range |= std::isfinite(value) && std::abs(value) > HALF_FLOAT_MAX;
+            half_buffer_[i] = math::float_to_half(value);
+          }
+          if (is_range_out_of_range) {
+            is_out_of_range = true;
+          }
+        });
+  });
+
+  /* Keep data like depths which can't be represented in half precision as is. */
+  if (is_out_of_range) {
+    MEM_freeN(half_buffer_);
+    half_buffer_ = nullptr;
+    return false;
+  }
+
+  MEM_freeN(buffer_);
+  buffer_ = nullptr;
+  return true;
+}
+
+void MemoryBuffer::convert_to_full_float()
+{
+  if (!is_half_float()) {
+    return;
+  }
+
+  const int64_t size = buffer_len() * num_channels_;
+  buffer_ = (float *)MEM_mallocN_aligned(sizeof(float) * size, 16, "COM_MemoryBuffer");
+  threading::isolate_task([&]() {
+    threading::parallel_for(
+        IndexRange(size), HALF_FLOAT_CONVERSION_GRAIN_SIZE, [&](const IndexRange range) {
+          for (const int64_t i : range) {
+            buffer_[i] = math::half_to_float(half_buffer_[i]);
+          }
+        });
+  });
+  MEM_freeN(half_buffer_);
+  half_buffer_ = nullptr;
 }
 
 void MemoryBuffer::copy_from(const MemoryBuffer *src, const rcti &area)
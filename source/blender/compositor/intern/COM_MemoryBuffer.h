@@ -84,6 +84,12 @@ class MemoryBuffer {
    */
   bool owns_data_;
 
+  /**
+   * The data stored in half precision, while the float buffer is freed. See
+   * #convert_to_half_float.
+   */
+  uint16_t *half_buffer_;
+
   /** Stride to make any x coordinate within buffer positive (non-zero). */
   int to_positive_x_stride_;
 
@@ -133,6 +139,37 @@ class MemoryBuffer {
     return is_a_single_elem_;
   }
 
+  /**
+   * Whether the data is stored in half precision. Its elements can't be accessed until it is
+   * converted back to full precision.
+   */
+  bool is_half_float() const
+  {
+    return half_buffer_ != nullptr;
+  }
+
+  /**
+   * Store the data in half precision, which halves its memory while the buffer is not accessed.
+   * Buffers not owning their data are left as is, since their data would not be freed anyway, and
+   * so are buffers with values beyond the range of half floats.
+   * \return Whether the data is stored in half precision.
+   */
+  bool convert_to_half_float();
+
+  /**
+   * Store the data back in full precision, so that its elements can be accessed again.
+   */
+  void convert_to_full_float();
+
+  /**
+   * Size in bytes of the stored data, which is halved while it is stored in half precision.
+   */
+  int64_t get_memory_size() const
+  {
+    const int64_t element_size = is_half_float() ? sizeof(uint16_t) : sizeof(float);
+    return buffer_len() * num_channels_ * element_size;
+  }
+
   float &operator[](int index)
   {
     BLI_assert(is_a_single_elem_ ? index < num_channels_ :
@@ -366,6 +403,7 @@ class MemoryBuffer {
    */
   float *get_buffer()
   {
+    BLI_assert(!is_half_float());
     return buffer_;
   }
 
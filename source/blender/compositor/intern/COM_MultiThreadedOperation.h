@@ -47,6 +47,9 @@ class MultiThreadedOperation : public NodeOperation {
   {
   }
 
+  /* Evaluates fused operations directly, without going through #update_memory_buffer. */
+  friend class FusedOperation;
+
  private:
   void update_memory_buffer(MemoryBuffer *output,
                             const rcti &area,
@@ -84,6 +84,40 @@ std::optional<NodeOperationHash> NodeOperation::generate_hash()
   return hash;
 }
 
+std::optional<uint64_t> NodeOperation::generate_cache_key(
+    const Map<NodeOperation *, uint64_t> &input_keys)
+{
+  const std::optional<NodeOperationHash> hash = generate_hash();
+  if (!hash) {
+    return std::nullopt;
+  }
+
+  size_t key = hash->type_hash_;
+  combine_hashes(key, hash->params_hash_);
+  for (NodeOperationInput &socket : inputs_) {
+    if (!socket.is_connected()) {
+      continue;
+    }
+
+    NodeOperation &input = socket.get_link()->get_operation();
+    if (input.get_flags().is_constant_operation) {
+      const float *elem = ((ConstantOperation *)&input)->get_constant_elem();
+      const int num_channels = COM_data_type_num_channels(socket.get_data_type());
+      for (const int i : IndexRange(num_channels)) {
+        combine_hashes(key, get_default_hash(elem[i]));
+      }
+      continue;
+    }
+
+    const uint64_t *input_key = input_keys.lookup_ptr(&input);
+    if (input_key == nullptr) {
+      return std::nullopt;
+    }
+    combine_hashes(key, *input_key);
+  }
+  return key;
+}
+
 NodeOperationOutput *NodeOperation::get_output_socket(uint index)
 {
   return &outputs_[index];
@@ -9,6 +9,7 @@
 
 #include "BLI_ghash.h"
 #include "BLI_hash.hh"
+#include "BLI_map.hh"
 #include "BLI_math_base.hh"
 #include "BLI_rect.h"
 #include "BLI_span.hh"
@@ -206,6 +207,21 @@ struct NodeOperationFlags {
    */
   bool can_be_constant : 1;
 
+  /**
+   * Whether operation computes every output pixel in a single pass, only reading input pixels at
+   * the same position. Chains of such operations are fused into a single #FusedOperation, which
+   * does not need full-frame buffers for intermediate results. Only valid for
+   * #MultiThreadedOperation subclasses.
+   */
+  bool can_be_fused : 1;
+
+  /**
+   * Whether the output buffer is never compressed to half precision while waiting for its
+   * readers, see #SharedOperationBuffers::set_compress_idle_buffers. Used for outputs holding data
+   * which half floats can't represent accurately, like depths or positions.
+   */
+  bool use_lossless_idle_buffer : 1;
+
   NodeOperationFlags()
   {
     use_render_border = false;
@@ -217,6 +233,8 @@ struct NodeOperationFlags {
     use_datatype_conversion = true;
     is_constant_operation = false;
     can_be_constant = false;
+    can_be_fused = false;
+    use_lossless_idle_buffer = false;
   }
 };
 
@@ -345,6 +363,15 @@ class NodeOperation {
    */
   std::optional<NodeOperationHash> generate_hash();
 
+  /**
+   * Generate a key that identifies the operation result across executions, used by the results
+   * cache. Unlike #generate_hash, linked operations are identified by their own keys in
+   * \a input_keys instead of their ids in the current execution, so `hash_output_params` must
+   * hash everything that may change the result between executions, such as the frame number.
+   * Returns `std::nullopt` when the operation or any of its non-constant inputs has no key.
+   */
+  std::optional<uint64_t> generate_cache_key(const Map<NodeOperation *, uint64_t> &input_keys);
+
   unsigned int get_number_of_input_sockets() const
   {
     return inputs_.size();
@@ -11,6 +11,7 @@
 #include "COM_Converter.h"
 #include "COM_Debug.h"
 
+#include "COM_FusedOperation.h"
 #include "COM_PreviewOperation.h"
 #include "COM_SetColorOperation.h"
 #include "COM_SetValueOperation.h"
@@ -90,6 +91,9 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
   save_graphviz("compositor_prior_merging");
   merge_equal_operations();
 
+  save_graphviz("compositor_prior_fusing");
+  fuse_operations();
+
   /* links not available from here on */
   /* XXX make links_ a local variable to avoid confusion! */
   links_.clear();
@@ -493,6 +497,101 @@ void NodeOperationBuilder::merge_equal_operations(NodeOperation *from, NodeOpera
   delete from;
 }
 
+static bool is_fusable_operation(NodeOperation *operation, const bool is_rendering)
+{
+  return operation->get_flags().can_be_fused && !operation->get_flags().is_constant_operation &&
+         !operation->is_output_operation(is_rendering) &&
+         operation->get_number_of_output_sockets() == 1;
+}
+
+void NodeOperationBuilder::fuse_operations()
+{
+  const bool is_rendering = context_->is_rendering();
+
+  /* Operations reading the output of every operation. */
+  MultiValueMap<NodeOperation *, NodeOperation *> readers;
+  for (const Link &link : links_) {
+    readers.add(&link.from()->get_operation(), &link.to()->get_operation());
+  }
+
+  /* An operation is fused into its reader when the reader is the only operation using its result,
+   * and both compute the same area. */
+  const auto is_fused_into_reader = [&](NodeOperation *operation) {
+    if (!is_fusable_operation(operation, is_rendering)) {
+      return false;
+    }
+    const Span<NodeOperation *> operation_readers = readers.lookup(operation);
+    if (operation_readers.size() != 1) {
+      return false;
+    }
+    NodeOperation *reader = operation_readers.first();
+    return is_fusable_operation(reader, is_rendering) &&
+           BLI_rcti_compare(&operation->get_canvas(), &reader->get_canvas());
+  };
+
+  Vector<NodeOperation *> roots;
+  for (NodeOperation *operation : operations_) {
+    if (is_fusable_operation(operation, is_rendering) && !is_fused_into_reader(operation)) {
+      roots.append(operation);
+    }
+  }
+
+  for (NodeOperation *root : roots) {
+    /* Gather the operations fused into the root, every operation after its inputs. */
+    Vector<MultiThreadedOperation *> stages;
+    Vector<std::pair<NodeOperation *, int>> stack;
+    stack.append({root, 0});
+    while (!stack.is_empty()) {
+      auto &[operation, next_input] = stack.last();
+      if (next_input == operation->get_number_of_input_sockets()) {
+        stages.append(static_cast<MultiThreadedOperation *>(operation));
+        stack.remove_last();
+        continue;
+      }
+      NodeOperation *input_op = operation->get_input_operation(next_input++);
+      if (is_fused_into_reader(input_op)) {
+        stack.append({input_op, 0});
+      }
+    }
+
+    if (stages.size() < 2) {
+      continue;
+    }
+
+    FusedOperation *fused_op = new FusedOperation(stages);
+    fused_op->set_name(root->get_name());
+    fused_op->set_node_instance_key(root->get_node_instance_key());
+    fused_op->set_canvas(root->get_canvas());
+    add_operation(fused_op);
+
+    /* Read the inputs of the fused tree from the fused operation sockets. */
+    for (int i = 0; i < fused_op->get_number_of_input_sockets(); i++) {
+      NodeOperationInput *stage_input = fused_op->get_stage_input(i);
+      NodeOperationOutput *from = stage_input->get_link();
+      remove_input_link(stage_input);
+      add_link(from, fused_op->get_input_socket(i));
+    }
+
+    /* Pass the result of the fused tree to the readers of the root. */
+    for (NodeOperationInput *to : cache_output_links(root->get_output_socket())) {
+      remove_input_link(to);
+      add_link(fused_op->get_output_socket(), to);
+    }
+
+    /* Links between the stages are not seen by the execution system anymore, and the stages are
+     * owned by the fused operation. */
+    for (MultiThreadedOperation *stage : stages) {
+      for (int i = 0; i < stage->get_number_of_input_sockets(); i++) {
+        if (stage->get_input_socket(i)->is_connected()) {
+          remove_input_link(stage->get_input_socket(i));
+        }
+      }
+      stage->set_bnodetree(context_->get_bnodetree());
+      operations_.remove_first_occurrence_and_reorder(stage);
+    }
+  }
+}
+
 Vector<NodeOperationInput *> NodeOperationBuilder::cache_output_links(
     NodeOperationOutput *output) const
 {
@@ -0,0 +1,317 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "BLI_fileops.h"
+#include "BLI_map.hh"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_vector.hh"
+
+#include "BKE_appdir.hh"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_ResultsCache.h"
+
+namespace blender::compositor {
+
+struct CachedBuffer {
+  /** Null when the buffer was moved to disk. */
+  std::shared_ptr<MemoryBuffer> buffer;
+  int num_channels;
+  rcti rect;
+  int64_t size;
+  /** Use counter of the cache when the buffer was last used, least recently used are removed
+   * first. */
+  uint64_t last_use;
+  /** Non-zero while the buffer is written to disk outside of the lock, the buffer stays in
+   * memory until then but is not counted in the memory usage anymore. */
+  uint64_t write_id = 0;
+  /** Whether the buffer is read back from disk outside of the lock, its file is not removed until
+   * then. */
+  bool is_reading = false;
+};
+
+/** A buffer that is moved to disk, written once the lock is released. */
+struct PendingWrite {
+  uint64_t key;
+  uint64_t write_id;
+  std::shared_ptr<MemoryBuffer> buffer;
+  int64_t size;
+};
+
+static struct {
+  std::mutex mutex;
+  Map<uint64_t, CachedBuffer> buffers;
+  int64_t memory_limit = 0;
+  int64_t disk_limit = 0;
+  int64_t memory_usage = 0;
+  int64_t disk_usage = 0;
+  uint64_t use_counter = 0;
+} g_results_cache;
+
+static int64_t get_buffer_size(const MemoryBuffer &buffer)
+{
+  return int64_t(buffer.get_memory_width()) * buffer.get_memory_height() *
+         buffer.get_num_channels() * sizeof(float);
+}
+
+static std::string get_cache_filepath(const uint64_t key)
+{
+  char filename[64];
+  SNPRINTF(filename, "compositor_cache_%016" PRIx64 ".bin", key);
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath, sizeof(filepath), BKE_tempdir_session(), filename);
+  return filepath;
+}
+
+static bool write_to_disk(const PendingWrite &pending)
+{
+  const std::string filepath = get_cache_filepath(pending.key);
+  FILE *file = BLI_fopen(filepath.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  const size_t num_floats = size_t(pending.size / sizeof(float));
+  const bool is_written = fwrite(pending.buffer->get_buffer(), sizeof(float), num_floats, file) ==
+                          num_floats;
+  fclose(file);
+  if (!is_written) {
+    BLI_delete(filepath.c_str(), false, false);
+  }
+  return is_written;
+}
+
+static std::shared_ptr<MemoryBuffer> read_from_disk(const uint64_t key, const CachedBuffer &cached)
+{
+  const std::string filepath = get_cache_filepath(key);
+  FILE *file = BLI_fopen(filepath.c_str(), "rb");
+  if (file == nullptr) {
+    return nullptr;
+  }
+  std::shared_ptr<MemoryBuffer> buffer = std::make_shared<MemoryBuffer>(
+      COM_num_channels_data_type(cached.num_channels), cached.rect);
+  const size_t num_floats = size_t(cached.size / sizeof(float));
+  const bool is_read = fread(buffer->get_buffer(), sizeof(float), num_floats, file) == num_floats;
+  fclose(file);
+  return is_read ? buffer : nullptr;
+}
+
+static void remove_cached_buffer(const uint64_t key)
+{
+  const CachedBuffer cached = g_results_cache.buffers.pop(key);
+  if (cached.buffer) {
+    /* Buffers that are being written were already removed from the memory usage, their file is
+     * deleted once the write is done. */
+    if (cached.write_id == 0) {
+      g_results_cache.memory_usage -= cached.size;
+    }
+  }
+  else {
+    g_results_cache.disk_usage -= cached.size;
+    BLI_delete(get_cache_filepath(key).c_str(), false, false);
+  }
+}
+
+/** Returns the least recently used buffer, either in memory or on disk. */
+static std::optional<uint64_t> find_least_recently_used(const bool in_memory)
+{
+  std::optional<uint64_t> lru_key;
+  uint64_t lru_use = UINT64_MAX;
+  for (MapItem<uint64_t, CachedBuffer> item : g_results_cache.buffers.items()) {
+    if (bool(item.value.buffer) == in_memory && item.value.write_id == 0 &&
+        !item.value.is_reading && item.value.last_use < lru_use)
+    {
+      lru_key = item.key;
+      lru_use = item.value.last_use;
+    }
+  }
+  return lru_key;
+}
+
+static void enforce_disk_limit()
+{
+  while (g_results_cache.disk_usage > g_results_cache.disk_limit) {
+    const std::optional<uint64_t> key = find_least_recently_used(false);
+    if (!key) {
+      /* Only buffers being read remain on disk, they are moved to memory once read. */
+      break;
+    }
+    remove_cached_buffer(*key);
+  }
+}
+
+/**
+ * Must be called with the lock held. Buffers that exceed the memory limit are either removed or
+ * returned to be written to disk with #write_pending_to_disk once the lock is released, so other
+ * operations don't wait for the file I/O.
+ */
+[[nodiscard]] static Vector<PendingWrite> enforce_limits()
+{
+  Vector<PendingWrite> pending_writes;
+  while (g_results_cache.memory_usage > g_results_cache.memory_limit) {
+    const uint64_t key = *find_least_recently_used(true);
+    CachedBuffer &cached = g_results_cache.buffers.lookup(key);
+    if (cached.size > g_results_cache.disk_limit) {
+      remove_cached_buffer(key);
+      continue;
+    }
+    cached.write_id = ++g_results_cache.use_counter;
+    g_results_cache.memory_usage -= cached.size;
+    pending_writes.append({key, cached.write_id, cached.buffer, cached.size});
+  }
+  enforce_disk_limit();
+  return pending_writes;
+}
+
+/** Must be called without the lock held. */
+static void write_pending_to_disk(const Span<PendingWrite> pending_writes)
+{
+  for (const PendingWrite &pending : pending_writes) {
+    const bool is_written = write_to_disk(pending);
+
+    std::scoped_lock lock(g_results_cache.mutex);
+    CachedBuffer *cached = g_results_cache.buffers.lookup_ptr(pending.key);
+    if (cached == nullptr || cached->write_id != pending.write_id) {
+      /* Removed while writing, or replaced by a buffer that is still in memory. */
+      if (is_written && (cached == nullptr || (cached->buffer && cached->write_id == 0))) {
+        BLI_delete(get_cache_filepath(pending.key).c_str(), false, false);
+      }
+      continue;
+    }
+    if (!is_written) {
+      remove_cached_buffer(pending.key);
+      continue;
+    }
+    cached->buffer.reset();
+    cached->write_id = 0;
+    g_results_cache.disk_usage += cached->size;
+    enforce_disk_limit();
+  }
+}
+
+static void clear_cached_buffers()
+{
+  for (MapItem<uint64_t, CachedBuffer> item : g_results_cache.buffers.items()) {
+    if (!item.value.buffer) {
+      BLI_delete(get_cache_filepath(item.key).c_str(), false, false);
+    }
+  }
+  g_results_cache.buffers.clear();
+  g_results_cache.memory_usage = 0;
+  g_results_cache.disk_usage = 0;
+}
+
+void ResultsCache::set_limits(const int64_t memory_limit, const int64_t disk_limit)
+{
+  Vector<PendingWrite> pending_writes;
+  {
+    std::scoped_lock lock(g_results_cache.mutex);
+    g_results_cache.memory_limit = memory_limit;
+    g_results_cache.disk_limit = disk_limit;
+    if (memory_limit == 0) {
+      clear_cached_buffers();
+    }
+    else {
+      pending_writes = enforce_limits();
+    }
+  }
+  write_pending_to_disk(pending_writes);
+}
+
+bool ResultsCache::is_enabled()
+{
+  std::scoped_lock lock(g_results_cache.mutex);
+  return g_results_cache.memory_limit > 0;
+}
+
+std::shared_ptr<MemoryBuffer> ResultsCache::lookup(const uint64_t key)
+{
+  CachedBuffer on_disk;
+  {
+    std::scoped_lock lock(g_results_cache.mutex);
+    CachedBuffer *cached = g_results_cache.buffers.lookup_ptr(key);
+    if (cached == nullptr || cached->is_reading) {
+      /* Buffers being read by another lookup are missing until they are in memory. */
+      return nullptr;
+    }
+
+    cached->last_use = ++g_results_cache.use_counter;
+    if (cached->buffer) {
+      return cached->buffer;
+    }
+    cached->is_reading = true;
+    on_disk = *cached;
+  }
+
+  /* Read outside of the lock, other operations may be using the cache in the meantime. */
+  std::shared_ptr<MemoryBuffer> buffer = read_from_disk(key, on_disk);
+
+  Vector<PendingWrite> pending_writes;
+  {
+    std::scoped_lock lock(g_results_cache.mutex);
+    CachedBuffer *cached = g_results_cache.buffers.lookup_ptr(key);
+    if (cached == nullptr || !cached->is_reading) {
+      /* The cache was cleared while reading, the buffer is still valid but not kept. */
+      return buffer;
+    }
+    cached->is_reading = false;
+    remove_cached_buffer(key);
+    if (buffer == nullptr) {
+      return nullptr;
+    }
+
+    /* Move the buffer back to memory. */
+    on_disk.buffer = buffer;
+    on_disk.is_reading = false;
+    g_results_cache.buffers.add_new(key, on_disk);
+    g_results_cache.memory_usage += on_disk.size;
+    pending_writes = enforce_limits();
+  }
+  write_pending_to_disk(pending_writes);
+  return buffer;
+}
+
+void ResultsCache::add(const uint64_t key, const MemoryBuffer &buffer)
+{
+  const int64_t size = get_buffer_size(buffer);
+  {
+    std::scoped_lock lock(g_results_cache.mutex);
+    if (size > g_results_cache.memory_limit || g_results_cache.buffers.contains(key)) {
+      return;
+    }
+  }
+
+  /* Copy outside of the lock, other operations may be using the cache in the meantime. */
+  CachedBuffer cached;
+  cached.buffer = std::make_shared<MemoryBuffer>(buffer);
+  cached.num_channels = buffer.get_num_channels();
+  cached.rect = buffer.get_rect();
+  cached.size = size;
+
+  Vector<PendingWrite> pending_writes;
+  {
+    std::scoped_lock lock(g_results_cache.mutex);
+    if (!g_results_cache.buffers.contains(key)) {
+      cached.last_use = ++g_results_cache.use_counter;
+      g_results_cache.buffers.add_new(key, std::move(cached));
+      g_results_cache.memory_usage += size;
+      pending_writes = enforce_limits();
+    }
+  }
+  write_pending_to_disk(pending_writes);
+}
+
+void ResultsCache::clear()
+{
+  std::scoped_lock lock(g_results_cache.mutex);
+  clear_cached_buffers();
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,61 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+
+/**
+ * \brief Cache of operations rendered buffers kept across compositor executions.
+ *
+ * Branches of the node tree whose inputs do not change between executions, for example between
+ * the frames of an animation, are not rendered again. Buffers are identified by keys generated
+ * from the operations params and the keys of their inputs, see
+ * #NodeOperation::generate_cache_key.
+ *
+ * Least recently used buffers are written to disk when exceeding the memory limit, and removed
+ * when exceeding the disk limit.
+ * \ingroup execution
+ */
+struct ResultsCache {
+  /**
+   * \brief Set the cache limits in bytes, removing buffers exceeding them.
+   * A zero memory limit disables the cache, a zero disk limit keeps buffers in memory only.
+   */
+  static void set_limits(int64_t memory_limit, int64_t disk_limit);
+
+  static bool is_enabled();
+
+  /**
+   * \brief Get the buffer cached for the given key, reading it from disk when needed.
+   * Returns null when there is no buffer for the key. The returned buffer stays valid while
+   * referenced, even when it is removed from the cache in the meantime.
+   */
+  static std::shared_ptr<MemoryBuffer> lookup(uint64_t key);
+
+  /**
+   * \brief Add a copy of the given buffer to the cache.
+   */
+  static void add(uint64_t key, const MemoryBuffer &buffer);
+
+  /**
+   * \brief Remove all cached buffers, from memory and disk.
+   */
+  static void clear();
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:ResultsCache")
+#endif
+};
+
+}  // namespace blender::compositor
@@ -3,15 +3,63 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "COM_SharedOperationBuffers.h"
+#include "COM_MemoryBuffer.h"
 #include "COM_NodeOperation.h"
 
 namespace blender::compositor {
 
 SharedOperationBuffers::BufferData::BufferData()
-    : buffer(nullptr), registered_reads(0), received_reads(0), is_rendered(false)
+    : buffer(nullptr),
+      registered_reads(0),
+      received_reads(0),
+      is_rendered(false),
+      is_kept(false),
+      scheduled_reads(0),
+      compression(nullptr)
 {
 }
 
+void IdleBufferCompression::decompress()
+{
+  std::scoped_lock lock(mutex_);
+  BLI_assert(num_reads_ > 0);
+  if (buffer_) {
+    buffer_->convert_to_full_float();
+  }
+}
+
+void IdleBufferCompression::compress_if_unread()
+{
+  std::scoped_lock lock(mutex_);
+  if (buffer_ && num_reads_ == 0 && is_compressible_) {
+    /* Don't try again for buffers with values out of the half float range. */
+    is_compressible_ = buffer_->convert_to_half_float();
+  }
+}
+
+void SharedOperationBuffers::set_keep_whole_buffers(const bool keep_whole_buffers)
+{
+  keep_whole_buffers_ = keep_whole_buffers;
+}
+
+void SharedOperationBuffers::set_compress_idle_buffers(const bool compress_idle_buffers)
+{
+  compress_idle_buffers_ = compress_idle_buffers;
+}
+
+void SharedOperationBuffers::clear_partial_buffers()
+{
+  buffers_.remove_if([](MutableMapItem<NodeOperation *, BufferData> item) {
+    if (!item.value.is_kept) {
+      return true;
+    }
+    item.value.registered_reads = 0;
+    item.value.received_reads = 0;
+    item.value.scheduled_reads = 0;
+    return false;
+  });
+}
+
 SharedOperationBuffers::BufferData &SharedOperationBuffers::get_buffer_data(NodeOperation *op)
 {
   return buffers_.lookup_or_add_cb(op, []() { return BufferData(); });
@@ -72,6 +120,13 @@ void SharedOperationBuffers::set_rendered_buffer(NodeOperation *op,
   BLI_assert(buf_data.buffer == nullptr);
   buf_data.buffer = std::move(buffer);
   buf_data.is_rendered = true;
+  buf_data.is_kept = keep_whole_buffers_ && buf_data.buffer &&
+                     is_area_registered(op, op->get_canvas());
+  if (compress_idle_buffers_ && buf_data.buffer && !buf_data.buffer->is_a_single_elem() &&
+      !op->get_flags().use_lossless_idle_buffer)
+  {
+    buf_data.compression = std::make_unique<IdleBufferCompression>(buf_data.buffer.get());
+  }
 }
 
 MemoryBuffer *SharedOperationBuffers::get_rendered_buffer(NodeOperation *op)
@@ -80,15 +135,58 @@ MemoryBuffer *SharedOperationBuffers::get_rendered_buffer(NodeOperation *op)
   return get_buffer_data(op).buffer.get();
 }
 
+void SharedOperationBuffers::read_scheduled(NodeOperation *read_op)
+{
+  get_buffer_data(read_op).scheduled_reads++;
+}
+
+MemoryBuffer *SharedOperationBuffers::read_started(NodeOperation *read_op)
+{
+  BufferData &buf_data = get_buffer_data(read_op);
+  BLI_assert(buf_data.is_rendered);
+  /* Reads of output operations are started without being scheduled. */
+  if (buf_data.scheduled_reads > 0) {
+    buf_data.scheduled_reads--;
+  }
+  if (buf_data.compression) {
+    buf_data.compression->num_reads_++;
+  }
+  return buf_data.buffer.get();
+}
+
 void SharedOperationBuffers::read_finished(NodeOperation *read_op)
 {
   BufferData &buf_data = get_buffer_data(read_op);
   buf_data.received_reads++;
   BLI_assert(buf_data.received_reads > 0 && buf_data.received_reads <= buf_data.registered_reads);
-  if (buf_data.received_reads == buf_data.registered_reads) {
+  if (buf_data.compression) {
+    buf_data.compression->num_reads_--;
+    BLI_assert(buf_data.compression->num_reads_ >= 0);
+  }
+  if (buf_data.received_reads == buf_data.registered_reads && !buf_data.is_kept) {
     /* Dispose buffer. */
+    if (buf_data.compression) {
+      std::scoped_lock lock(buf_data.compression->mutex_);
+      buf_data.compression->buffer_ = nullptr;
+    }
     buf_data.buffer = nullptr;
   }
 }
 
+IdleBufferCompression *SharedOperationBuffers::get_buffer_compression(NodeOperation *op)
+{
+  return get_buffer_data(op).compression.get();
+}
+
+IdleBufferCompression *SharedOperationBuffers::get_idle_buffer_compression(NodeOperation *op)
+{
+  BufferData &buf_data = get_buffer_data(op);
+  if (!buf_data.compression || !buf_data.buffer || buf_data.compression->num_reads_ > 0 ||
+      buf_data.scheduled_reads > 0 || buf_data.received_reads >= buf_data.registered_reads)
+  {
+    return nullptr;
+  }
+  return buf_data.compression.get();
+}
+
 }  // namespace blender::compositor
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 #include "BLI_map.hh"
 #include "BLI_vector.hh"
 
@@ -18,6 +22,44 @@ namespace blender::compositor {
 class MemoryBuffer;
 class NodeOperation;
 
+/**
+ * Compresses a rendered buffer to half precision while it waits for its readers, and decompresses
+ * it back to full precision for them, see #SharedOperationBuffers::set_compress_idle_buffers. The
+ * conversions are done without holding the lock of the execution model, so they don't block
+ * operations rendered concurrently.
+ */
+class IdleBufferCompression {
+ private:
+  std::mutex mutex_;
+  /** Null once the buffer is disposed. */
+  MemoryBuffer *buffer_;
+  /** Number of operations reading the buffer, changed while holding the execution model lock. */
+  std::atomic<int> num_reads_ = 0;
+  /** Cleared when the buffer has values out of the range of half floats. */
+  bool is_compressible_ = true;
+
+  friend class SharedOperationBuffers;
+
+ public:
+  explicit IdleBufferCompression(MemoryBuffer *buffer) : buffer_(buffer) {}
+
+  /**
+   * Decompresses the buffer back to full precision for a read started with
+   * #SharedOperationBuffers::read_started, waiting for a compression in progress.
+   */
+  void decompress();
+
+  /**
+   * Compresses the buffer to half precision, unless it was disposed or a read was started since it
+   * was returned by #SharedOperationBuffers::get_idle_buffer_compression.
+   */
+  void compress_if_unread();
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:IdleBufferCompression")
+#endif
+};
+
 /**
  * Stores and shares operations rendered buffers including render data. Buffers are
  * disposed once all dependent operations have finished reading them.
@@ -32,10 +74,40 @@ class SharedOperationBuffers {
     int registered_reads;
     int received_reads;
     bool is_rendered;
+    /** Buffer is kept after all reads are received, see #set_keep_whole_buffers. */
+    bool is_kept;
+    /** Number of reads by operations ready to render but not started yet, see #read_scheduled. */
+    int scheduled_reads;
+    /** Only set for buffers that may be compressed while idle, see
+     * #set_compress_idle_buffers. */
+    std::unique_ptr<IdleBufferCompression> compression;
   } BufferData;
   blender::Map<NodeOperation *, BufferData> buffers_;
+  bool keep_whole_buffers_ = false;
+  bool compress_idle_buffers_ = false;
 
  public:
+  /**
+   * Whether buffers rendered for the whole operation canvas are kept after their reads are
+   * received, so that they are reused when rendering other areas of the outputs.
+   */
+  void set_keep_whole_buffers(bool keep_whole_buffers);
+  /**
+   * Removes all operations data except for kept buffers, whose reads are reset. Used to render
+   * areas of the outputs one after another.
+   */
+  void clear_partial_buffers();
+
+  /**
+   * Memory saving fallback compressing rendered buffers to half precision while waiting for
+   * readers which are not ready to render, unless their operation uses lossless idle buffers.
+   * Operations always read and write full precision buffers, so this only reduces the memory of
+   * idle buffers, at the cost of precision and of converting them around reads. A color buffer of
+   * 3840x2160 pixels takes 127 MiB in full precision and 63 MiB compressed. See
+   * #get_idle_buffer_compression.
+   */
+  void set_compress_idle_buffers(bool compress_idle_buffers);
+
   /**
    * Whether given operation area to render is already registered.
    */
@@ -72,12 +144,37 @@ class SharedOperationBuffers {
    */
   MemoryBuffer *get_rendered_buffer(NodeOperation *op);
 
+  /**
+   * Reports an operation reading given operation is ready to render, its buffer is not
+   * compressed until the read is started.
+   */
+  void read_scheduled(NodeOperation *read_op);
+
+  /**
+   * Reports an operation has started reading given operation and gets its rendered buffer. The
+   * buffer may be compressed, in which case #IdleBufferCompression::decompress of
+   * #get_buffer_compression must be called before accessing it.
+   */
+  MemoryBuffer *read_started(NodeOperation *read_op);
+
   /**
    * Reports an operation has finished reading given operation. If all given operation dependencies
    * have finished its buffer will be disposed.
    */
   void read_finished(NodeOperation *read_op);
 
+  /**
+   * Get the compression of given operation buffer, null when it is never compressed.
+   */
+  IdleBufferCompression *get_buffer_compression(NodeOperation *op);
+
+  /**
+   * Get the compression of given operation buffer when it should be compressed: when it still
+   * has reads to receive, but none of its readers is reading it or ready to render. Buffers whose
+   * readers render right away are not compressed, since that wouldn't save memory.
+   */
+  IdleBufferCompression *get_idle_buffer_compression(NodeOperation *op);
+
  private:
   BufferData &get_buffer_data(NodeOperation *op);
 
@@ -5,10 +5,12 @@
 #include "COM_WorkScheduler.h"
 
 #include "COM_CPUDevice.h"
+#include "COM_WorkPackage.h"
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_vector.hh"
 
@@ -106,6 +108,41 @@ static void threading_model_queue_finish()
   BLI_thread_queue_wait_finish(g_work_scheduler.queue.queue);
 }
 
+static void threading_model_queue_execute_and_wait(MutableSpan<WorkPackage> packages)
+{
+  /* The queue is shared by all operations, so count the given packages instead of waiting for the
+   * queue to be empty. */
+  ThreadMutex mutex;
+  ThreadCondition finished_cond;
+  BLI_mutex_init(&mutex);
+  BLI_condition_init(&finished_cond);
+  int num_remaining = packages.size();
+
+  for (WorkPackage &package : packages) {
+    package.executed_fn = [&, executed_fn = std::move(package.executed_fn)]() {
+      if (executed_fn) {
+        executed_fn();
+      }
+      BLI_mutex_lock(&mutex);
+      num_remaining--;
+      if (num_remaining == 0) {
+        BLI_condition_notify_all(&finished_cond);
+      }
+      BLI_mutex_unlock(&mutex);
+    };
+    threading_model_queue_schedule(&package);
+  }
+
+  BLI_mutex_lock(&mutex);
+  while (num_remaining > 0) {
+    BLI_condition_wait(&finished_cond, &mutex);
+  }
+  BLI_mutex_unlock(&mutex);
+
+  BLI_condition_end(&finished_cond);
+  BLI_mutex_end(&mutex);
+}
+
 static void threading_model_queue_stop()
 {
   BLI_thread_queue_nowait(g_work_scheduler.queue.queue);
@@ -176,6 +213,20 @@ static void threading_model_task_finish()
   BLI_task_pool_work_and_wait(g_work_scheduler.task.pool);
 }
 
+static void threading_model_task_execute_and_wait(MutableSpan<WorkPackage> packages)
+{
+  /* Use a pool per caller, so that only its packages are waited for. The wait is isolated, so that
+   * the calling thread does not pick up the rendering of another operation in the meantime. */
+  threading::isolate_task([&]() {
+    TaskPool *pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_HIGH);
+    for (WorkPackage &package : packages) {
+      BLI_task_pool_push(pool, threading_model_task_execute, &package, false, nullptr);
+    }
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  });
+}
+
 static void threading_model_task_stop()
 {
   BLI_task_pool_free(g_work_scheduler.task.pool);
@@ -209,6 +260,28 @@ void WorkScheduler::schedule(WorkPackage *package)
   }
 }
 
+void WorkScheduler::execute_and_wait(MutableSpan<WorkPackage> packages)
+{
+  switch (COM_threading_model()) {
+    case ThreadingModel::SingleThreaded: {
+      for (WorkPackage &package : packages) {
+        threading_model_single_thread_execute(&package);
+      }
+      break;
+    }
+
+    case ThreadingModel::Queue: {
+      threading_model_queue_execute_and_wait(packages);
+      break;
+    }
+
+    case ThreadingModel::Task: {
+      threading_model_task_execute_and_wait(packages);
+      break;
+    }
+  }
+}
+
 void WorkScheduler::start()
 {
   switch (COM_threading_model()) {
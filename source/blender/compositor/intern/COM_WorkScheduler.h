@@ -8,6 +8,8 @@
 #  include "MEM_guardedalloc.h"
 #endif
 
+#include "BLI_span.hh"
+
 namespace blender::compositor {
 
 struct WorkPackage;
@@ -22,6 +24,13 @@ struct WorkScheduler {
    */
   static void schedule(WorkPackage *package);
 
+  /**
+   * \brief execute the given packages and wait for them to be completed.
+   * Unlike #finish, work scheduled by other callers is not waited for, so operations which are
+   * rendered concurrently don't wait on each other.
+   */
+  static void execute_and_wait(MutableSpan<WorkPackage> packages);
+
   /**
    * \brief initialize the WorkScheduler
    *
@@ -2,10 +2,15 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <chrono>
+
 #include "BLI_threads.h"
+#include "BLI_timeit.hh"
 
 #include "BLT_translation.hh"
 
+#include "CLG_log.h"
+
 #include "DNA_userdef_types.h"
 
 #include "BKE_node.hh"
@@ -13,11 +18,15 @@
 #include "BKE_scene.hh"
 
 #include "COM_ExecutionSystem.h"
+#include "COM_ResultsCache.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.hh"
+#include "COM_profiler.hh"
 
 #include "RE_compositor.hh"
 
+static CLG_LogRef LOG = {"compositor"};
+
 static struct {
   bool is_initialized = false;
   ThreadMutex mutex;
@@ -45,6 +54,30 @@ static void compositor_init_node_previews(const RenderData *render_data, bNodeTr
   blender::bke::node_preview_init_tree(node_tree, preview_width, preview_height);
 }
 
+static double compositor_seconds(const blender::timeit::Nanoseconds time)
+{
+  return std::chrono::duration<double>(time).count();
+}
+
+/* Log the total execution time and the execution time of every top level node of the tree. */
+static void compositor_log_execution_times(const bNodeTree &node_tree,
+                                           blender::realtime_compositor::Profiler &profiler,
+                                           const blender::timeit::Nanoseconds total_time)
+{
+  CLOG_INFO(&LOG, 1, "Execution time: %f", compositor_seconds(total_time));
+
+  const blender::Map<bNodeInstanceKey, blender::timeit::Nanoseconds> &nodes_times =
+      profiler.get_nodes_evaluation_times();
+  for (const bNode *node : node_tree.all_nodes()) {
+    const bNodeInstanceKey key = blender::bke::node_instance_key(
+        blender::bke::NODE_INSTANCE_KEY_BASE, &node_tree, node);
+    if (const blender::timeit::Nanoseconds *time = nodes_times.lookup_ptr(key)) {
+      CLOG_INFO(
+          &LOG, 1, "Node \"%s\" execution time: %f", node->name, compositor_seconds(*time));
+    }
+  }
+}
+
 static void compositor_reset_node_tree_status(bNodeTree *node_tree)
 {
   node_tree->runtime->progress(node_tree->runtime->prh, 0.0);
@@ -79,6 +112,15 @@ void COM_execute(Render *render,
   compositor_init_node_previews(render_data, node_tree);
   compositor_reset_node_tree_status(node_tree);
 
+  /* Profile executions without a profiler too when logging is enabled, so that node times can be
+   * inspected for final renders, for example by the benchmarks. */
+  blender::realtime_compositor::Profiler log_profiler;
+  const bool use_log_profiler = profiler == nullptr && CLOG_CHECK(&LOG, 1);
+  if (use_log_profiler) {
+    profiler = &log_profiler;
+  }
+  const blender::timeit::TimePoint start_time = blender::timeit::Clock::now();
+
   if (scene->r.compositor_device == SCE_COMPOSITOR_DEVICE_GPU ||
       (USER_EXPERIMENTAL_TEST(&U, enable_new_cpu_compositor) && !scene->r.use_old_cpu_compositor))
   {
@@ -99,6 +141,11 @@ void COM_execute(Render *render,
     system.execute();
   }
 
+  if (use_log_profiler) {
+    compositor_log_execution_times(
+        *node_tree, log_profiler, blender::timeit::Clock::now() - start_time);
+  }
+
   BLI_mutex_unlock(&g_compositor.mutex);
 }
 
@@ -107,6 +154,7 @@ void COM_deinitialize()
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
     blender::compositor::WorkScheduler::deinitialize();
+    blender::compositor::ResultsCache::clear();
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
     BLI_mutex_end(&g_compositor.mutex);
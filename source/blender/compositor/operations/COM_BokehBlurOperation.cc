@@ -2,11 +2,13 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array.hh"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
 
 #include "COM_BokehBlurOperation.h"
 #include "COM_ConstantOperation.h"
+#include "COM_FFTConvolutionAlgorithm.h"
 
 namespace blender::compositor {
 
@@ -29,6 +31,7 @@ BokehBlurOperation::BokehBlurOperation()
   sizeavailable_ = false;
 
   extend_bounds_ = false;
+  use_fft_convolution_ = false;
 }
 
 void BokehBlurOperation::init_data()
@@ -50,6 +53,12 @@ void BokehBlurOperation::update_size()
   sizeavailable_ = true;
 }
 
+int BokehBlurOperation::get_blur_radius() const
+{
+  const float max_dim = std::max(this->get_width(), this->get_height());
+  return size_ * max_dim / 100.0f;
+}
+
 void BokehBlurOperation::determine_canvas(const rcti &preferred_area, rcti &r_area)
 {
   if (!extend_bounds_) {
@@ -96,12 +105,39 @@ void BokehBlurOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+void BokehBlurOperation::update_memory_buffer_started(MemoryBuffer *output,
+                                                      const rcti &area,
+                                                      Span<MemoryBuffer *> inputs)
+{
+  const int radius = get_blur_radius();
+  use_fft_convolution_ = use_fft_convolution(radius);
+  if (!use_fft_convolution_) {
+    return;
+  }
+
+  /* Sample the bokeh kernel exactly like the direct convolution does. */
+  const MemoryBuffer *bokeh_input = inputs[BOKEH_INPUT_INDEX];
+  const int2 bokeh_size = int2(bokeh_input->get_width(), bokeh_input->get_height());
+  const int kernel_size = radius * 2 + 1;
+  Array<float4> kernel(int64_t(kernel_size) * kernel_size);
+  for (const int y : IndexRange(kernel_size)) {
+    for (const int x : IndexRange(kernel_size)) {
+      const float2 normalized_texel = (float2(x, y) + 0.5f) / float(kernel_size);
+      const float2 weight_texel = (1.0f - normalized_texel) * float2(bokeh_size - 1);
+      kernel[x + y * kernel_size] = float4(
+          bokeh_input->get_elem(int(weight_texel.x), int(weight_texel.y)));
+    }
+  }
+
+  FFTConvolution convolution(*inputs[IMAGE_INPUT_INDEX], area, radius);
+  convolution.convolve(kernel, radius, *output);
+}
+
 void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                       const rcti &area,
                                                       Span<MemoryBuffer *> inputs)
 {
-  const float max_dim = std::max(this->get_width(), this->get_height());
-  const int radius = size_ * max_dim / 100.0f;
+  const int radius = get_blur_radius();
 
   const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
   const MemoryBuffer *bokeh_input = inputs[BOKEH_INPUT_INDEX];
@@ -117,6 +153,11 @@ void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
       continue;
     }
 
+    /* Already computed for the whole area in #update_memory_buffer_started. */
+    if (use_fft_convolution_) {
+      continue;
+    }
+
     float4 accumulated_color = float4(0.0f);
     float4 accumulated_weight = float4(0.0f);
     for (int yi = -radius; yi <= radius; ++yi) {
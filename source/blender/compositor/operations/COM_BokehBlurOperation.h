@@ -11,11 +11,16 @@ namespace blender::compositor {
 class BokehBlurOperation : public MultiThreadedOperation {
  private:
   void update_size();
+  int get_blur_radius() const;
   float size_;
   bool sizeavailable_;
 
   bool extend_bounds_;
 
+  /* Large blurs are computed for the whole area using an FFT convolution when rendering starts,
+   * instead of directly convolving every pixel. */
+  bool use_fft_convolution_;
+
  public:
   BokehBlurOperation();
 
@@ -35,6 +40,9 @@ class BokehBlurOperation : public MultiThreadedOperation {
   void determine_canvas(const rcti &preferred_area, rcti &r_area) override;
 
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
@@ -0,0 +1,130 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "BLI_array.hh"
+
+#include "COM_FusedOperation.h"
+
+namespace blender::compositor {
+
+/**
+ * Number of pixels evaluated by all stages before moving on to the next rows. Small enough for
+ * the intermediate results of a few stages to fit in the CPU cache of one core.
+ */
+static constexpr int PIXELS_PER_CHUNK = 8192;
+
+FusedOperation::FusedOperation(Span<MultiThreadedOperation *> operations)
+{
+  BLI_assert(operations.size() > 1);
+
+  for (const int stage_index : operations.index_range()) {
+    MultiThreadedOperation *operation = operations[stage_index];
+    BLI_assert(operation->get_flags().can_be_fused);
+
+    Stage stage;
+    stage.operation = operation;
+    for (int i = 0; i < operation->get_number_of_input_sockets(); i++) {
+      NodeOperationInput *input = operation->get_input_socket(i);
+      NodeOperation *input_op = &input->get_link()->get_operation();
+
+      int input_stage_index = -1;
+      for (const int j : IndexRange(stage_index)) {
+        if (operations[j] == input_op) {
+          input_stage_index = j;
+          break;
+        }
+      }
+
+      if (input_stage_index != -1) {
+        stage.input_sources.append(-(input_stage_index + 1));
+      }
+      else {
+        stage.input_sources.append(stage_inputs_.size());
+        stage_inputs_.append(input);
+        this->add_input_socket(input->get_data_type(), ResizeMode::None);
+      }
+    }
+    stages_.append(std::move(stage));
+  }
+
+  this->add_output_socket(operations.last()->get_output_socket()->get_data_type());
+  flags_.can_be_fused = true;
+}
+
+FusedOperation::~FusedOperation()
+{
+  for (Stage &stage : stages_) {
+    delete stage.operation;
+  }
+}
+
+void FusedOperation::init_data()
+{
+  for (Stage &stage : stages_) {
+    stage.operation->init_data();
+  }
+}
+
+void FusedOperation::init_execution()
+{
+  for (Stage &stage : stages_) {
+    stage.operation->init_execution();
+  }
+}
+
+void FusedOperation::deinit_execution()
+{
+  for (Stage &stage : stages_) {
+    stage.operation->deinit_execution();
+  }
+}
+
+void FusedOperation::update_memory_buffer_partial(MemoryBuffer *output,
+                                                  const rcti &area,
+                                                  Span<MemoryBuffer *> inputs)
+{
+  const int width = BLI_rcti_size_x(&area);
+  const int chunk_height = std::max(1, PIXELS_PER_CHUNK / std::max(width, 1));
+
+  /* Storage for the results of all stages but the last one, which writes to the output. */
+  const int num_intermediates = stages_.size() - 1;
+  Array<Array<float>> intermediate_storage(num_intermediates);
+  Array<int> intermediate_channels(num_intermediates);
+  for (int i = 0; i < num_intermediates; i++) {
+    const DataType data_type = stages_[i].operation->get_output_socket()->get_data_type();
+    intermediate_channels[i] = COM_data_type_num_channels(data_type);
+    intermediate_storage[i].reinitialize(size_t(width) * chunk_height * intermediate_channels[i]);
+  }
+
+  Vector<MemoryBuffer> intermediates;
+  intermediates.reserve(num_intermediates);
+  Vector<MemoryBuffer *> stage_inputs;
+
+  for (int y = area.ymin; y < area.ymax; y += chunk_height) {
+    rcti chunk;
+    BLI_rcti_init(&chunk, area.xmin, area.xmax, y, std::min(y + chunk_height, area.ymax));
+
+    intermediates.clear();
+    for (int i = 0; i < num_intermediates; i++) {
+      intermediates.append_unchecked_as(
+          intermediate_storage[i].data(), intermediate_channels[i], chunk);
+    }
+
+    for (const int stage_index : stages_.index_range()) {
+      const Stage &stage = stages_[stage_index];
+
+      stage_inputs.clear();
+      for (const int source : stage.input_sources) {
+        stage_inputs.append(source >= 0 ? inputs[source] : &intermediates[-source - 1]);
+      }
+
+      MemoryBuffer *stage_output = stage_index == num_intermediates ?
+                                       output :
+                                       &intermediates[stage_index];
+      stage.operation->update_memory_buffer_partial(stage_output, chunk, stage_inputs);
+    }
+  }
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,64 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "COM_MultiThreadedOperation.h"
+
+namespace blender::compositor {
+
+/**
+ * Evaluates a tree of per-pixel operations as a single operation. The operations are evaluated
+ * one after the other on small row chunks, so that their intermediate results stay in CPU caches
+ * instead of being written to full-frame buffers.
+ *
+ * Owns the fused operations, which are not part of the execution system anymore.
+ */
+class FusedOperation : public MultiThreadedOperation {
+ private:
+  struct Stage {
+    MultiThreadedOperation *operation;
+    /**
+     * Source of every input of the operation: the index of a fused operation input when
+     * non-negative, otherwise `-(stage_index + 1)` of the stage computing it.
+     */
+    Vector<int> input_sources;
+  };
+
+  /** Stages in evaluation order, the last one computes the output of the fused operation. */
+  Vector<Stage> stages_;
+
+  /** Input sockets of the stages which are read from operations outside of the fused tree. */
+  Vector<NodeOperationInput *> stage_inputs_;
+
+ public:
+  /**
+   * \param operations: Operations with the #NodeOperationFlags.can_be_fused flag, in an order
+   * where every operation comes after the operations it reads from. Only the last operation is
+   * read by operations outside of the fused tree.
+   */
+  FusedOperation(Span<MultiThreadedOperation *> operations);
+  ~FusedOperation();
+
+  /** Input socket of a fused operation which corresponds to the given input of this operation. */
+  NodeOperationInput *get_stage_input(const int index) const
+  {
+    return stage_inputs_[index];
+  }
+
+  int get_number_of_stages() const
+  {
+    return stages_.size();
+  }
+
+  void init_data() override;
+  void init_execution() override;
+  void deinit_execution() override;
+
+  void update_memory_buffer_partial(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
+};
+
+}  // namespace blender::compositor
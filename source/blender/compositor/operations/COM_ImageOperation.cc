@@ -63,6 +63,29 @@ void BaseImageOperation::deinit_execution()
   BKE_image_release_ibuf(image_, buffer_, nullptr);
 }
 
+void BaseImageOperation::hash_output_params()
+{
+  /* Only images read from files are identified by their settings, others like generated or
+   * edited images may change without any of their settings changing. */
+  if (image_ == nullptr || !ELEM(image_->source, IMA_SRC_FILE, IMA_SRC_SEQUENCE, IMA_SRC_MOVIE) ||
+      !ELEM(image_->type, IMA_TYPE_IMAGE, IMA_TYPE_MULTILAYER) || BKE_image_is_dirty(image_))
+  {
+    NodeOperation::hash_output_params();
+    return;
+  }
+
+  /* The update identifier changes when the image is reloaded, its file may have changed. */
+  hash_params(image_->id.session_uid, image_->runtime.update_id, StringRef(image_->filepath));
+  /* Still images are the same for every frame, only hash the frame of the image user, which was
+   * already resolved from the scene frame, for image sequences and movies. */
+  if (ELEM(image_->source, IMA_SRC_SEQUENCE, IMA_SRC_MOVIE)) {
+    hash_param(image_user_.framenr);
+  }
+  hash_params(StringRef(image_->colorspace_settings.name), int(image_->alpha_mode), image_->flag);
+  hash_params(image_user_.layer, image_user_.pass, image_user_.view);
+  hash_param(StringRef(view_name_ ? view_name_ : ""));
+}
+
 void BaseImageOperation::determine_canvas(const rcti & /*preferred_area*/, rcti &r_area)
 {
   ImBuf *stackbuf = get_im_buf();
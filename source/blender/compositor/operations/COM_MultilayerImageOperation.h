@@ -18,6 +18,7 @@ class MultilayerBaseOperation : public BaseImageOperation {
   std::string pass_name_;
 
   ImBuf *get_im_buf() override;
+  void hash_output_params() override;
 
  public:
   MultilayerBaseOperation() = default;
@@ -50,6 +51,7 @@ class MultilayerValueOperation : public MultilayerBaseOperation {
   MultilayerValueOperation()
   {
     this->add_output_socket(DataType::Value);
+    flags_.use_lossless_idle_buffer = true;
   }
 };
 
@@ -58,6 +60,7 @@ class MultilayerVectorOperation : public MultilayerBaseOperation {
   MultilayerVectorOperation()
   {
     this->add_output_socket(DataType::Vector);
+    flags_.use_lossless_idle_buffer = true;
   }
 };
 
@@ -23,6 +23,8 @@ RenderLayersProg::RenderLayersProg(const char *pass_name, DataType type, int ele
   layer_buffer_ = nullptr;
 
   this->add_output_socket(type);
+  /* Passes other than colors hold data like depths, positions or normals. */
+  flags_.use_lossless_idle_buffer = type != DataType::Color;
 }
 
 void RenderLayersProg::init_execution()
@@ -63,6 +65,21 @@ void RenderLayersProg::deinit_execution()
   }
 }
 
+void RenderLayersProg::hash_output_params()
+{
+  Scene *scene = this->get_scene();
+  Render *re = (scene) ? RE_GetSceneRender(scene) : nullptr;
+  if (re == nullptr || rd_ == nullptr) {
+    NodeOperation::hash_output_params();
+    return;
+  }
+
+  /* The render start time identifies the render result, which changes with every render even
+   * when rendering the same frame again. */
+  hash_params(scene->id.session_uid, layer_id_, RE_GetStats(re)->starttime);
+  hash_params(pass_name_, StringRef(view_name_ ? view_name_ : ""), rd_->cfra);
+}
+
 void RenderLayersProg::determine_canvas(const rcti & /*preferred_area*/, rcti &r_area)
 {
   Scene *sce = this->get_scene();
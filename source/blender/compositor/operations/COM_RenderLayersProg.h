@@ -60,6 +60,7 @@ class RenderLayersProg : public MultiThreadedOperation {
    * Determine the output resolution. The resolution is retrieved from the Renderer
    */
   void determine_canvas(const rcti &preferred_area, rcti &r_area) override;
+  void hash_output_params() override;
 
   /**
    * retrieve the reference to the float buffer of the renderer.
@@ -53,6 +53,17 @@ void ScreenLensDistortionOperation::init_data()
   update_variables(distortion_, dispersion_);
 }
 
+void ScreenLensDistortionOperation::hash_output_params()
+{
+  /* Jitter is randomly seeded on every execution. */
+  if (jitter_) {
+    NodeOperation::hash_output_params();
+    return;
+  }
+  hash_params(fit_, distortion_const_, dispersion_const_);
+  hash_params(distortion_, dispersion_);
+}
+
 void ScreenLensDistortionOperation::init_execution()
 {
   SocketReader *input_reader = this->get_input_socket_reader(0);
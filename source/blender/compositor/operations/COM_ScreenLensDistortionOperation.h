@@ -29,6 +29,9 @@ class ScreenLensDistortionOperation : public MultiThreadedOperation {
   float maxk_;
   float sc_, cx_, cy_;
 
+ protected:
+  void hash_output_params() override;
+
  public:
   ScreenLensDistortionOperation();
 
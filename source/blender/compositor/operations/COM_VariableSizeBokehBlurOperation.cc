@@ -2,9 +2,15 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array.hh"
+#include "BLI_function_ref.hh"
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
+#include "BLI_rect.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
+#include "COM_FFTConvolutionAlgorithm.h"
 #include "COM_VariableSizeBokehBlurOperation.h"
 
 namespace blender::compositor {
@@ -25,6 +31,7 @@ VariableSizeBokehBlurOperation::VariableSizeBokehBlurOperation()
   max_blur_ = 32.0f;
   threshold_ = 1.0f;
   do_size_scale_ = false;
+  use_fft_convolution_ = false;
 }
 
 struct VariableSizeBokehBlurTileData {
@@ -70,6 +77,225 @@ void VariableSizeBokehBlurOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+int VariableSizeBokehBlurOperation::get_search_radius(const MemoryBuffer *size_buffer) const
+{
+  const float max_dim = std::max(get_width(), get_height());
+  const float base_size = do_size_scale_ ? (max_dim / 100.0f) : 1.0f;
+  const float maximum_size = size_buffer->get_max_value();
+  return math::clamp(int(maximum_size * base_size), 0, max_blur_);
+}
+
+/* Get the weight of the layer of the given index for a pixel of the given size, which linearly
+ * interpolates between the two layers whose radii are nearest to the size. Sizes outside of the
+ * range of the radii are given entirely to the first or last layer. */
+static float compute_layer_weight(Span<int> radii, const int layer, const float size)
+{
+  const float radius = radii[layer];
+  if (layer > 0 && size < radius) {
+    const float previous_radius = radii[layer - 1];
+    return math::max(0.0f, (size - previous_radius) / (radius - previous_radius));
+  }
+  if (layer < radii.size() - 1 && size > radius) {
+    const float next_radius = radii[layer + 1];
+    return math::max(0.0f, (next_radius - size) / (next_radius - radius));
+  }
+  return 1.0f;
+}
+
+/* Get the weight with which a neighbor of the given size contributes to the layers of indices
+ * starting from the given one, see #compute_layer_weight. */
+static float compute_layers_weight(Span<int> radii, const int first_layer, const float size)
+{
+  float weight = 0.0f;
+  for (const int layer : radii.index_range().drop_front(first_layer)) {
+    weight += compute_layer_weight(radii, layer, size);
+  }
+  return weight;
+}
+
+/* Convolve the input colors multiplied by the weight of their neighbor sizes with the given kernel
+ * without normalizing it, writing the weighted sum of the colors to the area of the output colors
+ * and the sum of the kernel weights to the area of the output weights. Neighbors under the
+ * threshold have no weight. */
+static void convolve_weighted_neighbors(const MemoryBuffer &input_buffer,
+                                        const MemoryBuffer &size_buffer,
+                                        const float base_size,
+                                        const float threshold,
+                                        const FunctionRef<float(float)> neighbor_weight,
+                                        Span<float4> kernel,
+                                        const int radius,
+                                        const rcti &area,
+                                        MemoryBuffer &r_colors,
+                                        MemoryBuffer &r_weights)
+{
+  /* The convolutions read the padding clamped, which is the same as reading the input clamped as
+   * long as the padded area is intersected with the input area. */
+  rcti padded_area = area;
+  BLI_rcti_pad(&padded_area, radius, radius);
+  rcti weighted_area;
+  BLI_rcti_isect(&padded_area, &input_buffer.get_rect(), &weighted_area);
+
+  MemoryBuffer weighted_colors(DataType::Color, weighted_area);
+  MemoryBuffer weights(DataType::Color, weighted_area);
+  const IndexRange x_range = IndexRange(weighted_area.xmin, BLI_rcti_size_x(&weighted_area));
+  const IndexRange y_range = IndexRange(weighted_area.ymin, BLI_rcti_size_y(&weighted_area));
+  threading::parallel_for(y_range, 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : x_range) {
+        const float size = math::max(0.0f, *size_buffer.get_elem_clamped(x, y) * base_size);
+        const float weight = size < threshold ? 0.0f : neighbor_weight(size);
+        const float4 color = float4(input_buffer.get_elem_clamped(x, y)) * weight;
+        copy_v4_v4(weighted_colors.get_elem(x, y), color);
+        copy_v4_fl(weights.get_elem(x, y), weight);
+      }
+    }
+  });
+
+  FFTConvolution(weighted_colors, area, radius).convolve(kernel, radius, r_colors, false);
+  FFTConvolution(weights, area, radius).convolve(kernel, radius, r_weights, false);
+}
+
+void VariableSizeBokehBlurOperation::compute_layered_fft_blur(MemoryBuffer *output,
+                                                              const rcti &area,
+                                                              Span<MemoryBuffer *> inputs,
+                                                              const int search_radius)
+{
+  const MemoryBuffer *input_buffer = inputs[IMAGE_INPUT_INDEX];
+  const MemoryBuffer *bokeh_buffer = inputs[BOKEH_INPUT_INDEX];
+  const MemoryBuffer *size_buffer = inputs[SIZE_INPUT_INDEX];
+
+  const float max_dim = std::max(get_width(), get_height());
+  const float base_size = do_size_scale_ ? (max_dim / 100.0f) : 1.0f;
+
+  /* Distribute the radii of the layers geometrically between the threshold and the search radius,
+   * since differences between blur radii are less noticeable the larger the radii are. */
+  const int min_radius = math::clamp(int(math::ceil(threshold_)), 1, search_radius);
+  Vector<int> radii;
+  for (const int i : IndexRange(FFT_LAYERS_COUNT)) {
+    const float t = float(i) / (FFT_LAYERS_COUNT - 1);
+    const float ratio = float(search_radius) / min_radius;
+    const int radius = int(math::round(min_radius * math::pow(ratio, t)));
+    if (radii.is_empty() || radius > radii.last()) {
+      radii.append(radius);
+    }
+  }
+
+  /* Like the direct blur, every neighbor is blurred with the kernel of the smaller of its own size
+   * and the size of the center pixel. So for center pixels of the size of a layer, neighbors that
+   * are at least as large contribute with the kernel of that layer, while smaller neighbors
+   * contribute with the kernels of the smaller layers nearest to their size. Layers are computed
+   * in order of increasing radius, accumulating the contributions of smaller neighbors along the
+   * way. Weighted sums of colors and of kernel weights are accumulated separately and divided at
+   * the end, like the direct blur does. */
+  const float4 zero_color = float4(0.0f);
+  MemoryBuffer colors(DataType::Color, area);
+  MemoryBuffer weights(DataType::Color, area);
+  MemoryBuffer smaller_neighbors_colors(DataType::Color, area);
+  MemoryBuffer smaller_neighbors_weights(DataType::Color, area);
+  MemoryBuffer layer_colors(DataType::Color, area);
+  MemoryBuffer layer_weights(DataType::Color, area);
+  colors.fill(area, zero_color);
+  weights.fill(area, zero_color);
+  smaller_neighbors_colors.fill(area, zero_color);
+  smaller_neighbors_weights.fill(area, zero_color);
+
+  const IndexRange x_range = IndexRange(area.xmin, BLI_rcti_size_x(&area));
+  const IndexRange y_range = IndexRange(area.ymin, BLI_rcti_size_y(&area));
+  for (const int layer : radii.index_range()) {
+    /* Sample the bokeh kernel exactly like the direct blur does for pixels of this size, including
+     * the unit weight of the center pixel. */
+    const int radius = radii[layer];
+    const int kernel_size = radius * 2 + 1;
+    Array<float4> kernel(int64_t(kernel_size) * kernel_size);
+    for (const int y : IndexRange(kernel_size)) {
+      for (const int x : IndexRange(kernel_size)) {
+        const float2 normalized_texel = (float2(x, y) + 0.5f) / float(kernel_size);
+        const float2 weight_texel = 1.0f - normalized_texel;
+        kernel[x + y * kernel_size] = bokeh_buffer->texture_bilinear_extend(weight_texel);
+      }
+    }
+    kernel[radius + radius * kernel_size] = float4(1.0f);
+
+    /* Neighbors at least as large as the layer. */
+    convolve_weighted_neighbors(
+        *input_buffer,
+        *size_buffer,
+        base_size,
+        threshold_,
+        [&](const float size) { return compute_layers_weight(radii, layer, size); },
+        kernel,
+        radius,
+        area,
+        layer_colors,
+        layer_weights);
+
+    threading::parallel_for(y_range, 1, [&](const IndexRange sub_y_range) {
+      for (const int64_t y : sub_y_range) {
+        for (const int64_t x : x_range) {
+          const float size = math::max(0.0f, *size_buffer->get_elem(x, y) * base_size);
+          const float weight = compute_layer_weight(radii, layer, size);
+          if (weight == 0.0f) {
+            continue;
+          }
+          const float4 color = float4(smaller_neighbors_colors.get_elem(x, y)) +
+                               float4(layer_colors.get_elem(x, y));
+          const float4 color_weight = float4(smaller_neighbors_weights.get_elem(x, y)) +
+                                      float4(layer_weights.get_elem(x, y));
+          madd_v4_v4fl(colors.get_elem(x, y), color, weight);
+          madd_v4_v4fl(weights.get_elem(x, y), color_weight, weight);
+        }
+      }
+    });
+
+    if (layer == radii.index_range().last()) {
+      break;
+    }
+
+    /* Neighbors of the size of the layer, which are smaller than the next layers. */
+    convolve_weighted_neighbors(
+        *input_buffer,
+        *size_buffer,
+        base_size,
+        threshold_,
+        [&](const float size) { return compute_layer_weight(radii, layer, size); },
+        kernel,
+        radius,
+        area,
+        layer_colors,
+        layer_weights);
+
+    threading::parallel_for(y_range, 1, [&](const IndexRange sub_y_range) {
+      for (const int64_t y : sub_y_range) {
+        for (const int64_t x : x_range) {
+          add_v4_v4(smaller_neighbors_colors.get_elem(x, y), layer_colors.get_elem(x, y));
+          add_v4_v4(smaller_neighbors_weights.get_elem(x, y), layer_weights.get_elem(x, y));
+        }
+      }
+    });
+  }
+
+  threading::parallel_for(y_range, 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : x_range) {
+        const float4 color = math::safe_divide(float4(colors.get_elem(x, y)),
+                                               float4(weights.get_elem(x, y)));
+        copy_v4_v4(output->get_elem(x, y), color);
+      }
+    }
+  });
+}
+
+void VariableSizeBokehBlurOperation::update_memory_buffer_started(MemoryBuffer *output,
+                                                                  const rcti &area,
+                                                                  Span<MemoryBuffer *> inputs)
+{
+  const int search_radius = get_search_radius(inputs[SIZE_INPUT_INDEX]);
+  use_fft_convolution_ = use_fft_convolution(search_radius);
+  if (use_fft_convolution_) {
+    compute_layered_fft_blur(output, area, inputs, search_radius);
+  }
+}
+
 void VariableSizeBokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                                   const rcti &area,
                                                                   Span<MemoryBuffer *> inputs)
@@ -81,8 +307,7 @@ void VariableSizeBokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *
 
   const float max_dim = std::max(get_width(), get_height());
   const float base_size = do_size_scale_ ? (max_dim / 100.0f) : 1.0f;
-  const float maximum_size = size_buffer->get_max_value();
-  const int search_radius = math::clamp(int(maximum_size * base_size), 0, max_blur_);
+  const int search_radius = get_search_radius(size_buffer);
 
   BuffersIterator<float> it = output->iterate_with({}, area);
   for (; !it.is_end(); ++it) {
@@ -93,33 +318,43 @@ void VariableSizeBokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *
 
     const float center_size = math::max(0.0f, *size_buffer->get_elem(it.x, it.y) * base_size);
 
-    float4 accumulated_color = float4(input_buffer->get_elem(it.x, it.y));
-    float4 accumulated_weight = float4(1.0f);
-    if (center_size >= threshold_) {
-      for (int yi = -search_radius; yi <= search_radius; ++yi) {
-        for (int xi = -search_radius; xi <= search_radius; ++xi) {
-          if (xi == 0 && yi == 0) {
-            continue;
-          }
-          const float candidate_size = math::max(
-              0.0f, *size_buffer->get_elem_clamped(it.x + xi, it.y + yi) * base_size);
-          const float size = math::min(center_size, candidate_size);
-          if (size < threshold_ || math::max(math::abs(xi), math::abs(yi)) > size) {
-            continue;
-          }
+    if (use_fft_convolution_) {
+      /* The blur was already computed in #update_memory_buffer_started, but pixels under the
+       * threshold are not blurred. */
+      if (center_size < threshold_) {
+        copy_v4_v4(it.out, input_buffer->get_elem(it.x, it.y));
+      }
+    }
+    else {
+      float4 accumulated_color = float4(input_buffer->get_elem(it.x, it.y));
+      float4 accumulated_weight = float4(1.0f);
+      if (center_size >= threshold_) {
+        for (int yi = -search_radius; yi <= search_radius; ++yi) {
+          for (int xi = -search_radius; xi <= search_radius; ++xi) {
+            if (xi == 0 && yi == 0) {
+              continue;
+            }
+            const float candidate_size = math::max(
+                0.0f, *size_buffer->get_elem_clamped(it.x + xi, it.y + yi) * base_size);
+            const float size = math::min(center_size, candidate_size);
+            if (size < threshold_ || math::max(math::abs(xi), math::abs(yi)) > size) {
+              continue;
+            }
 
-          const float2 normalized_texel = (float2(xi, yi) + size + 0.5f) / (size * 2.0f + 1.0f);
-          const float2 weight_texel = 1.0f - normalized_texel;
-          const float4 weight = bokeh_buffer->texture_bilinear_extend(weight_texel);
-          const float4 color = input_buffer->get_elem_clamped(it.x + xi, it.y + yi);
-          accumulated_color += color * weight;
-          accumulated_weight += weight;
+            const float2 normalized_texel = (float2(xi, yi) + size + 0.5f) /
+                                            (size * 2.0f + 1.0f);
+            const float2 weight_texel = 1.0f - normalized_texel;
+            const float4 weight = bokeh_buffer->texture_bilinear_extend(weight_texel);
+            const float4 color = input_buffer->get_elem_clamped(it.x + xi, it.y + yi);
+            accumulated_color += color * weight;
+            accumulated_weight += weight;
+          }
         }
       }
-    }
 
-    const float4 final_color = math::safe_divide(accumulated_color, accumulated_weight);
-    copy_v4_v4(it.out, final_color);
+      const float4 final_color = math::safe_divide(accumulated_color, accumulated_weight);
+      copy_v4_v4(it.out, final_color);
+    }
 
     /* blend in out values over the threshold, otherwise we get sharp, ugly transitions */
     if ((center_size > threshold_) && (center_size < threshold_ * 2.0f)) {
@@ -20,10 +20,25 @@ class VariableSizeBokehBlurOperation : public MultiThreadedOperation {
   static constexpr int DEFOCUS_INPUT_INDEX = 4;
 #endif
 
+  /* Number of blur radii the image is convolved with when using the layered FFT blur. */
+  static constexpr int FFT_LAYERS_COUNT = 8;
+
   int max_blur_;
   float threshold_;
   bool do_size_scale_; /* scale size, matching 'BokehBlurNode' */
 
+  /* Large blurs are approximated for the whole area when rendering starts, by convolving the image
+   * with a few bokeh kernels of increasing radius in the frequency domain and interpolating
+   * between them by the size of every pixel. Neighbors are masked by their size for every kernel,
+   * since they are blurred with the size of the smaller of them and the center pixel. */
+  bool use_fft_convolution_;
+
+  int get_search_radius(const MemoryBuffer *size_buffer) const;
+  void compute_layered_fft_blur(MemoryBuffer *output,
+                                const rcti &area,
+                                Span<MemoryBuffer *> inputs,
+                                int search_radius);
+
  public:
   VariableSizeBokehBlurOperation();
 
@@ -43,6 +58,9 @@ class VariableSizeBokehBlurOperation : public MultiThreadedOperation {
   }
 
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "BLI_map.hh"
+#include "BLI_set.hh"
 #include "BLI_timeit.hh"
 
 #include "DNA_node_types.h"
@@ -28,6 +29,10 @@ class Profiler {
    * evaluation time of each individual node. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> nodes_evaluation_times_;
 
+  /* Stores the instance keys of the nodes whose result was reused from a previous evaluation
+   * instead of being evaluated. */
+  Set<bNodeInstanceKey> cached_nodes_;
+
  public:
   /* Returns a reference to the nodes evaluation times. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> &get_nodes_evaluation_times();
@@ -35,6 +40,13 @@ class Profiler {
   /* Set the evaluation time of the node identified by the given node instance key. */
   void set_node_evaluation_time(bNodeInstanceKey node_instance_key, timeit::Nanoseconds time);
 
+  /* Returns a reference to the instance keys of the cached nodes. */
+  Set<bNodeInstanceKey> &get_cached_nodes();
+
+  /* Mark the node identified by the given node instance key as reused from a previous
+   * evaluation. */
+  void set_node_cached(bNodeInstanceKey node_instance_key);
+
   /* Finalize profiling by computing node group times. This should be called after evaluation. */
   void finalize(const bNodeTree &node_tree);
 
@@ -365,6 +365,9 @@ class Result {
   /* Returns a reference to the allocate float data. */
   float *float_texture();
 
+  /* Returns a reference to the allocate integer data. */
+  int *integer_texture();
+
   /* Loads the float pixel at the given texel coordinates and returns it in a float4. If the number
    * of channels in the result are less than 4, then the rest of the returned float4 will have its
    * vales initialized as follows: float4(0, 0, 0, 1). This is similar to how the texelFetch
@@ -372,11 +375,30 @@ class Result {
    * returned for all texel coordinates. */
   float4 load_pixel(const int2 &texel) const;
 
+  /* Identical to load_pixel but with extended boundary condition, that is, out of bound texels are
+   * clamped to the closest texel in the image. This is similar to the texture_load function in
+   * GLSL with no fallback. */
+  float4 load_pixel_extended(const int2 &texel) const;
+
+  /* Identical to load_pixel but returns the given fallback value for out of bound texels. This is
+   * similar to the texture_load function in GLSL with a fallback. */
+  float4 load_pixel_fallback(const int2 &texel, const float4 &fallback) const;
+
+  /* Loads the integer pixel at the given texel coordinates of an Int2 result. */
+  int2 load_integer_pixel(const int2 &texel) const;
+
+  /* Identical to load_integer_pixel but with extended boundary condition. */
+  int2 load_integer_pixel_extended(const int2 &texel) const;
+
   /* Stores the given pixel value in the float pixel at the given texel coordinates. While a float4
    * is given, only the number of channels of the result will be written, while the rest of the
    * float4 will be ignored. This is similar to how the imageStore function in GLSL works. */
   void store_pixel(const int2 &texel, const float4 &pixel_value);
 
+  /* Stores the given integer pixel value in the pixel at the given texel coordinates of an Int2
+   * result. */
+  void store_integer_pixel(const int2 &texel, const int2 &pixel_value);
+
  private:
   /* Allocates the texture data for the given size, either on the GPU or CPU based on the result's
    * context. See the allocate_texture method for information about the from_pool argument. */
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "BLI_math_vector_types.hh"
+
 #include "COM_context.hh"
 #include "COM_result.hh"
 
@@ -26,4 +28,12 @@ void summed_area_table(Context &context,
                        Result &output,
                        SummedAreaTableOperation operation = SummedAreaTableOperation::Identity);
 
+/* Computes the sum of the rectangular region defined by the given lower and upper bounds from the
+ * given summed area table, which is assumed to be stored on the CPU. Identical to the
+ * summed_area_table_sum function in gpu_shader_compositor_summed_area_table_lib.glsl, see that
+ * function for more information. */
+float4 summed_area_table_sum(const Result &table,
+                             const int2 &lower_bound,
+                             const int2 &upper_bound);
+
 }  // namespace blender::realtime_compositor
@@ -2,9 +2,13 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
+#include "BLI_index_range.hh"
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_task.hh"
 
 #include "GPU_shader.hh"
 
@@ -53,7 +57,7 @@ static void sum_causal_and_non_causal_results(Context &context,
   output.unbind_as_image();
 }
 
-static void blur_pass(Context &context, Result &input, Result &output, float sigma)
+static void blur_pass_gpu(Context &context, Result &input, Result &output, float sigma)
 {
   GPUShader *shader = context.get_shader("compositor_deriche_gaussian_blur");
   GPU_shader_bind(shader);
@@ -101,6 +105,97 @@ static void blur_pass(Context &context, Result &input, Result &output, float sig
   non_causal_result.release();
 }
 
+/* A CPU implementation of the compositor_deriche_gaussian_blur shader and the sum shader, see the
+ * shader for more information. The causal and non causal filters of each row are computed by the
+ * same thread, the former is written to a temporary row buffer, while the latter is added to it
+ * and the sum is written to the output transposed. See the sum_causal_and_non_causal_results
+ * function for the rational behind the transposition. */
+static void blur_pass_cpu(Context &context, Result &input, Result &output, float sigma)
+{
+  constexpr int filter_order = 4;
+
+  const DericheGaussianCoefficients &coefficients =
+      context.cache_manager().deriche_gaussian_coefficients.get(context, sigma);
+  const float4 causal_feedforward_coefficients = float4(
+      coefficients.causal_feedforward_coefficients());
+  const float4 non_causal_feedforward_coefficients = float4(
+      coefficients.non_causal_feedforward_coefficients());
+  const float4 feedback_coefficients = float4(coefficients.feedback_coefficients());
+  const float causal_boundary_coefficient = float(coefficients.causal_boundary_coefficient());
+  const float non_causal_boundary_coefficient = float(
+      coefficients.non_causal_boundary_coefficient());
+
+  const int2 size = input.domain().size;
+  output.allocate_texture(int2(size.y, size.x));
+
+  threading::parallel_for(IndexRange(size.y), 1, [&](const IndexRange sub_y_range) {
+    Array<float4> causal_row(size.x);
+    for (const int64_t y : sub_y_range) {
+      /* Hold the last filter_order inputs and outputs along with the current ones at index 0,
+       * assuming Neumann boundary condition like the shader. */
+      float4 inputs[filter_order + 1];
+      float4 outputs[filter_order + 1];
+
+      const float4 causal_input_boundary = input.load_pixel(int2(0, y));
+      const float4 causal_output_boundary = causal_input_boundary * causal_boundary_coefficient;
+      for (const int i : IndexRange(filter_order + 1)) {
+        inputs[i] = causal_input_boundary;
+        outputs[i] = causal_output_boundary;
+      }
+
+      for (const int64_t x : IndexRange(size.x)) {
+        inputs[0] = input.load_pixel(int2(x, y));
+        outputs[0] = float4(0.0f);
+        for (const int i : IndexRange(filter_order)) {
+          outputs[0] += causal_feedforward_coefficients[i] * inputs[i];
+          outputs[0] -= feedback_coefficients[i] * outputs[i + 1];
+        }
+        causal_row[x] = outputs[0];
+
+        for (int i = filter_order; i >= 1; i--) {
+          inputs[i] = inputs[i - 1];
+          outputs[i] = outputs[i - 1];
+        }
+      }
+
+      const float4 non_causal_input_boundary = input.load_pixel(int2(size.x - 1, y));
+      const float4 non_causal_output_boundary = non_causal_input_boundary *
+                                                non_causal_boundary_coefficient;
+      for (const int i : IndexRange(filter_order + 1)) {
+        inputs[i] = non_causal_input_boundary;
+        outputs[i] = non_causal_output_boundary;
+      }
+
+      /* The non causal filter runs backward and ignores the current input, so it starts from the
+       * previous input. */
+      for (int64_t x = size.x - 1; x >= 0; x--) {
+        inputs[0] = input.load_pixel(int2(x, y));
+        outputs[0] = float4(0.0f);
+        for (const int i : IndexRange(filter_order)) {
+          outputs[0] += non_causal_feedforward_coefficients[i] * inputs[i + 1];
+          outputs[0] -= feedback_coefficients[i] * outputs[i + 1];
+        }
+        output.store_pixel(int2(y, x), causal_row[x] + outputs[0]);
+
+        for (int i = filter_order; i >= 1; i--) {
+          inputs[i] = inputs[i - 1];
+          outputs[i] = outputs[i - 1];
+        }
+      }
+    }
+  });
+}
+
+static void blur_pass(Context &context, Result &input, Result &output, float sigma)
+{
+  if (context.use_gpu()) {
+    blur_pass_gpu(context, input, output, sigma);
+  }
+  else {
+    blur_pass_cpu(context, input, output, sigma);
+  }
+}
+
 void deriche_gaussian_blur(Context &context, Result &input, Result &output, float2 sigma)
 {
   BLI_assert_msg(math::reduce_max(sigma) >= 3.0f,
@@ -4,9 +4,12 @@
 
 #include <utility>
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
 #include "BLI_math_base.h"
 #include "BLI_math_base.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 #include "GPU_shader.hh"
 
@@ -16,6 +19,8 @@
 
 #include "COM_algorithm_jump_flooding.hh"
 
+#include "COM_JumpFloodingAlgorithm.h"
+
 namespace blender::realtime_compositor {
 
 static void jump_flooding_pass(Context &context, Result &input, Result &output, int step_size)
@@ -35,11 +40,8 @@ static void jump_flooding_pass(Context &context, Result &input, Result &output,
   output.unbind_as_image();
 }
 
-void jump_flooding(Context &context, Result &input, Result &output)
+static void jump_flooding_gpu(Context &context, Result &input, Result &output)
 {
-  BLI_assert(input.type() == ResultType::Int2);
-  BLI_assert(output.type() == ResultType::Int2);
-
   /* First, run a jump flooding pass with a step size of 1. This initial pass is proposed by the
    * 1+FJA variant to improve accuracy. */
   Result initial_flooded_result = context.create_result(ResultType::Int2, ResultPrecision::Half);
@@ -72,4 +74,32 @@ void jump_flooding(Context &context, Result &input, Result &output)
   output.steal_data(*result_to_flood);
 }
 
+/* Computes the jump flooding table on the CPU using the same algorithm that the CPU compositor
+ * uses, see COM_JumpFloodingAlgorithm.h. */
+static void jump_flooding_cpu(Result &input, Result &output)
+{
+  const int2 size = input.domain().size;
+  const int64_t pixels_count = int64_t(size.x) * size.y;
+  const Span<int2> input_table(reinterpret_cast<const int2 *>(input.integer_texture()),
+                               pixels_count);
+  const Array<int2> flooded_table = compositor::jump_flooding(input_table, size);
+
+  output.allocate_texture(input.domain());
+  MutableSpan<int2>(reinterpret_cast<int2 *>(output.integer_texture()), pixels_count)
+      .copy_from(flooded_table);
+}
+
+void jump_flooding(Context &context, Result &input, Result &output)
+{
+  BLI_assert(input.type() == ResultType::Int2);
+  BLI_assert(output.type() == ResultType::Int2);
+
+  if (context.use_gpu()) {
+    jump_flooding_gpu(context, input, output);
+  }
+  else {
+    jump_flooding_cpu(input, output);
+  }
+}
+
 }  // namespace blender::realtime_compositor
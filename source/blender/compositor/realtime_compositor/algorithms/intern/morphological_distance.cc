@@ -2,7 +2,13 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <cfloat>
+
+#include "BLI_array.hh"
+#include "BLI_index_range.hh"
 #include "BLI_math_base.hh"
+#include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "GPU_shader.hh"
 #include "GPU_texture.hh"
@@ -23,7 +29,10 @@ static const char *get_shader_name(int distance)
   return "compositor_morphological_distance_erode";
 }
 
-void morphological_distance(Context &context, Result &input, Result &output, int distance)
+static void morphological_distance_gpu(Context &context,
+                                       Result &input,
+                                       Result &output,
+                                       int distance)
 {
   GPUShader *shader = context.get_shader(get_shader_name(distance));
   GPU_shader_bind(shader);
@@ -43,4 +52,141 @@ void morphological_distance(Context &context, Result &input, Result &output, int
   input.unbind_as_texture();
 }
 
+/* Computes the maximum, or minimum if not dilating, of every window of the given size in the
+ * given input using the van Herk/Gil-Werman algorithm, which needs three comparisons per element
+ * regardless of the window size. The input is divided into blocks of the window size, each window
+ * then spans the end of one block and the start of the next, so its extremum is the extremum of
+ * the suffix of the former and the prefix of the latter. The extremum of the window starting at
+ * index i is written to output[i], so the output has window_size - 1 less elements than the
+ * input. The prefix and suffix spans are scratch buffers of the same size as the input. */
+template<bool IsDilate>
+static void van_herk_gil_werman(Span<float> input,
+                                int window_size,
+                                MutableSpan<float> prefix,
+                                MutableSpan<float> suffix,
+                                MutableSpan<float> output)
+{
+  const auto extremum = [](float a, float b) {
+    return IsDilate ? math::max(a, b) : math::min(a, b);
+  };
+
+  const int64_t size = input.size();
+  for (const int64_t i : IndexRange(size)) {
+    prefix[i] = i % window_size == 0 ? input[i] : extremum(prefix[i - 1], input[i]);
+  }
+  for (int64_t i = size - 1; i >= 0; i--) {
+    const bool is_block_end = i % window_size == window_size - 1 || i == size - 1;
+    suffix[i] = is_block_end ? input[i] : extremum(suffix[i + 1], input[i]);
+  }
+
+  for (const int64_t i : output.index_range()) {
+    output[i] = extremum(suffix[i], prefix[i + window_size - 1]);
+  }
+}
+
+/* Find the minimum or maximum value in the circular window of the given radius around each pixel,
+ * matching the compositor_morphological_distance shaders. The circular window is decomposed into
+ * rows, each row being a horizontal span of a certain half width, and the rows that share the same
+ * half width form two vertical ranges of rows, one above and one below the center. So for every
+ * distinct half width, we compute a horizontal sliding window extremum of that half width, then a
+ * vertical sliding window extremum over each of the two ranges of rows, both in linear time using
+ * the van Herk/Gil-Werman algorithm. There are at most radius + 1 distinct half widths, so the
+ * complexity is O(radius) per pixel as opposed to the O(radius^2) of the shaders. Pixels outside
+ * of the image are padded with the LIMIT value that doesn't affect the result, like the shaders
+ * fallback to it. */
+template<bool IsDilate>
+static void morphological_distance_cpu(Result &input, Result &output, int distance)
+{
+  const int radius = math::abs(distance);
+  const float limit = IsDilate ? FLT_MIN : FLT_MAX;
+
+  /* Compute the half width of each row of the positive half of the window, that is, the largest
+   * horizontal offset whose squared distance to the center is at most the squared radius. */
+  Array<int> half_widths(radius + 1);
+  int half_width = radius;
+  for (const int y : half_widths.index_range()) {
+    while (half_width * half_width + y * y > radius * radius) {
+      half_width--;
+    }
+    half_widths[y] = half_width;
+  }
+
+  const int2 size = input.domain().size;
+  const int64_t pixels_count = int64_t(size.x) * size.y;
+  output.allocate_texture(input.domain());
+  const Span<float> input_data(input.float_texture(), pixels_count);
+  MutableSpan<float> output_data(output.float_texture(), pixels_count);
+  output_data.fill(limit);
+
+  Array<float> horizontal_extremum(pixels_count);
+  int start_row = 0;
+  while (start_row <= radius) {
+    /* Find the range of rows that share the half width of the start row. */
+    const int window_half_width = half_widths[start_row];
+    int end_row = start_row;
+    while (end_row < radius && half_widths[end_row + 1] == window_half_width) {
+      end_row++;
+    }
+
+    /* Compute the extremum of the horizontal window of the half width around each pixel. */
+    threading::parallel_for(IndexRange(size.y), 16, [&](const IndexRange sub_y_range) {
+      const int padded_size = size.x + window_half_width * 2;
+      Array<float> padded_row(padded_size, limit);
+      Array<float> prefix(padded_size);
+      Array<float> suffix(padded_size);
+      for (const int64_t y : sub_y_range) {
+        padded_row.as_mutable_span()
+            .slice(window_half_width, size.x)
+            .copy_from(input_data.slice(y * size.x, size.x));
+        MutableSpan<float> output_row = horizontal_extremum.as_mutable_span().slice(y * size.x,
+                                                                                   size.x);
+        van_herk_gil_werman<IsDilate>(
+            padded_row, window_half_width * 2 + 1, prefix, suffix, output_row);
+      }
+    });
+
+    /* Compute the extremum of the vertical window spanning the range of rows above each pixel and
+     * the mirrored range of rows below it, both of which are windows of the same size, so compute
+     * the extremum of all windows of that size in a column padded by the radius and pick the two
+     * windows that start at the start of each of the ranges. */
+    const int rows_count = end_row - start_row + 1;
+    threading::parallel_for(IndexRange(size.x), 16, [&](const IndexRange sub_x_range) {
+      const int padded_size = size.y + radius * 2;
+      Array<float> padded_column(padded_size, limit);
+      Array<float> prefix(padded_size);
+      Array<float> suffix(padded_size);
+      Array<float> vertical_extremum(padded_size - rows_count + 1);
+      for (const int64_t x : sub_x_range) {
+        for (const int64_t y : IndexRange(size.y)) {
+          padded_column[radius + y] = horizontal_extremum[y * size.x + x];
+        }
+        van_herk_gil_werman<IsDilate>(
+            padded_column, rows_count, prefix, suffix, vertical_extremum);
+        for (const int64_t y : IndexRange(size.y)) {
+          const float upper = vertical_extremum[radius + y + start_row];
+          const float lower = vertical_extremum[radius + y - end_row];
+          float &value = output_data[y * size.x + x];
+          value = IsDilate ? math::max(value, math::max(upper, lower)) :
+                             math::min(value, math::min(upper, lower));
+        }
+      }
+    });
+
+    start_row = end_row + 1;
+  }
+}
+
+void morphological_distance(Context &context, Result &input, Result &output, int distance)
+{
+  if (context.use_gpu()) {
+    morphological_distance_gpu(context, input, output, distance);
+  }
+  else if (distance > 0) {
+    morphological_distance_cpu<true>(input, output, distance);
+  }
+  else {
+    morphological_distance_cpu<false>(input, output, distance);
+  }
+}
+
 }  // namespace blender::realtime_compositor
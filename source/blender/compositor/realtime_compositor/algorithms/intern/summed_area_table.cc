@@ -2,10 +2,13 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
+#include "BLI_index_range.hh"
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_task.hh"
 
 #include "GPU_compute.hh"
 #include "GPU_shader.hh"
@@ -199,10 +202,10 @@ static void compute_complete_blocks(Context &context,
   output.unbind_as_image();
 }
 
-void summed_area_table(Context &context,
-                       Result &input,
-                       Result &output,
-                       SummedAreaTableOperation operation)
+static void summed_area_table_gpu(Context &context,
+                                  Result &input,
+                                  Result &output,
+                                  SummedAreaTableOperation operation)
 {
   Result incomplete_x_prologues = context.create_result(ResultType::Color, ResultPrecision::Full);
   Result incomplete_y_prologues = context.create_result(ResultType::Color, ResultPrecision::Full);
@@ -228,4 +231,87 @@ void summed_area_table(Context &context,
   complete_y_prologues.release();
 }
 
+/* ------------------------------------------------------------------------------------------------
+ * Summed Area Table CPU
+ *
+ * The CPU implementation doesn't need the block decomposition of the GPU one, since each thread
+ * can afford to process whole rows or columns serially. So the table is computed in two passes,
+ * the first accumulates each row of the input horizontally, parallel across rows, and the second
+ * accumulates the result vertically, parallel across chunks of columns. The second pass iterates
+ * over the rows of each chunk of columns while keeping a running sum for each column, such that
+ * memory is accessed contiguously in both passes and the inner loops can be vectorized. */
+
+static float4 apply_operation(const float4 &value, SummedAreaTableOperation operation)
+{
+  switch (operation) {
+    case SummedAreaTableOperation::Identity:
+      return value;
+    case SummedAreaTableOperation::Square:
+      return value * value;
+  }
+
+  BLI_assert_unreachable();
+  return value;
+}
+
+static void summed_area_table_cpu(Result &input,
+                                  Result &output,
+                                  SummedAreaTableOperation operation)
+{
+  const int2 size = input.domain().size;
+  output.allocate_texture(input.domain());
+
+  threading::parallel_for(IndexRange(size.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      float4 accumulated_color = float4(0.0f);
+      for (const int64_t x : IndexRange(size.x)) {
+        const int2 texel = int2(x, y);
+        accumulated_color += apply_operation(input.load_pixel(texel), operation);
+        output.store_pixel(texel, accumulated_color);
+      }
+    }
+  });
+
+  float4 *table = reinterpret_cast<float4 *>(output.float_texture());
+  threading::parallel_for(IndexRange(size.x), 64, [&](const IndexRange sub_x_range) {
+    Array<float4> accumulated_colors(sub_x_range.size(), float4(0.0f));
+    for (const int64_t y : IndexRange(size.y)) {
+      float4 *row = table + y * size.x + sub_x_range.start();
+      for (const int64_t i : sub_x_range.index_range()) {
+        accumulated_colors[i] += row[i];
+        row[i] = accumulated_colors[i];
+      }
+    }
+  });
+}
+
+float4 summed_area_table_sum(const Result &table, const int2 &lower_bound, const int2 &upper_bound)
+{
+  const int2 corrected_lower_bound = lower_bound - int2(1);
+  const int2 corrected_upper_bound = math::min(table.domain().size - int2(1), upper_bound);
+  const float4 addend = table.load_pixel_fallback(corrected_upper_bound, float4(0.0f)) +
+                        table.load_pixel_fallback(corrected_lower_bound, float4(0.0f));
+  const float4 subtrahend =
+      table.load_pixel_fallback(int2(corrected_lower_bound.x, corrected_upper_bound.y),
+                                float4(0.0f)) +
+      table.load_pixel_fallback(int2(corrected_upper_bound.x, corrected_lower_bound.y),
+                                float4(0.0f));
+  return addend - subtrahend;
+}
+
+void summed_area_table(Context &context,
+                       Result &input,
+                       Result &output,
+                       SummedAreaTableOperation operation)
+{
+  BLI_assert(output.type() == ResultType::Color);
+
+  if (context.use_gpu()) {
+    summed_area_table_gpu(context, input, output, operation);
+  }
+  else {
+    summed_area_table_cpu(input, output, operation);
+  }
+}
+
 }  // namespace blender::realtime_compositor
@@ -6,6 +6,7 @@
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 #include "GPU_shader.hh"
 #include "GPU_texture.hh"
@@ -132,13 +133,13 @@ static void vertical_pass(Context &context,
   weights.unbind_as_texture();
 }
 
-void symmetric_separable_blur(Context &context,
-                              Result &input,
-                              Result &output,
-                              float2 radius,
-                              int filter_type,
-                              bool extend_bounds,
-                              bool gamma_correct)
+static void symmetric_separable_blur_gpu(Context &context,
+                                         Result &input,
+                                         Result &output,
+                                         float2 radius,
+                                         int filter_type,
+                                         bool extend_bounds,
+                                         bool gamma_correct)
 {
   Result horizontal_pass_result = horizontal_pass(
       context, input, radius.x, filter_type, extend_bounds, gamma_correct);
@@ -155,4 +156,127 @@ void symmetric_separable_blur(Context &context,
   horizontal_pass_result.release();
 }
 
+/* Identical to the gamma_correct_blur_input function in gpu_shader_compositor_blur_common.glsl. */
+static float4 gamma_correct_blur_input(const float4 &color)
+{
+  /* Un-pre-multiply alpha, square the color channels if they are positive, otherwise zero them,
+   * then pre-multiply alpha again. */
+  const float alpha = color.w > 0.0f ? color.w : 1.0f;
+  const float3 straight_color = math::max(color.xyz() / alpha, float3(0.0f));
+  return float4(straight_color * straight_color * alpha, color.w);
+}
+
+/* Identical to the gamma_uncorrect_blur_output function in
+ * gpu_shader_compositor_blur_common.glsl. */
+static float4 gamma_uncorrect_blur_output(const float4 &color)
+{
+  /* Un-pre-multiply alpha, take the square root of the color channels if they are positive,
+   * otherwise zero them, then pre-multiply alpha again. */
+  const float alpha = color.w > 0.0f ? color.w : 1.0f;
+  const float3 straight_color = math::max(color.xyz() / alpha, float3(0.0f));
+  return float4(math::sqrt(straight_color) * alpha, color.w);
+}
+
+/* Blurs the input along the horizontal or vertical axis, identical to the
+ * compositor_symmetric_separable_blur shader but without the transposition, since the CPU passes
+ * can access the image along either axis. */
+static void blur_pass_cpu(const Result &input,
+                          Result &output,
+                          const SymmetricSeparableBlurWeights &weights,
+                          bool is_vertical_pass,
+                          bool extend_bounds,
+                          bool gamma_correct_input,
+                          bool gamma_uncorrect_output)
+{
+  const Span<float> weights_data = weights.weights();
+  const int2 axis = is_vertical_pass ? int2(0, 1) : int2(1, 0);
+
+  /* If bounds are extended, then we treat the input as padded by a radius amount of pixels along
+   * the blur axis, so we load the input with an offset by the radius amount and fallback to a
+   * transparent color if it is out of bounds. */
+  const int blur_size = weights_data.size() - 1;
+  const auto load_input = [&](const int2 texel) {
+    const float4 color = extend_bounds ?
+                             input.load_pixel_fallback(texel - axis * blur_size, float4(0.0f)) :
+                             input.load_pixel_extended(texel);
+    return gamma_correct_input ? gamma_correct_blur_input(color) : color;
+  };
+
+  parallel_for(output.domain().size, [&](const int2 texel) {
+    float4 accumulated_color = load_input(texel) * weights_data[0];
+    for (const int i : weights_data.index_range().drop_front(1)) {
+      accumulated_color += load_input(texel + axis * i) * weights_data[i];
+      accumulated_color += load_input(texel - axis * i) * weights_data[i];
+    }
+
+    if (gamma_uncorrect_output) {
+      accumulated_color = gamma_uncorrect_blur_output(accumulated_color);
+    }
+
+    output.store_pixel(texel, accumulated_color);
+  });
+}
+
+static void symmetric_separable_blur_cpu(Context &context,
+                                         Result &input,
+                                         Result &output,
+                                         float2 radius,
+                                         int filter_type,
+                                         bool extend_bounds,
+                                         bool gamma_correct)
+{
+  const SymmetricSeparableBlurWeights &horizontal_weights =
+      context.cache_manager().symmetric_separable_blur_weights.get(context, filter_type, radius.x);
+  const SymmetricSeparableBlurWeights &vertical_weights =
+      context.cache_manager().symmetric_separable_blur_weights.get(context, filter_type, radius.y);
+
+  Domain domain = input.domain();
+  if (extend_bounds) {
+    domain.size.x += int(math::ceil(radius.x)) * 2;
+  }
+
+  Result horizontal_pass_result = context.create_result(input.type());
+  horizontal_pass_result.allocate_texture(domain);
+  blur_pass_cpu(input,
+                horizontal_pass_result,
+                horizontal_weights,
+                false,
+                extend_bounds,
+                gamma_correct,
+                false);
+
+  if (extend_bounds) {
+    domain.size.y += int(math::ceil(radius.y)) * 2;
+  }
+
+  output.allocate_texture(domain);
+  blur_pass_cpu(horizontal_pass_result,
+                output,
+                vertical_weights,
+                true,
+                extend_bounds,
+                false,
+                gamma_correct);
+
+  horizontal_pass_result.release();
+}
+
+void symmetric_separable_blur(Context &context,
+                              Result &input,
+                              Result &output,
+                              float2 radius,
+                              int filter_type,
+                              bool extend_bounds,
+                              bool gamma_correct)
+{
+  if (context.use_gpu()) {
+    symmetric_separable_blur_gpu(
+        context, input, output, radius, filter_type, extend_bounds, gamma_correct);
+  }
+  else {
+    symmetric_separable_blur_cpu(
+        context, input, output, radius, filter_type, extend_bounds, gamma_correct);
+  }
+}
+
 }  // namespace blender::realtime_compositor
@@ -6,6 +6,7 @@
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 #include "GPU_shader.hh"
 #include "GPU_texture.hh"
@@ -122,6 +123,77 @@ static void vertical_pass(Context &context,
   radius.unbind_as_texture();
 }
 
+static void symmetric_separable_blur_variable_size_gpu(Context &context,
+                                                       Result &input,
+                                                       Result &output,
+                                                       Result &radius,
+                                                       int filter_type,
+                                                       int weights_resolution)
+{
+  Result horizontal_pass_result = horizontal_pass(
+      context, input, radius, filter_type, weights_resolution);
+  vertical_pass(
+      context, input, horizontal_pass_result, output, radius, filter_type, weights_resolution);
+  horizontal_pass_result.release();
+}
+
+/* Samples the weights at the given normalized coordinate with linear interpolation and extended
+ * boundary condition, identical to sampling the weights texture in the shader. */
+static float sample_weight(Span<float> weights, float coordinate)
+{
+  const float x = math::clamp(coordinate * weights.size() - 0.5f, 0.0f, weights.size() - 1.0f);
+  const int lower_index = int(x);
+  const int upper_index = math::min(lower_index + 1, int(weights.size()) - 1);
+  return math::interpolate(weights[lower_index], weights[upper_index], x - lower_index);
+}
+
+/* Blurs the input along the horizontal or vertical axis, identical to the
+ * compositor_symmetric_separable_blur_variable_size shader but without the transposition, since
+ * the CPU passes can access the image along either axis. */
+static void blur_pass_cpu(const Result &input,
+                          const Result &radius_input,
+                          Result &output,
+                          Span<float> weights,
+                          bool is_vertical_pass)
+{
+  const int2 axis = is_vertical_pass ? int2(0, 1) : int2(1, 0);
+  parallel_for(output.domain().size, [&](const int2 texel) {
+    float accumulated_weight = weights[0];
+    float4 accumulated_color = input.load_pixel(texel) * weights[0];
+
+    const int radius = int(radius_input.load_pixel(texel).x);
+    for (int i = 1; i <= radius; i++) {
+      /* Add 0.5 to evaluate at the center of the pixels. */
+      const float weight = sample_weight(weights, (float(i) + 0.5f) / float(radius + 1));
+      accumulated_color += input.load_pixel_extended(texel + axis * i) * weight;
+      accumulated_color += input.load_pixel_extended(texel - axis * i) * weight;
+      accumulated_weight += weight * 2.0f;
+    }
+
+    output.store_pixel(texel, accumulated_color / accumulated_weight);
+  });
+}
+
+static void symmetric_separable_blur_variable_size_cpu(Context &context,
+                                                       Result &input,
+                                                       Result &output,
+                                                       Result &radius,
+                                                       int filter_type,
+                                                       int weights_resolution)
+{
+  const SymmetricSeparableBlurWeights &weights =
+      context.cache_manager().symmetric_separable_blur_weights.get(
+          context, filter_type, weights_resolution);
+
+  Result horizontal_pass_result = context.create_result(input.type());
+  horizontal_pass_result.allocate_texture(input.domain());
+  blur_pass_cpu(input, radius, horizontal_pass_result, weights.weights(), false);
+
+  output.allocate_texture(input.domain());
+  blur_pass_cpu(horizontal_pass_result, radius, output, weights.weights(), true);
+  horizontal_pass_result.release();
+}
+
 void symmetric_separable_blur_variable_size(Context &context,
                                             Result &input,
                                             Result &output,
@@ -129,11 +201,14 @@ void symmetric_separable_blur_variable_size(Context &context,
                                             int filter_type,
                                             int weights_resolution)
 {
-  Result horizontal_pass_result = horizontal_pass(
-      context, input, radius, filter_type, weights_resolution);
-  vertical_pass(
-      context, input, horizontal_pass_result, output, radius, filter_type, weights_resolution);
-  horizontal_pass_result.release();
+  if (context.use_gpu()) {
+    symmetric_separable_blur_variable_size_gpu(
+        context, input, output, radius, filter_type, weights_resolution);
+  }
+  else {
+    symmetric_separable_blur_variable_size_cpu(
+        context, input, output, radius, filter_type, weights_resolution);
+  }
 }
 
 }  // namespace blender::realtime_compositor
@@ -2,9 +2,13 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
+#include "BLI_index_range.hh"
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_task.hh"
 
 #include "GPU_shader.hh"
 
@@ -59,7 +63,7 @@ static void sum_causal_and_non_causal_results(Context &context,
   output.unbind_as_image();
 }
 
-static void blur_pass(Context &context, Result &input, Result &output, float sigma)
+static void blur_pass_gpu(Context &context, Result &input, Result &output, float sigma)
 {
   GPUShader *shader = context.get_shader("compositor_van_vliet_gaussian_blur");
   GPU_shader_bind(shader);
@@ -140,6 +144,124 @@ static void blur_pass(Context &context, Result &input, Result &output, float sig
   second_non_causal_result.release();
 }
 
+/* The state of one of the second order filters that compose the Van Vliet filter, holding the last
+ * filter_order inputs and outputs along with the current ones at index 0. See the
+ * compositor_van_vliet_gaussian_blur shader for more information. */
+class SecondOrderFilter {
+ private:
+  static constexpr int filter_order = 2;
+
+  float2 feedforward_coefficients_;
+  float2 feedback_coefficients_;
+  /* The non causal filter ignores the current input and starts from the previous input. */
+  int first_input_index_;
+  float4 inputs_[filter_order + 1];
+  float4 outputs_[filter_order + 1];
+
+ public:
+  /* Initialize the filter assuming Neumann boundary condition, that is, all inputs are initialized
+   * by the boundary pixel and all outputs by the boundary pixel multiplied by the boundary
+   * coefficient. */
+  SecondOrderFilter(const double2 &feedforward_coefficients,
+                    const double2 &feedback_coefficients,
+                    double boundary_coefficient,
+                    bool is_causal,
+                    const float4 &boundary)
+      : feedforward_coefficients_(float2(feedforward_coefficients)),
+        feedback_coefficients_(float2(feedback_coefficients)),
+        first_input_index_(is_causal ? 0 : 1)
+  {
+    for (const int i : IndexRange(filter_order + 1)) {
+      inputs_[i] = boundary;
+      outputs_[i] = boundary * float(boundary_coefficient);
+    }
+  }
+
+  /* Feed the given input to the filter and return its output. */
+  float4 filter(const float4 &input)
+  {
+    inputs_[0] = input;
+    outputs_[0] = float4(0.0f);
+    for (const int i : IndexRange(filter_order)) {
+      outputs_[0] += feedforward_coefficients_[i] * inputs_[first_input_index_ + i];
+      outputs_[0] -= feedback_coefficients_[i] * outputs_[i + 1];
+    }
+    const float4 output = outputs_[0];
+
+    for (int i = filter_order; i >= 1; i--) {
+      inputs_[i] = inputs_[i - 1];
+      outputs_[i] = outputs_[i - 1];
+    }
+
+    return output;
+  }
+};
+
+/* A CPU implementation of the compositor_van_vliet_gaussian_blur shader and the sum shader, see
+ * the shader for more information. The four filters of each row are computed by the same thread,
+ * the causal filters are written to a temporary row buffer, while the non causal filters are added
+ * to it and the sum is written to the output transposed. See the
+ * sum_causal_and_non_causal_results function for the rational behind the transposition. */
+static void blur_pass_cpu(Context &context, Result &input, Result &output, float sigma)
+{
+  const VanVlietGaussianCoefficients &coefficients =
+      context.cache_manager().van_vliet_gaussian_coefficients.get(context, sigma);
+
+  const int2 size = input.domain().size;
+  output.allocate_texture(int2(size.y, size.x));
+
+  threading::parallel_for(IndexRange(size.y), 1, [&](const IndexRange sub_y_range) {
+    Array<float4> causal_row(size.x);
+    for (const int64_t y : sub_y_range) {
+      const float4 causal_boundary = input.load_pixel(int2(0, y));
+      SecondOrderFilter first_causal_filter(coefficients.first_causal_feedforward_coefficients(),
+                                            coefficients.first_feedback_coefficients(),
+                                            coefficients.first_causal_boundary_coefficient(),
+                                            true,
+                                            causal_boundary);
+      SecondOrderFilter second_causal_filter(coefficients.second_causal_feedforward_coefficients(),
+                                             coefficients.second_feedback_coefficients(),
+                                             coefficients.second_causal_boundary_coefficient(),
+                                             true,
+                                             causal_boundary);
+      for (const int64_t x : IndexRange(size.x)) {
+        const float4 color = input.load_pixel(int2(x, y));
+        causal_row[x] = first_causal_filter.filter(color) + second_causal_filter.filter(color);
+      }
+
+      const float4 non_causal_boundary = input.load_pixel(int2(size.x - 1, y));
+      SecondOrderFilter first_non_causal_filter(
+          coefficients.first_non_causal_feedforward_coefficients(),
+          coefficients.first_feedback_coefficients(),
+          coefficients.first_non_causal_boundary_coefficient(),
+          false,
+          non_causal_boundary);
+      SecondOrderFilter second_non_causal_filter(
+          coefficients.second_non_causal_feedforward_coefficients(),
+          coefficients.second_feedback_coefficients(),
+          coefficients.second_non_causal_boundary_coefficient(),
+          false,
+          non_causal_boundary);
+      for (int64_t x = size.x - 1; x >= 0; x--) {
+        const float4 color = input.load_pixel(int2(x, y));
+        const float4 non_causal_output = first_non_causal_filter.filter(color) +
+                                         second_non_causal_filter.filter(color);
+        output.store_pixel(int2(y, x), causal_row[x] + non_causal_output);
+      }
+    }
+  });
+}
+
+static void blur_pass(Context &context, Result &input, Result &output, float sigma)
+{
+  if (context.use_gpu()) {
+    blur_pass_gpu(context, input, output, sigma);
+  }
+  else {
+    blur_pass_cpu(context, input, output, sigma);
+  }
+}
+
 void van_vliet_gaussian_blur(Context &context, Result &input, Result &output, float2 sigma)
 {
   BLI_assert_msg(math::reduce_max(sigma) >= 32.0f,
@@ -7,8 +7,10 @@
 #include <cstdint>
 #include <memory>
 
+#include "BLI_array.hh"
 #include "BLI_map.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 #include "GPU_shader.hh"
 #include "GPU_texture.hh"
@@ -41,15 +43,17 @@ bool operator==(const SymmetricSeparableBlurWeightsKey &a,
 /* -------------------------------------------------------------------- */
 /** \name Symmetric Separable Blur Weights
  *
- * A cached resource that computes and caches a 1D GPU texture containing the weights of the
- * separable filter of the given type and radius. The filter is assumed to be symmetric, because
- * the filter functions are all even functions. Consequently, only the positive half of the filter
- * is computed and the shader takes that into consideration.
+ * A cached resource that computes and caches the weights of the separable filter of the given type
+ * and radius, stored in a 1D GPU texture if the context uses the GPU and in an array otherwise.
+ * The filter is assumed to be symmetric, because the filter functions are all even functions.
+ * Consequently, only the positive half of the filter is computed and the shader takes that into
+ * consideration.
  * \{ */
 
 class SymmetricSeparableBlurWeights : public CachedResource {
  private:
   GPUTexture *texture_ = nullptr;
+  Array<float> weights_;
 
  public:
   SymmetricSeparableBlurWeights(Context &context, int type, float radius);
@@ -59,6 +63,10 @@ class SymmetricSeparableBlurWeights : public CachedResource {
   void bind_as_texture(GPUShader *shader, const char *texture_name) const;
 
   void unbind_as_texture() const;
+
+  /* Returns the weights of the positive half of the filter, starting with the center weight. Only
+   * valid if the context doesn't use the GPU. */
+  Span<float> weights() const;
 };
 
 /** \} */
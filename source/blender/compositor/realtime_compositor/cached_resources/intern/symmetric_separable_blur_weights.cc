@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <utility>
 
 #include "BLI_array.hh"
 #include "BLI_hash.hh"
@@ -77,6 +78,11 @@ SymmetricSeparableBlurWeights::SymmetricSeparableBlurWeights(Context &context,
     weights[i] /= sum;
   }
 
+  if (!context.use_gpu()) {
+    weights_ = std::move(weights);
+    return;
+  }
+
   texture_ = GPU_texture_create_1d(
       "Weights",
       size,
@@ -90,7 +96,9 @@ SymmetricSeparableBlurWeights::SymmetricSeparableBlurWeights(Context &context,
 
 SymmetricSeparableBlurWeights::~SymmetricSeparableBlurWeights()
 {
-  GPU_texture_free(texture_);
+  if (texture_) {
+    GPU_texture_free(texture_);
+  }
 }
 
 void SymmetricSeparableBlurWeights::bind_as_texture(GPUShader *shader,
@@ -105,6 +113,11 @@ void SymmetricSeparableBlurWeights::unbind_as_texture() const
   GPU_texture_unbind(texture_);
 }
 
+Span<float> SymmetricSeparableBlurWeights::weights() const
+{
+  return weights_;
+}
+
 /* --------------------------------------------------------------------
  * Symmetric Separable Blur Weights Container.
  */
@@ -26,6 +26,16 @@ void Profiler::set_node_evaluation_time(bNodeInstanceKey node_instance_key,
   nodes_evaluation_times_.lookup_or_add(node_instance_key, timeit::Nanoseconds::zero()) += time;
 }
 
+Set<bNodeInstanceKey> &Profiler::get_cached_nodes()
+{
+  return cached_nodes_;
+}
+
+void Profiler::set_node_cached(bNodeInstanceKey node_instance_key)
+{
+  cached_nodes_.add(node_instance_key);
+}
+
 timeit::Nanoseconds Profiler::accumulate_node_group_times(const bNodeTree &node_tree,
                                                           bNodeInstanceKey instance_key)
 {
@@ -7,6 +7,7 @@
 #include "BLI_assert.h"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
 
 #include "GPU_shader.hh"
@@ -720,6 +721,12 @@ float *Result::float_texture()
   return float_texture_;
 }
 
+int *Result::integer_texture()
+{
+  BLI_assert(storage_type_ == ResultStorageType::IntegerCPU);
+  return integer_texture_;
+}
+
 float4 Result::load_pixel(const int2 &texel) const
 {
   float4 pixel_value = float4(0.0f, 0.0f, 0.0f, 1.0f);
@@ -732,11 +739,51 @@ float4 Result::load_pixel(const int2 &texel) const
   return pixel_value;
 }
 
+float4 Result::load_pixel_extended(const int2 &texel) const
+{
+  return this->load_pixel(math::clamp(texel, int2(0), domain_.size - int2(1)));
+}
+
+float4 Result::load_pixel_fallback(const int2 &texel, const float4 &fallback) const
+{
+  if (is_single_value_) {
+    return this->load_pixel(texel);
+  }
+
+  if (texel.x < 0 || texel.y < 0 || texel.x >= domain_.size.x || texel.y >= domain_.size.y) {
+    return fallback;
+  }
+
+  return this->load_pixel(texel);
+}
+
+int2 Result::load_integer_pixel(const int2 &texel) const
+{
+  BLI_assert(type_ == ResultType::Int2);
+  if (is_single_value_) {
+    return int2(integer_texture_);
+  }
+  return int2(integer_texture_ + (int64_t(texel.y) * domain_.size.x + texel.x) * 2);
+}
+
+int2 Result::load_integer_pixel_extended(const int2 &texel) const
+{
+  return this->load_integer_pixel(math::clamp(texel, int2(0), domain_.size - int2(1)));
+}
+
 void Result::store_pixel(const int2 &texel, const float4 &pixel_value)
 {
   this->copy_pixel(this->get_float_pixel(texel), pixel_value);
 }
 
+void Result::store_integer_pixel(const int2 &texel, const int2 &pixel_value)
+{
+  BLI_assert(type_ == ResultType::Int2);
+  int *pixel = integer_texture_ + (int64_t(texel.y) * domain_.size.x + texel.x) * 2;
+  pixel[0] = pixel_value.x;
+  pixel[1] = pixel_value.y;
+}
+
 void Result::allocate_data(int2 size, bool from_pool)
 {
   if (context_->use_gpu()) {
@@ -0,0 +1,106 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "COM_FullFrameExecutionModel.h"
+#include "COM_InvertOperation.h"
+#include "COM_RotateOperation.h"
+#include "COM_SetValueOperation.h"
+
+namespace blender::compositor::tests {
+
+class ImageOperation : public NodeOperation {
+ public:
+  ImageOperation()
+  {
+    add_output_socket(DataType::Color);
+    set_canvas({0, 64, 0, 64});
+  }
+};
+
+class OutputOperation : public NodeOperation {
+ public:
+  OutputOperation()
+  {
+    add_input_socket(DataType::Color);
+    add_input_socket(DataType::Color);
+    set_canvas({0, 64, 0, 64});
+  }
+
+  bool is_output_operation(bool /*rendering*/) const override
+  {
+    return true;
+  }
+};
+
+/* Image buffer of 64x64 color pixels. */
+constexpr int64_t image_buffer_size = 64 * 64 * 4 * sizeof(float);
+
+/* Rotated image is read outside of the tile areas, inverted image is only read in them. */
+struct TransformAndInvertGraph {
+  ImageOperation rotated_image;
+  ImageOperation inverted_image;
+  SetValueOperation value;
+  RotateOperation rotate;
+  InvertOperation invert;
+  OutputOperation output;
+
+  TransformAndInvertGraph()
+  {
+    rotate.get_input_socket(0)->set_link(rotated_image.get_output_socket());
+    rotate.get_input_socket(1)->set_link(value.get_output_socket());
+    rotate.set_canvas({0, 64, 0, 64});
+    invert.get_input_socket(0)->set_link(value.get_output_socket());
+    invert.get_input_socket(1)->set_link(inverted_image.get_output_socket());
+    invert.set_canvas({0, 64, 0, 64});
+    output.get_input_socket(0)->set_link(rotate.get_output_socket());
+    output.get_input_socket(1)->set_link(invert.get_output_socket());
+  }
+
+  Vector<NodeOperation *> operations()
+  {
+    return {&rotated_image, &inverted_image, &value, &rotate, &invert, &output};
+  }
+};
+
+TEST(FullFrameExecutionModel, WholeBufferOperations)
+{
+  TransformAndInvertGraph graph;
+  const Set<NodeOperation *> whole_buffer_operations =
+      FullFrameExecutionModel::find_whole_buffer_operations(graph.operations(), false);
+
+  EXPECT_TRUE(whole_buffer_operations.contains(&graph.rotated_image));
+  EXPECT_FALSE(whole_buffer_operations.contains(&graph.inverted_image));
+  EXPECT_FALSE(whole_buffer_operations.contains(&graph.value));
+  EXPECT_FALSE(whole_buffer_operations.contains(&graph.rotate));
+  EXPECT_FALSE(whole_buffer_operations.contains(&graph.invert));
+}
+
+TEST(FullFrameExecutionModel, NumTilesWithWholeBuffers)
+{
+  TransformAndInvertGraph graph;
+  const Vector<NodeOperation *> operations = graph.operations();
+  const Set<NodeOperation *> whole_buffer_operations =
+      FullFrameExecutionModel::find_whole_buffer_operations(operations, false);
+
+  /* Without memory for the whole buffer of the rotated image, only the partial buffers of the
+   * three other operations with outputs get smaller. */
+  const int64_t partial_buffers_size = image_buffer_size * 3;
+  EXPECT_EQ(FullFrameExecutionModel::calc_num_tiles(
+                operations, whole_buffer_operations, image_buffer_size * 4, false),
+            1);
+  EXPECT_EQ(FullFrameExecutionModel::calc_num_tiles(operations,
+                                                    whole_buffer_operations,
+                                                    image_buffer_size + partial_buffers_size / 3,
+                                                    false),
+            3);
+
+  /* The whole buffer alone exceeds a tiny limit, the maximum number of tiles is used. */
+  EXPECT_EQ(FullFrameExecutionModel::calc_num_tiles(
+                operations, whole_buffer_operations, image_buffer_size / 2, false),
+            64);
+}
+
+}  // namespace blender::compositor::tests
@@ -0,0 +1,68 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+
+#include "COM_FusedOperation.h"
+#include "COM_MathBaseOperation.h"
+#include "COM_SetValueOperation.h"
+
+namespace blender::compositor::tests {
+
+static void fill_value_buffer(MemoryBuffer &buffer, const rcti &area, const int seed)
+{
+  for (int y = area.ymin; y < area.ymax; y++) {
+    for (int x = area.xmin; x < area.xmax; x++) {
+      *buffer.get_elem(x, y) = float((x * 7 + y * 13 + seed) % 17);
+    }
+  }
+}
+
+/* Area taller than one row chunk of the fused operation, so that several chunks are evaluated. */
+TEST(FusedOperation, MultiplyAddChain)
+{
+  const rcti area = {0, 100, 0, 301};
+
+  /* Sources of the external inputs, only used for their output sockets. */
+  SetValueOperation sources[5];
+
+  MathMultiplyOperation *multiply = new MathMultiplyOperation();
+  MathAddOperation *add = new MathAddOperation();
+  multiply->get_input_socket(0)->set_link(sources[0].get_output_socket());
+  multiply->get_input_socket(1)->set_link(sources[1].get_output_socket());
+  multiply->get_input_socket(2)->set_link(sources[2].get_output_socket());
+  add->get_input_socket(0)->set_link(multiply->get_output_socket());
+  add->get_input_socket(1)->set_link(sources[3].get_output_socket());
+  add->get_input_socket(2)->set_link(sources[4].get_output_socket());
+
+  const Vector<MultiThreadedOperation *> stages = {multiply, add};
+  FusedOperation fused(stages);
+  EXPECT_EQ(fused.get_number_of_stages(), 2);
+  ASSERT_EQ(fused.get_number_of_input_sockets(), 5);
+  EXPECT_EQ(fused.get_stage_input(0), multiply->get_input_socket(0));
+  EXPECT_EQ(fused.get_stage_input(3), add->get_input_socket(1));
+
+  Array<std::unique_ptr<MemoryBuffer>> inputs(5);
+  Vector<MemoryBuffer *> input_ptrs;
+  for (int i = 0; i < 5; i++) {
+    inputs[i] = std::make_unique<MemoryBuffer>(DataType::Value, area);
+    fill_value_buffer(*inputs[i], area, i);
+    input_ptrs.append(inputs[i].get());
+  }
+
+  MemoryBuffer output(DataType::Value, area);
+  fused.update_memory_buffer_partial(&output, area, input_ptrs);
+
+  for (int y = area.ymin; y < area.ymax; y++) {
+    for (int x = area.xmin; x < area.xmax; x++) {
+      const float expected = *inputs[0]->get_elem(x, y) * *inputs[1]->get_elem(x, y) +
+                             *inputs[3]->get_elem(x, y);
+      EXPECT_FLOAT_EQ(*output.get_elem(x, y), expected);
+    }
+  }
+}
+
+}  // namespace blender::compositor::tests
@@ -149,4 +149,34 @@ TEST(NodeOperation, generate_hash)
   }
 }
 
+TEST(NodeOperation, generate_cache_key)
+{
+  Map<NodeOperation *, uint64_t> keys;
+
+  /* Non constant inputs without a key. */
+  NonHashedOperation input_op1(1);
+  HashedOperation op1(input_op1, 6, 4);
+  EXPECT_EQ(op1.generate_cache_key(keys), std::nullopt);
+
+  /* Inputs are identified by their keys instead of their ids. */
+  NonHashedOperation input_op2(2);
+  HashedOperation op2(input_op2, 6, 4);
+  keys.add(&input_op1, 10);
+  keys.add(&input_op2, 10);
+  std::optional<uint64_t> key1 = op1.generate_cache_key(keys);
+  EXPECT_NE(key1, std::nullopt);
+  EXPECT_EQ(key1, op2.generate_cache_key(keys));
+
+  keys.add_overwrite(&input_op2, 20);
+  EXPECT_NE(key1, op2.generate_cache_key(keys));
+
+  /* Constant inputs are identified by their values. */
+  NonHashedConstantOperation constant_op(3);
+  HashedOperation op3(constant_op, 6, 4);
+  key1 = op3.generate_cache_key(keys);
+  EXPECT_NE(key1, std::nullopt);
+  constant_op.set_constant(3.0f);
+  EXPECT_NE(key1, op3.generate_cache_key(keys));
+}
+
 }  // namespace blender::compositor::tests
@@ -0,0 +1,282 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cfloat>
+
+#include "BLI_hash.hh"
+#include "BLI_math_base.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+
+#include "DNA_node_types.h"
+#include "DNA_scene_types.h"
+
+#include "COM_context.hh"
+#include "COM_result.hh"
+#include "COM_texture_pool.hh"
+
+#include "COM_algorithm_morphological_distance.hh"
+#include "COM_algorithm_summed_area_table.hh"
+#include "COM_algorithm_symmetric_separable_blur.hh"
+#include "COM_symmetric_separable_blur_weights.hh"
+
+namespace blender::realtime_compositor::tests {
+
+/* The CPU algorithms are tested against straightforward implementations of the shaders of their
+ * GPU counterparts, since a GPU context is not available in tests. */
+
+class CPUTexturePool : public TexturePool {
+  GPUTexture *allocate_texture(int2 /*size*/, eGPUTextureFormat /*format*/) override
+  {
+    BLI_assert_unreachable();
+    return nullptr;
+  }
+};
+
+class CPUContext : public Context {
+ private:
+  Scene scene_ = {};
+  bNodeTree node_tree_ = {};
+
+ public:
+  CPUContext(TexturePool &texture_pool) : Context(texture_pool) {}
+
+  const Scene &get_scene() const override
+  {
+    return scene_;
+  }
+
+  const bNodeTree &get_node_tree() const override
+  {
+    return node_tree_;
+  }
+
+  bool use_gpu() const override
+  {
+    return false;
+  }
+
+  bool use_file_output() const override
+  {
+    return false;
+  }
+
+  bool should_compute_node_previews() const override
+  {
+    return false;
+  }
+
+  bool use_composite_output() const override
+  {
+    return false;
+  }
+
+  const RenderData &get_render_data() const override
+  {
+    return scene_.r;
+  }
+
+  int2 get_render_size() const override
+  {
+    return int2(0);
+  }
+
+  rcti get_compositing_region() const override
+  {
+    return rcti{0, 0, 0, 0};
+  }
+
+  Result get_output_result() override
+  {
+    return create_result(ResultType::Color);
+  }
+
+  Result get_viewer_output_result(Domain /*domain*/, bool /*is_data*/) override
+  {
+    return create_result(ResultType::Color);
+  }
+
+  GPUTexture *get_input_texture(const Scene * /*scene*/,
+                                int /*view_layer*/,
+                                const char * /*pass_name*/) override
+  {
+    return nullptr;
+  }
+
+  StringRef get_view_name() const override
+  {
+    return "";
+  }
+
+  ResultPrecision get_precision() const override
+  {
+    return ResultPrecision::Full;
+  }
+
+  void set_info_message(StringRef /*message*/) const override {}
+
+  IDRecalcFlag query_id_recalc_flag(ID * /*id*/) const override
+  {
+    return IDRecalcFlag(0);
+  }
+};
+
+/* Returns a result of the given type and size filled with pseudo random values in the [0, 1]
+ * range, where values are rounded to the given number of levels if it is not zero. */
+static Result create_random_result(Context &context, ResultType type, int2 size, int levels = 0)
+{
+  Result result = context.create_result(type);
+  result.allocate_texture(Domain(size));
+  for (const int y : IndexRange(size.y)) {
+    for (const int x : IndexRange(size.x)) {
+      float4 value;
+      for (const int i : IndexRange(4)) {
+        value[i] = float(get_default_hash(x, y, i) % 1024) / 1023.0f;
+        if (levels != 0) {
+          value[i] = math::round(value[i] * levels) / levels;
+        }
+      }
+      result.store_pixel(int2(x, y), value);
+    }
+  }
+  return result;
+}
+
+TEST(RealtimeCompositorAlgorithms, MorphologicalDistanceCPU)
+{
+  CPUTexturePool texture_pool;
+  CPUContext context(texture_pool);
+
+  const int2 size = int2(41, 23);
+  Result input = create_random_result(context, ResultType::Float, size, 4);
+
+  for (const int distance : {1, -1, 3, -4, 7, -9, 30}) {
+    Result output = context.create_result(ResultType::Float);
+    morphological_distance(context, input, output, distance);
+
+    /* Identical to the compositor_morphological_distance shader. */
+    const int radius = math::abs(distance);
+    const float limit = distance > 0 ? FLT_MIN : FLT_MAX;
+    for (const int y : IndexRange(size.y)) {
+      for (const int x : IndexRange(size.x)) {
+        float expected_value = limit;
+        for (int j = -radius; j <= radius; j++) {
+          for (int i = -radius; i <= radius; i++) {
+            if (i * i + j * j <= radius * radius) {
+              const float value =
+                  input.load_pixel_fallback(int2(x + i, y + j), float4(limit)).x;
+              expected_value = distance > 0 ? math::max(expected_value, value) :
+                                              math::min(expected_value, value);
+            }
+          }
+        }
+        EXPECT_EQ(output.load_pixel(int2(x, y)).x, expected_value);
+      }
+    }
+
+    output.release();
+  }
+
+  input.release();
+}
+
+TEST(RealtimeCompositorAlgorithms, SymmetricSeparableBlurCPU)
+{
+  CPUTexturePool texture_pool;
+  CPUContext context(texture_pool);
+
+  const int2 size = int2(19, 27);
+  Result input = create_random_result(context, ResultType::Color, size);
+
+  for (const bool extend_bounds : {false, true}) {
+    const float2 radius = float2(3.0f, 5.5f);
+    Result output = context.create_result(ResultType::Color);
+    symmetric_separable_blur(context, input, output, radius, R_FILTER_GAUSS, extend_bounds);
+
+    const int2 blur_size = int2(math::ceil(radius));
+    const int2 expected_size = extend_bounds ? size + blur_size * 2 : size;
+    EXPECT_EQ(output.domain().size, expected_size);
+
+    const Span<float> horizontal_weights =
+        context.cache_manager()
+            .symmetric_separable_blur_weights.get(context, R_FILTER_GAUSS, radius.x)
+            .weights();
+    const Span<float> vertical_weights =
+        context.cache_manager()
+            .symmetric_separable_blur_weights.get(context, R_FILTER_GAUSS, radius.y)
+            .weights();
+
+    /* A direct 2D convolution with the outer product of the weights of both directions. */
+    for (const int y : IndexRange(expected_size.y)) {
+      for (const int x : IndexRange(expected_size.x)) {
+        float4 expected_color = float4(0.0f);
+        for (int j = -blur_size.y; j <= blur_size.y; j++) {
+          for (int i = -blur_size.x; i <= blur_size.x; i++) {
+            const int2 texel = int2(x + i, y + j);
+            const float4 color = extend_bounds ?
+                                     input.load_pixel_fallback(texel - blur_size, float4(0.0f)) :
+                                     input.load_pixel_extended(texel);
+            expected_color += color * horizontal_weights[math::abs(i)] *
+                              vertical_weights[math::abs(j)];
+          }
+        }
+
+        const float4 color = output.load_pixel(int2(x, y));
+        for (const int i : IndexRange(4)) {
+          EXPECT_NEAR(color[i], expected_color[i], 1e-5f);
+        }
+      }
+    }
+
+    output.release();
+  }
+
+  input.release();
+}
+
+TEST(RealtimeCompositorAlgorithms, SummedAreaTableSumCPU)
+{
+  CPUTexturePool texture_pool;
+  CPUContext context(texture_pool);
+
+  const int2 size = int2(17, 13);
+  Result input = create_random_result(context, ResultType::Color, size);
+
+  Result table = context.create_result(ResultType::Color);
+  summed_area_table(context, input, table);
+
+  /* Regions that are inside the image as well as regions that cross its bounds, whose out of
+   * bound pixels are considered zero. */
+  const int2 regions[][2] = {
+      {int2(0, 0), int2(0, 0)},
+      {int2(3, 2), int2(9, 11)},
+      {int2(-4, -2), int2(5, 6)},
+      {int2(10, 8), int2(25, 20)},
+      {int2(-3, -3), int2(20, 20)},
+  };
+  for (const auto &region : regions) {
+    const int2 lower_bound = region[0];
+    const int2 upper_bound = region[1];
+
+    float4 expected_sum = float4(0.0f);
+    for (int y = lower_bound.y; y <= upper_bound.y; y++) {
+      for (int x = lower_bound.x; x <= upper_bound.x; x++) {
+        expected_sum += input.load_pixel_fallback(int2(x, y), float4(0.0f));
+      }
+    }
+
+    const float4 sum = summed_area_table_sum(table, lower_bound, upper_bound);
+    for (const int i : IndexRange(4)) {
+      EXPECT_NEAR(sum[i], expected_sum[i], 1e-4f);
+    }
+  }
+
+  table.release();
+  input.release();
+}
+
+}  // namespace blender::realtime_compositor::tests
@@ -0,0 +1,144 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_NodeOperation.h"
+#include "COM_SharedOperationBuffers.h"
+
+namespace blender::compositor::tests {
+
+class CanvasOperation : public NodeOperation {
+ public:
+  CanvasOperation()
+  {
+    add_output_socket(DataType::Value);
+    set_canvas({0, 4, 0, 4});
+  }
+};
+
+static std::unique_ptr<MemoryBuffer> create_buffer(const rcti &rect)
+{
+  return std::make_unique<MemoryBuffer>(DataType::Value, rect);
+}
+
+TEST(SharedOperationBuffers, KeepWholeBuffers)
+{
+  CanvasOperation whole_op;
+  CanvasOperation partial_op;
+  const rcti canvas = whole_op.get_canvas();
+  const rcti half = {0, 4, 0, 2};
+
+  SharedOperationBuffers buffers;
+  buffers.set_keep_whole_buffers(true);
+  buffers.register_area(&whole_op, canvas);
+  buffers.register_area(&partial_op, half);
+  buffers.register_read(&whole_op);
+  buffers.register_read(&partial_op);
+  buffers.set_rendered_buffer(&whole_op, create_buffer(canvas));
+  buffers.set_rendered_buffer(&partial_op, create_buffer(half));
+
+  /* Buffers covering the whole canvas are not disposed once read. */
+  buffers.read_started(&whole_op);
+  buffers.read_started(&partial_op);
+  buffers.read_finished(&whole_op);
+  buffers.read_finished(&partial_op);
+  EXPECT_NE(buffers.get_rendered_buffer(&whole_op), nullptr);
+  EXPECT_EQ(buffers.get_rendered_buffer(&partial_op), nullptr);
+
+  buffers.clear_partial_buffers();
+  EXPECT_TRUE(buffers.is_operation_rendered(&whole_op));
+  EXPECT_TRUE(buffers.is_area_registered(&whole_op, half));
+  EXPECT_FALSE(buffers.has_registered_reads(&whole_op));
+  EXPECT_FALSE(buffers.is_operation_rendered(&partial_op));
+  EXPECT_FALSE(buffers.is_area_registered(&partial_op, half));
+}
+
+TEST(SharedOperationBuffers, DisposeWholeBuffers)
+{
+  CanvasOperation op;
+  const rcti canvas = op.get_canvas();
+
+  SharedOperationBuffers buffers;
+  buffers.register_area(&op, canvas);
+  buffers.register_read(&op);
+  buffers.set_rendered_buffer(&op, create_buffer(canvas));
+  buffers.read_started(&op);
+  buffers.read_finished(&op);
+  EXPECT_EQ(buffers.get_rendered_buffer(&op), nullptr);
+}
+
+TEST(SharedOperationBuffers, CompressIdleBuffers)
+{
+  CanvasOperation op;
+  const rcti canvas = op.get_canvas();
+
+  SharedOperationBuffers buffers;
+  buffers.set_compress_idle_buffers(true);
+  buffers.register_area(&op, canvas);
+  for (int i = 0; i < 3; i++) {
+    buffers.register_read(&op);
+  }
+
+  std::unique_ptr<MemoryBuffer> buffer = create_buffer(canvas);
+  *buffer->get_elem(1, 2) = 0.5f;
+  buffers.set_rendered_buffer(&op, std::move(buffer));
+  MemoryBuffer *rendered_buffer = buffers.get_rendered_buffer(&op);
+  EXPECT_FALSE(rendered_buffer->is_half_float());
+  const int64_t full_float_size = rendered_buffer->get_memory_size();
+  EXPECT_EQ(full_float_size, int64_t(4 * 4 * sizeof(float)));
+
+  /* Buffers whose readers are ready to render are not compressed. */
+  buffers.read_scheduled(&op);
+  EXPECT_EQ(buffers.get_idle_buffer_compression(&op), nullptr);
+  buffers.read_started(&op);
+  EXPECT_EQ(buffers.get_idle_buffer_compression(&op), nullptr);
+  buffers.read_finished(&op);
+
+  /* Buffers waiting for readers are compressed to half precision until the next read. */
+  IdleBufferCompression *compression = buffers.get_idle_buffer_compression(&op);
+  ASSERT_NE(compression, nullptr);
+  compression->compress_if_unread();
+  EXPECT_TRUE(rendered_buffer->is_half_float());
+  EXPECT_EQ(rendered_buffer->get_memory_size(), full_float_size / 2);
+
+  /* Reads started after the buffer was found idle prevent the compression. */
+  buffers.read_started(&op);
+  compression->decompress();
+  EXPECT_FALSE(rendered_buffer->is_half_float());
+  EXPECT_EQ(rendered_buffer->get_memory_size(), full_float_size);
+  EXPECT_EQ(*rendered_buffer->get_elem(1, 2), 0.5f);
+  compression->compress_if_unread();
+  EXPECT_FALSE(rendered_buffer->is_half_float());
+  buffers.read_finished(&op);
+
+  buffers.read_started(&op);
+  buffers.read_finished(&op);
+  EXPECT_EQ(buffers.get_rendered_buffer(&op), nullptr);
+  EXPECT_EQ(buffers.get_idle_buffer_compression(&op), nullptr);
+}
+
+TEST(SharedOperationBuffers, CompressIdleBuffersOutOfRange)
+{
+  CanvasOperation op;
+  const rcti canvas = op.get_canvas();
+
+  SharedOperationBuffers buffers;
+  buffers.set_compress_idle_buffers(true);
+  buffers.register_area(&op, canvas);
+  buffers.register_read(&op);
+
+  /* Values half floats can't represent, like depths, keep the buffer in full precision. */
+  std::unique_ptr<MemoryBuffer> buffer = create_buffer(canvas);
+  *buffer->get_elem(1, 2) = 100000.0f;
+  buffers.set_rendered_buffer(&op, std::move(buffer));
+  IdleBufferCompression *compression = buffers.get_idle_buffer_compression(&op);
+  ASSERT_NE(compression, nullptr);
+  compression->compress_if_unread();
+  EXPECT_FALSE(buffers.get_rendered_buffer(&op)->is_half_float());
+  EXPECT_EQ(*buffers.get_rendered_buffer(&op)->get_elem(1, 2), 100000.0f);
+}
+
+}  // namespace blender::compositor::tests
@@ -7282,6 +7282,17 @@ void uiTemplateCacheFileTimeSettings(uiLayout *layout, PointerRNA *fileptr)
   row = uiLayoutRow(layout, false);
   uiItemR(row, fileptr, "frame_offset", UI_ITEM_NONE, nullptr, ICON_NONE);
   uiLayoutSetActive(row, !RNA_boolean_get(fileptr, "is_sequence"));
+
+  /* File sequences are not read ahead. */
+  row = uiLayoutRow(layout, false);
+  uiItemR(row, fileptr, "use_read_ahead", UI_ITEM_NONE, nullptr, ICON_NONE);
+  uiLayoutSetActive(row, !RNA_boolean_get(fileptr, "is_sequence"));
+
+  sub = uiLayoutRow(layout, false);
+  uiItemR(sub, fileptr, "read_ahead_cache_size", UI_ITEM_NONE, nullptr, ICON_NONE);
+  uiLayoutSetActive(sub,
+                    RNA_boolean_get(fileptr, "use_read_ahead") &&
+                        !RNA_boolean_get(fileptr, "is_sequence"));
 }
 
 static void cache_file_layer_item(uiList * /*ui_list*/,
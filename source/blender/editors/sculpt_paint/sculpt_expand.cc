@@ -35,6 +35,8 @@
 #include "BKE_report.hh"
 #include "BKE_subdiv_ccg.hh"
 
+#include "GEO_mesh_distances.hh"
+
 #include "WM_api.hh"
 #include "WM_types.hh"
 
@@ -50,7 +52,6 @@
 #include "sculpt_color.hh"
 #include "sculpt_face_set.hh"
 #include "sculpt_flood_fill.hh"
-#include "sculpt_geodesic.hh"
 #include "sculpt_intern.hh"
 #include "sculpt_islands.hh"
 #include "sculpt_smooth.hh"
@@ -637,8 +638,23 @@ static Vector<int> calc_symmetry_vert_indices(const Depsgraph &depsgraph,
  */
 static Array<float> geodesic_falloff_create(const Depsgraph &depsgraph,
                                             Object &ob,
+                                            Cache &expand_cache,
                                             const IndexMask &initial_verts)
 {
+  Array<int> initial_indices(initial_verts.size());
+  initial_verts.to_indices(initial_indices.as_mutable_span());
+
+  Vector<GeodesicFalloff, EXPAND_GEODESIC_CACHE_SIZE> &falloffs = expand_cache.geodesic_falloffs;
+  for (const int i : falloffs.index_range()) {
+    if (falloffs[i].initial_verts.as_span() == initial_indices.as_span()) {
+      GeodesicFalloff falloff = std::move(falloffs[i]);
+      falloffs.remove(i);
+      Array<float> distances = falloff.distances;
+      falloffs.append(std::move(falloff));
+      return distances;
+    }
+  }
+
   const Mesh &mesh = *static_cast<const Mesh *>(ob.data);
   const Span<float3> vert_positions = bke::pbvh::vert_positions_eval(depsgraph, ob);
   const Span<int2> edges = mesh.edges();
@@ -658,21 +674,27 @@ static Array<float> geodesic_falloff_create(const Depsgraph &depsgraph,
         edges, mesh.verts_num, ss.vert_to_edge_offsets, ss.vert_to_edge_indices);
   }
 
-  Set<int> verts;
-  initial_verts.foreach_index([&](const int vert) { verts.add(vert); });
+  Array<float> distances = geometry::geodesic_distances(vert_positions,
+                                                        edges,
+                                                        faces,
+                                                        corner_verts,
+                                                        ss.vert_to_edge_map,
+                                                        mesh.vert_to_face_map(),
+                                                        ss.edge_to_face_map,
+                                                        hide_poly,
+                                                        initial_verts,
+                                                        FLT_MAX,
+                                                        geometry::GeodesicMethod::Parallel);
 
-  return geodesic::distances_create(vert_positions,
-                                    edges,
-                                    faces,
-                                    corner_verts,
-                                    ss.vert_to_edge_map,
-                                    ss.edge_to_face_map,
-                                    hide_poly,
-                                    verts,
-                                    FLT_MAX);
+  if (falloffs.size() == EXPAND_GEODESIC_CACHE_SIZE) {
+    falloffs.remove(0);
+  }
+  falloffs.append({std::move(initial_indices), distances});
+  return distances;
 }
 static Array<float> geodesic_falloff_create(const Depsgraph &depsgraph,
                                             Object &ob,
+                                            Cache &expand_cache,
                                             const int initial_vert)
 {
   const Vector<int> symm_verts = calc_symmetry_vert_indices(
@@ -681,7 +703,7 @@ static Array<float> geodesic_falloff_create(const Depsgraph &depsgraph,
   IndexMaskMemory memory;
   const IndexMask mask = IndexMask::from_indices(symm_verts.as_span(), memory);
 
-  return geodesic_falloff_create(depsgraph, ob, mask);
+  return geodesic_falloff_create(depsgraph, ob, expand_cache, mask);
 }
 
 /**
@@ -1166,7 +1188,8 @@ static void geodesics_from_state_boundary(const Depsgraph &depsgraph,
 
   expand_cache.face_falloff = {};
 
-  expand_cache.vert_falloff = geodesic_falloff_create(depsgraph, ob, boundary_verts);
+  expand_cache.vert_falloff = geodesic_falloff_create(
+      depsgraph, ob, expand_cache, boundary_verts);
 }
 
 /**
@@ -1363,7 +1386,7 @@ static void calc_falloff_from_vert_and_symmetry(const Depsgraph &depsgraph,
   switch (falloff_type) {
     case FalloffType::Geodesic:
       expand_cache.vert_falloff = has_topology_info ?
-                                      geodesic_falloff_create(depsgraph, ob, vert) :
+                                      geodesic_falloff_create(depsgraph, ob, expand_cache, vert) :
                                       spherical_falloff_create(depsgraph, ob, vert);
       break;
     case FalloffType::Topology:
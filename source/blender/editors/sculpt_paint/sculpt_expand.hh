@@ -11,6 +11,7 @@
 #include "BLI_index_mask.hh"
 #include "BLI_math_vector.hh"
 #include "BLI_set.hh"
+#include "BLI_vector.hh"
 
 #include "BKE_pbvh.hh"
 
@@ -46,6 +47,16 @@ enum class RecursionType {
 
 #define EXPAND_SYMM_AREAS 8
 
+/* Number of geodesic falloffs kept in #Cache::geodesic_falloffs. */
+#define EXPAND_GEODESIC_CACHE_SIZE 2
+
+/* Geodesic distances from a set of initial vertices. */
+struct GeodesicFalloff {
+  /* Sorted indices of the vertices the distances were calculated from. */
+  Array<int> initial_verts;
+  Array<float> distances;
+};
+
 struct Cache {
   /* Target data elements that the expand operation will affect. */
   TargetType target;
@@ -59,6 +70,11 @@ struct Cache {
   /* Max falloff value in *vert_falloff. */
   float max_vert_falloff;
 
+  /* Geodesic falloffs calculated during this operation, most recent last. The positions don't
+   * change while Expand runs, so these are reused when the same initial vertices are requested
+   * again, for example when switching back to the geodesic falloff or moving the origin. */
+  Vector<GeodesicFalloff, EXPAND_GEODESIC_CACHE_SIZE> geodesic_falloffs;
+
   /* Indexed by base mesh face index, precalculated falloff value of that face. These values are
    * calculated from the per vertex falloff (*vert_falloff) when needed. */
   Array<float> face_falloff;
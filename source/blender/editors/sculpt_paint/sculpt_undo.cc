@@ -31,15 +31,21 @@
  */
 #include "sculpt_undo.hh"
 
+#include <atomic>
 #include <mutex>
+#include <optional>
+#include <thread>
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array.hh"
+#include "BLI_array_store.h"
+#include "BLI_array_store_utils.h"
 #include "BLI_bit_group_vector.hh"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
 
@@ -93,6 +99,23 @@ namespace blender::ed::sculpt_paint::undo {
 /* Uncomment to print the undo stack in the console on push/undo/redo. */
 // #define SCULPT_UNDO_DEBUG
 
+/**
+ * De-duplicate the arrays of undo nodes with #BLI_array_store, see #undo::Node::store.
+ */
+#define USE_ARRAY_STORE
+
+#ifdef USE_ARRAY_STORE
+/**
+ * Compress the arrays of old steps with zstd, when this uses less memory than the chunks that are
+ * only used by them in the array store.
+ */
+#  define USE_ARRAY_STORE_ZSTD
+#endif
+
+#ifdef USE_ARRAY_STORE_ZSTD
+#  include <zstd.h>
+#endif
+
 /* Implementation of undo system for objects in sculpt mode.
  *
  * Each undo step in sculpt mode consists of list of nodes, each node contains:
@@ -166,6 +189,43 @@ struct Node {
   Array<int, 0> face_sets;
 
   Vector<int> face_indices;
+
+  /**
+   * The #bke::pbvh::Node this undo node was created for. Only used to find the undo node of the
+   * same BVH node in other steps when de-duplicating memory, it must never be dereferenced.
+   */
+  const bke::pbvh::Node *pbvh_node_key;
+
+#ifdef USE_ARRAY_STORE
+  /**
+   * De-duplicated copies of the arrays above, used while the step isn't being built or restored.
+   * Null states are considered empty arrays.
+   */
+  struct {
+    BArrayState *position;
+    BArrayState *orig_position;
+    BArrayState *col;
+    BArrayState *mask;
+    BArrayState *loop_col;
+    BArrayState *vert_indices;
+    BArrayState *grids;
+    BArrayState *face_sets;
+  } store;
+#endif
+
+#ifdef USE_ARRAY_STORE_ZSTD
+  /** Compressed copies of the arrays above, used instead of #store for old steps. */
+  struct {
+    Array<uint8_t, 0> position;
+    Array<uint8_t, 0> orig_position;
+    Array<uint8_t, 0> col;
+    Array<uint8_t, 0> mask;
+    Array<uint8_t, 0> loop_col;
+    Array<uint8_t, 0> vert_indices;
+    Array<uint8_t, 0> grids;
+    Array<uint8_t, 0> face_sets;
+  } zstd;
+#endif
 };
 
 struct SculptAttrRef {
@@ -256,6 +316,14 @@ struct StepData {
   /** Storage of per-node undo data after creation of the undo step is finished. */
   Vector<std::unique_ptr<Node>> nodes;
 
+  /**
+   * True when the node arrays are moved to the array store, they have to be expanded before the
+   * nodes can be restored.
+   */
+  bool use_array_store;
+  /** True when the step was tagged to be compressed with zstd, which is only done once. */
+  bool use_zstd;
+
   size_t undo_size;
 };
 
@@ -1664,6 +1732,7 @@ static Node *ensure_node(StepData &step_data, const bke::pbvh::Node &node, bool
   r_new = false;
   std::unique_ptr<Node> &unode = step_data.undo_nodes_by_pbvh_node.lookup_or_add_cb(&node, [&]() {
     std::unique_ptr<Node> unode = std::make_unique<Node>();
+    unode->pbvh_node_key = &node;
     r_new = true;
     return unode;
   });
@@ -1929,6 +1998,620 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
   print_nodes(ob, nullptr);
 }
 
+#ifdef USE_ARRAY_STORE
+
+/* -------------------------------------------------------------------- */
+/** \name Array Store
+ *
+ * Strokes often touch the same BVH nodes, so the arrays of consecutive steps are mostly equal.
+ * Once a step is finished its node arrays are moved to a #BArrayStore in a background task, using
+ * the nodes of the previous step as reference, so only the changed chunks use memory. The arrays
+ * are expanded right before the step is restored and compacted again afterwards. The background
+ * task yields the array store in between nodes, so undo never waits for a whole step.
+ *
+ * The arrays of old steps are compressed with zstd when that uses less memory than their chunks,
+ * which is the case when most of the chunks aren't shared with other steps.
+ *
+ * The memory used by the chunks added for a step is used as the step size, so the undo memory
+ * limit prunes steps based on the memory that is actually used.
+ * \{ */
+
+/**
+ * Chunk size in bytes, see the mesh undo for details. The arrays of sculpt undo nodes are at least
+ * as large as the ones of edit-mesh undo, so a smaller size would only add overhead.
+ */
+#  define ARRAY_CHUNK_SIZE_IN_BYTES 65536
+#  define ARRAY_CHUNK_NUM_MIN 256
+
+enum {
+  ARRAY_STORE_INDEX_POSITION = 0,
+  ARRAY_STORE_INDEX_ORIG_POSITION,
+  ARRAY_STORE_INDEX_COLOR,
+  ARRAY_STORE_INDEX_MASK,
+  ARRAY_STORE_INDEX_LOOP_COLOR,
+  ARRAY_STORE_INDEX_VERT_INDICES,
+  ARRAY_STORE_INDEX_GRIDS,
+  ARRAY_STORE_INDEX_FACE_SETS,
+};
+#  define ARRAY_STORE_INDEX_NUM (ARRAY_STORE_INDEX_FACE_SETS + 1)
+
+struct ArrayStoreTask {
+  SculptUndoStep *us;
+  /**
+   * Neighboring sculpt steps (may be null), the first one that is compacted when the task runs
+   * is used as reference. The next step is needed when undoing several steps at once.
+   */
+  const SculptUndoStep *us_prev;
+  const SculptUndoStep *us_next;
+#  ifdef USE_ARRAY_STORE_ZSTD
+  /** Compress the arrays of a step that is in the array store already. */
+  bool use_zstd;
+#  endif
+};
+
+static struct {
+  BArrayStore_AtSize bs_stride[ARRAY_STORE_INDEX_NUM];
+  /** The number of steps with data in the array store. */
+  int users;
+
+  /**
+   * Protects the array store, the queued tasks and the node arrays of the steps in them. The
+   * background task releases it after every node when the main thread waits for it, see
+   * #array_store_lock and #array_store_yield.
+   */
+  std::mutex mutex;
+  std::atomic<bool> main_waiting;
+
+  TaskPool *task_pool;
+  /** True while the background task runs, it processes #tasks until there are none left. */
+  bool task_pool_active;
+  /** Steps to compact once #array_store_compact_in_background is called (main thread only). */
+  Vector<ArrayStoreTask> tasks_pending;
+  /** Steps waiting to be processed by the background task. */
+  Vector<ArrayStoreTask> tasks;
+  /** The task processed by the background task. */
+  std::optional<ArrayStoreTask> task_running;
+  /** Set when the step of the running task is expanded or freed, it's not processed further. */
+  bool task_running_cancel;
+  /** Set when the reference step of the running task is freed. */
+  bool task_running_ref_free;
+  /** Steps with a new #StepData::undo_size, that is copied to #UndoStep::data_size. */
+  Vector<SculptUndoStep *> steps_resized;
+} array_store = {};
+
+static size_t array_chunk_size_calc(const size_t stride)
+{
+  return std::max(ARRAY_CHUNK_NUM_MIN, ARRAY_CHUNK_SIZE_IN_BYTES / power_of_2_max_i(stride));
+}
+
+static size_t array_store_calc_size_compacted()
+{
+  size_t size = 0;
+  for (const int bs_index : IndexRange(ARRAY_STORE_INDEX_NUM)) {
+    size_t size_expanded, size_compacted;
+    BLI_array_store_at_size_calc_memory_usage(
+        &array_store.bs_stride[bs_index], &size_expanded, &size_compacted);
+    size += size_compacted;
+  }
+  return size;
+}
+
+/** Lock the array store from the main thread, without waiting for the running task to finish. */
+static std::unique_lock<std::mutex> array_store_lock()
+{
+  array_store.main_waiting = true;
+  std::unique_lock lock(array_store.mutex);
+  array_store.main_waiting = false;
+  return lock;
+}
+
+/**
+ * Called by the background task in between nodes, to let the main thread access the array store.
+ * \return True when the lock was released.
+ */
+static bool array_store_yield(std::unique_lock<std::mutex> &lock)
+{
+  if (!array_store.main_waiting) {
+    return false;
+  }
+  lock.unlock();
+  while (array_store.main_waiting) {
+    std::this_thread::yield();
+  }
+  lock.lock();
+  return true;
+}
+
+template<typename T>
+static void array_store_compact(const int bs_index,
+                                Array<T, 0> &array,
+                                BArrayState *&state,
+                                const BArrayState *state_reference)
+{
+  if (array.is_empty()) {
+    return;
+  }
+  BLI_assert(state == nullptr);
+  const size_t stride = sizeof(T);
+  BArrayStore *bs = BLI_array_store_at_size_ensure(
+      &array_store.bs_stride[bs_index], stride, array_chunk_size_calc(stride));
+  state = BLI_array_store_state_add(
+      bs, array.data(), array.as_span().size_in_bytes(), state_reference);
+  array = {};
+}
+
+template<typename T> static void array_store_expand(BArrayState *state, Array<T, 0> &array)
+{
+  if (state == nullptr) {
+    return;
+  }
+  array = Array<T, 0>(BLI_array_store_state_size_get(state) / sizeof(T), NoInitialization());
+  BLI_array_store_state_data_get(state, array.data());
+}
+
+template<typename T> static void array_store_remove(const int bs_index, BArrayState *&state)
+{
+  if (state == nullptr) {
+    return;
+  }
+  BArrayStore *bs = BLI_array_store_at_size_get(&array_store.bs_stride[bs_index], sizeof(T));
+  BLI_array_store_state_remove(bs, state);
+  state = nullptr;
+}
+
+static void node_array_store_compact(Node &unode, const Node *unode_ref)
+{
+  using Store = decltype(Node::store);
+  const Store ref = unode_ref ? unode_ref->store : Store{};
+  Store &store = unode.store;
+  array_store_compact(ARRAY_STORE_INDEX_POSITION, unode.position, store.position, ref.position);
+  array_store_compact(ARRAY_STORE_INDEX_ORIG_POSITION,
+                      unode.orig_position,
+                      store.orig_position,
+                      ref.orig_position);
+  array_store_compact(ARRAY_STORE_INDEX_COLOR, unode.col, store.col, ref.col);
+  array_store_compact(ARRAY_STORE_INDEX_MASK, unode.mask, store.mask, ref.mask);
+  array_store_compact(ARRAY_STORE_INDEX_LOOP_COLOR, unode.loop_col, store.loop_col, ref.loop_col);
+  array_store_compact(
+      ARRAY_STORE_INDEX_VERT_INDICES, unode.vert_indices, store.vert_indices, ref.vert_indices);
+  array_store_compact(ARRAY_STORE_INDEX_GRIDS, unode.grids, store.grids, ref.grids);
+  array_store_compact(
+      ARRAY_STORE_INDEX_FACE_SETS, unode.face_sets, store.face_sets, ref.face_sets);
+}
+
+static void node_array_store_expand(Node &unode)
+{
+  array_store_expand(unode.store.position, unode.position);
+  array_store_expand(unode.store.orig_position, unode.orig_position);
+  array_store_expand(unode.store.col, unode.col);
+  array_store_expand(unode.store.mask, unode.mask);
+  array_store_expand(unode.store.loop_col, unode.loop_col);
+  array_store_expand(unode.store.vert_indices, unode.vert_indices);
+  array_store_expand(unode.store.grids, unode.grids);
+  array_store_expand(unode.store.face_sets, unode.face_sets);
+}
+
+static void node_array_store_remove(Node &unode)
+{
+  array_store_remove<float3>(ARRAY_STORE_INDEX_POSITION, unode.store.position);
+  array_store_remove<float3>(ARRAY_STORE_INDEX_ORIG_POSITION, unode.store.orig_position);
+  array_store_remove<float4>(ARRAY_STORE_INDEX_COLOR, unode.store.col);
+  array_store_remove<float>(ARRAY_STORE_INDEX_MASK, unode.store.mask);
+  array_store_remove<float4>(ARRAY_STORE_INDEX_LOOP_COLOR, unode.store.loop_col);
+  array_store_remove<int>(ARRAY_STORE_INDEX_VERT_INDICES, unode.store.vert_indices);
+  array_store_remove<int>(ARRAY_STORE_INDEX_GRIDS, unode.store.grids);
+  array_store_remove<int>(ARRAY_STORE_INDEX_FACE_SETS, unode.store.face_sets);
+}
+
+/**
+ * The nodes of the reference step of the task by their BVH node. Finding no match (or the wrong
+ * one after the BVH tree was rebuilt) only means less memory is shared.
+ */
+static Map<const bke::pbvh::Node *, const Node *> task_nodes_ref_map(const ArrayStoreTask &task)
+{
+  const StepData &step_data = task.us->data;
+  const SculptUndoStep *us_ref = (task.us_prev && task.us_prev->data.use_array_store) ?
+                                     task.us_prev :
+                                     task.us_next;
+  Map<const bke::pbvh::Node *, const Node *> nodes_ref;
+  if (us_ref && us_ref->data.use_array_store && us_ref->data.object_name == step_data.object_name)
+  {
+    nodes_ref.reserve(us_ref->data.nodes.size());
+    for (const std::unique_ptr<Node> &unode : us_ref->data.nodes) {
+      nodes_ref.add(unode->pbvh_node_key, unode.get());
+    }
+  }
+  return nodes_ref;
+}
+
+/**
+ * Move the node arrays of the step to the array store and update its size to the memory that is
+ * used by the newly added chunks. Runs in the background task.
+ *
+ * \return False when the step was expanded or freed in between, the nodes that were compacted
+ * already stay in the array store then.
+ */
+static bool step_array_store_compact(std::unique_lock<std::mutex> &lock,
+                                     const ArrayStoreTask &task)
+{
+  StepData &step_data = task.us->data;
+  Map<const bke::pbvh::Node *, const Node *> nodes_ref = task_nodes_ref_map(task);
+
+  /* Measuring the array store iterates over all chunks, so it's only done again when the main
+   * thread may have changed it. */
+  size_t size_compacted_prev = array_store_calc_size_compacted();
+  size_t size_added = 0;
+  size_t size = 0;
+  for (std::unique_ptr<Node> &unode : step_data.nodes) {
+    if (array_store.main_waiting) {
+      size_added += array_store_calc_size_compacted() - size_compacted_prev;
+      array_store_yield(lock);
+      if (array_store.task_running_cancel) {
+        return false;
+      }
+      if (array_store.task_running_ref_free) {
+        nodes_ref.clear();
+      }
+      size_compacted_prev = array_store_calc_size_compacted();
+    }
+    node_array_store_compact(*unode, nodes_ref.lookup_default(unode->pbvh_node_key, nullptr));
+    size += node_size_in_bytes(*unode);
+    if (!step_data.use_array_store) {
+      step_data.use_array_store = true;
+      array_store.users += 1;
+    }
+  }
+  size_added += array_store_calc_size_compacted() - size_compacted_prev;
+  step_data.undo_size = size + size_added;
+  return true;
+}
+
+#  ifdef USE_ARRAY_STORE_ZSTD
+
+/** Compress steps that are this many sculpt steps older than the newest step. */
+#    define ARRAY_STORE_ZSTD_STEP_DISTANCE 8
+#    define ARRAY_STORE_ZSTD_LEVEL 3
+
+template<typename T>
+static size_t array_zstd_compress(BArrayState *state, Array<uint8_t, 0> &r_data)
+{
+  BLI_assert(r_data.is_empty());
+  if (state == nullptr) {
+    return 0;
+  }
+  Array<T, 0> array;
+  array_store_expand(state, array);
+  const size_t size = array.as_span().size_in_bytes();
+  Array<uint8_t, 0> buffer(ZSTD_compressBound(size), NoInitialization());
+  const size_t compressed_size = ZSTD_compress(
+      buffer.data(), buffer.size(), array.data(), size, ARRAY_STORE_ZSTD_LEVEL);
+  if (ZSTD_isError(compressed_size)) {
+    /* Keep using the array store. */
+    return 0;
+  }
+  r_data = Array<uint8_t, 0>(buffer.as_span().take_front(compressed_size));
+  return compressed_size;
+}
+
+template<typename T>
+static void array_zstd_remove_state(const int bs_index,
+                                    const Array<uint8_t, 0> &data,
+                                    BArrayState *&state)
+{
+  if (!data.is_empty()) {
+    array_store_remove<T>(bs_index, state);
+  }
+}
+
+template<typename T> static void array_zstd_expand(Array<uint8_t, 0> &data, Array<T, 0> &array)
+{
+  if (data.is_empty()) {
+    return;
+  }
+  /* The array was expanded from the array store already when the compression was cancelled. */
+  if (array.is_empty()) {
+    const size_t size = ZSTD_getFrameContentSize(data.data(), data.size());
+    array = Array<T, 0>(size / sizeof(T), NoInitialization());
+    const size_t decompressed_size = ZSTD_decompress(array.data(), size, data.data(), data.size());
+    BLI_assert(decompressed_size == size);
+    UNUSED_VARS_NDEBUG(decompressed_size);
+  }
+  data = {};
+}
+
+/** Compress the arrays of a node in the array store, without removing them from it yet. */
+static size_t node_zstd_compress(Node &unode)
+{
+  size_t size = 0;
+  size += array_zstd_compress<float3>(unode.store.position, unode.zstd.position);
+  size += array_zstd_compress<float3>(unode.store.orig_position, unode.zstd.orig_position);
+  size += array_zstd_compress<float4>(unode.store.col, unode.zstd.col);
+  size += array_zstd_compress<float>(unode.store.mask, unode.zstd.mask);
+  size += array_zstd_compress<float4>(unode.store.loop_col, unode.zstd.loop_col);
+  size += array_zstd_compress<int>(unode.store.vert_indices, unode.zstd.vert_indices);
+  size += array_zstd_compress<int>(unode.store.grids, unode.zstd.grids);
+  size += array_zstd_compress<int>(unode.store.face_sets, unode.zstd.face_sets);
+  return size;
+}
+
+static void node_zstd_remove_states(Node &unode)
+{
+  array_zstd_remove_state<float3>(
+      ARRAY_STORE_INDEX_POSITION, unode.zstd.position, unode.store.position);
+  array_zstd_remove_state<float3>(
+      ARRAY_STORE_INDEX_ORIG_POSITION, unode.zstd.orig_position, unode.store.orig_position);
+  array_zstd_remove_state<float4>(ARRAY_STORE_INDEX_COLOR, unode.zstd.col, unode.store.col);
+  array_zstd_remove_state<float>(ARRAY_STORE_INDEX_MASK, unode.zstd.mask, unode.store.mask);
+  array_zstd_remove_state<float4>(
+      ARRAY_STORE_INDEX_LOOP_COLOR, unode.zstd.loop_col, unode.store.loop_col);
+  array_zstd_remove_state<int>(
+      ARRAY_STORE_INDEX_VERT_INDICES, unode.zstd.vert_indices, unode.store.vert_indices);
+  array_zstd_remove_state<int>(ARRAY_STORE_INDEX_GRIDS, unode.zstd.grids, unode.store.grids);
+  array_zstd_remove_state<int>(
+      ARRAY_STORE_INDEX_FACE_SETS, unode.zstd.face_sets, unode.store.face_sets);
+}
+
+/** Decompress the arrays of the node, which has to be expanded from the array store first. */
+static void node_zstd_expand(Node &unode)
+{
+  array_zstd_expand(unode.zstd.position, unode.position);
+  array_zstd_expand(unode.zstd.orig_position, unode.orig_position);
+  array_zstd_expand(unode.zstd.col, unode.col);
+  array_zstd_expand(unode.zstd.mask, unode.mask);
+  array_zstd_expand(unode.zstd.loop_col, unode.loop_col);
+  array_zstd_expand(unode.zstd.vert_indices, unode.vert_indices);
+  array_zstd_expand(unode.zstd.grids, unode.grids);
+  array_zstd_expand(unode.zstd.face_sets, unode.face_sets);
+}
+
+/**
+ * Replace the array store states of an old step by compressed arrays. Chunks that are shared
+ * with other steps aren't freed, so the compressed arrays are only kept if they use less memory
+ * than the chunks that are freed. Runs in the background task.
+ *
+ * \return False when the step wasn't changed.
+ */
+static bool step_array_store_compress(std::unique_lock<std::mutex> &lock,
+                                      const ArrayStoreTask &task)
+{
+  StepData &step_data = task.us->data;
+  if (!step_data.use_array_store) {
+    return false;
+  }
+
+  size_t size_zstd = 0;
+  for (std::unique_ptr<Node> &unode : step_data.nodes) {
+    if (array_store_yield(lock) && array_store.task_running_cancel) {
+      /* The compressed arrays are cleared when the step is expanded or freed. */
+      return false;
+    }
+    size_zstd += node_zstd_compress(*unode);
+  }
+
+  const size_t size_compacted_prev = array_store_calc_size_compacted();
+  for (std::unique_ptr<Node> &unode : step_data.nodes) {
+    node_zstd_remove_states(*unode);
+  }
+  const size_t size_freed = size_compacted_prev - array_store_calc_size_compacted();
+
+  if (size_zstd < size_freed) {
+    size_t size = 0;
+    for (const std::unique_ptr<Node> &unode : step_data.nodes) {
+      size += node_size_in_bytes(*unode);
+    }
+    step_data.undo_size = size + size_zstd;
+    return true;
+  }
+
+  /* Move the arrays back to the array store. */
+  const Map<const bke::pbvh::Node *, const Node *> nodes_ref = task_nodes_ref_map(task);
+  for (std::unique_ptr<Node> &unode : step_data.nodes) {
+    node_zstd_expand(*unode);
+    node_array_store_compact(*unode, nodes_ref.lookup_default(unode->pbvh_node_key, nullptr));
+  }
+  return false;
+}
+
+/**
+ * Tag the sculpt step that is #ARRAY_STORE_ZSTD_STEP_DISTANCE steps older than a new step to be
+ * compressed, once it's compacted. Steps are only compressed once.
+ */
+static void array_store_compress_tag_old_step(const UndoStep *us_prev)
+{
+  const UndoStep *us_iter = us_prev;
+  for (int distance = 1; us_iter && distance < ARRAY_STORE_ZSTD_STEP_DISTANCE; distance++) {
+    if (us_iter->type != BKE_UNDOSYS_TYPE_SCULPT) {
+      return;
+    }
+    us_iter = us_iter->prev;
+  }
+  if (us_iter == nullptr || us_iter->type != BKE_UNDOSYS_TYPE_SCULPT) {
+    return;
+  }
+  SculptUndoStep *us = reinterpret_cast<SculptUndoStep *>(const_cast<UndoStep *>(us_iter));
+  if (us->data.use_zstd || us->data.nodes.is_empty()) {
+    return;
+  }
+  us->data.use_zstd = true;
+  array_store.tasks_pending.append({us, nullptr, nullptr, true});
+}
+
+#  endif /* USE_ARRAY_STORE_ZSTD */
+
+static void array_store_task_cb(TaskPool *__restrict /*pool*/, void * /*taskdata*/)
+{
+  std::unique_lock lock(array_store.mutex);
+  while (!array_store.tasks.is_empty()) {
+    const ArrayStoreTask task = array_store.tasks.first();
+    array_store.tasks.remove(0);
+    array_store.task_running = task;
+    array_store.task_running_cancel = false;
+    array_store.task_running_ref_free = false;
+#  ifdef USE_ARRAY_STORE_ZSTD
+    const bool resized = task.use_zstd ? step_array_store_compress(lock, task) :
+                                         step_array_store_compact(lock, task);
+#  else
+    const bool resized = step_array_store_compact(lock, task);
+#  endif
+    if (resized) {
+      array_store.steps_resized.append_non_duplicates(task.us);
+    }
+    array_store.task_running.reset();
+  }
+  array_store.task_pool_active = false;
+}
+
+/**
+ * Copy the sizes of the steps that were compacted in the background to the undo steps, so the
+ * undo memory limit uses them.
+ */
+static void array_store_sizes_update()
+{
+  std::unique_lock lock = array_store_lock();
+  for (SculptUndoStep *us : array_store.steps_resized) {
+    us->step.data_size = us->data.undo_size;
+  }
+  array_store.steps_resized.clear();
+}
+
+/**
+ * Tag the step to be compacted by the next #array_store_compact_in_background.
+ * The neighbors are passed in because steps are only linked into the stack after encoding.
+ */
+static void array_store_compact_tag(SculptUndoStep *us,
+                                    const UndoStep *us_prev,
+                                    const UndoStep *us_next)
+{
+  BLI_assert(!us->data.use_array_store);
+  if (us->data.nodes.is_empty()) {
+    return;
+  }
+  const auto sculpt_step = [](const UndoStep *step) -> const SculptUndoStep * {
+    if (step && step->type == BKE_UNDOSYS_TYPE_SCULPT) {
+      return reinterpret_cast<const SculptUndoStep *>(step);
+    }
+    return nullptr;
+  };
+#  ifdef USE_ARRAY_STORE_ZSTD
+  array_store.tasks_pending.append({us, sculpt_step(us_prev), sculpt_step(us_next), false});
+#  else
+  array_store.tasks_pending.append({us, sculpt_step(us_prev), sculpt_step(us_next)});
+#  endif
+}
+
+static void array_store_compact_in_background()
+{
+  if (array_store.tasks_pending.is_empty()) {
+    return;
+  }
+  std::unique_lock lock = array_store_lock();
+  array_store.tasks.extend(array_store.tasks_pending);
+  array_store.tasks_pending.clear_and_shrink();
+  if (array_store.task_pool_active) {
+    /* The running background task processes the new tasks too. */
+    return;
+  }
+  if (array_store.task_pool == nullptr) {
+    array_store.task_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+  }
+  array_store.task_pool_active = true;
+  BLI_task_pool_push(array_store.task_pool, array_store_task_cb, nullptr, false, nullptr);
+}
+
+/**
+ * Stop processing the step in the background, before it's expanded or freed.
+ * The array store has to be locked.
+ */
+static void array_store_tasks_remove(const SculptUndoStep *us, const bool is_free)
+{
+  for (Vector<ArrayStoreTask> *tasks : {&array_store.tasks_pending, &array_store.tasks}) {
+    tasks->remove_if([&](const ArrayStoreTask &task) { return task.us == us; });
+    if (is_free) {
+      for (ArrayStoreTask &task : *tasks) {
+        task.us_prev = task.us_prev == us ? nullptr : task.us_prev;
+        task.us_next = task.us_next == us ? nullptr : task.us_next;
+      }
+    }
+  }
+  if (const std::optional<ArrayStoreTask> &task = array_store.task_running) {
+    if (task->us == us) {
+      array_store.task_running_cancel = true;
+    }
+    else if (is_free && ELEM(us, task->us_prev, task->us_next)) {
+      array_store.task_running_ref_free = true;
+    }
+  }
+  if (is_free) {
+    array_store.steps_resized.remove_if([&](const SculptUndoStep *step) { return step == us; });
+  }
+}
+
+static void array_store_users_remove(std::unique_lock<std::mutex> &lock)
+{
+  array_store.users -= 1;
+  BLI_assert(array_store.users >= 0);
+  if (array_store.users != 0) {
+    return;
+  }
+  for (const int bs_index : IndexRange(ARRAY_STORE_INDEX_NUM)) {
+    BLI_array_store_at_size_clear(&array_store.bs_stride[bs_index]);
+  }
+  if (array_store.task_pool && array_store.tasks.is_empty()) {
+    /* The background task is idle or finishes the running task, which needs the lock. */
+    TaskPool *task_pool = array_store.task_pool;
+    array_store.task_pool = nullptr;
+    lock.unlock();
+    BLI_task_pool_free(task_pool);
+  }
+}
+
+/**
+ * Move the node arrays of the step out of the array store so the step can be restored. This
+ * doesn't wait for the step to be compacted, at most for the node that is being compacted.
+ */
+static void step_array_store_expand(SculptUndoStep *us)
+{
+  StepData &step_data = us->data;
+  std::unique_lock lock = array_store_lock();
+  array_store_tasks_remove(us, false);
+  if (!step_data.use_array_store) {
+    return;
+  }
+  /* Reading states doesn't modify the array store, only removing them does. */
+  threading::parallel_for(step_data.nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      node_array_store_expand(*step_data.nodes[i]);
+#  ifdef USE_ARRAY_STORE_ZSTD
+      node_zstd_expand(*step_data.nodes[i]);
+#  endif
+    }
+  });
+  for (std::unique_ptr<Node> &unode : step_data.nodes) {
+    node_array_store_remove(*unode);
+  }
+  step_data.use_array_store = false;
+  array_store_users_remove(lock);
+}
+
+static void step_array_store_free(SculptUndoStep *us)
+{
+  StepData &step_data = us->data;
+  std::unique_lock lock = array_store_lock();
+  array_store_tasks_remove(us, true);
+  if (!step_data.use_array_store) {
+    return;
+  }
+  for (std::unique_ptr<Node> &unode : step_data.nodes) {
+    node_array_store_remove(*unode);
+  }
+  step_data.use_array_store = false;
+  array_store_users_remove(lock);
+}
+
+/** \} */
+
+#endif /* USE_ARRAY_STORE */
+
 /* -------------------------------------------------------------------- */
 /** \name Implements ED Undo System
  * \{ */
@@ -1992,6 +2675,9 @@ static bool step_encode(bContext * /*C*/, Main *bmain, UndoStep *us_p)
   /* Dummy, encoding is done along the way by adding tiles
    * to the current 'SculptUndoStep' added by encode_init. */
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+#ifdef USE_ARRAY_STORE
+  array_store_sizes_update();
+#endif
   us->step.data_size = us->data.undo_size;
 
   Node *unode = us->data.nodes.is_empty() ? nullptr : us->data.nodes.last().get();
@@ -2004,6 +2690,15 @@ static bool step_encode(bContext * /*C*/, Main *bmain, UndoStep *us_p)
     bmain->is_memfile_undo_flush_needed = true;
   }
 
+#ifdef USE_ARRAY_STORE
+  const UndoStep *us_prev = static_cast<const UndoStep *>(ED_undo_stack_get()->steps.last);
+  array_store_compact_tag(us, us_prev, nullptr);
+#  ifdef USE_ARRAY_STORE_ZSTD
+  array_store_compress_tag_old_step(us_prev);
+#  endif
+  array_store_compact_in_background();
+#endif
+
   return true;
 }
 
@@ -2011,9 +2706,17 @@ static void step_decode_undo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == true);
 
+#ifdef USE_ARRAY_STORE
+  step_array_store_expand(us);
+#endif
+
   restore_list(C, depsgraph, us->data);
   us->step.is_applied = false;
 
+#ifdef USE_ARRAY_STORE
+  array_store_compact_tag(us, us->step.prev, us->step.next);
+#endif
+
   print_nodes(*CTX_data_active_object(C), nullptr);
 }
 
@@ -2021,9 +2724,17 @@ static void step_decode_redo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == false);
 
+#ifdef USE_ARRAY_STORE
+  step_array_store_expand(us);
+#endif
+
   restore_list(C, depsgraph, us->data);
   us->step.is_applied = true;
 
+#ifdef USE_ARRAY_STORE
+  array_store_compact_tag(us, us->step.prev, us->step.next);
+#endif
+
   print_nodes(*CTX_data_active_object(C), nullptr);
 }
 
@@ -2131,11 +2842,19 @@ static void step_decode(
   else if (dir == STEP_REDO) {
     step_decode_redo(C, depsgraph, us);
   }
+
+#ifdef USE_ARRAY_STORE
+  array_store_sizes_update();
+  array_store_compact_in_background();
+#endif
 }
 
 static void step_free(UndoStep *us_p)
 {
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+#ifdef USE_ARRAY_STORE
+  step_array_store_free(us);
+#endif
   free_step_data(us->data);
 }
 
@@ -37,6 +37,7 @@
 #include "BKE_action.hh"
 #include "BKE_armature.hh"
 #include "BKE_blender_version.h"
+#include "BKE_cachefile.hh"
 #include "BKE_curve.hh"
 #include "BKE_curves.hh"
 #include "BKE_editmesh.hh"
@@ -756,6 +757,22 @@ static void stats_row(int col1,
   BLF_draw_default(col2, *y, 0.0f, values, sizeof(values));
 }
 
+/* Frames of cache files read by modifiers that were read ahead, out of all reads. Only shown once
+ * frames are read with reading ahead enabled. */
+static void stats_row_cachefile_prefetch(int col1, const char *key, int col2, int *y, int height)
+{
+  int64_t hits, misses;
+  BKE_cachefile_prefetch_stats_get(&hits, &misses);
+  if (hits + misses == 0) {
+    return;
+  }
+  char hits_fmt[BLI_STR_FORMAT_UINT64_GROUPED_SIZE];
+  char reads_fmt[BLI_STR_FORMAT_UINT64_GROUPED_SIZE];
+  BLI_str_format_uint64_grouped(hits_fmt, uint64_t(hits));
+  BLI_str_format_uint64_grouped(reads_fmt, uint64_t(hits + misses));
+  stats_row(col1, key, col2, hits_fmt, reads_fmt, y, height);
+}
+
 void ED_info_draw_stats(
     Main *bmain, Scene *scene, ViewLayer *view_layer, View3D *v3d_local, int x, int *y, int height)
 {
@@ -785,6 +802,7 @@ void ED_info_draw_stats(
     STROKES,
     POINTS,
     LIGHTS,
+    CACHE_HITS,
     MAX_LABELS_COUNT
   };
   char labels[MAX_LABELS_COUNT][64];
@@ -801,6 +819,7 @@ void ED_info_draw_stats(
   STRNCPY_UTF8(labels[STROKES], IFACE_("Strokes"));
   STRNCPY_UTF8(labels[POINTS], IFACE_("Points"));
   STRNCPY_UTF8(labels[LIGHTS], IFACE_("Lights"));
+  STRNCPY_UTF8(labels[CACHE_HITS], IFACE_("Cache Hits"));
 
   int longest_label = 0;
   for (int i = 0; i < MAX_LABELS_COUNT; ++i) {
@@ -826,6 +845,7 @@ void ED_info_draw_stats(
     stats_row(col1, labels[EDGES], col2, stats_fmt.totedge, nullptr, y, height);
     stats_row(col1, labels[FACES], col2, stats_fmt.totface, nullptr, y, height);
     stats_row(col1, labels[TRIS], col2, stats_fmt.tottri, nullptr, y, height);
+    stats_row_cachefile_prefetch(col1, labels[CACHE_HITS], col2, y, height);
     return;
   }
   else if (!(object_mode & OB_MODE_SCULPT)) {
@@ -878,4 +898,6 @@ void ED_info_draw_stats(
     stats_row(col1, labels[FACES], col2, stats_fmt.totfacesel, stats_fmt.totface, y, height);
     stats_row(col1, labels[TRIS], col2, stats_fmt.tottrisel, stats_fmt.tottri, y, height);
   }
+
+  stats_row_cachefile_prefetch(col1, labels[CACHE_HITS], col2, y, height);
 }
@@ -132,6 +132,7 @@ struct TreeDrawContext {
 
   blender::Map<bNodeInstanceKey, blender::timeit::Nanoseconds>
       *compositor_per_node_execution_time = nullptr;
+  blender::Set<bNodeInstanceKey> *compositor_cached_nodes = nullptr;
 
   /**
    * Label for reroute nodes that is derived from upstream reroute nodes.
@@ -3054,6 +3055,13 @@ static void node_get_compositor_extra_info(TreeDrawContext &tree_draw_ctx,
     std::optional<NodeExtraInfoRow> row = node_get_execution_time_label_row(
         tree_draw_ctx, snode, node);
     if (row.has_value()) {
+      if (tree_draw_ctx.compositor_cached_nodes->contains(current_node_instance_key(snode, node)))
+      {
+        row->text += IFACE_(" (Cached)");
+        row->tooltip = TIP_(
+            "The result of the node was reused from a previous evaluation, the time is the one "
+            "taken to retrieve it");
+      }
       rows.append(std::move(*row));
     }
   }
@@ -4831,6 +4839,7 @@ static void draw_nodetree(const bContext &C,
     tree_draw_ctx.used_by_realtime_compositor = realtime_compositor_is_in_use(C);
     tree_draw_ctx.compositor_per_node_execution_time =
         &scene->runtime->compositor.per_node_execution_time;
+    tree_draw_ctx.compositor_cached_nodes = &scene->runtime->compositor.cached_nodes;
   }
   else if (ntree.type == NTREE_SHADER && U.experimental.use_shader_node_previews &&
            BKE_scene_uses_shader_previews(CTX_data_scene(&C)) &&
@@ -327,6 +327,7 @@ static void compo_canceljob(void *cjv)
   cj->cancelled = true;
 
   scene->runtime->compositor.per_node_execution_time = cj->profiler.get_nodes_evaluation_times();
+  scene->runtime->compositor.cached_nodes = cj->profiler.get_cached_nodes();
 }
 
 static void compo_completejob(void *cjv)
@@ -337,6 +338,7 @@ static void compo_completejob(void *cjv)
   BKE_callback_exec_id(bmain, &scene->id, BKE_CB_EVT_COMPOSITE_POST);
 
   scene->runtime->compositor.per_node_execution_time = cj->profiler.get_nodes_evaluation_times();
+  scene->runtime->compositor.cached_nodes = cj->profiler.get_cached_nodes();
 }
 
 /** \} */
@@ -0,0 +1,64 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_offset_indices.hh"
+#include "BLI_span.hh"
+#include "BLI_virtual_array.hh"
+
+namespace blender::geometry {
+
+/**
+ * Find the cheapest path along edges from every vertex to the closest of the start vertices.
+ * Negative edge costs are treated as zero.
+ *
+ * \param r_next_vert: The next vertex on the path towards the closest start vertex. Expected to be
+ * filled with -1, which is kept for start vertices and vertices that can't reach any of them.
+ * \param r_cost: The total cost of that path. Expected to be filled with #FLT_MAX.
+ */
+void shortest_edge_paths(Span<int2> edges,
+                         GroupedSpan<int> vert_to_edge_map,
+                         const IndexMask &start_verts,
+                         const VArray<float> &edge_costs,
+                         MutableSpan<int> r_next_vert,
+                         MutableSpan<float> r_cost);
+
+enum class GeodesicMethod {
+  /**
+   * Propagate a single wavefront of edges, updating distances in place. Cheap when only a small
+   * region around the start vertices is reached, but runs on a single thread.
+   */
+  Sequential,
+  /**
+   * Recompute the distances of all vertices next to the changed ones in parallel rounds, reading
+   * the distances of the previous round (a fast iterative method). The result doesn't depend on
+   * the number of threads, but may differ slightly from the sequential method.
+   */
+  Parallel,
+};
+
+/**
+ * Approximate the geodesic distance of every vertex to the closest start vertex, by unfolding the
+ * faces around each edge the distance is propagated across.
+ *
+ * Vertices that are further away than \a limit_radius in a straight line from every start vertex
+ * are skipped. They keep #FLT_MAX, like vertices that can't be reached through visible faces.
+ */
+Array<float> geodesic_distances(Span<float3> vert_positions,
+                                Span<int2> edges,
+                                OffsetIndices<int> faces,
+                                Span<int> corner_verts,
+                                GroupedSpan<int> vert_to_edge_map,
+                                GroupedSpan<int> vert_to_face_map,
+                                GroupedSpan<int> edge_to_face_map,
+                                Span<bool> hide_poly,
+                                const IndexMask &start_verts,
+                                float limit_radius,
+                                GeodesicMethod method);
+
+}  // namespace blender::geometry
@@ -0,0 +1,479 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+#include <queue>
+
+#include "atomic_ops.h"
+
+#include "BLI_bit_vector.hh"
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_math_geom.h"
+#include "BLI_math_vector.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_mesh.hh"
+
+#include "GEO_mesh_distances.hh"
+
+namespace blender::geometry {
+
+using VertPriority = std::pair<float, int>;
+
+void shortest_edge_paths(const Span<int2> edges,
+                         const GroupedSpan<int> vert_to_edge_map,
+                         const IndexMask &start_verts,
+                         const VArray<float> &edge_costs,
+                         MutableSpan<int> r_next_vert,
+                         MutableSpan<float> r_cost)
+{
+  Array<bool> visited(vert_to_edge_map.size(), false);
+
+  std::priority_queue<VertPriority, std::vector<VertPriority>, std::greater<VertPriority>> queue;
+
+  start_verts.foreach_index([&](const int start_vert_i) {
+    r_cost[start_vert_i] = 0.0f;
+    queue.emplace(0.0f, start_vert_i);
+  });
+
+  /* Though it uses more memory, calculating the adjacent vertex
+   * across each edge beforehand is noticeably faster. */
+  Array<int> other_vertex(vert_to_edge_map.data.size());
+  threading::parallel_for(vert_to_edge_map.index_range(), 2048, [&](const IndexRange range) {
+    for (const int vert_i : range) {
+      for (const int edge_i : vert_to_edge_map.offsets[vert_i]) {
+        other_vertex[edge_i] = bke::mesh::edge_other_vert(edges[vert_to_edge_map.data[edge_i]],
+                                                          vert_i);
+      }
+    }
+  });
+
+  while (!queue.empty()) {
+    const float cost_i = queue.top().first;
+    const int vert_i = queue.top().second;
+    queue.pop();
+    if (visited[vert_i]) {
+      continue;
+    }
+    visited[vert_i] = true;
+    for (const int index : vert_to_edge_map.offsets[vert_i]) {
+      const int edge_i = vert_to_edge_map.data[index];
+      const int neighbor_vert_i = other_vertex[index];
+      if (visited[neighbor_vert_i]) {
+        continue;
+      }
+      const float edge_cost = std::max(0.0f, edge_costs[edge_i]);
+      const float new_neighbor_cost = cost_i + edge_cost;
+      if (new_neighbor_cost < r_cost[neighbor_vert_i]) {
+        r_cost[neighbor_vert_i] = new_neighbor_cost;
+        r_next_vert[neighbor_vert_i] = vert_i;
+        queue.emplace(new_neighbor_cost, neighbor_vert_i);
+      }
+    }
+  }
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Geodesic Distances
+ * \{ */
+
+#define GEODESIC_VERTEX_NONE -1
+
+/**
+ * Masks vertices that are further than limit radius from a start vertex. As there is no need to
+ * define a distance to them the propagation can stop earlier by skipping them.
+ */
+static Array<bool> calc_affected_verts(const Span<float3> vert_positions,
+                                       const IndexMask &start_verts,
+                                       const float limit_radius)
+{
+  Array<bool> affected_vert(vert_positions.size());
+  if (limit_radius == FLT_MAX) {
+    /* In this case, no need to loop through all start vertices to check distances as they are all
+     * going to be affected. */
+    affected_vert.fill(true);
+    return affected_vert;
+  }
+
+  /* This is an O(n^2) loop used to limit the geodesic distance calculation to a radius. When this
+   * optimization is needed, it is expected for the tool to request the distance to a low number of
+   * vertices (usually just 1 or 2). */
+  const float limit_radius_sq = limit_radius * limit_radius;
+  Array<int> start_indices(start_verts.size());
+  start_verts.to_indices(start_indices.as_mutable_span());
+  threading::parallel_for(vert_positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      affected_vert[i] = std::any_of(
+          start_indices.begin(), start_indices.end(), [&](const int v) {
+            return math::distance_squared(vert_positions[v], vert_positions[i]) <=
+                   limit_radius_sq;
+          });
+    }
+  });
+  return affected_vert;
+}
+
+/* Propagate distance from v1 and v2 to v0. */
+static bool geodesic_test_dist_add(const Span<float3> vert_positions,
+                                   const int v0,
+                                   const int v1,
+                                   const int v2,
+                                   MutableSpan<float> dists,
+                                   const Span<bool> is_start_vert)
+{
+  if (is_start_vert[v0]) {
+    return false;
+  }
+
+  BLI_assert(dists[v1] != FLT_MAX);
+  if (dists[v0] <= dists[v1]) {
+    return false;
+  }
+
+  float dist0;
+  if (v2 != GEODESIC_VERTEX_NONE) {
+    BLI_assert(dists[v2] != FLT_MAX);
+    if (dists[v0] <= dists[v2]) {
+      return false;
+    }
+    dist0 = geodesic_distance_propagate_across_triangle(
+        vert_positions[v0], vert_positions[v1], vert_positions[v2], dists[v1], dists[v2]);
+  }
+  else {
+    dist0 = dists[v1] + math::distance(vert_positions[v1], vert_positions[v0]);
+  }
+
+  if (dist0 < dists[v0]) {
+    dists[v0] = dist0;
+    return true;
+  }
+
+  return false;
+}
+
+static void geodesic_distances_sequential(const Span<float3> vert_positions,
+                                          const Span<int2> edges,
+                                          const OffsetIndices<int> faces,
+                                          const Span<int> corner_verts,
+                                          const GroupedSpan<int> vert_to_edge_map,
+                                          const GroupedSpan<int> edge_to_face_map,
+                                          const Span<bool> hide_poly,
+                                          const Span<bool> is_start_vert,
+                                          const Span<bool> affected_vert,
+                                          MutableSpan<float> dists)
+{
+  /* Add edges adjacent to a start vertex to the queue. */
+  Vector<int> queue;
+  {
+    IndexMaskMemory memory;
+    const IndexMask initial_edges = IndexMask::from_predicate(
+        edges.index_range(), GrainSize(4096), memory, [&](const int i) {
+          const int v1 = edges[i][0];
+          const int v2 = edges[i][1];
+          if (!affected_vert[v1] && !affected_vert[v2]) {
+            return false;
+          }
+          return dists[v1] != FLT_MAX || dists[v2] != FLT_MAX;
+        });
+    queue.resize(initial_edges.size());
+    initial_edges.to_indices(queue.as_mutable_span());
+  }
+
+  /* Edges that are already in the next queue. */
+  BitVector<> edge_tag(edges.size());
+  Vector<int> queue_next;
+
+  do {
+    while (!queue.is_empty()) {
+      const int e = queue.pop_last();
+      int v1 = edges[e][0];
+      int v2 = edges[e][1];
+
+      if (dists[v1] == FLT_MAX || dists[v2] == FLT_MAX) {
+        if (dists[v1] > dists[v2]) {
+          std::swap(v1, v2);
+        }
+        geodesic_test_dist_add(
+            vert_positions, v2, v1, GEODESIC_VERTEX_NONE, dists, is_start_vert);
+      }
+
+      for (const int face : edge_to_face_map[e]) {
+        if (!hide_poly.is_empty() && hide_poly[face]) {
+          continue;
+        }
+        for (const int v_other : corner_verts.slice(faces[face])) {
+          if (ELEM(v_other, v1, v2)) {
+            continue;
+          }
+          if (geodesic_test_dist_add(vert_positions, v_other, v1, v2, dists, is_start_vert)) {
+            for (const int e_other : vert_to_edge_map[v_other]) {
+              const int ev_other = bke::mesh::edge_other_vert(edges[e_other], v_other);
+              if (e_other != e && !edge_tag[e_other] &&
+                  (edge_to_face_map[e_other].is_empty() || dists[ev_other] != FLT_MAX))
+              {
+                if (affected_vert[v_other] || affected_vert[ev_other]) {
+                  edge_tag[e_other].set();
+                  queue_next.append(e_other);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    for (const int e : queue_next) {
+      edge_tag[e].reset();
+    }
+
+    std::swap(queue, queue_next);
+
+  } while (!queue.is_empty());
+}
+
+/**
+ * Calculate the distance of a vertex from the distances of its neighbors, using the same rules
+ * as #geodesic_test_dist_add for every face edge opposite to the vertex.
+ */
+static float geodesic_vert_dist_calc(const Span<float3> vert_positions,
+                                     const Span<int2> edges,
+                                     const OffsetIndices<int> faces,
+                                     const Span<int> corner_verts,
+                                     const GroupedSpan<int> vert_to_edge_map,
+                                     const GroupedSpan<int> vert_to_face_map,
+                                     const GroupedSpan<int> edge_to_face_map,
+                                     const Span<bool> hide_poly,
+                                     const Span<bool> is_start_vert,
+                                     const Span<float> dists,
+                                     const int v0)
+{
+  float dist = dists[v0];
+  if (dist == FLT_MAX) {
+    /* Like in the sequential propagation, only edges from a start vertex and loose edges pass the
+     * distance on without unfolding a face. */
+    for (const int edge : vert_to_edge_map[v0]) {
+      const int v1 = bke::mesh::edge_other_vert(edges[edge], v0);
+      if (dists[v1] == FLT_MAX) {
+        continue;
+      }
+      if (!is_start_vert[v1] && !edge_to_face_map[edge].is_empty()) {
+        continue;
+      }
+      dist = std::min(dist, dists[v1] + math::distance(vert_positions[v1], vert_positions[v0]));
+    }
+  }
+
+  for (const int face : vert_to_face_map[v0]) {
+    if (!hide_poly.is_empty() && hide_poly[face]) {
+      continue;
+    }
+    const IndexRange face_range = faces[face];
+    for (const int corner : face_range) {
+      const int v1 = corner_verts[corner];
+      const int v2 = corner_verts[bke::mesh::face_corner_next(face_range, corner)];
+      if (ELEM(v0, v1, v2)) {
+        continue;
+      }
+      if (dists[v1] == FLT_MAX || dists[v2] == FLT_MAX) {
+        continue;
+      }
+      if (dist <= dists[v1] || dist <= dists[v2]) {
+        continue;
+      }
+      dist = std::min(dist,
+                      geodesic_distance_propagate_across_triangle(vert_positions[v0],
+                                                                  vert_positions[v1],
+                                                                  vert_positions[v2],
+                                                                  dists[v1],
+                                                                  dists[v2]));
+    }
+  }
+  return dist;
+}
+
+/**
+ * Find the vertices whose distance can depend on the changed vertices: the other vertices of their
+ * edges and visible faces.
+ */
+static Vector<int> gather_next_front(const Span<int> changed_verts,
+                                     const Span<int2> edges,
+                                     const OffsetIndices<int> faces,
+                                     const Span<int> corner_verts,
+                                     const GroupedSpan<int> vert_to_edge_map,
+                                     const GroupedSpan<int> vert_to_face_map,
+                                     const Span<bool> hide_poly,
+                                     const Span<bool> is_start_vert,
+                                     const Span<bool> affected_vert,
+                                     MutableSpan<uint8_t> vert_tag)
+{
+  threading::EnumerableThreadSpecific<Vector<int>> all_fronts;
+  const auto add_vert = [&](Vector<int> &front, const int vert) {
+    if (is_start_vert[vert] || !affected_vert[vert]) {
+      return;
+    }
+    if (atomic_fetch_and_or_uint8(&vert_tag[vert], 1) == 0) {
+      front.append(vert);
+    }
+  };
+  threading::parallel_for(changed_verts.index_range(), 1024, [&](const IndexRange range) {
+    Vector<int> &front = all_fronts.local();
+    for (const int vert : changed_verts.slice(range)) {
+      for (const int edge : vert_to_edge_map[vert]) {
+        add_vert(front, bke::mesh::edge_other_vert(edges[edge], vert));
+      }
+      for (const int face : vert_to_face_map[vert]) {
+        if (!hide_poly.is_empty() && hide_poly[face]) {
+          continue;
+        }
+        for (const int other : corner_verts.slice(faces[face])) {
+          add_vert(front, other);
+        }
+      }
+    }
+  });
+
+  Vector<int> front;
+  for (const Vector<int> &thread_front : all_fronts) {
+    front.extend(thread_front);
+  }
+  threading::parallel_for(front.index_range(), 4096, [&](const IndexRange range) {
+    for (const int vert : front.as_span().slice(range)) {
+      vert_tag[vert] = 0;
+    }
+  });
+  return front;
+}
+
+static void geodesic_distances_parallel(const Span<float3> vert_positions,
+                                        const Span<int2> edges,
+                                        const OffsetIndices<int> faces,
+                                        const Span<int> corner_verts,
+                                        const GroupedSpan<int> vert_to_edge_map,
+                                        const GroupedSpan<int> vert_to_face_map,
+                                        const GroupedSpan<int> edge_to_face_map,
+                                        const Span<bool> hide_poly,
+                                        const IndexMask &start_verts,
+                                        const Span<bool> is_start_vert,
+                                        const Span<bool> affected_vert,
+                                        MutableSpan<float> dists)
+{
+  Array<uint8_t> vert_tag(vert_positions.size(), 0);
+  const auto next_front = [&](const Span<int> changed_verts) {
+    return gather_next_front(changed_verts,
+                             edges,
+                             faces,
+                             corner_verts,
+                             vert_to_edge_map,
+                             vert_to_face_map,
+                             hide_poly,
+                             is_start_vert,
+                             affected_vert,
+                             vert_tag);
+  };
+
+  Vector<int> front;
+  {
+    Array<int> start_indices(start_verts.size());
+    start_verts.to_indices(start_indices.as_mutable_span());
+    front = next_front(start_indices);
+  }
+
+  /* New distances are stored separately until the whole front is processed, so every vertex of a
+   * round reads the same distances regardless of the order the threads run in. */
+  Vector<float> front_dists;
+  Vector<int> changed_verts;
+  while (!front.is_empty()) {
+    front_dists.resize(front.size());
+    threading::parallel_for(front.index_range(), 512, [&](const IndexRange range) {
+      for (const int i : range) {
+        front_dists[i] = geodesic_vert_dist_calc(vert_positions,
+                                                 edges,
+                                                 faces,
+                                                 corner_verts,
+                                                 vert_to_edge_map,
+                                                 vert_to_face_map,
+                                                 edge_to_face_map,
+                                                 hide_poly,
+                                                 is_start_vert,
+                                                 dists,
+                                                 front[i]);
+      }
+    });
+
+    IndexMaskMemory memory;
+    const IndexMask changed = IndexMask::from_predicate(
+        front.index_range(), GrainSize(4096), memory, [&](const int i) {
+          return front_dists[i] < dists[front[i]];
+        });
+    changed_verts.resize(changed.size());
+    changed.foreach_index(GrainSize(4096), [&](const int i, const int pos) {
+      dists[front[i]] = front_dists[i];
+      changed_verts[pos] = front[i];
+    });
+
+    front = next_front(changed_verts);
+  }
+}
+
+Array<float> geodesic_distances(const Span<float3> vert_positions,
+                                const Span<int2> edges,
+                                const OffsetIndices<int> faces,
+                                const Span<int> corner_verts,
+                                const GroupedSpan<int> vert_to_edge_map,
+                                const GroupedSpan<int> vert_to_face_map,
+                                const GroupedSpan<int> edge_to_face_map,
+                                const Span<bool> hide_poly,
+                                const IndexMask &start_verts,
+                                const float limit_radius,
+                                const GeodesicMethod method)
+{
+  /* Looking up vertices in the mask is too slow for the propagation below. */
+  Array<bool> is_start_vert(vert_positions.size(), false);
+  start_verts.to_bools(is_start_vert);
+
+  Array<float> dists(vert_positions.size());
+  threading::parallel_for(vert_positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      dists[i] = is_start_vert[i] ? 0.0f : FLT_MAX;
+    }
+  });
+
+  const Array<bool> affected_vert = calc_affected_verts(vert_positions, start_verts, limit_radius);
+
+  switch (method) {
+    case GeodesicMethod::Sequential:
+      geodesic_distances_sequential(vert_positions,
+                                    edges,
+                                    faces,
+                                    corner_verts,
+                                    vert_to_edge_map,
+                                    edge_to_face_map,
+                                    hide_poly,
+                                    is_start_vert,
+                                    affected_vert,
+                                    dists);
+      break;
+    case GeodesicMethod::Parallel:
+      geodesic_distances_parallel(vert_positions,
+                                  edges,
+                                  faces,
+                                  corner_verts,
+                                  vert_to_edge_map,
+                                  vert_to_face_map,
+                                  edge_to_face_map,
+                                  hide_poly,
+                                  start_verts,
+                                  is_start_vert,
+                                  affected_vert,
+                                  dists);
+      break;
+  }
+
+  return dists;
+}
+
+/** \} */
+
+}  // namespace blender::geometry
@@ -0,0 +1,158 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "BKE_mesh_mapping.hh"
+
+#include "BLI_math_vector.hh"
+#include "GEO_mesh_distances.hh"
+
+#include "testing/testing.h"
+
+namespace blender::geometry::tests {
+
+/** A flat grid of quads with #size vertices on each side, in the same layout as a mesh. */
+struct GridData {
+  int size;
+  Array<float3> positions;
+  Array<int2> edges;
+  Array<int> face_offsets;
+  Array<int> corner_verts;
+  Array<int> corner_edges;
+
+  Array<int> vert_to_edge_offsets;
+  Array<int> vert_to_edge_indices;
+  GroupedSpan<int> vert_to_edge_map;
+  Array<int> vert_to_face_offsets;
+  Array<int> vert_to_face_indices;
+  GroupedSpan<int> vert_to_face_map;
+  Array<int> edge_to_face_offsets;
+  Array<int> edge_to_face_indices;
+  GroupedSpan<int> edge_to_face_map;
+
+  GridData(const int size) : size(size)
+  {
+    const int edges_x_num = (size - 1) * size;
+    const int faces_num = (size - 1) * (size - 1);
+    positions.reinitialize(size * size);
+    edges.reinitialize(edges_x_num * 2);
+    face_offsets.reinitialize(faces_num + 1);
+    corner_verts.reinitialize(faces_num * 4);
+    corner_edges.reinitialize(faces_num * 4);
+
+    const auto vert = [&](const int x, const int y) { return y * size + x; };
+    const auto edge_x = [&](const int x, const int y) { return y * (size - 1) + x; };
+    const auto edge_y = [&](const int x, const int y) { return edges_x_num + y * size + x; };
+
+    for (const int y : IndexRange(size)) {
+      for (const int x : IndexRange(size)) {
+        positions[vert(x, y)] = float3(x, y, 0.0f);
+        if (x < size - 1) {
+          edges[edge_x(x, y)] = int2(vert(x, y), vert(x + 1, y));
+        }
+        if (y < size - 1) {
+          edges[edge_y(x, y)] = int2(vert(x, y), vert(x, y + 1));
+        }
+      }
+    }
+    for (const int y : IndexRange(size - 1)) {
+      for (const int x : IndexRange(size - 1)) {
+        const int face = y * (size - 1) + x;
+        face_offsets[face] = face * 4;
+        corner_verts.as_mutable_span().slice(face * 4, 4).copy_from(
+            {vert(x, y), vert(x + 1, y), vert(x + 1, y + 1), vert(x, y + 1)});
+        corner_edges.as_mutable_span().slice(face * 4, 4).copy_from(
+            {edge_x(x, y), edge_y(x + 1, y), edge_x(x, y + 1), edge_y(x, y)});
+      }
+    }
+    face_offsets.last() = faces_num * 4;
+
+    vert_to_edge_map = bke::mesh::build_vert_to_edge_map(
+        edges, positions.size(), vert_to_edge_offsets, vert_to_edge_indices);
+    vert_to_face_map = bke::mesh::build_vert_to_face_map(
+        faces(), corner_verts, positions.size(), vert_to_face_offsets, vert_to_face_indices);
+    edge_to_face_map = bke::mesh::build_edge_to_face_map(
+        faces(), corner_edges, edges.size(), edge_to_face_offsets, edge_to_face_indices);
+  }
+
+  OffsetIndices<int> faces() const
+  {
+    return face_offsets.as_span();
+  }
+
+  Array<float> geodesic_distances(const Span<bool> hide_poly,
+                                  const IndexMask &start_verts,
+                                  const GeodesicMethod method) const
+  {
+    return geometry::geodesic_distances(positions,
+                                        edges,
+                                        faces(),
+                                        corner_verts,
+                                        vert_to_edge_map,
+                                        vert_to_face_map,
+                                        edge_to_face_map,
+                                        hide_poly,
+                                        start_verts,
+                                        FLT_MAX,
+                                        method);
+  }
+};
+
+TEST(mesh_distances, ShortestEdgePathsGrid)
+{
+  const GridData grid(6);
+  Array<int> next_vert(grid.positions.size(), -1);
+  Array<float> cost(grid.positions.size(), FLT_MAX);
+  shortest_edge_paths(grid.edges,
+                      grid.vert_to_edge_map,
+                      IndexRange(1),
+                      VArray<float>::ForSingle(1.0f, grid.edges.size()),
+                      next_vert,
+                      cost);
+
+  EXPECT_EQ(next_vert[0], -1);
+  for (const int vert : grid.positions.index_range()) {
+    const float3 &position = grid.positions[vert];
+    EXPECT_FLOAT_EQ(cost[vert], position.x + position.y);
+    if (vert != 0) {
+      EXPECT_FLOAT_EQ(cost[next_vert[vert]], cost[vert] - 1.0f);
+    }
+  }
+}
+
+TEST(mesh_distances, GeodesicFlatGrid)
+{
+  const GridData grid(16);
+  for (const GeodesicMethod method : {GeodesicMethod::Sequential, GeodesicMethod::Parallel}) {
+    const Array<float> dists = grid.geodesic_distances({}, IndexRange(1), method);
+    EXPECT_EQ(dists[0], 0.0f);
+    for (const int vert : grid.positions.index_range().drop_front(1)) {
+      const float expected = math::length(grid.positions[vert]);
+      EXPECT_NEAR(dists[vert], expected, expected * 0.1f);
+    }
+  }
+}
+
+TEST(mesh_distances, GeodesicHiddenFaces)
+{
+  const GridData grid(8);
+  /* Hide a column of faces, which separates the grid in two. */
+  Array<bool> hide_poly(grid.faces().size(), false);
+  for (const int y : IndexRange(grid.size - 1)) {
+    hide_poly[y * (grid.size - 1) + 3] = true;
+  }
+  for (const GeodesicMethod method : {GeodesicMethod::Sequential, GeodesicMethod::Parallel}) {
+    const Array<float> dists = grid.geodesic_distances(hide_poly, IndexRange(1), method);
+    for (const int vert : grid.positions.index_range()) {
+      const float x = grid.positions[vert].x;
+      if (x <= 3.0f) {
+        EXPECT_LT(dists[vert], FLT_MAX);
+      }
+      else {
+        EXPECT_EQ(dists[vert], FLT_MAX);
+      }
+    }
+  }
+}
+
+}  // namespace blender::geometry::tests
@@ -45,6 +45,11 @@ struct ExportJobData {
   bool was_canceled;
   bool export_ok;
   blender::timeit::TimePoint start_time;
+
+  /* Time spent in the stages of the export, for the report at the end of the job. */
+  blender::timeit::Nanoseconds evaluation_duration;
+  blender::timeit::Nanoseconds prepare_duration;
+  blender::timeit::Nanoseconds write_duration;
 };
 
 namespace blender::io::alembic {
@@ -78,7 +83,13 @@ static void report_job_duration(const ExportJobData *data)
   blender::timeit::Nanoseconds duration = blender::timeit::Clock::now() - data->start_time;
   std::cout << "Alembic export of '" << data->filepath << "' took ";
   blender::timeit::print_duration(duration);
-  std::cout << '\n';
+  std::cout << " (evaluation ";
+  blender::timeit::print_duration(data->evaluation_duration);
+  std::cout << ", conversion ";
+  blender::timeit::print_duration(data->prepare_duration);
+  std::cout << ", writing ";
+  blender::timeit::print_duration(data->write_duration);
+  std::cout << ")\n";
 }
 
 static void export_startjob(void *customdata, wmJobWorkerStatus *worker_status)
@@ -86,6 +97,9 @@ static void export_startjob(void *customdata, wmJobWorkerStatus *worker_status)
   ExportJobData *data = static_cast<ExportJobData *>(customdata);
   data->was_canceled = false;
   data->start_time = blender::timeit::Clock::now();
+  data->evaluation_duration = blender::timeit::Nanoseconds::zero();
+  data->prepare_duration = blender::timeit::Nanoseconds::zero();
+  data->write_duration = blender::timeit::Nanoseconds::zero();
 
   G.is_rendering = true;
   WM_set_locked_interface(data->wm, true);
@@ -152,9 +166,11 @@ static void export_startjob(void *customdata, wmJobWorkerStatus *worker_status)
       }
 
       /* Update the scene for the next frame to render. */
+      const blender::timeit::TimePoint evaluation_start = blender::timeit::Clock::now();
       scene->r.cfra = int(frame);
       scene->r.subframe = float(frame - scene->r.cfra);
       BKE_scene_graph_update_for_newframe(data->depsgraph);
+      data->evaluation_duration += blender::timeit::Clock::now() - evaluation_start;
 
       CLOG_INFO(&LOG, 2, "Exporting frame %.2f", frame);
       ExportSubset export_subset = abc_archive->export_subset_for_frame(frame);
@@ -170,6 +186,8 @@ static void export_startjob(void *customdata, wmJobWorkerStatus *worker_status)
     iter.iterate_and_write();
   }
 
+  data->prepare_duration = iter.prepare_duration();
+  data->write_duration = iter.write_duration();
   iter.release_writers();
 
   /* Finish up by going back to the keyframe that was current before we started. */
@@ -29,6 +29,14 @@ bool ABCAbstractWriter::is_supported(const HierarchyContext * /*context*/) const
   return true;
 }
 
+void ABCAbstractWriter::prepare(HierarchyContext &context)
+{
+  if (frame_has_been_written_ && !is_animated_) {
+    return;
+  }
+  do_prepare(context);
+}
+
 void ABCAbstractWriter::write(HierarchyContext &context)
 {
   if (!frame_has_been_written_) {
@@ -34,6 +34,7 @@ class ABCAbstractWriter : public AbstractHierarchyWriter {
  public:
   explicit ABCAbstractWriter(const ABCWriterConstructorArgs &args);
 
+  virtual void prepare(HierarchyContext &context) override;
   virtual void write(HierarchyContext &context) override;
 
   /* Returns true if the data to be written is actually supported. This would, for example, allow a
@@ -65,6 +66,10 @@ class ABCAbstractWriter : public AbstractHierarchyWriter {
   virtual Alembic::Abc::OCompoundProperty abc_prop_for_custom_props() = 0;
 
  protected:
+  /* Called from prepare() for the frames that do_write() will be called for. Writers that convert
+   * large amounts of data can do that here in parallel to other writers, instead of in
+   * do_write(), as long as the archive is not accessed. */
+  virtual void do_prepare(HierarchyContext & /*context*/) {}
   virtual void do_write(HierarchyContext &context) = 0;
 
   virtual void update_bounding_box(Object *object);
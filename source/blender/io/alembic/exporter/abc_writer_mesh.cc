@@ -71,6 +71,11 @@ ABCGenericMeshWriter::ABCGenericMeshWriter(const ABCWriterConstructorArgs &args)
 {
 }
 
+ABCGenericMeshWriter::~ABCGenericMeshWriter()
+{
+  free_prepared_mesh();
+}
+
 void ABCGenericMeshWriter::create_alembic_objects(const HierarchyContext *context)
 {
   if (!args_.export_params->apply_subdiv && export_as_subdivision_surface(context->object)) {
@@ -132,8 +137,10 @@ bool ABCGenericMeshWriter::is_supported(const HierarchyContext *context) const
   return true;
 }
 
-void ABCGenericMeshWriter::do_write(HierarchyContext &context)
+void ABCGenericMeshWriter::prepare_mesh(HierarchyContext &context)
 {
+  free_prepared_mesh();
+
   Object *object = context.object;
   bool needsfree = false;
 
@@ -169,6 +176,34 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
     needsfree = true;
   }
 
+  prepared_.mesh = mesh;
+  prepared_.needs_free = needsfree;
+  get_vertices(mesh, prepared_.points);
+  get_topology(mesh, prepared_.face_verts, prepared_.loop_counts);
+  if (!is_subd_ && args_.export_params->normals) {
+    get_loop_normals(mesh, prepared_.normals);
+  }
+}
+
+void ABCGenericMeshWriter::free_prepared_mesh()
+{
+  if (prepared_.mesh && prepared_.needs_free) {
+    free_export_mesh(prepared_.mesh);
+  }
+  prepared_ = {};
+}
+
+void ABCGenericMeshWriter::do_write(HierarchyContext &context)
+{
+  if (prepared_.mesh == nullptr) {
+    prepare_mesh(context);
+  }
+  Mesh *mesh = prepared_.mesh;
+
+  if (mesh == nullptr) {
+    return;
+  }
+
   m_custom_data_config.pack_uvs = args_.export_params->packuv;
   m_custom_data_config.mesh = mesh;
   m_custom_data_config.face_offsets = mesh->face_offsets_for_write().data();
@@ -186,14 +221,10 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
       write_mesh(context, mesh);
     }
 
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
+    free_prepared_mesh();
   }
   catch (...) {
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
+    free_prepared_mesh();
     throw;
   }
 }
@@ -205,19 +236,16 @@ void ABCGenericMeshWriter::free_export_mesh(Mesh *mesh)
 
 void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
 {
-  std::vector<Imath::V3f> points, normals;
-  std::vector<int32_t> face_verts, loop_counts;
   std::vector<Imath::V3f> velocities;
 
-  get_vertices(mesh, points);
-  get_topology(mesh, face_verts, loop_counts);
-
   if (!frame_has_been_written_ && args_.export_params->face_sets) {
     write_face_sets(context.object, mesh, abc_poly_mesh_schema_);
   }
 
   OPolyMeshSchema::Sample mesh_sample = OPolyMeshSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(face_verts), Int32ArraySample(loop_counts));
+      V3fArraySample(prepared_.points),
+      Int32ArraySample(prepared_.face_verts),
+      Int32ArraySample(prepared_.loop_counts));
 
   UVSample uvs_and_indices;
 
@@ -241,12 +269,10 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   }
 
   if (args_.export_params->normals) {
-    get_loop_normals(mesh, normals);
-
     ON3fGeomParam::Sample normals_sample;
-    if (!normals.empty()) {
+    if (!prepared_.normals.empty()) {
       normals_sample.setScope(kFacevaryingScope);
-      normals_sample.setVals(V3fArraySample(normals));
+      normals_sample.setVals(V3fArraySample(prepared_.normals));
     }
 
     mesh_sample.setNormals(normals_sample);
@@ -271,12 +297,8 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
 void ABCGenericMeshWriter::write_subd(HierarchyContext &context, Mesh *mesh)
 {
   std::vector<float> edge_crease_sharpness, vert_crease_sharpness;
-  std::vector<Imath::V3f> points;
-  std::vector<int32_t> face_verts, loop_counts;
   std::vector<int32_t> edge_crease_indices, edge_crease_lengths, vert_crease_indices;
 
-  get_vertices(mesh, points);
-  get_topology(mesh, face_verts, loop_counts);
   get_edge_creases(mesh, edge_crease_indices, edge_crease_lengths, edge_crease_sharpness);
   get_vert_creases(mesh, vert_crease_indices, vert_crease_sharpness);
 
@@ -285,7 +307,9 @@ void ABCGenericMeshWriter::write_subd(HierarchyContext &context, Mesh *mesh)
   }
 
   OSubDSchema::Sample subdiv_sample = OSubDSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(face_verts), Int32ArraySample(loop_counts));
+      V3fArraySample(prepared_.points),
+      Int32ArraySample(prepared_.face_verts),
+      Int32ArraySample(prepared_.loop_counts));
 
   UVSample sample;
   if (args_.export_params->uvs) {
@@ -565,6 +589,11 @@ static void get_loop_normals(const Mesh *mesh, std::vector<Imath::V3f> &normals)
 
 ABCMeshWriter::ABCMeshWriter(const ABCWriterConstructorArgs &args) : ABCGenericMeshWriter(args) {}
 
+void ABCMeshWriter::do_prepare(HierarchyContext &context)
+{
+  prepare_mesh(context);
+}
+
 Mesh *ABCMeshWriter::get_export_mesh(Object *object_eval, bool & /*r_needsfree*/)
 {
   return BKE_object_get_evaluated_mesh(object_eval);
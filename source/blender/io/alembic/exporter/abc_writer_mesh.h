@@ -36,8 +36,20 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
 
   CDStreamConfig m_custom_data_config;
 
+  /* Export mesh of the current frame and the samples converted from it, created by
+   * prepare_mesh() and consumed by do_write(). */
+  struct PreparedMesh {
+    Mesh *mesh = nullptr;
+    bool needs_free = false;
+    std::vector<Imath::V3f> points;
+    std::vector<int32_t> face_verts;
+    std::vector<int32_t> loop_counts;
+    std::vector<Imath::V3f> normals;
+  } prepared_;
+
  public:
   explicit ABCGenericMeshWriter(const ABCWriterConstructorArgs &args);
+  ~ABCGenericMeshWriter() override;
 
   virtual void create_alembic_objects(const HierarchyContext *context) override;
   virtual Alembic::Abc::OObject get_alembic_object() const override;
@@ -52,7 +64,13 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
 
   virtual bool export_as_subdivision_surface(Object *ob_eval) const;
 
+  /* Get the export mesh and convert its geometry for do_write(). This can be called from
+   * do_prepare() by subclasses whose get_export_mesh() is safe to call in parallel. Otherwise it
+   * is called by do_write(). */
+  void prepare_mesh(HierarchyContext &context);
+
  private:
+  void free_prepared_mesh();
   void write_mesh(HierarchyContext &context, Mesh *mesh);
   void write_subd(HierarchyContext &context, Mesh *mesh);
   template<typename Schema> void write_face_sets(Object *object, Mesh *mesh, Schema &schema);
@@ -70,6 +88,7 @@ class ABCMeshWriter : public ABCGenericMeshWriter {
   ABCMeshWriter(const ABCWriterConstructorArgs &args);
 
  protected:
+  virtual void do_prepare(HierarchyContext &context) override;
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) override;
 };
 
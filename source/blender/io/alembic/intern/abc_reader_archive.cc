@@ -15,11 +15,13 @@
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 
 #ifdef WIN32
 #  include "utfconv.hh"
 #endif
 
+#include <algorithm>
 #include <fstream>
 #include <vector>
 
@@ -30,6 +32,10 @@ using Alembic::Abc::kWrapExisting;
 
 namespace blender::io::alembic {
 
+/* Upper limit for the number of streams an archive is opened with, to avoid running out of file
+ * handles when many cache files are open. */
+static constexpr int MAX_STREAMS_PER_ARCHIVE = 8;
+
 static IArchive open_archive(const std::string &filename,
                              const std::vector<std::istream *> &input_streams)
 {
@@ -111,16 +117,24 @@ ArchiveReader::ArchiveReader(const Main *bmain, const char *filename)
   STRNCPY(abs_filepath, filename);
   BLI_path_abs(abs_filepath, BKE_main_blendfile_path(bmain));
 
+  const int streams_num = std::min(BLI_system_thread_count(), MAX_STREAMS_PER_ARCHIVE);
+  for (int i = 0; i < streams_num; i++) {
+    std::unique_ptr<std::ifstream> infile = std::make_unique<std::ifstream>();
 #ifdef WIN32
-  UTF16_ENCODE(abs_filepath);
-  std::wstring wstr(abs_filepath_16);
-  m_infile.open(wstr.c_str(), std::ios::in | std::ios::binary);
-  UTF16_UN_ENCODE(abs_filepath);
+    UTF16_ENCODE(abs_filepath);
+    std::wstring wstr(abs_filepath_16);
+    infile->open(wstr.c_str(), std::ios::in | std::ios::binary);
+    UTF16_UN_ENCODE(abs_filepath);
 #else
-  m_infile.open(abs_filepath, std::ios::in | std::ios::binary);
+    infile->open(abs_filepath, std::ios::in | std::ios::binary);
 #endif
-
-  m_streams.push_back(&m_infile);
+    if (!infile->is_open() && !m_infiles.empty()) {
+      /* Reading works with fewer streams, just not as many in parallel. */
+      break;
+    }
+    m_streams.push_back(infile.get());
+    m_infiles.push_back(std::move(infile));
+  }
 
   m_archive = open_archive(abs_filepath, m_streams);
 }
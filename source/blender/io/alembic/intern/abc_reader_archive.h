@@ -11,6 +11,7 @@
 #include <Alembic/Abc/IObject.h>
 
 #include <fstream>
+#include <memory>
 #include <vector>
 
 struct Main;
@@ -21,10 +22,13 @@ namespace blender::io::alembic {
  * Wrappers around input and output archives. The goal is to be able to use
  * streams so that unicode paths work on Windows (#49112), and to make sure that
  * the stream objects remain valid as long as the archives are open.
+ *
+ * The file is opened with several streams, which Ogawa hands out to concurrent reads, so that
+ * objects sharing an archive can read their samples in parallel during depsgraph evaluation.
  */
 class ArchiveReader {
   Alembic::Abc::IArchive m_archive;
-  std::ifstream m_infile;
+  std::vector<std::unique_ptr<std::ifstream>> m_infiles;
   std::vector<std::istream *> m_streams;
 
   std::vector<ArchiveReader *> m_readers;
@@ -24,9 +24,12 @@
 
 #include "DEG_depsgraph.hh"
 
+#include "BLI_timeit.hh"
+
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 struct Depsgraph;
 struct DupliObject;
@@ -109,6 +112,12 @@ struct HierarchyContext {
 class AbstractHierarchyWriter {
  public:
   virtual ~AbstractHierarchyWriter() = default;
+  /* Convert the evaluated data of the context into data owned by the writer, so that write() only
+   * has to pass it on to the exported file. This is called for all writers of an iteration in
+   * parallel, before write() is called for them one at a time in hierarchy order. It must not
+   * access the exported file or any other state shared between writers. The default
+   * implementation does nothing, leaving all work to write(). */
+  virtual void prepare(HierarchyContext & /*context*/) {}
   virtual void write(HierarchyContext &context) = 0;
   /* TODO(Sybren): add function like absent() that's called when a writer was previously created,
    * but wasn't used while exporting the current frame (for example, a particle-instanced mesh of
@@ -151,6 +160,7 @@ class EnsuredWriter {
   static EnsuredWriter newly_created(AbstractHierarchyWriter *writer);
 
   bool is_newly_created() const;
+  AbstractHierarchyWriter *get() const;
 
   /* These operators make an EnsuredWriter* act as an AbstractHierarchyWriter* */
   operator bool() const;
@@ -222,6 +232,10 @@ class AbstractHierarchyIterator {
   /* Release all writers. Call after all frames have been exported. */
   void release_writers();
 
+  /* Time spent in the prepare() and write() calls of the writers, summed over all iterations. */
+  timeit::Nanoseconds prepare_duration() const;
+  timeit::Nanoseconds write_duration() const;
+
   /* Determine which subset of writers is used for exporting.
    * Set this before calling iterate_and_write().
    *
@@ -246,6 +260,17 @@ class AbstractHierarchyIterator {
   virtual std::string get_object_data_path(const HierarchyContext *context) const;
 
  private:
+  /* A write() call queued by make_writers(). The context is a copy, because the contexts of the
+   * export graph and of object data only live as long as the iteration. */
+  struct PendingWrite {
+    AbstractHierarchyWriter *writer;
+    HierarchyContext context;
+  };
+  std::vector<PendingWrite> pending_writes_;
+
+  timeit::Nanoseconds prepare_duration_ = timeit::Nanoseconds::zero();
+  timeit::Nanoseconds write_duration_ = timeit::Nanoseconds::zero();
+
   void debug_print_export_graph(const ExportGraph &graph) const;
 
   void export_graph_construct();
@@ -265,11 +290,15 @@ class AbstractHierarchyIterator {
   void determine_duplication_references(const HierarchyContext *parent_context,
                                         const std::string &indent);
 
-  /* These three functions create writers and call their write() method. */
+  /* These three functions create writers and queue calls to their write() method. */
   void make_writers(const HierarchyContext *parent_context);
   void make_writer_object_data(const HierarchyContext *context);
   void make_writers_particle_systems(const HierarchyContext *transform_context);
 
+  /* Prepare the queued writes in parallel, then write them in the order they were queued. Writers
+   * are keyed by their export path, so every writer is queued at most once per iteration. */
+  void write_pending();
+
   /* Return the appropriate HierarchyContext for the data of the object represented by
    * object_context. */
   HierarchyContext context_for_object_data(const HierarchyContext *object_context) const;
@@ -19,6 +19,7 @@
 #include "BLI_assert.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
+#include "BLI_task.hh"
 
 #include "DNA_ID.h"
 #include "DNA_layer_types.h"
@@ -110,6 +111,11 @@ bool EnsuredWriter::is_newly_created() const
   return newly_created_;
 }
 
+AbstractHierarchyWriter *EnsuredWriter::get() const
+{
+  return writer_;
+}
+
 EnsuredWriter::operator bool() const
 {
   return writer_ != nullptr;
@@ -183,9 +189,39 @@ void AbstractHierarchyIterator::iterate_and_write()
   determine_export_paths(HierarchyContext::root());
   determine_duplication_references(HierarchyContext::root(), "");
   make_writers(HierarchyContext::root());
+  write_pending();
   export_graph_clear();
 }
 
+void AbstractHierarchyIterator::write_pending()
+{
+  const timeit::TimePoint prepare_start = timeit::Clock::now();
+  threading::parallel_for(IndexRange(pending_writes_.size()), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      pending_writes_[i].writer->prepare(pending_writes_[i].context);
+    }
+  });
+
+  const timeit::TimePoint write_start = timeit::Clock::now();
+  for (PendingWrite &pending_write : pending_writes_) {
+    pending_write.writer->write(pending_write.context);
+  }
+  pending_writes_.clear();
+
+  prepare_duration_ += write_start - prepare_start;
+  write_duration_ += timeit::Clock::now() - write_start;
+}
+
+timeit::Nanoseconds AbstractHierarchyIterator::prepare_duration() const
+{
+  return prepare_duration_;
+}
+
+timeit::Nanoseconds AbstractHierarchyIterator::write_duration() const
+{
+  return write_duration_;
+}
+
 void AbstractHierarchyIterator::release_writers()
 {
   for (WriterMap::value_type it : writers_) {
@@ -599,7 +635,7 @@ void AbstractHierarchyIterator::make_writers(const HierarchyContext *parent_cont
       /* XXX This can lead to too many XForms being written. For example, a camera writer can
        * refuse to write an orthographic camera. By the time that this is known, the XForm has
        * already been written. */
-      transform_writer->write(*context);
+      pending_writes_.push_back({transform_writer.get(), *context});
     }
 
     if (!context->weak_export) {
@@ -649,7 +685,7 @@ void AbstractHierarchyIterator::make_writer_object_data(const HierarchyContext *
   }
 
   if (data_writer.is_newly_created() || export_subset_.shapes) {
-    data_writer->write(data_context);
+    pending_writes_.push_back({data_writer.get(), data_context});
   }
 }
 
@@ -694,7 +730,7 @@ void AbstractHierarchyIterator::make_writers_particle_systems(
 
     /* Always write upon creation, otherwise depend on which subset is active. */
     if (writer.is_newly_created() || export_subset_.shapes) {
-      writer->write(hair_context);
+      pending_writes_.push_back({writer.get(), hair_context});
     }
   }
 }
@@ -27,14 +27,25 @@ class TestHierarchyWriter : public AbstractHierarchyWriter {
  public:
   std::string writer_type;
   used_writers &writers_map;
+  std::set<std::string> prepared_export_paths;
 
   TestHierarchyWriter(const std::string &writer_type, used_writers &writers_map)
       : writer_type(writer_type), writers_map(writers_map)
   {
   }
 
+  void prepare(HierarchyContext &context) override
+  {
+    prepared_export_paths.insert(context.export_path);
+  }
+
   void write(HierarchyContext &context) override
   {
+    if (prepared_export_paths.erase(context.export_path) == 0) {
+      ADD_FAILURE() << "Expected " << writer_type << " writer to be prepared before writing to "
+                    << context.export_path;
+    }
+
     const char *id_name = context.object->id.name;
     used_writers::mapped_type &writers = writers_map[id_name];
 
@@ -5,7 +5,9 @@
 #include "ply_import_buffer.hh"
 
 #include "BLI_fileops.h"
+#include "BLI_mmap.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <stdexcept>
@@ -25,6 +27,9 @@ PlyReadBuffer::PlyReadBuffer(const char *file_path, size_t read_buffer_size)
 
 PlyReadBuffer::~PlyReadBuffer()
 {
+  if (mmap_file_ != nullptr) {
+    BLI_mmap_free(mmap_file_);
+  }
   if (file_ != nullptr) {
     fclose(file_);
   }
@@ -33,6 +38,38 @@ PlyReadBuffer::~PlyReadBuffer()
 void PlyReadBuffer::after_header(bool is_binary)
 {
   is_binary_ = is_binary;
+  if (is_binary_) {
+    map_file();
+  }
+}
+
+void PlyReadBuffer::map_file()
+{
+  if (file_ == nullptr) {
+    return;
+  }
+  mmap_file_ = BLI_mmap_open(fileno(file_));
+  if (mmap_file_ == nullptr) {
+    /* Continue reading through the buffer from where the header ended. */
+    fseek(file_, buffer_file_offset_ + buf_used_, SEEK_SET);
+    return;
+  }
+  mapped_data_ = Span<uint8_t>(static_cast<const uint8_t *>(BLI_mmap_get_pointer(mmap_file_)),
+                               int64_t(BLI_mmap_get_length(mmap_file_)));
+  mapped_pos_ = buffer_file_offset_ + pos_;
+}
+
+Span<uint8_t> PlyReadBuffer::mapped_remaining() const
+{
+  BLI_assert(is_mapped());
+  return mapped_data_.drop_front(std::min<int64_t>(mapped_pos_, mapped_data_.size()));
+}
+
+Span<uint8_t> PlyReadBuffer::read_mapped_bytes(size_t size)
+{
+  const Span<uint8_t> result = mapped_remaining().take_front(int64_t(size));
+  mapped_pos_ += result.size();
+  return result;
 }
 
 Span<char> PlyReadBuffer::read_line()
@@ -62,6 +99,11 @@ Span<char> PlyReadBuffer::read_line()
 
 bool PlyReadBuffer::read_bytes(void *dst, size_t size)
 {
+  if (is_mapped()) {
+    const Span<uint8_t> bytes = read_mapped_bytes(size);
+    memcpy(dst, bytes.data(), bytes.size());
+    return size_t(bytes.size()) == size;
+  }
   while (size > 0) {
     if (pos_ + size > buf_used_) {
       if (!refill_buffer()) {
@@ -91,6 +133,7 @@ bool PlyReadBuffer::refill_buffer()
   }
 
   /* Move any leftover to start of buffer. */
+  buffer_file_offset_ += pos_;
   int keep = buf_used_ - pos_;
   if (keep > 0) {
     memmove(buffer_.data(), buffer_.data() + pos_, keep);
@@ -13,18 +13,26 @@
 #include "BLI_array.hh"
 #include "BLI_span.hh"
 
+struct BLI_mmap_file;
+
 namespace blender::io::ply {
 
 /**
  * Reads underlying PLY file in large chunks, and provides interface for ascii/header
  * parsing to read individual lines, and for binary parsing to read chunks of bytes.
+ *
+ * The data after the header of binary files is mapped into memory when possible, so that
+ * elements can be decoded in place on multiple threads, see #is_mapped.
  */
 class PlyReadBuffer {
  public:
   PlyReadBuffer(const char *file_path, size_t read_buffer_size = 64 * 1024);
   ~PlyReadBuffer();
 
-  /** After header is parsed, indicate whether the rest of reading will be ascii or binary. */
+  /**
+   * After header is parsed, indicate whether the rest of reading will be ascii or binary.
+   * Binary data is then read from a memory mapping of the file if it can be mapped.
+   */
   void after_header(bool is_binary);
 
   /**
@@ -38,8 +46,24 @@ class PlyReadBuffer {
    */
   bool read_bytes(void *dst, size_t size);
 
+  /** Whether the binary data after the header is read from a memory mapping of the file. */
+  bool is_mapped() const
+  {
+    return mmap_file_ != nullptr;
+  }
+
+  /** All bytes of the mapped file that were not read yet, without consuming them. */
+  Span<uint8_t> mapped_remaining() const;
+
+  /**
+   * Consumes a number of bytes from the mapped file and returns them without copying. The result
+   * is shorter than the requested size if the file ends before.
+   */
+  Span<uint8_t> read_mapped_bytes(size_t size);
+
  private:
   bool refill_buffer();
+  void map_file();
 
  private:
   FILE *file_ = nullptr;
@@ -47,9 +71,15 @@ class PlyReadBuffer {
   int pos_ = 0;
   int buf_used_ = 0;
   int last_newline_ = 0;
+  /* Offset of the start of the buffer in the file. */
+  size_t buffer_file_offset_ = 0;
   size_t read_buffer_size_ = 0;
   bool at_eof_ = false;
   bool is_binary_ = false;
+
+  BLI_mmap_file *mmap_file_ = nullptr;
+  Span<uint8_t> mapped_data_;
+  size_t mapped_pos_ = 0;
 };
 
 }  // namespace blender::io::ply
@@ -12,10 +12,12 @@
 
 #include "BLI_endian_switch.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 
 #include "fast_float.h"
 
 #include <charconv>
+#include <cstring>
 
 static bool is_whitespace(char c)
 {
@@ -190,6 +192,37 @@ template<typename T> static T get_binary_value(PlyDataTypes type, const uint8_t
   return val;
 }
 
+/**
+ * Like #get_binary_value, but handles big endian values without modifying the data, which is
+ * read-only when the file is mapped into memory.
+ */
+template<typename T>
+static T read_binary_value(PlyDataTypes type, const uint8_t *&r_ptr, const bool big_endian)
+{
+  if (!big_endian) {
+    return get_binary_value<T>(type, r_ptr);
+  }
+  const int size = data_type_size[type];
+  uint8_t value[8];
+  memcpy(value, r_ptr, size);
+  endian_switch(value, size);
+  r_ptr += size;
+  const uint8_t *value_ptr = value;
+  return get_binary_value<T>(type, value_ptr);
+}
+
+/** Decodes a row of an element without list properties from the mapped file. */
+static void decode_row_binary(const uint8_t *ptr,
+                              const PlyElement &element,
+                              const bool big_endian,
+                              MutableSpan<float> r_values)
+{
+  BLI_assert(r_values.size() == element.properties.size());
+  for (int i = 0, n = int(element.properties.size()); i != n; i++) {
+    r_values[i] = read_binary_value<float>(element.properties[i].type, ptr, big_endian);
+  }
+}
+
 static const char *parse_row_binary(PlyReadBuffer &file,
                                     const PlyHeader &header,
                                     const PlyElement &element,
@@ -266,15 +299,15 @@ static const char *load_vertex_element(PlyReadBuffer &file,
     data->vertex_custom_attr.append(attr);
   }
 
-  data->vertices.reserve(element.count);
+  data->vertices.resize(element.count);
   if (has_color) {
-    data->vertex_colors.reserve(element.count);
+    data->vertex_colors.resize(element.count);
   }
   if (has_normal) {
-    data->vertex_normals.reserve(element.count);
+    data->vertex_normals.resize(element.count);
   }
   if (has_uv) {
-    data->uv_coordinates.reserve(element.count);
+    data->uv_coordinates.resize(element.count);
   }
 
   float4 color_norm = {1, 1, 1, 1};
@@ -287,31 +320,13 @@ static const char *load_vertex_element(PlyReadBuffer &file,
     color_norm.w = data_type_normalizer[element.properties[alpha_index].type];
   }
 
-  Vector<float> value_vec(element.properties.size());
-  Vector<uint8_t> scratch;
-  if (header.type != PlyFormatType::ASCII) {
-    scratch.resize(element.stride);
-  }
-
-  for (int i = 0; i < element.count; i++) {
-
-    const char *error = nullptr;
-    if (header.type == PlyFormatType::ASCII) {
-      error = parse_row_ascii(file, value_vec);
-    }
-    else {
-      error = parse_row_binary(file, header, element, scratch, value_vec);
-    }
-    if (error != nullptr) {
-      return error;
-    }
-
+  const auto store_row = [&](const int i, const Span<float> value_vec) {
     /* Vertex coord */
     float3 vertex3;
     vertex3.x = value_vec[vertex_index.x];
     vertex3.y = value_vec[vertex_index.y];
     vertex3.z = value_vec[vertex_index.z];
-    data->vertices.append(vertex3);
+    data->vertices[i] = vertex3;
 
     /* Vertex color */
     if (has_color) {
@@ -325,7 +340,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       else {
         colors4.w = 1.0f;
       }
-      data->vertex_colors.append(colors4);
+      data->vertex_colors[i] = colors4;
     }
 
     /* If normals */
@@ -334,7 +349,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       normals3.x = value_vec[normal_index.x];
       normals3.y = value_vec[normal_index.y];
       normals3.z = value_vec[normal_index.z];
-      data->vertex_normals.append(normals3);
+      data->vertex_normals[i] = normals3;
     }
 
     /* If uv */
@@ -342,7 +357,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       float2 uvmap;
       uvmap.x = value_vec[uv_index.x];
       uvmap.y = value_vec[uv_index.y];
-      data->uv_coordinates.append(uvmap);
+      data->uv_coordinates[i] = uvmap;
     }
 
     /* Custom attributes */
@@ -350,6 +365,44 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       float value = value_vec[custom_attr_indices[ci]];
       data->vertex_custom_attr[ci].data[i] = value;
     }
+  };
+
+  if (file.is_mapped() && element.stride != 0) {
+    /* All rows have the same size, so they can be decoded in place on multiple threads. */
+    const Span<uint8_t> rows = file.read_mapped_bytes(size_t(element.count) * element.stride);
+    if (rows.size() != int64_t(element.count) * element.stride) {
+      return "Could not read row of binary property";
+    }
+    const bool big_endian = header.type == PlyFormatType::BINARY_BE;
+    threading::parallel_for(IndexRange(element.count), 4096, [&](const IndexRange range) {
+      Vector<float> value_vec(element.properties.size());
+      for (const int i : range) {
+        decode_row_binary(&rows[int64_t(i) * element.stride], element, big_endian, value_vec);
+        store_row(i, value_vec);
+      }
+    });
+    return nullptr;
+  }
+
+  Vector<float> value_vec(element.properties.size());
+  Vector<uint8_t> scratch;
+  if (header.type != PlyFormatType::ASCII) {
+    scratch.resize(element.stride);
+  }
+
+  for (int i = 0; i < element.count; i++) {
+
+    const char *error = nullptr;
+    if (header.type == PlyFormatType::ASCII) {
+      error = parse_row_ascii(file, value_vec);
+    }
+    else {
+      error = parse_row_binary(file, header, element, scratch, value_vec);
+    }
+    if (error != nullptr) {
+      return error;
+    }
+    store_row(i, value_vec);
   }
   return nullptr;
 }
@@ -385,6 +438,104 @@ static void skip_property(PlyReadBuffer &file,
   }
 }
 
+/**
+ * Skips a property of a row in the mapped file. Returns false if the row does not fit into the
+ * remaining bytes.
+ */
+static bool skip_mapped_property(const Span<uint8_t> bytes,
+                                 const PlyProperty &prop,
+                                 const bool big_endian,
+                                 int64_t &r_pos)
+{
+  if (prop.count_type == PlyDataTypes::NONE) {
+    r_pos += data_type_size[prop.type];
+    return r_pos <= bytes.size();
+  }
+  if (r_pos + data_type_size[prop.count_type] > bytes.size()) {
+    return false;
+  }
+  const uint8_t *ptr = &bytes[r_pos];
+  const uint32_t count = read_binary_value<uint32_t>(prop.count_type, ptr, big_endian);
+  r_pos += data_type_size[prop.count_type] + int64_t(count) * data_type_size[prop.type];
+  return r_pos <= bytes.size();
+}
+
+/**
+ * Loads the faces of a binary file that is mapped into memory. Since the rows have varying sizes,
+ * they are located in a sequential pass that only reads the list sizes, and the vertex indices
+ * are then decoded on multiple threads.
+ */
+static const char *load_face_element_mapped(PlyReadBuffer &file,
+                                            const PlyHeader &header,
+                                            const PlyElement &element,
+                                            const int prop_index,
+                                            PlyData *data)
+{
+  const bool big_endian = header.type == PlyFormatType::BINARY_BE;
+  const PlyProperty &prop = element.properties[prop_index];
+  const Span<uint8_t> bytes = file.mapped_remaining();
+
+  /* Offsets of the vertex indices of the faces in the file. */
+  Vector<int64_t> list_offsets;
+  list_offsets.reserve(element.count);
+
+  int64_t pos = 0;
+  for (int i = 0; i < element.count; i++) {
+    /* Skip any properties before vertex indices. */
+    for (int j = 0; j < prop_index; j++) {
+      if (!skip_mapped_property(bytes, element.properties[j], big_endian, pos)) {
+        return "Could not read face element";
+      }
+    }
+
+    const int64_t list_pos = pos;
+    if (!skip_mapped_property(bytes, prop, big_endian, pos)) {
+      return "Could not read face element";
+    }
+    const uint8_t *ptr = &bytes[list_pos];
+    const uint32_t count = read_binary_value<uint32_t>(prop.count_type, ptr, big_endian);
+    if (count < 1 || count > 255) {
+      return "Invalid face size, must be between 1 and 255";
+    }
+    /* Previous python based importer was accepting faces with fewer
+     * than 3 vertices, and silently dropping them. */
+    if (count < 3) {
+      fprintf(stderr, "PLY Importer: ignoring face %i (%i vertices)\n", i, int(count));
+    }
+    else {
+      list_offsets.append(list_pos + data_type_size[prop.count_type]);
+      data->face_sizes.append(count);
+    }
+
+    /* Skip any properties after vertex indices. */
+    for (int j = prop_index + 1; j < element.properties.size(); j++) {
+      if (!skip_mapped_property(bytes, element.properties[j], big_endian, pos)) {
+        return "Could not read face element";
+      }
+    }
+  }
+  file.read_mapped_bytes(pos);
+
+  Array<int> face_offsets(data->face_sizes.size() + 1);
+  int offset = 0;
+  for (const int i : data->face_sizes.index_range()) {
+    face_offsets[i] = offset;
+    offset += data->face_sizes[i];
+  }
+  face_offsets.last() = offset;
+
+  data->face_vertices.resize(offset);
+  threading::parallel_for(list_offsets.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const uint8_t *ptr = &bytes[list_offsets[i]];
+      for (const int j : IndexRange::from_begin_end(face_offsets[i], face_offsets[i + 1])) {
+        data->face_vertices[j] = read_binary_value<uint32_t>(prop.type, ptr, big_endian);
+      }
+    }
+  });
+  return nullptr;
+}
+
 static const char *load_face_element(PlyReadBuffer &file,
                                      const PlyHeader &header,
                                      const PlyElement &element,
@@ -452,6 +603,9 @@ static const char *load_face_element(PlyReadBuffer &file,
       data->face_sizes.append(count);
     }
   }
+  else if (file.is_mapped()) {
+    return load_face_element_mapped(file, header, element, prop_index, data);
+  }
   else {
     Vector<uint8_t> scratch(64);
 
@@ -12,6 +12,9 @@
 #include "BKE_mesh.hh"
 
 #include "BLI_array.hh"
+#include "BLI_fileops.hh"
+#include "BLI_mmap.h"
+#include "BLI_memory_utils.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -24,7 +27,6 @@ namespace blender::io::stl {
 
 Mesh *read_stl_binary(FILE *file, const bool use_custom_normals)
 {
-  const int chunk_size = 1024;
   uint32_t num_tris = 0;
   fseek(file, BINARY_HEADER_SIZE, SEEK_SET);
   if (fread(&num_tris, sizeof(uint32_t), 1, file) != 1) {
@@ -36,16 +38,33 @@ Mesh *read_stl_binary(FILE *file, const bool use_custom_normals)
     return BKE_mesh_new_nomain(0, 0, 0, 0);
   }
 
-  Array<PackedTriangle> tris_buf(chunk_size);
-  STLMeshHelper stl_mesh(num_tris, use_custom_normals);
-  size_t num_read_tris;
-  while ((num_read_tris = fread(tris_buf.data(), sizeof(PackedTriangle), chunk_size, file))) {
-    for (size_t i = 0; i < num_read_tris; i++) {
-      stl_mesh.add_triangle(tris_buf[i]);
+  /* Corner indices are stored as int in the mesh. */
+  if (int64_t(num_tris) * 3 > INT_MAX) {
+    fprintf(stderr, "STL Importer: too many triangles (%u)\n", num_tris);
+    return nullptr;
+  }
+
+  /* Decode the triangles directly from the mapped file when possible, so that they can be
+   * processed on multiple threads without copying them first. */
+  const size_t tris_offset = BINARY_HEADER_SIZE + sizeof(uint32_t);
+  BLI_mmap_file *mmap_file = BLI_mmap_open(fileno(file));
+  if (mmap_file != nullptr) {
+    BLI_SCOPED_DEFER([&]() { BLI_mmap_free(mmap_file); });
+    if (BLI_mmap_get_length(mmap_file) >= tris_offset + size_t(num_tris) * BINARY_STRIDE) {
+      const PackedTriangle *tris = reinterpret_cast<const PackedTriangle *>(
+          static_cast<const char *>(BLI_mmap_get_pointer(mmap_file)) + tris_offset);
+      return stl_triangles_to_mesh(Span<PackedTriangle>(tris, num_tris), use_custom_normals);
     }
   }
 
-  return stl_mesh.to_mesh();
+  /* Fall back to reading the whole file when it can not be mapped. */
+  Array<PackedTriangle> tris(num_tris);
+  fseek(file, tris_offset, SEEK_SET);
+  if (fread(tris.data(), sizeof(PackedTriangle), num_tris, file) != num_tris) {
+    stl_import_report_error(file);
+    return nullptr;
+  }
+  return stl_triangles_to_mesh(tris, use_custom_normals);
 }
 
 }  // namespace blender::io::stl
@@ -10,8 +10,14 @@
 
 #include "BKE_mesh.hh"
 
+#include "BLI_array.hh"
 #include "BLI_array_utils.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_math_base.h"
+#include "BLI_offset_indices.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -79,4 +85,342 @@ Mesh *STLMeshHelper::to_mesh()
   return mesh;
 }
 
+static void report_removed_triangles(const int64_t degenerate_tris_num,
+                                     const int64_t duplicate_tris_num)
+{
+  if (degenerate_tris_num > 0) {
+    std::cout << "STL Importer: " << degenerate_tris_num << " degenerate triangles were removed"
+              << std::endl;
+  }
+  if (duplicate_tris_num > 0) {
+    std::cout << "STL Importer: " << duplicate_tris_num << " duplicate triangles were removed"
+              << std::endl;
+  }
+}
+
+static IndexRange chunk_range(const int64_t chunk, const int64_t chunk_size, const int64_t size)
+{
+  const int64_t begin = chunk * chunk_size;
+  return IndexRange::from_begin_end(begin, std::min(begin + chunk_size, size));
+}
+
+/**
+ * Deduplicates keys that are added in blocks and numbers the unique keys in the order of their
+ * first occurrence, like a #VectorSet. The unique keys are stored in that order and the hash table
+ * only stores their numbers, so it needs a few integers per unique key. The table is split into
+ * partitions by hash, the keys of every block are scattered into the partitions with a stable
+ * counting sort, and every partition is then filled on its own thread in the order of the keys, so
+ * the result does not depend on the scheduling. The memory used for a block is proportional to its
+ * size.
+ */
+template<typename Key> class OrderedDeduplicator {
+ private:
+  static constexpr int partition_bits = 8;
+  static constexpr int partitions_num = 1 << partition_bits;
+  static constexpr int64_t chunk_size = 64 * 1024;
+
+  /* Empty slots are -1, the slots of keys of the current block that are not numbered yet store
+   * -2 minus their index in the block, other slots store the number of their key. */
+  static constexpr int empty_slot = -1;
+
+  struct Partition {
+    Array<int> slots;
+    int64_t size = 0;
+  };
+
+  Array<Partition> partitions_;
+  Vector<Key> keys_;
+  Vector<int> added_indices_;
+
+ public:
+  OrderedDeduplicator() : partitions_(partitions_num) {}
+
+  int64_t size() const
+  {
+    return keys_.size();
+  }
+
+  /** The unique keys in the order of their numbers. */
+  Span<Key> keys() const
+  {
+    return keys_;
+  }
+
+  /** The indices in the last added block of the keys that were added to the unique keys. */
+  Span<int> added_indices() const
+  {
+    return added_indices_;
+  }
+
+  /** Frees the hash table, keys can not be added afterwards. */
+  void free_table()
+  {
+    partitions_ = {};
+  }
+
+  /** Adds a block of keys and writes the number of the unique key equal to every key. */
+  void add_block(const Span<Key> block, MutableSpan<int> r_numbers)
+  {
+    BLI_assert(block.size() == r_numbers.size());
+    const int64_t chunks_num = divide_ceil_ul(block.size(), chunk_size);
+
+    /* Count the keys of every partition in every chunk. */
+    Array<uint64_t> hashes(block.size());
+    Array<int> offsets(chunks_num * partitions_num, 0);
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+      for (const int64_t chunk : range) {
+        MutableSpan<int> chunk_counts = offsets.as_mutable_span().slice(chunk * partitions_num,
+                                                                        partitions_num);
+        for (const int64_t i : chunk_range(chunk, chunk_size, block.size())) {
+          hashes[i] = hash_key(block[i]);
+          chunk_counts[partition_of(hashes[i])]++;
+        }
+      }
+    });
+
+    /* Lay the partitions out one after another, with the keys of every chunk in chunk order. */
+    Array<int> partition_offsets(partitions_num + 1);
+    int offset = 0;
+    for (const int partition : IndexRange(partitions_num)) {
+      partition_offsets[partition] = offset;
+      for (const int64_t chunk : IndexRange(chunks_num)) {
+        const int count = offsets[chunk * partitions_num + partition];
+        offsets[chunk * partitions_num + partition] = offset;
+        offset += count;
+      }
+    }
+    partition_offsets.last() = offset;
+
+    Array<int> sorted_indices(block.size());
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+      for (const int64_t chunk : range) {
+        MutableSpan<int> chunk_offsets = offsets.as_mutable_span().slice(chunk * partitions_num,
+                                                                         partitions_num);
+        for (const int64_t i : chunk_range(chunk, chunk_size, block.size())) {
+          sorted_indices[chunk_offsets[partition_of(hashes[i])]++] = int(i);
+        }
+      }
+    });
+    const auto partition_indices = [&](const int partition) {
+      return sorted_indices.as_span().slice(IndexRange::from_begin_end(
+          partition_offsets[partition], partition_offsets[partition + 1]));
+    };
+
+    /* Look up every key, the first occurrence of a new key stores its own index in the block and
+     * the others store the index of the first occurrence, both encoded like the slots. */
+    threading::parallel_for(IndexRange(partitions_num), 1, [&](const IndexRange range) {
+      for (const int partition : range) {
+        for (const int i : partition_indices(partition)) {
+          r_numbers[i] = this->lookup_or_add(partitions_[partition], block, hashes[i], i);
+        }
+      }
+    });
+
+    /* Number the new keys in the order of their first occurrence. */
+    Array<int> chunk_added_offsets(chunks_num + 1, 0);
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+      for (const int64_t chunk : range) {
+        for (const int64_t i : chunk_range(chunk, chunk_size, block.size())) {
+          chunk_added_offsets[chunk] += r_numbers[i] == pending_slot(i);
+        }
+      }
+    });
+    const OffsetIndices<int> added_offsets = offset_indices::accumulate_counts_to_offsets(
+        chunk_added_offsets);
+    const int64_t old_size = keys_.size();
+    keys_.resize(old_size + added_offsets.total_size());
+    added_indices_.resize(added_offsets.total_size());
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+      for (const int64_t chunk : range) {
+        int64_t added_index = added_offsets[chunk].start();
+        for (const int64_t i : chunk_range(chunk, chunk_size, block.size())) {
+          if (r_numbers[i] == pending_slot(i)) {
+            added_indices_[added_index] = int(i);
+            keys_[old_size + added_index] = block[i];
+            r_numbers[i] = int(old_size + added_index);
+            added_index++;
+          }
+        }
+      }
+    });
+
+    /* Resolve the other occurrences of the new keys and replace the pending slots. */
+    threading::parallel_for(block.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        if (r_numbers[i] < 0) {
+          r_numbers[i] = r_numbers[pending_index(r_numbers[i])];
+        }
+      }
+    });
+    threading::parallel_for(IndexRange(partitions_num), 1, [&](const IndexRange range) {
+      for (const int partition : range) {
+        Partition &data = partitions_[partition];
+        const uint64_t mask = uint64_t(data.slots.size()) - 1;
+        for (const int i : partition_indices(partition)) {
+          if (r_numbers[i] < old_size || added_indices_[r_numbers[i] - old_size] != i) {
+            continue;
+          }
+          uint64_t slot = hashes[i] & mask;
+          while (data.slots[slot] != pending_slot(i)) {
+            slot = (slot + 1) & mask;
+          }
+          data.slots[slot] = r_numbers[i];
+        }
+      }
+    });
+  }
+
+ private:
+  static int pending_slot(const int64_t index)
+  {
+    return -2 - int(index);
+  }
+
+  static int pending_index(const int slot)
+  {
+    return -2 - slot;
+  }
+
+  /* The hash is mixed since some hashes only vary in their lower bits. The slots are chosen by the
+   * lower bits and the partitions by the upper bits. */
+  static uint64_t hash_key(const Key &key)
+  {
+    return uint64_t(DefaultHash<Key>{}(key)) * 0x9E3779B97F4A7C15ull;
+  }
+
+  static int partition_of(const uint64_t hash)
+  {
+    return int(hash >> (64 - partition_bits));
+  }
+
+  const Key &slot_key(const int slot, const Span<Key> block) const
+  {
+    return slot >= 0 ? keys_[slot] : block[pending_index(slot)];
+  }
+
+  /* Uses linear probing with a load factor of at most one half. */
+  int lookup_or_add(Partition &data, const Span<Key> block, const uint64_t hash, const int index)
+  {
+    if ((data.size + 1) * 2 > data.slots.size()) {
+      this->grow(data, block);
+    }
+    const uint64_t mask = uint64_t(data.slots.size()) - 1;
+    for (uint64_t slot = hash & mask;; slot = (slot + 1) & mask) {
+      const int value = data.slots[slot];
+      if (value == empty_slot) {
+        data.slots[slot] = pending_slot(index);
+        data.size++;
+        return pending_slot(index);
+      }
+      if (this->slot_key(value, block) == block[index]) {
+        return value;
+      }
+    }
+  }
+
+  void grow(Partition &data, const Span<Key> block) const
+  {
+    Array<int> old_slots = std::move(data.slots);
+    data.slots = Array<int>(std::max<int64_t>(old_slots.size() * 2, 64), empty_slot);
+    const uint64_t mask = uint64_t(data.slots.size()) - 1;
+    for (const int value : old_slots) {
+      if (value == empty_slot) {
+        continue;
+      }
+      uint64_t slot = hash_key(this->slot_key(value, block)) & mask;
+      while (data.slots[slot] != empty_slot) {
+        slot = (slot + 1) & mask;
+      }
+      data.slots[slot] = value;
+    }
+  }
+};
+
+Mesh *stl_triangles_to_mesh(const Span<PackedTriangle> tris, const bool use_custom_normals)
+{
+  /* The triangles are welded in blocks, so that the temporary per corner data is bounded by the
+   * block size instead of growing with the number of triangles. */
+  constexpr int64_t block_size = 1024 * 1024;
+  const int64_t max_block_size = std::min(tris.size(), block_size);
+  Array<float3> corner_positions(max_block_size * 3);
+  Array<int> corner_verts(max_block_size * 3);
+  Array<Triangle> block_tris(max_block_size);
+  Array<int> block_tri_indices(max_block_size);
+  Array<int> tri_numbers(max_block_size);
+
+  OrderedDeduplicator<float3> verts;
+  OrderedDeduplicator<Triangle> unique_tris;
+  Vector<int> unique_tri_indices;
+  int64_t degenerate_tris_num = 0;
+
+  for (int64_t block_start = 0; block_start < tris.size(); block_start += block_size) {
+    const Span<PackedTriangle> block = tris.slice(
+        IndexRange::from_begin_end(block_start, std::min(block_start + block_size, tris.size())));
+
+    /* Negative zeros are replaced by adding zero, since they compare equal to positive zeros but
+     * have a different hash, so they would not be merged reliably. */
+    threading::parallel_for(block.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        corner_positions[i * 3] = block[i].vertices[0] + float3(0.0f);
+        corner_positions[i * 3 + 1] = block[i].vertices[1] + float3(0.0f);
+        corner_positions[i * 3 + 2] = block[i].vertices[2] + float3(0.0f);
+      }
+    });
+
+    /* Weld the vertices, numbering them in order of their first use like #STLMeshHelper. */
+    const MutableSpan<int> block_corner_verts = corner_verts.as_mutable_span().take_front(
+        block.size() * 3);
+    verts.add_block(corner_positions.as_span().take_front(block.size() * 3), block_corner_verts);
+
+    /* Degenerate triangles are removed, but their vertices are kept. */
+    IndexMaskMemory memory;
+    const IndexMask valid_tris = IndexMask::from_predicate(
+        block.index_range(), GrainSize(4096), memory, [&](const int64_t i) {
+          const int v1 = block_corner_verts[i * 3];
+          const int v2 = block_corner_verts[i * 3 + 1];
+          const int v3 = block_corner_verts[i * 3 + 2];
+          return v1 != v2 && v1 != v3 && v2 != v3;
+        });
+    degenerate_tris_num += block.size() - valid_tris.size();
+    valid_tris.foreach_index(GrainSize(4096), [&](const int64_t i, const int64_t pos) {
+      block_tris[pos] = {
+          block_corner_verts[i * 3], block_corner_verts[i * 3 + 1], block_corner_verts[i * 3 + 2]};
+      block_tri_indices[pos] = int(i);
+    });
+
+    unique_tris.add_block(block_tris.as_span().take_front(valid_tris.size()),
+                          tri_numbers.as_mutable_span().take_front(valid_tris.size()));
+    if (use_custom_normals) {
+      for (const int i : unique_tris.added_indices()) {
+        unique_tri_indices.append(int(block_start) + block_tri_indices[i]);
+      }
+    }
+  }
+  verts.free_table();
+  unique_tris.free_table();
+
+  report_removed_triangles(degenerate_tris_num,
+                           tris.size() - degenerate_tris_num - unique_tris.size());
+
+  Mesh *mesh = BKE_mesh_new_nomain(verts.size(), 0, unique_tris.size(), unique_tris.size() * 3);
+  mesh->vert_positions_for_write().copy_from(verts.keys());
+  offset_indices::fill_constant_group_size(3, 0, mesh->face_offsets_for_write());
+  array_utils::copy(unique_tris.keys().cast<int>(), mesh->corner_verts_for_write());
+
+  /* NOTE: edges must be calculated first before setting custom normals. */
+  bke::mesh_calc_edges(*mesh, false, false);
+
+  if (use_custom_normals) {
+    Array<float3> corner_normals(mesh->corners_num);
+    threading::parallel_for(unique_tri_indices.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        corner_normals.as_mutable_span().slice(i * 3, 3).fill(tris[unique_tri_indices[i]].normal);
+      }
+    });
+    BKE_mesh_set_custom_normals(mesh, reinterpret_cast<float(*)[3]>(corner_normals.data()));
+  }
+
+  return mesh;
+}
+
 }  // namespace blender::io::stl
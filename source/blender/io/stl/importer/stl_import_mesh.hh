@@ -11,6 +11,7 @@
 #include <cstdint>
 
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 #include "stl_data.hh"
@@ -67,4 +68,11 @@ class STLMeshHelper {
   Mesh *to_mesh();
 };
 
+/**
+ * Creates a mesh from the triangles of a binary STL file. Duplicate vertices and triangles are
+ * merged like with #STLMeshHelper and keep the order of their first occurrence, but the triangles
+ * are decoded and welded on multiple threads.
+ */
+Mesh *stl_triangles_to_mesh(Span<PackedTriangle> tris, bool use_custom_normals);
+
 }  // namespace blender::io::stl
@@ -441,6 +441,8 @@ pxr::UsdStageRefPtr export_to_stage(const USDExportParams &params,
   worker_status->progress = 0.11f;
   worker_status->do_update = true;
 
+  timeit::Nanoseconds evaluation_duration = timeit::Nanoseconds::zero();
+
   if (params.export_animation) {
     /* Writing the animated frames is not 100% of the work, here it's assumed to be 75% of it. */
     float progress_per_frame = 0.75f / std::max(1, (scene->r.efra - scene->r.sfra + 1));
@@ -451,9 +453,11 @@ pxr::UsdStageRefPtr export_to_stage(const USDExportParams &params,
       }
 
       /* Update the scene for the next frame to render. */
+      const timeit::TimePoint evaluation_start = timeit::Clock::now();
       scene->r.cfra = int(frame);
       scene->r.subframe = frame - scene->r.cfra;
       BKE_scene_graph_update_for_newframe(depsgraph);
+      evaluation_duration += timeit::Clock::now() - evaluation_start;
 
       iter.set_export_frame(frame);
       iter.iterate_and_write();
@@ -470,6 +474,13 @@ pxr::UsdStageRefPtr export_to_stage(const USDExportParams &params,
   worker_status->progress = 0.86f;
   worker_status->do_update = true;
 
+  CLOG_INFO(&LOG,
+            1,
+            "Evaluation took %.3f s, conversion %.3f s, writing %.3f s",
+            std::chrono::duration<double>(evaluation_duration).count(),
+            std::chrono::duration<double>(iter.prepare_duration()).count(),
+            std::chrono::duration<double>(iter.write_duration()).count());
+
   iter.release_writers();
 
   if (params.export_shapekeys || params.export_armatures) {
@@ -25,6 +25,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
 #include "BLT_translation.hh"
@@ -333,11 +334,34 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
     reader->create_object(data->bmain, 0.0);
     if ((++i & 1023) == 0) {
       *data->do_update = true;
-      *data->progress = 0.25f + 0.25f * (i / size);
+      *data->progress = 0.25f + 0.1f * (i / size);
     }
   }
 
+  /* Decode the geometry of all prims in parallel. This is where most of the time is spent for
+   * large stages, and readers only write to their own data here, so that creating the Main data
+   * from the results can be done serially below. */
+  *data->do_update = true;
+  *data->progress = 0.35f;
+  threading::parallel_for(archive->readers().index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t reader_index : range) {
+      if (G.is_break) {
+        return;
+      }
+      if (USDPrimReader *reader = archive->readers()[reader_index]) {
+        reader->decode_object_data(0.0);
+      }
+    }
+  });
+
+  if (G.is_break) {
+    data->was_canceled = true;
+    return;
+  }
+
   /* Setup parenthood and read actual object data. */
+  *data->do_update = true;
+  *data->progress = 0.7f;
   i = 0;
   for (USDPrimReader *reader : archive->readers()) {
 
@@ -358,7 +382,7 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
       ob->parent = parent->object();
     }
 
-    *data->progress = 0.5f + 0.5f * (++i / size);
+    *data->progress = 0.7f + 0.3f * (++i / size);
     *data->do_update = true;
 
     if (G.is_break) {
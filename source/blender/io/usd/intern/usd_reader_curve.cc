@@ -138,11 +138,14 @@ void USDCurvesReader::create_object(Main *bmain, const double /*motionSampleTime
   object_->data = curve_;
 }
 
-void USDCurvesReader::read_object_data(Main *bmain, double motionSampleTime)
+void USDCurvesReader::decode_object_data(const double motionSampleTime)
 {
   Curves *cu = (Curves *)object_->data;
   read_curve_sample(cu, motionSampleTime);
+}
 
+void USDCurvesReader::read_object_data(Main *bmain, double motionSampleTime)
+{
   if (curve_prim_.GetPointsAttr().ValueMightBeTimeVarying()) {
     add_cache_modifier();
   }
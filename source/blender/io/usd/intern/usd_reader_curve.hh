@@ -37,6 +37,7 @@ class USDCurvesReader : public USDGeomReader {
   }
 
   void create_object(Main *bmain, double motionSampleTime) override;
+  void decode_object_data(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
   void read_curve_sample(Curves *curves_id, double motionSampleTime);
@@ -20,17 +20,22 @@ class USDPointsReader : public USDGeomReader {
  private:
   pxr::UsdGeomPoints points_prim_;
 
+  /** Point cloud read by #decode_object_data, when it is not the point cloud of the object. */
+  PointCloud *decoded_point_cloud_ = nullptr;
+
  public:
   USDPointsReader(const pxr::UsdPrim &prim,
                   const USDImportParams &import_params,
                   const ImportSettings &settings);
+  ~USDPointsReader() override;
 
   bool valid() const override;
 
   /* Initial object creation. */
   void create_object(Main *bmain, double motionSampleTime) override;
 
-  /* Initial point cloud data update. */
+  /* Initial point cloud data read, and update of the object. */
+  void decode_object_data(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
   /* Implement point cloud update. This may be called by the cache modifier
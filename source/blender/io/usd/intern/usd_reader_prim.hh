@@ -108,6 +108,13 @@ class USDPrimReader {
   virtual bool valid() const;
 
   virtual void create_object(Main *bmain, double motionSampleTime) = 0;
+  /**
+   * Read the geometry, attributes and primvars of the prim into data that is not in Main yet.
+   * This is called for all readers in parallel after create_object(), so it must not modify
+   * Main or anything shared with other readers. read_object_data() is called afterwards, one
+   * reader at a time, to move the data into the object and to create everything else.
+   */
+  virtual void decode_object_data(double /*motionSampleTime*/){};
   virtual void read_object_data(Main * /*bmain*/, double /*motionSampleTime*/){};
 
   Object *object() const;
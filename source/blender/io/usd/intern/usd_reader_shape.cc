@@ -42,6 +42,13 @@ USDShapeReader::USDShapeReader(const pxr::UsdPrim &prim,
 {
 }
 
+USDShapeReader::~USDShapeReader()
+{
+  if (decoded_mesh_) {
+    BKE_id_free(nullptr, decoded_mesh_);
+  }
+}
+
 void USDShapeReader::create_object(Main *bmain, double /*motionSampleTime*/)
 {
   Mesh *mesh = BKE_mesh_add(bmain, name_.c_str());
@@ -49,7 +56,7 @@ void USDShapeReader::create_object(Main *bmain, double /*motionSampleTime*/)
   object_->data = mesh;
 }
 
-void USDShapeReader::read_object_data(Main *bmain, double motionSampleTime)
+void USDShapeReader::decode_object_data(double motionSampleTime)
 {
   const USDMeshReadParams params = create_mesh_read_params(motionSampleTime,
                                                            import_params_.mesh_read_flag);
@@ -57,7 +64,17 @@ void USDShapeReader::read_object_data(Main *bmain, double motionSampleTime)
   Mesh *read_mesh = this->read_mesh(mesh, params, nullptr);
 
   if (read_mesh != mesh) {
-    BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_);
+    decoded_mesh_ = read_mesh;
+  }
+}
+
+void USDShapeReader::read_object_data(Main *bmain, double motionSampleTime)
+{
+  Mesh *mesh = (Mesh *)object_->data;
+
+  if (decoded_mesh_) {
+    BKE_mesh_nomain_to_mesh(decoded_mesh_, mesh, object_);
+    decoded_mesh_ = nullptr;
     if (is_time_varying()) {
       USDGeomReader::add_cache_modifier();
     }
@@ -49,12 +49,17 @@ class USDShapeReader : public USDGeomReader {
 
   Mesh *read_mesh(Mesh *existing_mesh, USDMeshReadParams params, const char ** /*r_err_str*/);
 
+  /** Mesh read by #decode_object_data, when it is not the mesh of the object. */
+  Mesh *decoded_mesh_ = nullptr;
+
  public:
   USDShapeReader(const pxr::UsdPrim &prim,
                  const USDImportParams &import_params,
                  const ImportSettings &settings);
+  ~USDShapeReader() override;
 
   void create_object(Main *bmain, double /*motionSampleTime*/) override;
+  void decode_object_data(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
   void read_geometry(bke::GeometrySet & /*geometry_set*/,
                      USDMeshReadParams /*params*/,
@@ -174,6 +174,14 @@ pxr::UsdTimeCode USDAbstractWriter::get_export_time_code() const
   return default_timecode;
 }
 
+void USDAbstractWriter::prepare(HierarchyContext &context)
+{
+  if (frame_has_been_written_ && !is_animated_) {
+    return;
+  }
+  do_prepare(context);
+}
+
 void USDAbstractWriter::write(HierarchyContext &context)
 {
   if (!frame_has_been_written_) {
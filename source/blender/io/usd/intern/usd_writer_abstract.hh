@@ -37,6 +37,7 @@ class USDAbstractWriter : public AbstractHierarchyWriter {
  public:
   USDAbstractWriter(const USDExporterContext &usd_export_context);
 
+  virtual void prepare(HierarchyContext &context) override;
   virtual void write(HierarchyContext &context) override;
 
   /**
@@ -59,6 +60,12 @@ class USDAbstractWriter : public AbstractHierarchyWriter {
   }
 
  protected:
+  /**
+   * Called from prepare() for the frames that do_write() will be called for. Writers that convert
+   * large amounts of data can do that here in parallel to other writers, instead of in
+   * do_write(), as long as the stage is not accessed.
+   */
+  virtual void do_prepare(HierarchyContext & /*context*/) {}
   virtual void do_write(HierarchyContext &context) = 0;
   std::string get_export_file_path() const;
   pxr::UsdTimeCode get_export_time_code() const;
@@ -46,10 +46,44 @@ static const pxr::TfToken Anim("Anim", pxr::TfToken::Immortal);
 
 namespace blender::io::usd {
 
+struct USDMeshData {
+  pxr::VtArray<pxr::GfVec3f> points;
+  pxr::VtIntArray face_vertex_counts;
+  pxr::VtIntArray face_indices;
+  Map<short, pxr::VtIntArray> face_groups;
+
+  /* The length of this array specifies the number of creases on the surface. Each element gives
+   * the number of (must be adjacent) vertices in each crease, whose indices are linearly laid out
+   * in the 'creaseIndices' attribute. Since each crease must be at least one edge long, each
+   * element of this array should be greater than one. */
+  pxr::VtIntArray crease_lengths;
+  /* The indices of all vertices forming creased edges. The size of this array must be equal to the
+   * sum of all elements of the 'creaseLengths' attribute. */
+  pxr::VtIntArray crease_vertex_indices;
+  /* The per-crease or per-edge sharpness for all creases (Usd.Mesh.SHARPNESS_INFINITE for a
+   * perfectly sharp crease). Since 'creaseLengths' encodes the number of vertices in each crease,
+   * the number of elements in this array will be either 'len(creaseLengths)' or the sum over all X
+   * of '(creaseLengths[X] - 1)'. Note that while the RI spec allows each crease to have either a
+   * single sharpness or a value per-edge, USD will encode either a single sharpness per crease on
+   * a mesh, or sharpness's for all edges making up the creases on a mesh. */
+  pxr::VtFloatArray crease_sharpnesses;
+
+  /* The lengths of this array specifies the number of sharp corners (or vertex crease) on the
+   * surface. Each value is the index of a vertex in the mesh's vertex list. */
+  pxr::VtIntArray corner_indices;
+  /* The per-vertex sharpnesses. The lengths of this array must match that of `corner_indices`. */
+  pxr::VtFloatArray corner_sharpnesses;
+};
+
 USDGenericMeshWriter::USDGenericMeshWriter(const USDExporterContext &ctx) : USDAbstractWriter(ctx)
 {
 }
 
+USDGenericMeshWriter::~USDGenericMeshWriter()
+{
+  free_prepared_mesh();
+}
+
 bool USDGenericMeshWriter::is_supported(const HierarchyContext *context) const
 {
   if (usd_export_context_.export_params.visible_objects_only) {
@@ -87,8 +121,10 @@ static const SubsurfModifierData *get_last_subdiv_modifier(eEvaluationMode eval_
   return nullptr;
 }
 
-void USDGenericMeshWriter::do_write(HierarchyContext &context)
+void USDGenericMeshWriter::prepare_mesh(HierarchyContext &context)
 {
+  free_prepared_mesh();
+
   Object *object_eval = context.object;
   bool needsfree = false;
   Mesh *mesh = get_export_mesh(object_eval, needsfree);
@@ -120,12 +156,43 @@ void USDGenericMeshWriter::do_write(HierarchyContext &context)
     needsfree = true;
   }
 
+  /* Ensure data exists if currently in edit mode. */
+  BKE_mesh_wrapper_ensure_mdata(mesh);
+
+  prepared_mesh_data_ = std::make_unique<USDMeshData>();
+  get_geometry_data(mesh, *prepared_mesh_data_);
+  prepared_mesh_ = mesh;
+  prepared_mesh_needs_free_ = needsfree;
+}
+
+void USDGenericMeshWriter::free_prepared_mesh()
+{
+  if (prepared_mesh_ && prepared_mesh_needs_free_) {
+    free_export_mesh(prepared_mesh_);
+  }
+  prepared_mesh_ = nullptr;
+  prepared_mesh_needs_free_ = false;
+  prepared_mesh_data_.reset();
+}
+
+void USDGenericMeshWriter::do_write(HierarchyContext &context)
+{
+  if (prepared_mesh_ == nullptr) {
+    prepare_mesh(context);
+  }
+  if (prepared_mesh_ == nullptr) {
+    return;
+  }
+
+  Object *object_eval = context.object;
+  Mesh *mesh = prepared_mesh_;
+
   try {
     /* Fetch the subdiv modifier, if one exists and it is the last modifier. */
     const SubsurfModifierData *subsurfData = get_last_subdiv_modifier(
         usd_export_context_.export_params.evaluation_mode, object_eval);
 
-    write_mesh(context, mesh, subsurfData);
+    write_mesh(context, mesh, *prepared_mesh_data_, subsurfData);
 
     auto prim = usd_export_context_.stage->GetPrimAtPath(usd_export_context_.usd_path);
     if (prim.IsValid() && object_eval) {
@@ -133,14 +200,10 @@ void USDGenericMeshWriter::do_write(HierarchyContext &context)
       write_id_properties(prim, mesh->id, get_export_time_code());
     }
 
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
+    free_prepared_mesh();
   }
   catch (...) {
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
+    free_prepared_mesh();
     throw;
   }
 }
@@ -333,37 +396,9 @@ void USDGenericMeshWriter::free_export_mesh(Mesh *mesh)
   BKE_id_free(nullptr, mesh);
 }
 
-struct USDMeshData {
-  pxr::VtArray<pxr::GfVec3f> points;
-  pxr::VtIntArray face_vertex_counts;
-  pxr::VtIntArray face_indices;
-  Map<short, pxr::VtIntArray> face_groups;
-
-  /* The length of this array specifies the number of creases on the surface. Each element gives
-   * the number of (must be adjacent) vertices in each crease, whose indices are linearly laid out
-   * in the 'creaseIndices' attribute. Since each crease must be at least one edge long, each
-   * element of this array should be greater than one. */
-  pxr::VtIntArray crease_lengths;
-  /* The indices of all vertices forming creased edges. The size of this array must be equal to the
-   * sum of all elements of the 'creaseLengths' attribute. */
-  pxr::VtIntArray crease_vertex_indices;
-  /* The per-crease or per-edge sharpness for all creases (Usd.Mesh.SHARPNESS_INFINITE for a
-   * perfectly sharp crease). Since 'creaseLengths' encodes the number of vertices in each crease,
-   * the number of elements in this array will be either 'len(creaseLengths)' or the sum over all X
-   * of '(creaseLengths[X] - 1)'. Note that while the RI spec allows each crease to have either a
-   * single sharpness or a value per-edge, USD will encode either a single sharpness per crease on
-   * a mesh, or sharpness's for all edges making up the creases on a mesh. */
-  pxr::VtFloatArray crease_sharpnesses;
-
-  /* The lengths of this array specifies the number of sharp corners (or vertex crease) on the
-   * surface. Each value is the index of a vertex in the mesh's vertex list. */
-  pxr::VtIntArray corner_indices;
-  /* The per-vertex sharpnesses. The lengths of this array must match that of `corner_indices`. */
-  pxr::VtFloatArray corner_sharpnesses;
-};
-
 void USDGenericMeshWriter::write_mesh(HierarchyContext &context,
                                       Mesh *mesh,
+                                      const USDMeshData &usd_mesh_data,
                                       const SubsurfModifierData *subsurfData)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
@@ -373,11 +408,6 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context,
   pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Define(stage, usd_path);
   write_visibility(context, timecode, usd_mesh);
 
-  USDMeshData usd_mesh_data;
-  /* Ensure data exists if currently in edit mode. */
-  BKE_mesh_wrapper_ensure_mdata(mesh);
-  get_geometry_data(mesh, usd_mesh_data);
-
   if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
     if (!mark_as_instance(context, usd_mesh.GetPrim())) {
       return;
@@ -886,6 +916,18 @@ void USDMeshWriter::init_blend_shapes(const HierarchyContext &context)
                       usd_export_context_.export_params.allow_unicode);
 }
 
+void USDMeshWriter::do_prepare(HierarchyContext &context)
+{
+  set_skel_export_flags(context);
+
+  if (frame_has_been_written_ && (write_skinned_mesh_ || write_blend_shapes_)) {
+    /* Only the rest mesh is written, see do_write(). */
+    return;
+  }
+
+  prepare_mesh(context);
+}
+
 void USDMeshWriter::do_write(HierarchyContext &context)
 {
   set_skel_export_flags(context);
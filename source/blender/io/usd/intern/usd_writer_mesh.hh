@@ -9,6 +9,8 @@
 
 #include <pxr/usd/usdGeom/mesh.h>
 
+#include <memory>
+
 struct SubsurfModifierData;
 
 namespace blender::bke {
@@ -23,6 +25,7 @@ struct USDMeshData;
 class USDGenericMeshWriter : public USDAbstractWriter {
  public:
   USDGenericMeshWriter(const USDExporterContext &ctx);
+  ~USDGenericMeshWriter() override;
 
  protected:
   virtual bool is_supported(const HierarchyContext *context) const override;
@@ -31,11 +34,26 @@ class USDGenericMeshWriter : public USDAbstractWriter {
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) = 0;
   virtual void free_export_mesh(Mesh *mesh);
 
+  /* Get the export mesh and convert its geometry for do_write(). This can be called from
+   * do_prepare() by subclasses whose get_export_mesh() is safe to call in parallel. Otherwise it
+   * is called by do_write(). */
+  void prepare_mesh(HierarchyContext &context);
+
  private:
   /* Mapping from material slot number to array of face indices with that material. */
   using MaterialFaceGroups = Map<short, pxr::VtIntArray>;
 
-  void write_mesh(HierarchyContext &context, Mesh *mesh, const SubsurfModifierData *subsurfData);
+  /* Export mesh of the current frame and its geometry arrays, created by prepare_mesh() and
+   * consumed by do_write(). */
+  Mesh *prepared_mesh_ = nullptr;
+  bool prepared_mesh_needs_free_ = false;
+  std::unique_ptr<USDMeshData> prepared_mesh_data_;
+
+  void free_prepared_mesh();
+  void write_mesh(HierarchyContext &context,
+                  Mesh *mesh,
+                  const USDMeshData &usd_mesh_data,
+                  const SubsurfModifierData *subsurfData);
   pxr::TfToken get_subdiv_scheme(const SubsurfModifierData *subsurfData);
   void write_subdiv(const pxr::TfToken &subdiv_scheme,
                     const pxr::UsdGeomMesh &usd_mesh,
@@ -70,6 +88,7 @@ class USDMeshWriter : public USDGenericMeshWriter {
   USDMeshWriter(const USDExporterContext &ctx);
 
  protected:
+  virtual void do_prepare(HierarchyContext &context) override;
   virtual void do_write(HierarchyContext &context) override;
 
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) override;
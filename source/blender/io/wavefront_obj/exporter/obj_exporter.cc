@@ -15,6 +15,7 @@
 #include "BKE_report.hh"
 #include "BKE_scene.hh"
 
+#include "BLI_function_ref.hh"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_task.hh"
@@ -97,15 +98,17 @@ static bool is_curve_nurbs_compatible(const Nurb *nurb)
 }
 
 /**
- * Filter supported objects from the Scene.
+ * Call the given functions for the supported objects of the Scene, including instances, in the
+ * order in which they are exported.
  *
- * \note Curves are also stored with Meshes if export settings specify so.
+ * \note Curves are also passed to `mesh_fn` if export settings specify so.
  */
-std::pair<Vector<std::unique_ptr<OBJMesh>>, Vector<std::unique_ptr<OBJCurve>>>
-filter_supported_objects(Depsgraph *depsgraph, const OBJExportParams &export_params)
+static void foreach_supported_object(
+    Depsgraph *depsgraph,
+    const OBJExportParams &export_params,
+    const FunctionRef<void(std::unique_ptr<OBJMesh> obj_mesh)> mesh_fn,
+    const FunctionRef<void(std::unique_ptr<OBJCurve> obj_curve)> nurbs_fn)
 {
-  Vector<std::unique_ptr<OBJMesh>> r_exportable_meshes;
-  Vector<std::unique_ptr<OBJCurve>> r_exportable_nurbs;
   DEGObjectIterSettings deg_iter_settings{};
   deg_iter_settings.depsgraph = depsgraph;
   deg_iter_settings.flags = DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY |
@@ -120,7 +123,7 @@ filter_supported_objects(Depsgraph *depsgraph, const OBJExportParams &export_par
         /* Evaluated surface objects appear as mesh objects from the iterator. */
         break;
       case OB_MESH:
-        r_exportable_meshes.append(std::make_unique<OBJMesh>(depsgraph, export_params, object));
+        mesh_fn(std::make_unique<OBJMesh>(depsgraph, export_params, object));
         break;
       case OB_CURVES_LEGACY: {
         Curve *curve = static_cast<Curve *>(object->data);
@@ -128,18 +131,17 @@ filter_supported_objects(Depsgraph *depsgraph, const OBJExportParams &export_par
         if (!nurb) {
           /* An empty curve. Not yet supported to export these as meshes. */
           if (export_params.export_curves_as_nurbs) {
-            r_exportable_nurbs.append(
-                std::make_unique<OBJCurve>(depsgraph, export_params, object));
+            nurbs_fn(std::make_unique<OBJCurve>(depsgraph, export_params, object));
           }
           break;
         }
         if (export_params.export_curves_as_nurbs && is_curve_nurbs_compatible(nurb)) {
           /* Export in parameter form: control points. */
-          r_exportable_nurbs.append(std::make_unique<OBJCurve>(depsgraph, export_params, object));
+          nurbs_fn(std::make_unique<OBJCurve>(depsgraph, export_params, object));
         }
         else {
           /* Export in mesh form: edges and vertices. */
-          r_exportable_meshes.append(std::make_unique<OBJMesh>(depsgraph, export_params, object));
+          mesh_fn(std::make_unique<OBJMesh>(depsgraph, export_params, object));
         }
         break;
       }
@@ -149,13 +151,32 @@ filter_supported_objects(Depsgraph *depsgraph, const OBJExportParams &export_par
     }
   }
   DEG_OBJECT_ITER_END;
+}
+
+std::pair<Vector<std::unique_ptr<OBJMesh>>, Vector<std::unique_ptr<OBJCurve>>>
+filter_supported_objects(Depsgraph *depsgraph, const OBJExportParams &export_params)
+{
+  Vector<std::unique_ptr<OBJMesh>> r_exportable_meshes;
+  Vector<std::unique_ptr<OBJCurve>> r_exportable_nurbs;
+  foreach_supported_object(
+      depsgraph,
+      export_params,
+      [&](std::unique_ptr<OBJMesh> obj_mesh) { r_exportable_meshes.append(std::move(obj_mesh)); },
+      [&](std::unique_ptr<OBJCurve> obj_curve) {
+        r_exportable_nurbs.append(std::move(obj_curve));
+      });
   return {std::move(r_exportable_meshes), std::move(r_exportable_nurbs)};
 }
 
+/**
+ * Write a chunk of consecutive mesh objects. The vertex, UV and normal indices of the chunk start
+ * at `offsets`, which is advanced past the chunk for the next one.
+ */
 static void write_mesh_objects(const Span<std::unique_ptr<OBJMesh>> exportable_as_mesh,
                                OBJWriter &obj_writer,
                                MTLWriter *mtl_writer,
-                               const OBJExportParams &export_params)
+                               const OBJExportParams &export_params,
+                               IndexOffsets &offsets)
 {
   /* Parallelization is over meshes/objects, which means
    * we have to have the output text buffer for each object,
@@ -166,7 +187,6 @@ static void write_mesh_objects(const Span<std::unique_ptr<OBJMesh>> exportable_a
   /* Serial: gather material indices, ensure normals & edges. */
   Vector<Vector<int>> mtlindices;
   if (mtl_writer) {
-    obj_writer.write_mtllib_name(mtl_writer->mtl_file_path());
     mtlindices.reserve(count);
   }
   for (auto &obj_mesh : exportable_as_mesh) {
@@ -193,7 +213,6 @@ static void write_mesh_objects(const Span<std::unique_ptr<OBJMesh>> exportable_a
    * over all meshes, and requite normal/uv indices to be calculated. */
   Vector<IndexOffsets> index_offsets;
   index_offsets.reserve(count);
-  IndexOffsets offsets{0, 0, 0};
   for (auto &obj_mesh : exportable_as_mesh) {
     OBJMesh &obj = *obj_mesh;
     index_offsets.append(offsets);
@@ -265,7 +284,10 @@ static void write_nurbs_curve_objects(const Span<std::unique_ptr<OBJCurve>> expo
   fh.write_to_file(obj_writer.get_outfile());
 }
 
-void export_frame(Depsgraph *depsgraph, const OBJExportParams &export_params, const char *filepath)
+void export_frame(Depsgraph *depsgraph,
+                  const OBJExportParams &export_params,
+                  const char *filepath,
+                  const OBJExportChunkLimits &chunk_limits)
 {
   std::unique_ptr<OBJWriter> frame_writer = nullptr;
   try {
@@ -295,11 +317,40 @@ void export_frame(Depsgraph *depsgraph, const OBJExportParams &export_params, co
   }
 
   frame_writer->write_header();
+  if (mtl_writer) {
+    frame_writer->write_mtllib_name(mtl_writer->mtl_file_path());
+  }
 
-  auto [exportable_as_mesh, exportable_as_nurbs] = filter_supported_objects(depsgraph,
-                                                                            export_params);
+  /* Meshes are written in chunks while iterating over the objects and instances, so that only the
+   * export meshes and text buffers of one chunk are in memory at a time. The result is the same
+   * as writing all meshes at once. */
+  Vector<std::unique_ptr<OBJMesh>> mesh_chunk;
+  int64_t mesh_chunk_vertices = 0;
+  IndexOffsets offsets{0, 0, 0};
+  auto write_mesh_chunk = [&]() {
+    write_mesh_objects(mesh_chunk, *frame_writer, mtl_writer.get(), export_params, offsets);
+    mesh_chunk.clear();
+    mesh_chunk_vertices = 0;
+  };
+
+  Vector<std::unique_ptr<OBJCurve>> exportable_as_nurbs;
+  foreach_supported_object(
+      depsgraph,
+      export_params,
+      [&](std::unique_ptr<OBJMesh> obj_mesh) {
+        mesh_chunk_vertices += obj_mesh->tot_vertices();
+        mesh_chunk.append(std::move(obj_mesh));
+        if (mesh_chunk.size() >= chunk_limits.max_objects ||
+            mesh_chunk_vertices >= chunk_limits.max_vertices)
+        {
+          write_mesh_chunk();
+        }
+      },
+      [&](std::unique_ptr<OBJCurve> obj_curve) {
+        exportable_as_nurbs.append(std::move(obj_curve));
+      });
+  write_mesh_chunk();
 
-  write_mesh_objects(exportable_as_mesh, *frame_writer, mtl_writer.get(), export_params);
   if (mtl_writer) {
     mtl_writer->write_header(export_params.blen_filepath);
     char dest_dir[FILE_MAX];
@@ -50,6 +50,16 @@ void exporter_main(bContext *C, const OBJExportParams &export_params);
 class OBJMesh;
 class OBJCurve;
 
+/**
+ * Maximum number of objects, and of vertices over all of their meshes, that are gathered before
+ * writing them to the file. Larger chunks give the parallel formatting more work to balance,
+ * smaller chunks use less memory for scenes with many or large instanced meshes.
+ */
+struct OBJExportChunkLimits {
+  int64_t max_objects = 1024;
+  int64_t max_vertices = 8 * 1024 * 1024;
+};
+
 /**
  * Export a single frame of a `.obj` file, according to the given `export_parameters`.
  * The frame state is given in `depsgraph`.
@@ -59,11 +69,13 @@ class OBJCurve;
 /**
  * Export a single frame to a `.OBJ` file.
  *
- * Conditionally write a `.MTL` file also.
+ * Conditionally write a `.MTL` file also. Meshes are written in chunks bounded by
+ * `chunk_limits`, which doesn't change the output.
  */
 void export_frame(Depsgraph *depsgraph,
                   const OBJExportParams &export_params,
-                  const char *filepath);
+                  const char *filepath,
+                  const OBJExportChunkLimits &chunk_limits = {});
 
 /**
  * Find the objects to be exported in the `view_layer` of the dependency graph`depsgraph`,
@@ -8,12 +8,19 @@
 
 #include "BKE_report.hh"
 
+#include "BLI_array.hh"
 #include "BLI_fileops.hh"
+#include "BLI_index_range.hh"
+#include "BLI_linear_allocator.hh"
 #include "BLI_map.hh"
+#include "BLI_math_base.hh"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector_types.hh"
+#include "BLI_mmap.h"
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
+#include "BLI_threads.h"
 #include "BLI_vector.hh"
 
 #include "obj_export_mtl.hh"
@@ -202,9 +209,56 @@ static void geom_add_polyline(Geometry *geom,
   }
 }
 
+/**
+ * A face corner as written in the OBJ file. Its indices are not yet transformed to be
+ * non-negative and zero-based, since that requires the number of elements read before it.
+ */
+struct RawFaceCorner {
+  int vert_index;
+  int uv_vert_index = -1;
+  int vertex_normal_index = -1;
+  bool got_uv = false;
+  bool got_normal = false;
+};
+
+static void parse_face_corners(const char *p, const char *end, Vector<RawFaceCorner> &r_corners)
+{
+  p = drop_whitespace(p, end);
+  while (p < end) {
+    RawFaceCorner corner;
+    /* Parse vertex index. */
+    p = parse_int(p, end, INT32_MAX, corner.vert_index, false);
+
+    /* Skip parsing when we reach start of the comment. */
+    if (p < end && *p == '#') {
+      break;
+    }
+
+    if (p < end && *p == '/') {
+      /* Parse UV index. */
+      ++p;
+      if (p < end && *p != '/') {
+        p = parse_int(p, end, INT32_MAX, corner.uv_vert_index, false);
+        corner.got_uv = corner.uv_vert_index != INT32_MAX;
+      }
+      /* Parse normal index. */
+      if (p < end && *p == '/') {
+        ++p;
+        p = parse_int(p, end, INT32_MAX, corner.vertex_normal_index, false);
+        corner.got_normal = corner.vertex_normal_index != INT32_MAX;
+      }
+    }
+    r_corners.append(corner);
+
+    /* Some files contain extra stuff per face (e.g. 4 indices); skip any remainder (#103441). */
+    p = drop_non_whitespace(p, end);
+    /* Skip whitespace to get to the next face corner. */
+    p = drop_whitespace(p, end);
+  }
+}
+
 static void geom_add_polygon(Geometry *geom,
-                             const char *p,
-                             const char *end,
+                             const Span<RawFaceCorner> raw_corners,
                              const GlobalVertices &global_vertices,
                              const int material_index,
                              const int group_index,
@@ -222,33 +276,16 @@ static void geom_add_polygon(Geometry *geom,
   curr_face.start_index_ = orig_corners_size;
 
   bool face_valid = true;
-  p = drop_whitespace(p, end);
-  while (p < end && face_valid) {
-    FaceCorner corner;
-    bool got_uv = false, got_normal = false;
-    /* Parse vertex index. */
-    p = parse_int(p, end, INT32_MAX, corner.vert_index, false);
-
-    /* Skip parsing when we reach start of the comment. */
-    if (*p == '#') {
+  for (const RawFaceCorner &raw_corner : raw_corners) {
+    if (!face_valid) {
       break;
     }
+    FaceCorner corner;
+    corner.vert_index = raw_corner.vert_index;
+    corner.uv_vert_index = raw_corner.uv_vert_index;
+    corner.vertex_normal_index = raw_corner.vertex_normal_index;
 
     face_valid &= corner.vert_index != INT32_MAX;
-    if (p < end && *p == '/') {
-      /* Parse UV index. */
-      ++p;
-      if (p < end && *p != '/') {
-        p = parse_int(p, end, INT32_MAX, corner.uv_vert_index, false);
-        got_uv = corner.uv_vert_index != INT32_MAX;
-      }
-      /* Parse normal index. */
-      if (p < end && *p == '/') {
-        ++p;
-        p = parse_int(p, end, INT32_MAX, corner.vertex_normal_index, false);
-        got_normal = corner.vertex_normal_index != INT32_MAX;
-      }
-    }
     /* Always keep stored indices non-negative and zero-based. */
     corner.vert_index += corner.vert_index < 0 ? global_vertices.vertices.size() : -1;
     if (corner.vert_index < 0 || corner.vert_index >= global_vertices.vertices.size()) {
@@ -262,7 +299,7 @@ static void geom_add_polygon(Geometry *geom,
       geom->track_vertex_index(corner.vert_index);
     }
     /* Ignore UV index, if the geometry does not have any UVs (#103212). */
-    if (got_uv && !global_vertices.uv_vertices.is_empty()) {
+    if (raw_corner.got_uv && !global_vertices.uv_vertices.is_empty()) {
       corner.uv_vert_index += corner.uv_vert_index < 0 ? global_vertices.uv_vertices.size() : -1;
       if (corner.uv_vert_index < 0 || corner.uv_vert_index >= global_vertices.uv_vertices.size()) {
         fprintf(stderr,
@@ -275,7 +312,7 @@ static void geom_add_polygon(Geometry *geom,
     /* Ignore corner normal index, if the geometry does not have any normals.
      * Some obj files out there do have face definitions that refer to normal indices,
      * without any normals being present (#98782). */
-    if (got_normal && !global_vertices.vert_normals.is_empty()) {
+    if (raw_corner.got_normal && !global_vertices.vert_normals.is_empty()) {
       corner.vertex_normal_index += corner.vertex_normal_index < 0 ?
                                         global_vertices.vert_normals.size() :
                                         -1;
@@ -291,11 +328,6 @@ static void geom_add_polygon(Geometry *geom,
     }
     geom->face_corners_.append(corner);
     curr_face.corner_count_++;
-
-    /* Some files contain extra stuff per face (e.g. 4 indices); skip any remainder (#103441). */
-    p = drop_non_whitespace(p, end);
-    /* Skip whitespace to get to the next face corner. */
-    p = drop_whitespace(p, end);
   }
 
   if (face_valid) {
@@ -477,28 +509,155 @@ static void use_all_vertices_if_no_faces(Geometry *geom,
   }
 }
 
-void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
-                      GlobalVertices &r_global_vertices)
+/**
+ * State of the parser that carries over from one line to the next. Once set, the state variables
+ * remain the same for the remaining elements in the object.
+ */
+struct OBJParseState {
+  Geometry *curr_geom = nullptr;
+  bool shaded_smooth = false;
+  string group_name;
+  int group_index = -1;
+  string material_name;
+  int material_index = -1;
+
+  /* Reused storage for the corners of the face being parsed. */
+  Vector<RawFaceCorner> face_corners;
+};
+
+static void geom_add_face(OBJParseState &state,
+                          const Span<RawFaceCorner> corners,
+                          const GlobalVertices &global_vertices)
 {
-  if (!obj_file_) {
-    return;
+  /* If we don't have a material index assigned yet, get one.
+   * It means "usemtl" state came from the previous object. */
+  if (state.material_index == -1 && !state.material_name.empty() &&
+      state.curr_geom->material_indices_.is_empty())
+  {
+    state.curr_geom->material_indices_.add_new(state.material_name, 0);
+    state.curr_geom->material_order_.append(state.material_name);
+    state.material_index = 0;
   }
 
-  /* Use the filename as the default name given to the initial object. */
-  char ob_name[FILE_MAXFILE];
-  STRNCPY(ob_name, BLI_path_basename(import_params_.filepath));
-  BLI_path_extension_strip(ob_name);
-
-  Geometry *curr_geom = create_geometry(nullptr, GEOM_MESH, ob_name, r_all_geometries);
+  geom_add_polygon(state.curr_geom,
+                   corners,
+                   global_vertices,
+                   state.material_index,
+                   state.group_index,
+                   state.shaded_smooth);
+}
 
-  /* State variables: once set, they remain the same for the remaining
-   * elements in the object. */
-  bool state_shaded_smooth = false;
-  string state_group_name;
-  int state_group_index = -1;
-  string state_material_name;
-  int state_material_index = -1;
+void OBJParser::parse_line(const char *p,
+                           const char *end,
+                           OBJParseState &state,
+                           Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                           GlobalVertices &r_global_vertices)
+{
+  /* Most common things that start with 'v': vertices, normals, UVs. */
+  if (*p == 'v') {
+    if (parse_keyword(p, end, "v")) {
+      geom_add_vertex(p, end, r_global_vertices);
+    }
+    else if (parse_keyword(p, end, "vn")) {
+      geom_add_vertex_normal(p, end, r_global_vertices);
+    }
+    else if (parse_keyword(p, end, "vt")) {
+      geom_add_uv_vertex(p, end, r_global_vertices);
+    }
+  }
+  /* Faces. */
+  else if (parse_keyword(p, end, "f")) {
+    state.face_corners.clear();
+    parse_face_corners(p, end, state.face_corners);
+    geom_add_face(state, state.face_corners, r_global_vertices);
+  }
+  /* Faces. */
+  else if (parse_keyword(p, end, "l")) {
+    geom_add_polyline(state.curr_geom, p, end, r_global_vertices);
+  }
+  /* Objects. */
+  else if (parse_keyword(p, end, "o")) {
+    if (import_params_.use_split_objects) {
+      geom_new_object(p,
+                      end,
+                      state.shaded_smooth,
+                      state.group_name,
+                      state.material_index,
+                      state.curr_geom,
+                      r_all_geometries);
+    }
+  }
+  /* Groups. */
+  else if (parse_keyword(p, end, "g")) {
+    if (import_params_.use_split_groups) {
+      geom_new_object(p,
+                      end,
+                      state.shaded_smooth,
+                      state.group_name,
+                      state.material_index,
+                      state.curr_geom,
+                      r_all_geometries);
+    }
+    else {
+      geom_update_group(StringRef(p, end).trim(), state.group_name);
+      int new_index = state.curr_geom->group_indices_.size();
+      state.group_index = state.curr_geom->group_indices_.lookup_or_add(state.group_name,
+                                                                        new_index);
+      if (new_index == state.group_index) {
+        state.curr_geom->group_order_.append(state.group_name);
+      }
+    }
+  }
+  /* Smoothing groups. */
+  else if (parse_keyword(p, end, "s")) {
+    geom_update_smooth_group(p, end, state.shaded_smooth);
+  }
+  /* Materials and their libraries. */
+  else if (parse_keyword(p, end, "usemtl")) {
+    state.material_name = StringRef(p, end).trim();
+    int new_mat_index = state.curr_geom->material_indices_.size();
+    state.material_index = state.curr_geom->material_indices_.lookup_or_add(state.material_name,
+                                                                            new_mat_index);
+    if (new_mat_index == state.material_index) {
+      state.curr_geom->material_order_.append(state.material_name);
+    }
+  }
+  else if (parse_keyword(p, end, "mtllib")) {
+    add_mtl_library(StringRef(p, end).trim());
+  }
+  else if (parse_keyword(p, end, "#MRGB")) {
+    geom_add_mrgb_colors(p, end, r_global_vertices);
+  }
+  /* Comments. */
+  else if (*p == '#') {
+    /* Nothing to do. */
+  }
+  /* Curve related things. */
+  else if (parse_keyword(p, end, "cstype")) {
+    state.curr_geom = geom_set_curve_type(
+        state.curr_geom, p, end, state.group_name, r_all_geometries);
+  }
+  else if (parse_keyword(p, end, "deg")) {
+    geom_set_curve_degree(state.curr_geom, p, end);
+  }
+  else if (parse_keyword(p, end, "curv")) {
+    geom_add_curve_vertex_indices(state.curr_geom, p, end, r_global_vertices);
+  }
+  else if (parse_keyword(p, end, "parm")) {
+    geom_add_curve_parameters(state.curr_geom, p, end);
+  }
+  else if (StringRef(p, end).startswith("end")) {
+    /* End of curve definition, nothing else to do. */
+  }
+  else {
+    std::cout << "OBJ element not recognized: '" << std::string(p, end) << "'" << std::endl;
+  }
+}
 
+void OBJParser::parse_buffered(OBJParseState &state,
+                               Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                               GlobalVertices &r_global_vertices)
+{
   /* Read the input file in chunks. We need up to twice the possible chunk size,
    * to possibly store remainder of the previous input line that got broken mid-chunk. */
   Array<char> buffer(read_buffer_size_ * 2);
@@ -559,128 +718,272 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
       if (p == end) {
         continue;
       }
-      /* Most common things that start with 'v': vertices, normals, UVs. */
-      if (*p == 'v') {
-        if (parse_keyword(p, end, "v")) {
-          geom_add_vertex(p, end, r_global_vertices);
-        }
-        else if (parse_keyword(p, end, "vn")) {
-          geom_add_vertex_normal(p, end, r_global_vertices);
-        }
-        else if (parse_keyword(p, end, "vt")) {
-          geom_add_uv_vertex(p, end, r_global_vertices);
-        }
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "f")) {
-        /* If we don't have a material index assigned yet, get one.
-         * It means "usemtl" state came from the previous object. */
-        if (state_material_index == -1 && !state_material_name.empty() &&
-            curr_geom->material_indices_.is_empty())
-        {
-          curr_geom->material_indices_.add_new(state_material_name, 0);
-          curr_geom->material_order_.append(state_material_name);
-          state_material_index = 0;
-        }
+      parse_line(p, end, state, r_all_geometries, r_global_vertices);
+    }
 
-        geom_add_polygon(curr_geom,
-                         p,
-                         end,
-                         r_global_vertices,
-                         state_material_index,
-                         state_group_index,
-                         state_shaded_smooth);
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "l")) {
-        geom_add_polyline(curr_geom, p, end, r_global_vertices);
-      }
-      /* Objects. */
-      else if (parse_keyword(p, end, "o")) {
-        if (import_params_.use_split_objects) {
-          geom_new_object(p,
-                          end,
-                          state_shaded_smooth,
-                          state_group_name,
-                          state_material_index,
-                          curr_geom,
-                          r_all_geometries);
-        }
-      }
-      /* Groups. */
-      else if (parse_keyword(p, end, "g")) {
-        if (import_params_.use_split_groups) {
-          geom_new_object(p,
-                          end,
-                          state_shaded_smooth,
-                          state_group_name,
-                          state_material_index,
-                          curr_geom,
-                          r_all_geometries);
-        }
-        else {
-          geom_update_group(StringRef(p, end).trim(), state_group_name);
-          int new_index = curr_geom->group_indices_.size();
-          state_group_index = curr_geom->group_indices_.lookup_or_add(state_group_name, new_index);
-          if (new_index == state_group_index) {
-            curr_geom->group_order_.append(state_group_name);
+    /* We might have a line that was cut in the middle by the previous buffer;
+     * copy it over for next chunk reading. */
+    size_t left_size = buffer_end - last_nl;
+    memmove(buffer.data(), buffer.data() + last_nl, left_size);
+    buffer_offset = left_size;
+  }
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Parallel Parsing
+ *
+ * Large files are memory mapped and split into chunks at line boundaries, which are parsed in
+ * parallel. Vertex data and face corners make up nearly all of a typical file, so those are
+ * parsed into storage local to each chunk. All other lines change the state of the parser or
+ * depend on it, so they are only recorded, and replayed in file order along with the faces once
+ * all chunks are parsed. Before each replayed line, the vertex data of the chunk that precedes it
+ * is appended to the global vertices, so relative indices and bounds checks see the same number
+ * of elements as they would when parsing the file sequentially.
+ * \{ */
+
+/* A line of a chunk that is replayed after parsing, see #OBJChunk. */
+struct OBJChunkLine {
+  /* The line itself, with leading white-space dropped. Faces are not parsed again, so this is
+   * empty for them and their corners are referred to by the range instead. */
+  StringRef line;
+  IndexRange face_corners;
+  /* The number of vertex elements of the chunk that come before the line. */
+  int vertices_num;
+  int uv_vertices_num;
+  int vert_normals_num;
+};
+
+/* The result of parsing a chunk of the file, see #OBJParser::parse_mapped. */
+struct OBJChunk {
+  StringRef text;
+
+  Vector<float3> vertices;
+  /* Colors of the vertices that have them, indexed by their index in the chunk. */
+  Vector<std::pair<int, float3>> vertex_colors;
+  Vector<float2> uv_vertices;
+  Vector<float3> vert_normals;
+  Vector<RawFaceCorner> face_corners;
+  Vector<OBJChunkLine> lines;
+
+  /* Storage for lines that were joined from line continuations. */
+  LinearAllocator<> allocator;
+};
+
+/* Returns the position right after the first newline at or after the given position that doesn't
+ * end a line continuation, or the end of the text. */
+static int64_t find_chunk_end(const StringRef text, int64_t position)
+{
+  while (position < text.size()) {
+    const int64_t newline = text.find('\n', position);
+    if (newline == StringRef::not_found) {
+      return text.size();
+    }
+    const int64_t line_start = newline == 0 ? 0 : text.rfind('\n', newline - 1) + 1;
+    position = newline + 1;
+    if (!has_line_continuation(text.substr(line_start, newline - line_start))) {
+      break;
+    }
+  }
+  return math::min(position, text.size());
+}
+
+static void parse_chunk(OBJChunk &chunk)
+{
+  std::string joined_line;
+  StringRef buffer_str = chunk.text;
+  while (!buffer_str.is_empty()) {
+    StringRef line = read_next_line_with_continuations(buffer_str, joined_line);
+    const char *p = line.begin(), *end = line.end();
+    p = drop_whitespace(p, end);
+    if (p == end) {
+      continue;
+    }
+
+    if (*p == 'v') {
+      if (parse_keyword(p, end, "v")) {
+        float3 vert;
+        p = parse_floats(p, end, 0.0f, vert, 3);
+        chunk.vertices.append(vert);
+        /* OBJ extension: `xyzrgb` vertex colors, see #geom_add_vertex. */
+        if (p < end) {
+          float3 srgb;
+          p = parse_floats(p, end, -1.0f, srgb, 3);
+          if (srgb.x >= 0 && srgb.y >= 0 && srgb.z >= 0) {
+            float3 linear;
+            srgb_to_linearrgb_v3_v3(linear, srgb);
+            chunk.vertex_colors.append({int(chunk.vertices.size() - 1), linear});
           }
         }
       }
-      /* Smoothing groups. */
-      else if (parse_keyword(p, end, "s")) {
-        geom_update_smooth_group(p, end, state_shaded_smooth);
-      }
-      /* Materials and their libraries. */
-      else if (parse_keyword(p, end, "usemtl")) {
-        state_material_name = StringRef(p, end).trim();
-        int new_mat_index = curr_geom->material_indices_.size();
-        state_material_index = curr_geom->material_indices_.lookup_or_add(state_material_name,
-                                                                          new_mat_index);
-        if (new_mat_index == state_material_index) {
-          curr_geom->material_order_.append(state_material_name);
-        }
-      }
-      else if (parse_keyword(p, end, "mtllib")) {
-        add_mtl_library(StringRef(p, end).trim());
+      else if (parse_keyword(p, end, "vn")) {
+        float3 normal;
+        parse_floats(p, end, 0.0f, normal, 3);
+        normalize_v3(normal);
+        chunk.vert_normals.append(normal);
       }
-      else if (parse_keyword(p, end, "#MRGB")) {
-        geom_add_mrgb_colors(p, end, r_global_vertices);
+      else if (parse_keyword(p, end, "vt")) {
+        float2 uv;
+        parse_floats(p, end, 0.0f, uv, 2);
+        chunk.uv_vertices.append(uv);
       }
+      continue;
+    }
+
+    OBJChunkLine chunk_line;
+    chunk_line.vertices_num = chunk.vertices.size();
+    chunk_line.uv_vertices_num = chunk.uv_vertices.size();
+    chunk_line.vert_normals_num = chunk.vert_normals.size();
+
+    const char *line_start = p;
+    if (parse_keyword(p, end, "f")) {
+      const int64_t corners_start = chunk.face_corners.size();
+      parse_face_corners(p, end, chunk.face_corners);
+      chunk_line.face_corners = IndexRange(corners_start,
+                                           chunk.face_corners.size() - corners_start);
+    }
+    else if (*p == '#' && !parse_keyword(p, end, "#MRGB")) {
       /* Comments. */
-      else if (*p == '#') {
-        /* Nothing to do. */
-      }
-      /* Curve related things. */
-      else if (parse_keyword(p, end, "cstype")) {
-        curr_geom = geom_set_curve_type(curr_geom, p, end, state_group_name, r_all_geometries);
-      }
-      else if (parse_keyword(p, end, "deg")) {
-        geom_set_curve_degree(curr_geom, p, end);
-      }
-      else if (parse_keyword(p, end, "curv")) {
-        geom_add_curve_vertex_indices(curr_geom, p, end, r_global_vertices);
-      }
-      else if (parse_keyword(p, end, "parm")) {
-        geom_add_curve_parameters(curr_geom, p, end);
-      }
-      else if (StringRef(p, end).startswith("end")) {
-        /* End of curve definition, nothing else to do. */
+      continue;
+    }
+    else if (line.data() == joined_line.data()) {
+      chunk_line.line = chunk.allocator.copy_string(StringRef(line_start, end));
+    }
+    else {
+      chunk_line.line = StringRef(line_start, end);
+    }
+    chunk.lines.append(chunk_line);
+  }
+}
+
+/* Append the vertex data of the chunk that comes before the given line to the global vertices,
+ * given the number of elements of each kind that were already appended. */
+static void append_chunk_vertices(const OBJChunk &chunk,
+                                  const OBJChunkLine &line,
+                                  int3 &r_appended_num,
+                                  int &r_appended_colors_num,
+                                  GlobalVertices &r_global_vertices)
+{
+  if (line.vertices_num > r_appended_num.x) {
+    /* Vertices complete a pending #MRGB block, see #geom_add_vertex. */
+    r_global_vertices.flush_mrgb_block();
+    const int64_t chunk_start = r_global_vertices.vertices.size() - r_appended_num.x;
+    r_global_vertices.vertices.extend(chunk.vertices.as_span().slice(
+        r_appended_num.x, line.vertices_num - r_appended_num.x));
+    r_appended_num.x = line.vertices_num;
+
+    while (r_appended_colors_num < chunk.vertex_colors.size() &&
+           chunk.vertex_colors[r_appended_colors_num].first < line.vertices_num)
+    {
+      const std::pair<int, float3> &color = chunk.vertex_colors[r_appended_colors_num];
+      r_global_vertices.set_vertex_color(chunk_start + color.first, color.second);
+      r_appended_colors_num++;
+    }
+  }
+  if (line.uv_vertices_num > r_appended_num.y) {
+    r_global_vertices.uv_vertices.extend(chunk.uv_vertices.as_span().slice(
+        r_appended_num.y, line.uv_vertices_num - r_appended_num.y));
+    r_appended_num.y = line.uv_vertices_num;
+  }
+  if (line.vert_normals_num > r_appended_num.z) {
+    r_global_vertices.vert_normals.extend(chunk.vert_normals.as_span().slice(
+        r_appended_num.z, line.vert_normals_num - r_appended_num.z));
+    r_appended_num.z = line.vert_normals_num;
+  }
+}
+
+bool OBJParser::parse_mapped(OBJParseState &state,
+                             Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                             GlobalVertices &r_global_vertices)
+{
+  BLI_mmap_file *mmap_file = BLI_mmap_open(fileno(obj_file_));
+  if (mmap_file == nullptr) {
+    /* Mapping seeks to the end of the file, so rewind it for the buffered parsing. */
+    fseek(obj_file_, 0, SEEK_SET);
+    return false;
+  }
+  const StringRef text(static_cast<const char *>(BLI_mmap_get_pointer(mmap_file)),
+                       int64_t(BLI_mmap_get_length(mmap_file)));
+
+  /* Use a few chunks per thread for load balancing, but not smaller than the read buffer. */
+  const int64_t chunk_size = math::max(int64_t(read_buffer_size_),
+                                       text.size() / (BLI_system_thread_count() * 4));
+  Vector<IndexRange> chunk_ranges;
+  for (int64_t start = 0; start < text.size();) {
+    const int64_t chunk_end = find_chunk_end(text, math::min(start + chunk_size, text.size()));
+    chunk_ranges.append(IndexRange(start, chunk_end - start));
+    start = chunk_end;
+  }
+
+  Array<OBJChunk> chunks(chunk_ranges.size());
+  threading::parallel_for(chunks.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      chunks[i].text = text.substr(chunk_ranges[i].start(), chunk_ranges[i].size());
+      parse_chunk(chunks[i]);
+    }
+  });
+
+  for (OBJChunk &chunk : chunks) {
+    int3 appended_num(0);
+    int appended_colors_num = 0;
+    for (const OBJChunkLine &line : chunk.lines) {
+      append_chunk_vertices(chunk, line, appended_num, appended_colors_num, r_global_vertices);
+      if (line.line.is_empty()) {
+        geom_add_face(
+            state, chunk.face_corners.as_span().slice(line.face_corners), r_global_vertices);
       }
       else {
-        std::cout << "OBJ element not recognized: '" << std::string(p, end) << "'" << std::endl;
+        parse_line(
+            line.line.begin(), line.line.end(), state, r_all_geometries, r_global_vertices);
       }
     }
 
-    /* We might have a line that was cut in the middle by the previous buffer;
-     * copy it over for next chunk reading. */
-    size_t left_size = buffer_end - last_nl;
-    memmove(buffer.data(), buffer.data() + last_nl, left_size);
-    buffer_offset = left_size;
+    OBJChunkLine chunk_end_line;
+    chunk_end_line.vertices_num = chunk.vertices.size();
+    chunk_end_line.uv_vertices_num = chunk.uv_vertices.size();
+    chunk_end_line.vert_normals_num = chunk.vert_normals.size();
+    append_chunk_vertices(
+        chunk, chunk_end_line, appended_num, appended_colors_num, r_global_vertices);
+
+    /* Free the chunk data as soon as it is merged to reduce peak memory usage. */
+    chunk.vertices.clear_and_shrink();
+    chunk.vertex_colors.clear_and_shrink();
+    chunk.uv_vertices.clear_and_shrink();
+    chunk.vert_normals.clear_and_shrink();
+    chunk.face_corners.clear_and_shrink();
+  }
+
+  /* The mapping has to outlive the replayed lines, which refer to it. */
+  BLI_mmap_free(mmap_file);
+  return true;
+}
+
+/** \} */
+
+void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                      GlobalVertices &r_global_vertices)
+{
+  if (!obj_file_) {
+    return;
+  }
+
+  /* Use the filename as the default name given to the initial object. */
+  char ob_name[FILE_MAXFILE];
+  STRNCPY(ob_name, BLI_path_basename(import_params_.filepath));
+  BLI_path_extension_strip(ob_name);
+
+  OBJParseState state;
+  state.curr_geom = create_geometry(nullptr, GEOM_MESH, ob_name, r_all_geometries);
+
+  /* Files that don't fit in the read buffer are parsed in parallel when they can be mapped to
+   * memory, which fails for example for pipes. */
+  if (BLI_file_size(import_params_.filepath) <= read_buffer_size_ ||
+      !parse_mapped(state, r_all_geometries, r_global_vertices))
+  {
+    parse_buffered(state, r_all_geometries, r_global_vertices);
   }
 
   r_global_vertices.flush_mrgb_block();
-  use_all_vertices_if_no_faces(curr_geom, r_all_geometries, r_global_vertices);
+  use_all_vertices_if_no_faces(state.curr_geom, r_all_geometries, r_global_vertices);
   add_default_mtl_library();
 }
 
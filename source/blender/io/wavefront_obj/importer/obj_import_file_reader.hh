@@ -18,6 +18,7 @@
 namespace blender::io::obj {
 
 struct MTLMaterial;
+struct OBJParseState;
 
 /* NOTE: the OBJ parser implementation is planned to get fairly large changes "soon",
  * so don't read too much into current implementation... */
@@ -38,6 +39,8 @@ class OBJParser {
   /**
    * Read the OBJ file line by line and create OBJ Geometry instances. Also store all the vertex
    * and UV vertex coordinates in a struct accessible by all objects.
+   *
+   * Files larger than the read buffer size are parsed in parallel if possible, see #parse_mapped.
    */
   void parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
              GlobalVertices &r_global_vertices);
@@ -47,6 +50,27 @@ class OBJParser {
   Span<std::string> mtl_libraries() const;
 
  private:
+  /**
+   * Read the file in chunks of the read buffer size and parse them line by line.
+   */
+  void parse_buffered(OBJParseState &state,
+                      Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                      GlobalVertices &r_global_vertices);
+  /**
+   * Map the file to memory and parse chunks of it in parallel. Returns false if the file could not
+   * be mapped, in which case nothing was parsed.
+   */
+  bool parse_mapped(OBJParseState &state,
+                    Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                    GlobalVertices &r_global_vertices);
+  /**
+   * Parse a single line whose leading white-space is dropped, updating the parser state.
+   */
+  void parse_line(const char *p,
+                  const char *end,
+                  OBJParseState &state,
+                  Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                  GlobalVertices &r_global_vertices);
   void add_mtl_library(StringRef path);
   void add_default_mtl_library();
 };
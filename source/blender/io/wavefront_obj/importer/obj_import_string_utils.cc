@@ -60,6 +60,52 @@ void fixup_line_continuations(char *p, char *end)
   }
 }
 
+/* Returns the position of the backslash of the line continuation at the end of the line,
+ * or -1 if there is none. */
+static int64_t find_line_continuation(StringRef line)
+{
+  int64_t pos = line.size();
+  while (pos > 0 && is_whitespace(line[pos - 1])) {
+    --pos;
+  }
+  if (pos > 0 && line[pos - 1] == '\\') {
+    return pos - 1;
+  }
+  return -1;
+}
+
+bool has_line_continuation(StringRef line)
+{
+  return find_line_continuation(line) != -1;
+}
+
+StringRef read_next_line_with_continuations(StringRef &buffer, std::string &r_joined_line)
+{
+  StringRef line = read_next_line(buffer);
+  /* Only a backslash followed by a newline is a line continuation, so when the buffer ends without
+   * a newline, the remaining backslash is left intact. */
+  auto has_newline = [&]() { return buffer.begin() != line.end(); };
+  int64_t backslash = find_line_continuation(line);
+  if (backslash == -1 || !has_newline()) {
+    return line;
+  }
+
+  /* Replace the backslash and the newline with spaces, like #fixup_line_continuations. */
+  r_joined_line.clear();
+  while (true) {
+    const int64_t offset = r_joined_line.size();
+    r_joined_line += line;
+    if (backslash == -1 || !has_newline()) {
+      break;
+    }
+    r_joined_line[offset + backslash] = ' ';
+    r_joined_line += ' ';
+    line = read_next_line(buffer);
+    backslash = find_line_continuation(line);
+  }
+  return r_joined_line;
+}
+
 const char *drop_whitespace(const char *p, const char *end)
 {
   while (p < end && is_whitespace(*p)) {
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "BLI_string_ref.hh"
 
 /*
@@ -35,6 +37,22 @@ StringRef read_next_line(StringRef &buffer);
  */
 void fixup_line_continuations(char *p, char *end);
 
+/**
+ * Returns true if the line (without its '\n' character) ends with an OBJ line
+ * continuation, that is, a backslash (\) followed only by white-space.
+ */
+bool has_line_continuation(StringRef line);
+
+/**
+ * Fetches next line from an input string buffer like #read_next_line,
+ * but also joins the lines that follow OBJ line continuations, the same
+ * way #fixup_line_continuations does for buffers that can be modified.
+ *
+ * Joined lines are stored in `r_joined_line`, which the returned line then
+ * refers to, so it has to outlive the use of the returned line.
+ */
+StringRef read_next_line_with_continuations(StringRef &buffer, std::string &r_joined_line);
+
 /**
  * Drop leading white-space from a string part.
  */
@@ -277,11 +277,13 @@ class OBJExportRegressionTest : public OBJExportTest {
    * \param blendfile: input, relative to "tests" directory.
    * \param golden_obj: expected output, relative to "tests" directory.
    * \param params: the parameters to be used for export.
+   * \param chunk_limits: how many meshes are written at once, which doesn't change the output.
    */
   void compare_obj_export_to_golden(const std::string &blendfile,
                                     const std::string &golden_obj,
                                     const std::string &golden_mtl,
-                                    OBJExportParams &params)
+                                    OBJExportParams &params,
+                                    const OBJExportChunkLimits &chunk_limits = {})
   {
     if (!load_file_and_depsgraph(blendfile)) {
       return;
@@ -295,7 +297,7 @@ class OBJExportRegressionTest : public OBJExportTest {
     std::string golden_file_path = blender::tests::flags_test_asset_dir() + SEP_STR + golden_obj;
     BLI_path_split_dir_part(
         golden_file_path.c_str(), params.file_base_for_tests, sizeof(params.file_base_for_tests));
-    export_frame(depsgraph, params, out_file_path.c_str());
+    export_frame(depsgraph, params, out_file_path.c_str(), chunk_limits);
     std::string output_str = read_temp_file_in_string(out_file_path);
 
     std::string golden_str = read_temp_file_in_string(golden_file_path);
@@ -580,6 +582,40 @@ TEST_F(OBJExportRegressionTest, all_objects)
                                _export.params);
 }
 
+TEST_F(OBJExportRegressionTest, all_objects_chunk_per_object)
+{
+  OBJExportParamsDefault _export;
+  _export.params.forward_axis = IO_AXIS_Y;
+  _export.params.up_axis = IO_AXIS_Z;
+  _export.params.export_smooth_groups = true;
+  _export.params.export_colors = true;
+  /* Index offsets have to carry over between chunks for the output to match. */
+  OBJExportChunkLimits chunk_limits;
+  chunk_limits.max_objects = 1;
+  compare_obj_export_to_golden("io_tests" SEP_STR "blend_scene" SEP_STR "all_objects.blend",
+                               "io_tests" SEP_STR "obj" SEP_STR "all_objects.obj",
+                               "io_tests" SEP_STR "obj" SEP_STR "all_objects.mtl",
+                               _export.params,
+                               chunk_limits);
+}
+
+TEST_F(OBJExportRegressionTest, all_objects_chunk_vertices)
+{
+  OBJExportParamsDefault _export;
+  _export.params.forward_axis = IO_AXIS_Y;
+  _export.params.up_axis = IO_AXIS_Z;
+  _export.params.export_smooth_groups = true;
+  _export.params.export_colors = true;
+  /* Chunks of a few objects, bounded by their vertex count. */
+  OBJExportChunkLimits chunk_limits;
+  chunk_limits.max_vertices = 16;
+  compare_obj_export_to_golden("io_tests" SEP_STR "blend_scene" SEP_STR "all_objects.blend",
+                               "io_tests" SEP_STR "obj" SEP_STR "all_objects.obj",
+                               "io_tests" SEP_STR "obj" SEP_STR "all_objects.mtl",
+                               _export.params,
+                               chunk_limits);
+}
+
 TEST_F(OBJExportRegressionTest, all_objects_mat_groups)
 {
   OBJExportParamsDefault _export;
@@ -40,6 +40,30 @@ TEST(obj_import_string_utils, fixup_line_continuations)
   EXPECT_STRREF_EQ(exp, buf);
 }
 
+TEST(obj_import_string_utils, read_next_line_with_continuations)
+{
+  std::string str =
+      "backslash \\\n eol\n"
+      "backslash spaces \\   \n eol\n"
+      "several \\\n lines \\\n joined\n"
+      "without eol \\ is \\\\ \\ left intact\n"
+      "\\";
+  StringRef s = str;
+  std::string joined;
+  EXPECT_STRREF_EQ("backslash    eol", read_next_line_with_continuations(s, joined));
+  EXPECT_STRREF_EQ("backslash spaces       eol", read_next_line_with_continuations(s, joined));
+  EXPECT_STRREF_EQ("several    lines    joined", read_next_line_with_continuations(s, joined));
+  EXPECT_STRREF_EQ("without eol \\ is \\\\ \\ left intact",
+                   read_next_line_with_continuations(s, joined));
+  EXPECT_STRREF_EQ("\\", read_next_line_with_continuations(s, joined));
+  EXPECT_TRUE(s.is_empty());
+
+  EXPECT_TRUE(has_line_continuation("abc \\"));
+  EXPECT_TRUE(has_line_continuation("abc \\ \r"));
+  EXPECT_FALSE(has_line_continuation("abc \\ d"));
+  EXPECT_FALSE(has_line_continuation(""));
+}
+
 static StringRef drop_whitespace(StringRef s)
 {
   return StringRef(drop_whitespace(s.begin(), s.end()), s.end());
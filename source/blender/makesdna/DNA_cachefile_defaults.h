@@ -29,6 +29,8 @@
     .handle_readers = NULL, \
     .use_prefetch = 1, \
     .prefetch_cache_size = 4096, \
+    .use_read_ahead = 0, \
+    .read_ahead_cache_size = 512, \
   }
 
 /** \} */
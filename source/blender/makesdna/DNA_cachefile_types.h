@@ -82,7 +82,8 @@ typedef struct CacheFile {
   /** The frame offset to subtract. */
   float frame_offset;
 
-  char _pad[4];
+  /** Size in megabytes for the frames read ahead during playback. */
+  int read_ahead_cache_size;
 
   /** Animation flag. */
   short flag;
@@ -97,7 +98,13 @@ typedef struct CacheFile {
    */
   char use_render_procedural;
 
-  char _pad1[3];
+  /**
+   * Read the following frames in the background during playback for modifiers, see
+   * #BKE_cachefile_read_geometry.
+   */
+  char use_read_ahead;
+
+  char _pad1[2];
 
   /** Enable data prefetching when using the Cycles Procedural. */
   char use_prefetch;
@@ -118,4 +125,6 @@ typedef struct CacheFile {
   struct CacheArchiveHandle *handle;
   char handle_filepath[1024];
   struct GSet *handle_readers;
+  /** Frames read ahead for modifiers, see #BKE_cachefile_read_geometry. */
+  struct CacheFilePrefetch *prefetch;
 } CacheFile;
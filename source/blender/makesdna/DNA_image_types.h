@@ -137,6 +137,13 @@ typedef struct Image_Runtime {
   /* Compositor viewer might be translated, and that translation will be stored in this runtime
    * vector by the compositor so that the editor draw code can draw the image translated. */
   float backdrop_offset[2];
+
+  /**
+   * Unique identifier of the current buffers of the image, changed every time they are freed
+   * since they may be read again from a different file. Used along with the session UID to
+   * identify the image content in caches, see #BKE_image_free_buffers_ex.
+   */
+  uint64_t update_id;
 } Image_Runtime;
 
 typedef struct Image {
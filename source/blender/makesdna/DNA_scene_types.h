@@ -835,7 +835,15 @@ typedef struct RenderData {
   /* If false and the experimental enable_new_cpu_compositor is true, use the new experimental
    * CPU compositor implementation, otherwise, use the old CPU compositor. */
   char use_old_cpu_compositor;
-  char _pad10[7];
+  char _pad10[3];
+
+  /** Maximum size in megabytes of the CPU compositor buffers, zero for unlimited. */
+  int compositor_memory_limit;
+
+  /** Maximum size in megabytes of the results cached by the CPU compositor between executions in
+   * memory and on disk, caching is disabled when the memory size is zero. */
+  int compositor_cache_memory_limit;
+  int compositor_cache_disk_limit;
 } RenderData;
 
 /** #RenderData::quality_flag */
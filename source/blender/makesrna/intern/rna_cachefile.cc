@@ -307,6 +307,21 @@ static void rna_def_cachefile(BlenderRNA *brna)
       "fit within the limit, rendering is aborted");
   RNA_def_property_update(prop, 0, "rna_CacheFile_update");
 
+  prop = RNA_def_property(srna, "use_read_ahead", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_ui_text(prop,
+                           "Read Ahead",
+                           "Read the following frames in the background during playback, for "
+                           "the Mesh Sequence Cache modifier. Uses additional memory, up to the "
+                           "read ahead cache size, and an additional reader for every modifier");
+  RNA_def_property_update(prop, 0, "rna_CacheFile_update");
+
+  prop = RNA_def_property(srna, "read_ahead_cache_size", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_ui_text(prop,
+                           "Read Ahead Cache Size",
+                           "Memory usage limit in megabytes for the frames read ahead, if the "
+                           "data does not fit within the limit, fewer frames are read ahead");
+  RNA_def_property_update(prop, 0, "rna_CacheFile_update");
+
   /* ----------------- Axis Conversion ----------------- */
 
   prop = RNA_def_property(srna, "forward_axis", PROP_ENUM, PROP_NONE);
@@ -7537,6 +7537,40 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
       prop, "Compositor Precision", "The precision of compositor intermediate result");
   RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_Scene_compositor_update");
 
+  prop = RNA_def_property(srna, "compositor_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "compositor_memory_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 1024 * 1024, 1024, -1);
+  RNA_def_property_ui_text(prop,
+                           "Compositor Memory Limit",
+                           "Maximum memory in megabytes used by the buffers of the CPU compositor, "
+                           "the output is rendered in tiles to stay within it. With automatic "
+                           "precision, intermediate results waiting to be used are also compressed "
+                           "to half precision outside of final renders, which saves memory but not "
+                           "processing time (0 for unlimited)");
+  RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_Scene_compositor_update");
+
+  prop = RNA_def_property(srna, "compositor_cache_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "compositor_cache_memory_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 1024 * 1024, 1024, -1);
+  RNA_def_property_ui_text(prop,
+                           "Compositor Cache Memory Limit",
+                           "Maximum memory in megabytes used to keep results of the CPU "
+                           "compositor between executions, reusing them for nodes whose inputs "
+                           "did not change (0 to disable the cache)");
+  RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_Scene_compositor_update");
+
+  prop = RNA_def_property(srna, "compositor_cache_disk_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "compositor_cache_disk_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 1024 * 1024, 1024, -1);
+  RNA_def_property_ui_text(prop,
+                           "Compositor Cache Disk Limit",
+                           "Maximum disk space in megabytes used to keep results of the CPU "
+                           "compositor exceeding the cache memory limit");
+  RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_Scene_compositor_update");
+
   prop = RNA_def_property(srna, "use_new_cpu_compositor", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_negative_sdna(prop, nullptr, "use_old_cpu_compositor", 1);
   RNA_def_property_ui_text(
@@ -89,6 +89,8 @@ static void free_data(ModifierData *md)
 {
   MeshSeqCacheModifierData *mcmd = reinterpret_cast<MeshSeqCacheModifierData *>(md);
 
+  BKE_cachefile_prefetch_free(mcmd->cache_file, mcmd);
+
   if (mcmd->reader) {
     mcmd->reader_object_path[0] = '\0';
     BKE_cachefile_reader_free(mcmd->cache_file, &mcmd->reader);
@@ -220,30 +222,19 @@ static void modify_geometry_set(ModifierData *md,
     velocity_scale *= FPS;
   }
 
-  switch (cache_file->type) {
-    case CACHEFILE_TYPE_ALEMBIC: {
-#  ifdef WITH_ALEMBIC
-      ABCReadParams params;
-      params.time = time;
-      params.read_flags = mcmd->read_flag;
-      params.velocity_name = mcmd->cache_file->velocity_name;
-      params.velocity_scale = velocity_scale;
-      ABC_read_geometry(mcmd->reader, ctx->object, *geometry_set, &params, &err_str);
-#  endif
-      break;
-    }
-    case CACHEFILE_TYPE_USD: {
-#  ifdef WITH_USD
-      const blender::io::usd::USDMeshReadParams params = blender::io::usd::create_mesh_read_params(
-          time * FPS, mcmd->read_flag);
-      blender::io::usd::USD_read_geometry(
-          mcmd->reader, ctx->object, *geometry_set, params, &err_str);
-#  endif
-      break;
-    }
-    case CACHE_FILE_TYPE_INVALID:
-      break;
-  }
+  CacheFileReadParams params;
+  params.frame = frame;
+  params.fps = FPS;
+  params.read_flags = mcmd->read_flag;
+  params.velocity_scale = velocity_scale;
+  BKE_cachefile_read_geometry(cache_file,
+                              mcmd->reader,
+                              mcmd,
+                              ctx->object,
+                              mcmd->object_path,
+                              *geometry_set,
+                              params,
+                              &err_str);
 
   if (err_str) {
     BKE_modifier_set_error(ctx->object, md, "%s", err_str);
@@ -6,8 +6,11 @@
  * \ingroup cmpnodes
  */
 
+#include <cfloat>
+
 #include "BLI_assert.h"
 #include "BLI_math_base.hh"
+#include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
 
 #include "RNA_access.hh"
@@ -19,12 +22,15 @@
 #include "GPU_state.hh"
 #include "GPU_texture.hh"
 
+#include "COM_algorithm_jump_flooding.hh"
 #include "COM_algorithm_morphological_distance.hh"
 #include "COM_algorithm_morphological_distance_feather.hh"
 #include "COM_algorithm_smaa.hh"
 #include "COM_node_operation.hh"
 #include "COM_utilities.hh"
 
+#include "COM_JumpFloodingAlgorithm.h"
+
 #include "node_composite_util.hh"
 
 /* **************** Dilate/Erode ******************** */
@@ -97,6 +103,16 @@ class DilateErodeOperation : public NodeOperation {
    * ---------------------------- */
 
   void execute_step()
+  {
+    if (context().use_gpu()) {
+      execute_step_gpu();
+    }
+    else {
+      execute_step_cpu();
+    }
+  }
+
+  void execute_step_gpu()
   {
     Result horizontal_pass_result = execute_step_horizontal_pass();
     execute_step_vertical_pass(horizontal_pass_result);
@@ -162,6 +178,47 @@ class DilateErodeOperation : public NodeOperation {
     output_mask.unbind_as_image();
   }
 
+  void execute_step_cpu()
+  {
+    const Domain domain = compute_domain();
+    Result horizontal_pass_result = context().create_result(ResultType::Float);
+    horizontal_pass_result.allocate_texture(domain);
+    if (get_distance() > 0) {
+      execute_step_pass_cpu<true>(get_input("Mask"), horizontal_pass_result, int2(1, 0));
+    }
+    else {
+      execute_step_pass_cpu<false>(get_input("Mask"), horizontal_pass_result, int2(1, 0));
+    }
+
+    Result &output_mask = get_result("Mask");
+    output_mask.allocate_texture(domain);
+    if (get_distance() > 0) {
+      execute_step_pass_cpu<true>(horizontal_pass_result, output_mask, int2(0, 1));
+    }
+    else {
+      execute_step_pass_cpu<false>(horizontal_pass_result, output_mask, int2(0, 1));
+    }
+
+    horizontal_pass_result.release();
+  }
+
+  /* Identical to the compositor_morphological_step shader but along the given axis and without
+   * the transposition, since the CPU passes can access the image along either axis. */
+  template<bool IsDilate>
+  void execute_step_pass_cpu(const Result &input, Result &output, const int2 &axis)
+  {
+    const float limit = IsDilate ? FLT_MIN : FLT_MAX;
+    const int radius = math::abs(get_distance());
+    parallel_for(output.domain().size, [&](const int2 texel) {
+      float value = limit;
+      for (int i = -radius; i <= radius; i++) {
+        const float sample = input.load_pixel_fallback(texel + axis * i, float4(limit)).x;
+        value = IsDilate ? math::max(value, sample) : math::min(value, sample);
+      }
+      output.store_pixel(texel, float4(value));
+    });
+  }
+
   const char *get_morphological_step_shader_name()
   {
     if (get_distance() > 0) {
@@ -184,6 +241,29 @@ class DilateErodeOperation : public NodeOperation {
    * ------------------------------------------ */
 
   void execute_distance_threshold()
+  {
+    Result output_mask = context().create_result(ResultType::Float);
+    if (context().use_gpu()) {
+      execute_distance_threshold_gpu(output_mask);
+    }
+    else {
+      execute_distance_threshold_cpu(output_mask);
+    }
+
+    /* For configurations where there is little user-specified inset, anti-alias the result for
+     * smoother edges. SMAA is not yet implemented on the CPU, so the result is not anti-aliased
+     * there. */
+    Result &output = get_result("Mask");
+    if (get_inset() < 2.0f && context().use_gpu()) {
+      smaa(context(), output_mask, output);
+      output_mask.release();
+    }
+    else {
+      output.steal_data(output_mask);
+    }
+  }
+
+  void execute_distance_threshold_gpu(Result &output_mask)
   {
     GPUShader *shader = context().get_shader("compositor_morphological_distance_threshold");
     GPU_shader_bind(shader);
@@ -196,7 +276,6 @@ class DilateErodeOperation : public NodeOperation {
     input_mask.bind_as_texture(shader, "input_tx");
 
     const Domain domain = compute_domain();
-    Result output_mask = context().create_result(ResultType::Float);
     output_mask.allocate_texture(domain);
     output_mask.bind_as_image(shader, "output_img");
 
@@ -205,17 +284,71 @@ class DilateErodeOperation : public NodeOperation {
     GPU_shader_unbind();
     output_mask.unbind_as_image();
     input_mask.unbind_as_texture();
+  }
 
-    /* For configurations where there is little user-specified inset, anti-alias the result for
-     * smoother edges. */
-    Result &output = get_result("Mask");
-    if (get_inset() < 2.0f) {
-      smaa(context(), output_mask, output);
-      output_mask.release();
-    }
-    else {
-      output.steal_data(output_mask);
-    }
+  /* Computes the same result as the compositor_morphological_distance_threshold shader, see the
+   * shader for more information. But instead of searching the window of the radius around each
+   * pixel for the nearest pixel whose masked state is different, the nearest masked and unmasked
+   * pixels are computed for all pixels using jump flooding, which is independent of the radius.
+   * Distances larger than the radius are not limited to the window of the shader, but they are
+   * clamped to the same value by the inset anyway. */
+  void execute_distance_threshold_cpu(Result &output_mask)
+  {
+    const Result &input_mask = get_input("Mask");
+    const Domain domain = compute_domain();
+
+    /* Apply a threshold operation, where the threshold is currently hard-coded at 0.5, and mark
+     * the masked and unmasked pixels as seeds of two separate jump flooding tables. */
+    Result masked_pixels = context().create_result(ResultType::Int2, ResultPrecision::Half);
+    Result unmasked_pixels = context().create_result(ResultType::Int2, ResultPrecision::Half);
+    masked_pixels.allocate_texture(domain);
+    unmasked_pixels.allocate_texture(domain);
+    parallel_for(domain.size, [&](const int2 texel) {
+      const bool is_masked = input_mask.load_pixel(texel).x > 0.5f;
+      masked_pixels.store_integer_pixel(
+          texel, compositor::initialize_jump_flooding_value(texel, is_masked));
+      unmasked_pixels.store_integer_pixel(
+          texel, compositor::initialize_jump_flooding_value(texel, !is_masked));
+    });
+
+    Result flooded_masked_pixels = context().create_result(ResultType::Int2,
+                                                           ResultPrecision::Half);
+    Result flooded_unmasked_pixels = context().create_result(ResultType::Int2,
+                                                             ResultPrecision::Half);
+    jump_flooding(context(), masked_pixels, flooded_masked_pixels);
+    jump_flooding(context(), unmasked_pixels, flooded_unmasked_pixels);
+    masked_pixels.release();
+    unmasked_pixels.release();
+
+    const int radius = get_morphological_distance_threshold_radius();
+    const int distance = get_distance();
+    const float inset = get_inset();
+    output_mask.allocate_texture(domain);
+    parallel_for(domain.size, [&](const int2 texel) {
+      const bool is_center_masked = input_mask.load_pixel(texel).x > 0.5f;
+
+      /* The nearest different pixel is the nearest unmasked pixel if the center pixel is masked
+       * and the nearest masked pixel otherwise. There might be no such pixel, in which case, the
+       * maximum squared distance of the shader is used. */
+      const Result &flooded_pixels = is_center_masked ? flooded_unmasked_pixels :
+                                                        flooded_masked_pixels;
+      const int2 nearest_different_texel = flooded_pixels.load_integer_pixel(texel);
+      int minimum_squared_distance = radius * radius * 2;
+      if (nearest_different_texel != JUMP_FLOODING_NON_FLOODED_VALUE) {
+        const int2 offset = nearest_different_texel - texel;
+        minimum_squared_distance = math::min(minimum_squared_distance, math::dot(offset, offset));
+      }
+
+      /* Compute the signed distance and adjust it by the erode/dilate distance and the inset, as
+       * described in the shader. */
+      const float signed_minimum_distance = math::sqrt(float(minimum_squared_distance)) *
+                                            (is_center_masked ? 1.0f : -1.0f);
+      const float value = math::clamp((signed_minimum_distance + distance) / inset, 0.0f, 1.0f);
+      output_mask.store_pixel(texel, float4(value));
+    });
+
+    flooded_masked_pixels.release();
+    flooded_unmasked_pixels.release();
   }
 
   /* See the discussion in the implementation for more information. */
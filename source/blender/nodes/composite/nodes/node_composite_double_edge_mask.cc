@@ -6,6 +6,9 @@
  * \ingroup cmpnodes
  */
 
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+
 #include "UI_interface.hh"
 #include "UI_resources.hh"
 
@@ -13,6 +16,8 @@
 #include "COM_node_operation.hh"
 #include "COM_utilities.hh"
 
+#include "COM_JumpFloodingAlgorithm.h"
+
 #include "node_composite_util.hh"
 
 /* **************** Double Edge Mask ******************** */
@@ -88,6 +93,16 @@ class DoubleEdgeMaskOperation : public NodeOperation {
   }
 
   void compute_boundary(Result &inner_boundary, Result &outer_boundary)
+  {
+    if (context().use_gpu()) {
+      compute_boundary_gpu(inner_boundary, outer_boundary);
+    }
+    else {
+      compute_boundary_cpu(inner_boundary, outer_boundary);
+    }
+  }
+
+  void compute_boundary_gpu(Result &inner_boundary, Result &outer_boundary)
   {
     GPUShader *shader = context().get_shader("compositor_double_edge_mask_compute_boundary",
                                              ResultPrecision::Half);
@@ -119,7 +134,82 @@ class DoubleEdgeMaskOperation : public NodeOperation {
     GPU_shader_unbind();
   }
 
+  /* Identical to the compositor_double_edge_mask_compute_boundary shader, see the shader for
+   * more information. */
+  void compute_boundary_cpu(Result &inner_boundary, Result &outer_boundary)
+  {
+    const bool include_all_inner_edges = this->include_all_inner_edges();
+    const bool include_edges_of_image = this->include_edges_of_image();
+
+    const Result &inner_mask = get_input("Inner Mask");
+    const Result &outer_mask = get_input("Outer Mask");
+
+    const Domain domain = compute_domain();
+    inner_boundary.allocate_texture(domain);
+    outer_boundary.allocate_texture(domain);
+
+    parallel_for(domain.size, [&](const int2 texel) {
+      /* Identify if any of the 8 neighbors around the center pixel are not masked. */
+      bool has_inner_non_masked_neighbors = false;
+      bool has_outer_non_masked_neighbors = false;
+      for (int j = -1; j <= 1; j++) {
+        for (int i = -1; i <= 1; i++) {
+          int2 offset = int2(i, j);
+
+          /* Exempt the center pixel. */
+          if (offset == int2(0)) {
+            continue;
+          }
+
+          if (inner_mask.load_pixel_extended(texel + offset).x == 0.0f) {
+            has_inner_non_masked_neighbors = true;
+          }
+
+          /* If the user specified include_edges_of_image to be true, then we assume the outer
+           * mask is bounded by the image boundary, otherwise, we assume the outer mask is
+           * open-ended. This is practically implemented by falling back to 0.0 or 1.0 for out of
+           * bound pixels. */
+          float4 boundary_fallback = include_edges_of_image ? float4(0.0f) : float4(1.0f);
+          if (outer_mask.load_pixel_fallback(texel + offset, boundary_fallback).x == 0.0f) {
+            has_outer_non_masked_neighbors = true;
+          }
+
+          /* Both are true, no need to continue. */
+          if (has_inner_non_masked_neighbors && has_outer_non_masked_neighbors) {
+            break;
+          }
+        }
+      }
+
+      bool is_inner_masked = inner_mask.load_pixel(texel).x > 0.0f;
+      bool is_outer_masked = outer_mask.load_pixel(texel).x > 0.0f;
+
+      /* The pixels at the boundary are those that are masked and have non masked neighbors. See
+       * the shader for more information. */
+      bool is_inner_boundary = is_inner_masked && has_inner_non_masked_neighbors &&
+                               (is_outer_masked || include_all_inner_edges);
+      bool is_outer_boundary = is_outer_masked && !is_inner_masked &&
+                               has_outer_non_masked_neighbors;
+
+      /* Encode the boundary information in the format expected by the jump flooding algorithm. */
+      inner_boundary.store_integer_pixel(
+          texel, compositor::initialize_jump_flooding_value(texel, is_inner_boundary));
+      outer_boundary.store_integer_pixel(
+          texel, compositor::initialize_jump_flooding_value(texel, is_outer_boundary));
+    });
+  }
+
   void compute_gradient(Result &flooded_inner_boundary, Result &flooded_outer_boundary)
+  {
+    if (context().use_gpu()) {
+      compute_gradient_gpu(flooded_inner_boundary, flooded_outer_boundary);
+    }
+    else {
+      compute_gradient_cpu(flooded_inner_boundary, flooded_outer_boundary);
+    }
+  }
+
+  void compute_gradient_gpu(Result &flooded_inner_boundary, Result &flooded_outer_boundary)
   {
     GPUShader *shader = context().get_shader("compositor_double_edge_mask_compute_gradient");
     GPU_shader_bind(shader);
@@ -146,6 +236,44 @@ class DoubleEdgeMaskOperation : public NodeOperation {
     GPU_shader_unbind();
   }
 
+  /* Identical to the compositor_double_edge_mask_compute_gradient shader, see the shader for more
+   * information. */
+  void compute_gradient_cpu(Result &flooded_inner_boundary, Result &flooded_outer_boundary)
+  {
+    const Result &inner_mask = get_input("Inner Mask");
+    const Result &outer_mask = get_input("Outer Mask");
+
+    const Domain domain = compute_domain();
+    Result &output = get_result("Mask");
+    output.allocate_texture(domain);
+
+    parallel_for(domain.size, [&](const int2 texel) {
+      /* Pixels inside the inner mask are always 1.0. */
+      float inner_mask_value = inner_mask.load_pixel(texel).x;
+      if (inner_mask_value != 0.0f) {
+        output.store_pixel(texel, float4(1.0f));
+        return;
+      }
+
+      /* Pixels outside the outer mask are always 0.0. */
+      float outer_mask_value = outer_mask.load_pixel(texel).x;
+      if (outer_mask_value == 0.0f) {
+        output.store_pixel(texel, float4(0.0f));
+        return;
+      }
+
+      /* Compute the distances to the inner and outer boundaries from the jump flooding tables. */
+      int2 inner_boundary_texel = flooded_inner_boundary.load_integer_pixel(texel);
+      int2 outer_boundary_texel = flooded_outer_boundary.load_integer_pixel(texel);
+      float distance_to_inner = math::distance(float2(texel), float2(inner_boundary_texel));
+      float distance_to_outer = math::distance(float2(texel), float2(outer_boundary_texel));
+
+      float gradient = distance_to_outer / (distance_to_outer + distance_to_inner);
+
+      output.store_pixel(texel, float4(gradient));
+    });
+  }
+
   /* If false, only edges of the inner mask that lie inside the outer mask will be considered. If
    * true, all edges of the inner mask will be considered. */
   bool include_all_inner_edges()
@@ -6,6 +6,11 @@
  * \ingroup cmpnodes
  */
 
+#include "BLI_math_base.hh"
+#include "BLI_math_numbers.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+
 #include "UI_interface.hh"
 #include "UI_resources.hh"
 
@@ -16,6 +21,8 @@
 #include "COM_node_operation.hh"
 #include "COM_utilities.hh"
 
+#include "COM_JumpFloodingAlgorithm.h"
+
 #include "node_composite_util.hh"
 
 /* **************** Inpaint/ ******************** */
@@ -84,6 +91,14 @@ class InpaintOperation : public NodeOperation {
    * the jump flooding algorithm. The inpainting region is the region composed of pixels that are
    * not opaque. */
   Result compute_inpainting_boundary()
+  {
+    if (context().use_gpu()) {
+      return compute_inpainting_boundary_gpu();
+    }
+    return compute_inpainting_boundary_cpu();
+  }
+
+  Result compute_inpainting_boundary_gpu()
   {
     GPUShader *shader = context().get_shader("compositor_inpaint_compute_boundary",
                                              ResultPrecision::Half);
@@ -106,12 +121,66 @@ class InpaintOperation : public NodeOperation {
     return inpainting_boundary;
   }
 
+  /* Identical to the compositor_inpaint_compute_boundary shader, see the shader for more
+   * information. */
+  Result compute_inpainting_boundary_cpu()
+  {
+    const Result &input = get_input("Image");
+
+    Result inpainting_boundary = context().create_result(ResultType::Int2, ResultPrecision::Half);
+    const Domain domain = compute_domain();
+    inpainting_boundary.allocate_texture(domain);
+
+    parallel_for(domain.size, [&](const int2 texel) {
+      /* Identify if any of the 8 neighbors around the center pixel are transparent. */
+      bool has_transparent_neighbors = false;
+      for (int j = -1; j <= 1; j++) {
+        for (int i = -1; i <= 1; i++) {
+          int2 offset = int2(i, j);
+
+          /* Exempt the center pixel. */
+          if (offset.x != 0 && offset.y != 0) {
+            if (input.load_pixel_extended(texel + offset).w < 1.0f) {
+              has_transparent_neighbors = true;
+              break;
+            }
+          }
+        }
+      }
+
+      /* The pixels at the boundary are those that are opaque and have transparent neighbors. */
+      bool is_opaque = input.load_pixel(texel).w == 1.0f;
+      bool is_boundary_pixel = is_opaque && has_transparent_neighbors;
+
+      /* Encode the boundary information in the format expected by the jump flooding algorithm. */
+      inpainting_boundary.store_integer_pixel(
+          texel, compositor::initialize_jump_flooding_value(texel, is_boundary_pixel));
+    });
+
+    return inpainting_boundary;
+  }
+
   /* Fill the inpainting region based on the jump flooding table and write the distance to the
    * closest boundary pixel to an intermediate buffer. */
   void fill_inpainting_region(Result &flooded_boundary,
                               Result &filled_region,
                               Result &distance_to_boundary,
                               Result &smoothing_radius)
+  {
+    if (context().use_gpu()) {
+      fill_inpainting_region_gpu(
+          flooded_boundary, filled_region, distance_to_boundary, smoothing_radius);
+    }
+    else {
+      fill_inpainting_region_cpu(
+          flooded_boundary, filled_region, distance_to_boundary, smoothing_radius);
+    }
+  }
+
+  void fill_inpainting_region_gpu(Result &flooded_boundary,
+                                  Result &filled_region,
+                                  Result &distance_to_boundary,
+                                  Result &smoothing_radius)
   {
     GPUShader *shader = context().get_shader("compositor_inpaint_fill_region");
     GPU_shader_bind(shader);
@@ -143,9 +212,65 @@ class InpaintOperation : public NodeOperation {
     GPU_shader_unbind();
   }
 
+  /* Identical to the compositor_inpaint_fill_region shader, see the shader for more
+   * information. */
+  void fill_inpainting_region_cpu(Result &flooded_boundary,
+                                  Result &filled_region,
+                                  Result &distance_to_boundary,
+                                  Result &smoothing_radius)
+  {
+    const int max_distance = get_max_distance();
+
+    const Result &input = get_input("Image");
+
+    const Domain domain = compute_domain();
+    filled_region.allocate_texture(domain);
+    distance_to_boundary.allocate_texture(domain);
+    smoothing_radius.allocate_texture(domain);
+
+    parallel_for(domain.size, [&](const int2 texel) {
+      float4 color = input.load_pixel(texel);
+
+      /* An opaque pixel, not part of the inpainting region. */
+      if (color.w == 1.0f) {
+        filled_region.store_pixel(texel, color);
+        smoothing_radius.store_pixel(texel, float4(0.0f));
+        distance_to_boundary.store_pixel(texel, float4(0.0f));
+        return;
+      }
+
+      int2 closest_boundary_texel = flooded_boundary.load_integer_pixel(texel);
+      float distance_to_boundary_value = math::distance(float2(texel),
+                                                        float2(closest_boundary_texel));
+      distance_to_boundary.store_pixel(texel, float4(distance_to_boundary_value));
+
+      /* See the shader for the reasoning behind the smoothing radius. */
+      float blur_window_size = math::min(float(max_distance), distance_to_boundary_value) /
+                               math::numbers::sqrt2;
+      bool skip_smoothing = distance_to_boundary_value > (max_distance * 2.0f);
+      float smoothing_radius_value = skip_smoothing ? 0.0f : blur_window_size;
+      smoothing_radius.store_pixel(texel, float4(smoothing_radius_value));
+
+      /* Mix the boundary color with the original color using its alpha because semi-transparent
+       * areas are considered to be partially inpainted. */
+      float4 boundary_color = input.load_pixel_extended(closest_boundary_texel);
+      filled_region.store_pixel(texel, math::interpolate(boundary_color, color, color.w));
+    });
+  }
+
   /* Compute the inpainting region by mixing the smoothed inpainted region with the original input
    * up to the inpainting distance. */
   void compute_inpainting_region(Result &inpainted_region, Result &distance_to_boundary)
+  {
+    if (context().use_gpu()) {
+      compute_inpainting_region_gpu(inpainted_region, distance_to_boundary);
+    }
+    else {
+      compute_inpainting_region_cpu(inpainted_region, distance_to_boundary);
+    }
+  }
+
+  void compute_inpainting_region_gpu(Result &inpainted_region, Result &distance_to_boundary)
   {
     GPUShader *shader = context().get_shader("compositor_inpaint_compute_region");
     GPU_shader_bind(shader);
@@ -172,6 +297,44 @@ class InpaintOperation : public NodeOperation {
     GPU_shader_unbind();
   }
 
+  /* Identical to the compositor_inpaint_compute_region shader, see the shader for more
+   * information. */
+  void compute_inpainting_region_cpu(Result &inpainted_region, Result &distance_to_boundary)
+  {
+    const int max_distance = get_max_distance();
+
+    const Result &input = get_input("Image");
+
+    const Domain domain = compute_domain();
+    Result &output = get_result("Image");
+    output.allocate_texture(domain);
+
+    parallel_for(domain.size, [&](const int2 texel) {
+      float4 color = input.load_pixel(texel);
+
+      /* An opaque pixel, not part of the inpainting region, write the original color. */
+      if (color.w == 1.0f) {
+        output.store_pixel(texel, color);
+        return;
+      }
+
+      float distance_to_boundary_value = distance_to_boundary.load_pixel(texel).x;
+
+      /* Further than the inpainting distance, not part of the inpainting region, write the
+       * original color. */
+      if (distance_to_boundary_value > max_distance) {
+        output.store_pixel(texel, color);
+        return;
+      }
+
+      /* Mix the inpainted color with the original color using its alpha because semi-transparent
+       * areas are considered to be partially inpainted. */
+      float4 inpainted_color = inpainted_region.load_pixel(texel);
+      output.store_pixel(
+          texel, float4(math::interpolate(inpainted_color.xyz(), color.xyz(), color.w), 1.0f));
+    });
+  }
+
   int get_max_distance()
   {
     return bnode().custom2;
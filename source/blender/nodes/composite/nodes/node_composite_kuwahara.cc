@@ -6,7 +6,11 @@
  * \ingroup cmpnodes
  */
 
+#include <limits>
+
 #include "BLI_math_base.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
 
 #include "RNA_access.hh"
 
@@ -101,12 +105,23 @@ class ConvertKuwaharaOperation : public NodeOperation {
       return;
     }
 
+    if (context().use_gpu()) {
+      execute_classic_convolution_gpu();
+    }
+    else {
+      execute_classic_cpu(nullptr, nullptr);
+    }
+  }
+
+  void execute_classic_convolution_gpu()
+  {
     GPUShader *shader = context().get_shader(get_classic_convolution_shader_name());
     GPU_shader_bind(shader);
 
     const Result &input_image = get_input("Image");
     input_image.bind_as_texture(shader, "input_tx");
 
+    Result &size_input = get_input("Size");
     if (size_input.is_single_value()) {
       GPU_shader_uniform_1i(shader, "size", int(size_input.get_float_value()));
     }
@@ -135,6 +150,19 @@ class ConvertKuwaharaOperation : public NodeOperation {
     summed_area_table(
         context(), get_input("Image"), squared_table, SummedAreaTableOperation::Square);
 
+    if (context().use_gpu()) {
+      execute_classic_summed_area_table_gpu(table, squared_table);
+    }
+    else {
+      execute_classic_cpu(&table, &squared_table);
+    }
+
+    table.release();
+    squared_table.release();
+  }
+
+  void execute_classic_summed_area_table_gpu(Result &table, Result &squared_table)
+  {
     GPUShader *shader = context().get_shader(get_classic_summed_area_table_shader_name());
     GPU_shader_bind(shader);
 
@@ -160,9 +188,82 @@ class ConvertKuwaharaOperation : public NodeOperation {
     squared_table.unbind_as_texture();
     output_image.unbind_as_image();
     GPU_shader_unbind();
+  }
 
-    table.release();
-    squared_table.release();
+  /* Identical to the compositor_kuwahara_classic shader, see the shader for more information. The
+   * statistics of the quadrants are computed from the given summed area tables if they are not
+   * null, otherwise, they are computed by convolution. */
+  void execute_classic_cpu(const Result *table, const Result *squared_table)
+  {
+    const Result &input_image = get_input("Image");
+    const Result &size_input = get_input("Size");
+
+    const Domain domain = compute_domain();
+    Result &output_image = get_result("Image");
+    output_image.allocate_texture(domain);
+
+    parallel_for(domain.size, [&](const int2 texel) {
+      const int radius = math::max(0, int(size_input.load_pixel(texel).x));
+
+      float4 mean_of_squared_color_of_quadrants[4];
+      float4 mean_of_color_of_quadrants[4];
+
+      /* Compute the above statistics for each of the quadrants around the current pixel. */
+      for (int q = 0; q < 4; q++) {
+        /* A fancy expression to compute the sign of the quadrant q. */
+        const int2 sign = int2((q % 2) * 2 - 1, ((q / 2) * 2 - 1));
+
+        const int2 lower_bound = texel -
+                                 int2(sign.x > 0 ? 0 : radius, sign.y > 0 ? 0 : radius);
+        const int2 upper_bound = texel +
+                                 int2(sign.x < 0 ? 0 : radius, sign.y < 0 ? 0 : radius);
+
+        /* Limit the quadrants to the image bounds. */
+        const int2 image_bound = domain.size - int2(1);
+        const int2 corrected_lower_bound = math::min(image_bound, math::max(int2(0), lower_bound));
+        const int2 corrected_upper_bound = math::min(image_bound, math::max(int2(0), upper_bound));
+        const int2 region_size = corrected_upper_bound - corrected_lower_bound + int2(1);
+        const int quadrant_pixel_count = region_size.x * region_size.y;
+
+        if (table) {
+          mean_of_color_of_quadrants[q] = summed_area_table_sum(
+              *table, lower_bound, upper_bound);
+          mean_of_squared_color_of_quadrants[q] = summed_area_table_sum(
+              *squared_table, lower_bound, upper_bound);
+        }
+        else {
+          mean_of_color_of_quadrants[q] = float4(0.0f);
+          mean_of_squared_color_of_quadrants[q] = float4(0.0f);
+          for (int j = 0; j <= radius; j++) {
+            for (int i = 0; i <= radius; i++) {
+              const float4 color = input_image.load_pixel_fallback(texel + int2(i, j) * sign,
+                                                                   float4(0.0f));
+              mean_of_color_of_quadrants[q] += color;
+              mean_of_squared_color_of_quadrants[q] += color * color;
+            }
+          }
+        }
+        mean_of_color_of_quadrants[q] /= quadrant_pixel_count;
+        mean_of_squared_color_of_quadrants[q] /= quadrant_pixel_count;
+      }
+
+      /* Find the quadrant which has the minimum variance. */
+      float minimum_variance = std::numeric_limits<float>::max();
+      float4 mean_color_of_chosen_quadrant = mean_of_color_of_quadrants[0];
+      for (int q = 0; q < 4; q++) {
+        const float4 color_mean = mean_of_color_of_quadrants[q];
+        const float4 squared_color_mean = mean_of_squared_color_of_quadrants[q];
+        const float4 color_variance = squared_color_mean - color_mean * color_mean;
+
+        const float variance = math::reduce_add(color_variance.xyz());
+        if (variance < minimum_variance) {
+          minimum_variance = variance;
+          mean_color_of_chosen_quadrant = color_mean;
+        }
+      }
+
+      output_image.store_pixel(texel, mean_color_of_chosen_quadrant);
+    });
   }
 
   /* An implementation of the Anisotropic Kuwahara filter described in the paper:
@@ -8,6 +8,14 @@
 #include "DNA_space_types.h"
 
 #include "BKE_node.hh"
+#include "BKE_report.hh"
+
+#include "BLI_fileops.h"
+#include "BLI_generic_key.hh"
+#include "BLI_hash.hh"
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_counter.hh"
+#include "BLI_path_util.h"
 
 #include "NOD_rna_define.hh"
 #include "NOD_socket.hh"
@@ -49,6 +57,97 @@ void search_link_ops_for_import_node(GatherLinkSearchOpParams &params)
   }
 }
 
+/**
+ * Identifies an imported file in the global memory cache.
+ */
+class ImportFileKey : public GenericKey {
+ public:
+  std::string file_path;
+  int64_t file_size;
+  int64_t modification_time;
+  std::string options;
+
+  uint64_t hash() const override
+  {
+    return get_default_hash(
+        this->file_path, this->file_size, this->modification_time, this->options);
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_4(
+      ImportFileKey, file_path, file_size, modification_time, options)
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    if (const auto *other_typed = dynamic_cast<const ImportFileKey *>(&other)) {
+      return *this == *other_typed;
+    }
+    return false;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<ImportFileKey>(*this);
+  }
+};
+
+class ImportFileValue : public memory_cache::CachedValue {
+ public:
+  Vector<GeometrySet> geometries;
+  Vector<std::pair<NodeWarningType, std::string>> warnings;
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    for (const GeometrySet &geometry : this->geometries) {
+      geometry.count_memory(memory);
+    }
+  }
+};
+
+Vector<GeometrySet> import_geometries_cached(
+    GeoNodeExecParams &params,
+    const StringRef file_path,
+    const StringRef options,
+    const FunctionRef<Vector<GeometrySet>(ReportList &reports)> import_fn)
+{
+  const auto import_file = [&]() {
+    auto value = std::make_unique<ImportFileValue>();
+    ReportList reports;
+    BKE_reports_init(&reports, RPT_STORE);
+    BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); });
+    value->geometries = import_fn(reports);
+    LISTBASE_FOREACH (Report *, report, &reports.list) {
+      const NodeWarningType type = report->type == RPT_ERROR ? NodeWarningType::Error :
+                                                               NodeWarningType::Info;
+      value->warnings.append({type, report->message});
+    }
+    return value;
+  };
+
+  char abs_file_path[FILE_MAX];
+  file_path.copy(abs_file_path);
+  BLI_path_abs_from_cwd(abs_file_path, sizeof(abs_file_path));
+
+  std::shared_ptr<const ImportFileValue> value;
+  BLI_stat_t stat;
+  if (BLI_stat(abs_file_path, &stat) == 0) {
+    ImportFileKey key;
+    key.file_path = abs_file_path;
+    key.file_size = stat.st_size;
+    key.modification_time = stat.st_mtime;
+    key.options = options;
+    value = memory_cache::get<ImportFileValue>(key, import_file);
+  }
+  else {
+    /* Let the importer report that the file can not be read, without caching the failure. */
+    value = import_file();
+  }
+
+  for (const auto &[type, message] : value->warnings) {
+    params.error_message_add(type, TIP_(message.c_str()));
+  }
+  return value->geometries;
+}
+
 namespace enums {
 
 const EnumPropertyItem *attribute_type_type_with_socket_fn(bContext * /*C*/,
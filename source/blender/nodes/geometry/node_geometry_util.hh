@@ -17,6 +17,7 @@
 #include "node_util.hh"
 
 struct BVHTreeFromMesh;
+struct ReportList;
 namespace blender::nodes {
 class GatherAddNodeSearchParams;
 class GatherLinkSearchOpParams;
@@ -34,6 +35,21 @@ void search_link_ops_for_tool_node(GatherLinkSearchOpParams &params);
 void search_link_ops_for_volume_grid_node(GatherLinkSearchOpParams &params);
 void search_link_ops_for_import_node(GatherLinkSearchOpParams &params);
 
+/**
+ * Imports geometries from a file for the import nodes. The result is kept in the global memory
+ * cache, keyed by the absolute file path, the size and modification time of the file and the
+ * import options, so that the file is only read again when one of them changed. The returned
+ * geometries share their data with the cached ones. Reports of the import are added as node
+ * warnings, also when the cached result is reused.
+ *
+ * \param options: All import options that affect the result, in any format.
+ */
+Vector<GeometrySet> import_geometries_cached(
+    GeoNodeExecParams &params,
+    StringRef file_path,
+    StringRef options,
+    FunctionRef<Vector<GeometrySet>(ReportList &reports)> import_fn);
+
 void get_closest_in_bvhtree(BVHTreeFromMesh &tree_data,
                             const VArray<float3> &positions,
                             const IndexMask &mask,
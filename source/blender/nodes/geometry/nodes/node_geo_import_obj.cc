@@ -8,10 +8,11 @@
 
 #include "BKE_instances.hh"
 #include "BKE_mesh.hh"
-#include "BKE_report.hh"
 
 #include "IO_wavefront_obj.hh"
 
+#include <fmt/format.h>
+
 #include "node_geometry_util.hh"
 
 namespace blender::nodes::node_geo_import_obj {
@@ -38,26 +39,24 @@ static void node_geo_exec(GeoNodeExecParams params)
   OBJImportParams import_params;
   STRNCPY(import_params.filepath, path.c_str());
 
-  ReportList reports;
-  BKE_reports_init(&reports, RPT_STORE);
-  BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); });
-  import_params.reports = &reports;
-
-  Vector<bke::GeometrySet> geometries;
-  OBJ_import_geometries(&import_params, geometries);
-
-  LISTBASE_FOREACH (Report *, report, &(import_params.reports)->list) {
-    NodeWarningType type;
-    switch (report->type) {
-      case RPT_ERROR:
-        type = NodeWarningType::Error;
-        break;
-      default:
-        type = NodeWarningType::Info;
-        break;
-    }
-    params.error_message_add(type, TIP_(report->message));
-  }
+  const std::string options = fmt::format("OBJ {} {} {} {} {} {} {} {} {}",
+                                          import_params.clamp_size,
+                                          import_params.global_scale,
+                                          int(import_params.forward_axis),
+                                          int(import_params.up_axis),
+                                          int(import_params.collection_separator),
+                                          import_params.use_split_objects,
+                                          import_params.use_split_groups,
+                                          import_params.import_vertex_groups,
+                                          import_params.validate_meshes);
+
+  Vector<bke::GeometrySet> geometries = import_geometries_cached(
+      params, path, options, [&](ReportList &reports) {
+        import_params.reports = &reports;
+        Vector<bke::GeometrySet> result;
+        OBJ_import_geometries(&import_params, result);
+        return result;
+      });
 
   if (geometries.is_empty()) {
     params.set_default_remaining_outputs();
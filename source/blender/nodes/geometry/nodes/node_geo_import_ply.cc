@@ -8,10 +8,11 @@
 
 #include "BKE_instances.hh"
 #include "BKE_mesh.hh"
-#include "BKE_report.hh"
 
 #include "IO_ply.hh"
 
+#include <fmt/format.h>
+
 namespace blender::nodes::nodes_geo_import_ply {
 
 static void node_declare(NodeDeclarationBuilder &b)
@@ -37,27 +38,22 @@ static void node_geo_exec(GeoNodeExecParams params)
   STRNCPY(import_params.filepath, path.c_str());
   import_params.import_attributes = true;
 
-  ReportList reports;
-  BKE_reports_init(&reports, RPT_STORE);
-  BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); })
-  import_params.reports = &reports;
-
-  Mesh *mesh = PLY_import_mesh(&import_params);
-
-  LISTBASE_FOREACH (Report *, report, &(import_params.reports)->list) {
-    NodeWarningType type;
-    switch (report->type) {
-      case RPT_ERROR:
-        type = NodeWarningType::Error;
-        break;
-      default:
-        type = NodeWarningType::Info;
-        break;
-    }
-    params.error_message_add(type, TIP_(report->message));
-  }
-
-  params.set_output("Mesh", GeometrySet::from_mesh(mesh));
+  const std::string options = fmt::format("PLY {} {} {} {} {} {} {}",
+                                          int(import_params.forward_axis),
+                                          int(import_params.up_axis),
+                                          import_params.use_scene_unit,
+                                          import_params.global_scale,
+                                          int(import_params.vertex_colors),
+                                          import_params.import_attributes,
+                                          import_params.merge_verts);
+
+  Vector<GeometrySet> geometries = import_geometries_cached(
+      params, path, options, [&](ReportList &reports) {
+        import_params.reports = &reports;
+        return Vector<GeometrySet>({GeometrySet::from_mesh(PLY_import_mesh(&import_params))});
+      });
+
+  params.set_output("Mesh", std::move(geometries.first()));
 
 #else
   params.error_message_add(NodeWarningType::Error,
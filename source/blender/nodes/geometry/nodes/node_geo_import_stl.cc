@@ -6,11 +6,12 @@
 
 #include "BKE_mesh.hh"
 
-#include "BKE_report.hh"
 #include "BLI_string.h"
 
 #include "IO_stl.hh"
 
+#include <fmt/format.h>
+
 #include "node_geometry_util.hh"
 
 namespace blender::nodes::node_geo_import_stl {
@@ -44,27 +45,21 @@ static void node_geo_exec(GeoNodeExecParams params)
   import_params.global_scale = 1.0f;
   import_params.use_mesh_validate = true;
 
-  ReportList reports;
-  BKE_reports_init(&reports, RPT_STORE);
-  BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); })
-  import_params.reports = &reports;
-
-  Mesh *mesh = STL_import_mesh(&import_params);
-
-  LISTBASE_FOREACH (Report *, report, &(import_params.reports)->list) {
-    NodeWarningType type;
-    switch (report->type) {
-      case RPT_ERROR:
-        type = NodeWarningType::Error;
-        break;
-      default:
-        type = NodeWarningType::Info;
-        break;
-    }
-    params.error_message_add(type, TIP_(report->message));
-  }
-
-  params.set_output("Mesh", GeometrySet::from_mesh(mesh));
+  const std::string options = fmt::format("STL {} {} {} {} {} {}",
+                                          int(import_params.forward_axis),
+                                          int(import_params.up_axis),
+                                          import_params.use_facet_normal,
+                                          import_params.use_scene_unit,
+                                          import_params.global_scale,
+                                          import_params.use_mesh_validate);
+
+  Vector<GeometrySet> geometries = import_geometries_cached(
+      params, path, options, [&](ReportList &reports) {
+        import_params.reports = &reports;
+        return Vector<GeometrySet>({GeometrySet::from_mesh(STL_import_mesh(&import_params))});
+      });
+
+  params.set_output("Mesh", std::move(geometries.first()));
 
 #else
   params.error_message_add(NodeWarningType::Error,
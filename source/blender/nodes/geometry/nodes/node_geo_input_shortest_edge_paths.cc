@@ -2,8 +2,6 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
-#include <queue>
-
 #include "BLI_array_utils.hh"
 #include "BLI_map.hh"
 #include "BLI_math_vector_types.hh"
@@ -13,6 +11,8 @@
 #include "BKE_mesh.hh"
 #include "BKE_mesh_mapping.hh"
 
+#include "GEO_mesh_distances.hh"
+
 #include "node_geometry_util.hh"
 
 namespace blender::nodes::node_geo_input_shortest_edge_paths_cc {
@@ -25,62 +25,6 @@ static void node_declare(NodeDeclarationBuilder &b)
   b.add_output<decl::Float>("Total Cost").field_source().reference_pass_all();
 }
 
-using VertPriority = std::pair<float, int>;
-
-static void shortest_paths(const Mesh &mesh,
-                           const GroupedSpan<int> vert_to_edge,
-                           const IndexMask end_selection,
-                           const VArray<float> &input_cost,
-                           MutableSpan<int> r_next_index,
-                           MutableSpan<float> r_cost)
-{
-  const Span<int2> edges = mesh.edges();
-  Array<bool> visited(mesh.verts_num, false);
-
-  std::priority_queue<VertPriority, std::vector<VertPriority>, std::greater<VertPriority>> queue;
-
-  end_selection.foreach_index([&](const int start_vert_i) {
-    r_cost[start_vert_i] = 0.0f;
-    queue.emplace(0.0f, start_vert_i);
-  });
-
-  /* Though it uses more memory, calculating the adjacent vertex
-   * across each edge beforehand is noticeably faster. */
-  Array<int> other_vertex(vert_to_edge.data.size());
-  threading::parallel_for(vert_to_edge.index_range(), 2048, [&](const IndexRange range) {
-    for (const int vert_i : range) {
-      for (const int edge_i : vert_to_edge.offsets[vert_i]) {
-        other_vertex[edge_i] = bke::mesh::edge_other_vert(edges[vert_to_edge.data[edge_i]],
-                                                          vert_i);
-      }
-    }
-  });
-
-  while (!queue.empty()) {
-    const float cost_i = queue.top().first;
-    const int vert_i = queue.top().second;
-    queue.pop();
-    if (visited[vert_i]) {
-      continue;
-    }
-    visited[vert_i] = true;
-    for (const int index : vert_to_edge.offsets[vert_i]) {
-      const int edge_i = vert_to_edge.data[index];
-      const int neighbor_vert_i = other_vertex[index];
-      if (visited[neighbor_vert_i]) {
-        continue;
-      }
-      const float edge_cost = std::max(0.0f, input_cost[edge_i]);
-      const float new_neighbor_cost = cost_i + edge_cost;
-      if (new_neighbor_cost < r_cost[neighbor_vert_i]) {
-        r_cost[neighbor_vert_i] = new_neighbor_cost;
-        r_next_index[neighbor_vert_i] = vert_i;
-        queue.emplace(new_neighbor_cost, neighbor_vert_i);
-      }
-    }
-  }
-}
-
 class ShortestEdgePathsNextVertFieldInput final : public bke::MeshFieldInput {
  private:
   Field<bool> end_selection_;
@@ -125,7 +69,8 @@ class ShortestEdgePathsNextVertFieldInput final : public bke::MeshFieldInput {
     Array<int> vert_to_edge_indices;
     const GroupedSpan<int> vert_to_edge = bke::mesh::build_vert_to_edge_map(
         edges, mesh.verts_num, vert_to_edge_offset_data, vert_to_edge_indices);
-    shortest_paths(mesh, vert_to_edge, end_selection, input_cost, next_index, cost);
+    geometry::shortest_edge_paths(
+        edges, vert_to_edge, end_selection, input_cost, next_index, cost);
 
     threading::parallel_for(next_index.index_range(), 1024, [&](const IndexRange range) {
       for (const int i : range) {
@@ -208,7 +153,8 @@ class ShortestEdgePathsCostFieldInput final : public bke::MeshFieldInput {
     Array<int> vert_to_edge_indices;
     const GroupedSpan<int> vert_to_edge = bke::mesh::build_vert_to_edge_map(
         edges, mesh.verts_num, vert_to_edge_offset_data, vert_to_edge_indices);
-    shortest_paths(mesh, vert_to_edge, end_selection, input_cost, next_index, cost);
+    geometry::shortest_edge_paths(
+        edges, vert_to_edge, end_selection, input_cost, next_index, cost);
 
     threading::parallel_for(cost.index_range(), 1024, [&](const IndexRange range) {
       for (const int i : range) {
@@ -0,0 +1,220 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Benchmark for the CPU compositor.
+#
+# Representative node trees are built over a generated image and rendered at several resolutions,
+# with compositing only since the trees have no Render Layers node. The compositor logs its total
+# execution time and the execution time of every node, and the render statistics give the peak
+# memory.
+
+RESOLUTIONS = ((1280, 720), (1920, 1080), (3840, 2160))
+
+
+def _build_blur(nodes, links, image):
+    blur = nodes.new('CompositorNodeBlur')
+    blur.name = "Gaussian Blur"
+    blur.filter_type = 'GAUSS'
+    blur.size_x = 50
+    blur.size_y = 50
+    links.new(image, blur.inputs['Image'])
+
+    directional_blur = nodes.new('CompositorNodeDBlur')
+    directional_blur.name = "Directional Blur"
+    directional_blur.iterations = 6
+    directional_blur.zoom = 0.2
+    links.new(blur.outputs['Image'], directional_blur.inputs['Image'])
+
+    bokeh_image = nodes.new('CompositorNodeBokehImage')
+    bokeh_blur = nodes.new('CompositorNodeBokehBlur')
+    bokeh_blur.name = "Bokeh Blur"
+    bokeh_blur.inputs['Size'].default_value = 1.0
+    links.new(directional_blur.outputs['Image'], bokeh_blur.inputs['Image'])
+    links.new(bokeh_image.outputs['Image'], bokeh_blur.inputs['Bokeh'])
+    return bokeh_blur.outputs['Image']
+
+
+def _build_keying(nodes, links, image):
+    keying = nodes.new('CompositorNodeKeying')
+    keying.name = "Keying"
+    keying.inputs['Key Color'].default_value = (0.1, 0.8, 0.1, 1.0)
+    keying.blur_pre = 4
+    keying.blur_post = 4
+    keying.feather_distance = 4
+    links.new(image, keying.inputs['Image'])
+
+    despill = nodes.new('CompositorNodeColorSpill')
+    despill.name = "Despill"
+    links.new(keying.outputs['Image'], despill.inputs['Image'])
+
+    alpha_over = nodes.new('CompositorNodeAlphaOver')
+    alpha_over.name = "Alpha Over"
+    alpha_over.inputs[1].default_value = (0.2, 0.2, 0.3, 1.0)
+    links.new(despill.outputs['Image'], alpha_over.inputs[2])
+    return alpha_over.outputs['Image']
+
+
+def _build_glare(nodes, links, image):
+    for glare_type in ('FOG_GLOW', 'STREAKS', 'GHOSTS'):
+        glare = nodes.new('CompositorNodeGlare')
+        glare.name = glare_type.replace('_', ' ').title()
+        glare.glare_type = glare_type
+        glare.quality = 'HIGH'
+        glare.threshold = 0.5
+        links.new(image, glare.inputs['Image'])
+        image = glare.outputs['Image']
+    return image
+
+
+def _build_lens_distortion(nodes, links, image):
+    distortion = nodes.new('CompositorNodeLensdist')
+    distortion.name = "Lens Distortion"
+    distortion.use_fit = True
+    distortion.inputs['Distortion'].default_value = 0.2
+    distortion.inputs['Dispersion'].default_value = 0.05
+    links.new(image, distortion.inputs['Image'])
+
+    jitter = nodes.new('CompositorNodeLensdist')
+    jitter.name = "Lens Distortion Jitter"
+    jitter.use_jitter = True
+    jitter.inputs['Distortion'].default_value = -0.1
+    jitter.inputs['Dispersion'].default_value = 0.1
+    links.new(distortion.outputs['Image'], jitter.inputs['Image'])
+    return jitter.outputs['Image']
+
+
+def _build_grade_chain(nodes, links, image):
+    # Repeated grades, as stacked by colorists, which are all per-pixel operations.
+    for i in range(4):
+        balance = nodes.new('CompositorNodeColorBalance')
+        balance.name = f"Color Balance {i}"
+        balance.lift = (1.0, 0.95, 0.9)
+        links.new(image, balance.inputs['Image'])
+
+        hue_saturation = nodes.new('CompositorNodeHueSat')
+        hue_saturation.name = f"Hue Saturation {i}"
+        hue_saturation.inputs['Saturation'].default_value = 1.1
+        links.new(balance.outputs['Image'], hue_saturation.inputs['Image'])
+
+        contrast = nodes.new('CompositorNodeBrightContrast')
+        contrast.name = f"Bright Contrast {i}"
+        contrast.inputs['Contrast'].default_value = 5.0
+        links.new(hue_saturation.outputs['Image'], contrast.inputs['Image'])
+
+        gamma = nodes.new('CompositorNodeGamma')
+        gamma.name = f"Gamma {i}"
+        gamma.inputs['Gamma'].default_value = 1.1
+        links.new(contrast.outputs['Image'], gamma.inputs['Image'])
+
+        curves = nodes.new('CompositorNodeCurveRGB')
+        curves.name = f"RGB Curves {i}"
+        links.new(gamma.outputs['Image'], curves.inputs['Image'])
+
+        exposure = nodes.new('CompositorNodeExposure')
+        exposure.name = f"Exposure {i}"
+        exposure.inputs['Exposure'].default_value = 0.1
+        links.new(curves.outputs['Image'], exposure.inputs['Image'])
+        image = exposure.outputs['Image']
+    return image
+
+
+TREES = {
+    'blur': _build_blur,
+    'keying': _build_keying,
+    'glare': _build_glare,
+    'lens_distortion': _build_lens_distortion,
+    'grade_chain': _build_grade_chain,
+}
+
+
+def _run(args):
+    import bpy
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+
+    scene = bpy.context.scene
+    scene.render.resolution_x = args['resolution'][0]
+    scene.render.resolution_y = args['resolution'][1]
+    scene.render.resolution_percentage = 100
+    scene.render.use_compositing = True
+    scene.render.compositor_device = 'CPU'
+    scene.render.compositor_cache_memory_limit = 0
+    scene.use_nodes = True
+
+    image = bpy.data.images.new("Input",
+                                args['resolution'][0],
+                                args['resolution'][1],
+                                float_buffer=True)
+    image.generated_type = 'COLOR_GRID'
+
+    nodes = scene.node_tree.nodes
+    links = scene.node_tree.links
+    nodes.clear()
+    image_node = nodes.new('CompositorNodeImage')
+    image_node.image = image
+    composite = nodes.new('CompositorNodeComposite')
+    output = TREES[args['tree']](nodes, links, image_node.outputs['Image'])
+    links.new(output, composite.inputs['Image'])
+
+    bpy.ops.render.render()
+
+    return None
+
+
+class CompositorTest(api.Test):
+    def __init__(self, tree, resolution):
+        self.tree = tree
+        self.resolution = resolution
+
+    def name(self):
+        return f"{self.tree}_{self.resolution[1]}p"
+
+    def category(self):
+        return "compositor"
+
+    def run(self, env, device_id):
+        args = {'tree': self.tree, 'resolution': self.resolution}
+
+        _, lines = env.run_in_blender(_run, args, ['--log', 'compositor', '--log-level', '1'])
+
+        # Parse total and per node execution times from the compositor log, and peak memory from
+        # the render statistics.
+        prefix_time = "Execution time: "
+        prefix_node = "Node \""
+        infix_node_time = "\" execution time: "
+        prefix_memory = "(Peak "
+        time = None
+        memory = None
+        node_times = {}
+        for line in lines:
+            line = line.strip()
+            offset = line.find(prefix_node)
+            infix_offset = line.find(infix_node_time)
+            if offset != -1 and infix_offset != -1:
+                node_name = line[offset + len(prefix_node):infix_offset]
+                node_times[node_name] = float(line[infix_offset + len(infix_node_time):])
+                continue
+            offset = line.find(prefix_time)
+            if offset != -1:
+                time = float(line[offset + len(prefix_time):])
+            offset = line.find(prefix_memory)
+            if offset != -1:
+                memory = line[offset + len(prefix_memory):].split('M')[0]
+                memory = float(memory) * 1024 * 1024
+
+        if time is None or memory is None:
+            raise Exception("Error parsing compositor execution time or peak memory output")
+
+        result = {'time': time, 'peak_memory': memory}
+        for node_name, node_time in node_times.items():
+            result[f"time {node_name}"] = node_time
+        return result
+
+
+def generate(env):
+    return [CompositorTest(tree, resolution)
+            for tree in TREES
+            for resolution in RESOLUTIONS]
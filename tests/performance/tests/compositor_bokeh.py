@@ -0,0 +1,115 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Benchmark for the FFT convolution of the compositor bokeh blurs.
+#
+# A generated image is blurred by a Bokeh Blur node, both with a constant size and with a variable
+# size, once using the FFT convolution and once using the direct convolution. The latter is forced
+# through the debug value that disables the FFT convolution. Besides the time of both, the root
+# mean square difference between their results is reported, which is only expected to be non-zero
+# for the layered approximation of the variable size blur.
+
+RESOLUTION = (1920, 1080)
+SIZES = (1.0, 2.0, 4.0)
+FFT_CONVOLUTION_DISABLE_DEBUG_VALUE = 5100
+
+
+def _run(args):
+    import bpy
+    import numpy
+    import time
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+
+    scene = bpy.context.scene
+    scene.render.resolution_x = RESOLUTION[0]
+    scene.render.resolution_y = RESOLUTION[1]
+    scene.render.resolution_percentage = 100
+    scene.render.use_compositing = True
+    scene.render.compositor_device = 'CPU'
+    # Disable the results cache, otherwise the second render would reuse the first one.
+    scene.render.compositor_cache_memory_limit = 0
+    scene.render.image_settings.file_format = 'OPEN_EXR'
+    scene.use_nodes = True
+
+    image = bpy.data.images.new("Input", RESOLUTION[0], RESOLUTION[1], float_buffer=True)
+    image.generated_type = 'COLOR_GRID'
+
+    nodes = scene.node_tree.nodes
+    links = scene.node_tree.links
+    nodes.clear()
+    image_node = nodes.new('CompositorNodeImage')
+    image_node.image = image
+    bokeh_image = nodes.new('CompositorNodeBokehImage')
+    bokeh_blur = nodes.new('CompositorNodeBokehBlur')
+    composite = nodes.new('CompositorNodeComposite')
+    links.new(image_node.outputs['Image'], bokeh_blur.inputs['Image'])
+    links.new(bokeh_image.outputs['Image'], bokeh_blur.inputs['Bokeh'])
+    links.new(bokeh_blur.outputs['Image'], composite.inputs['Image'])
+
+    if args['variable_size']:
+        # Vary the size over the image using one of the channels of the grid.
+        separate = nodes.new('CompositorNodeSeparateColor')
+        math = nodes.new('CompositorNodeMath')
+        math.operation = 'MULTIPLY'
+        math.inputs[1].default_value = args['size']
+        links.new(image_node.outputs['Image'], separate.inputs['Image'])
+        links.new(separate.outputs['Red'], math.inputs[0])
+        links.new(math.outputs['Value'], bokeh_blur.inputs['Size'])
+        bokeh_blur.use_variable_size = True
+        bokeh_blur.blur_max = 1000.0
+    else:
+        bokeh_blur.inputs['Size'].default_value = args['size']
+
+    result = {}
+    pixels = {}
+    for method, debug_value in (('fft', 0), ('direct', FFT_CONVOLUTION_DISABLE_DEBUG_VALUE)):
+        bpy.app.debug_value = debug_value
+        scene.render.filepath = args['render_filepath'] + '_' + method + '.exr'
+
+        start_time = time.perf_counter()
+        bpy.ops.render.render(write_still=True)
+        result[method + '_time'] = time.perf_counter() - start_time
+
+        output = bpy.data.images.load(scene.render.filepath)
+        pixels[method] = numpy.empty(len(output.pixels), dtype=numpy.float32)
+        output.pixels.foreach_get(pixels[method])
+
+    result['rmse'] = float(numpy.sqrt(numpy.mean(numpy.square(pixels['fft'] - pixels['direct']))))
+    return result
+
+
+class CompositorBokehTest(api.Test):
+    def __init__(self, size, variable_size):
+        self.size = size
+        self.variable_size = variable_size
+
+    def name(self):
+        kind = "variable" if self.variable_size else "constant"
+        return f"{kind}_size_{self.size:g}"
+
+    def category(self):
+        return "compositor_bokeh"
+
+    def run(self, env, device_id):
+        args = {'size': self.size,
+                'variable_size': self.variable_size,
+                'render_filepath': str(env.log_file.parent / env.log_file.stem)}
+
+        result, _ = env.run_in_blender(_run, args)
+        if not result:
+            raise Exception("Error running compositor bokeh benchmark")
+
+        return {'time': result['fft_time'],
+                'direct_time': result['direct_time'],
+                'speedup': result['direct_time'] / max(result['fft_time'], 1e-6),
+                'rmse': result['rmse']}
+
+
+def generate(env):
+    return [CompositorBokehTest(size, variable_size)
+            for variable_size in (False, True)
+            for size in SIZES]
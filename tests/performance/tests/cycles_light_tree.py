@@ -0,0 +1,95 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Scalability benchmark for the Cycles light tree construction.
+#
+# A subdivided grid with an emission material is rendered with a single sample at a tiny
+# resolution, so that the scene update time is dominated by building the light tree over all
+# of its emissive triangles.
+
+RESOLUTION = 64
+NUM_EMITTERS = (10_000, 100_000, 1_000_000, 10_000_000)
+
+
+def _run(args):
+    import bpy
+    import math
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+
+    scene = bpy.context.scene
+    scene.render.engine = 'CYCLES'
+    scene.render.resolution_x = RESOLUTION
+    scene.render.resolution_y = RESOLUTION
+    scene.render.resolution_percentage = 100
+
+    cscene = scene.cycles
+    cscene.device = 'CPU'
+    cscene.samples = 1
+    cscene.use_adaptive_sampling = False
+    cscene.use_denoising = False
+    cscene.use_light_tree = True
+
+    camera_data = bpy.data.cameras.new("Camera")
+    camera = bpy.data.objects.new("Camera", camera_data)
+    camera.location = (0.0, 0.0, 2.0)
+    scene.collection.objects.link(camera)
+    scene.camera = camera
+
+    # Every quad of the grid is split into two emissive triangles.
+    subdivisions = max(2, int(math.sqrt(args['num_emitters'] / 2)))
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=subdivisions,
+                                    y_subdivisions=subdivisions,
+                                    size=2.0)
+    grid = bpy.context.object
+
+    material = bpy.data.materials.new("Emission")
+    material.use_nodes = True
+    nodes = material.node_tree.nodes
+    nodes.clear()
+    output = nodes.new('ShaderNodeOutputMaterial')
+    emission = nodes.new('ShaderNodeEmission')
+    material.node_tree.links.new(emission.outputs['Emission'], output.inputs['Surface'])
+    grid.data.materials.append(material)
+
+    bpy.ops.render.render()
+
+    return None
+
+
+class CyclesLightTreeTest(api.Test):
+    def __init__(self, num_emitters):
+        self.num_emitters = num_emitters
+
+    def name(self):
+        return f"{self.num_emitters}_emitters"
+
+    def category(self):
+        return "cycles_light_tree"
+
+    def run(self, env, device_id):
+        args = {'num_emitters': self.num_emitters}
+
+        _, lines = env.run_in_blender(_run, args, ['--debug-cycles', '--verbose', '2'])
+
+        # Parse light tree build time from output.
+        prefix_time = "Light tree build time: "
+        time = None
+        for line in lines:
+            line = line.strip()
+            offset = line.find(prefix_time)
+            if offset != -1:
+                time = float(line[offset + len(prefix_time):])
+
+        if time is None:
+            raise Exception("Error parsing light tree build time output")
+
+        return {'time': time,
+                'emitters_per_second': self.num_emitters / max(time, 1e-6)}
+
+
+def generate(env):
+    return [CyclesLightTreeTest(num_emitters) for num_emitters in NUM_EMITTERS]
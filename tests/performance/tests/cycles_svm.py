@@ -0,0 +1,215 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Micro benchmark for the Cycles shader virtual machine on the CPU.
+#
+# A plane filling an orthographic camera is rendered with a single material and no bounces,
+# so every camera sample evaluates the surface shader exactly once, which gives the time per
+# shader evaluation. The number of SVM nodes the material compiles to is reported alongside it,
+# but is not part of the metric: fusing nodes lowers it while making evaluation faster.
+
+RESOLUTION = 256
+SAMPLES = 64
+MATERIAL_NAME = "SVMBenchmark"
+
+
+def _build_image_mapping(nodes, links):
+    # Texture coordinate to mapping to image texture chains, as used by most texture sets.
+    import bpy
+
+    output = nodes.new('ShaderNodeOutputMaterial')
+    bsdf = nodes.new('ShaderNodeBsdfPrincipled')
+    texcoord = nodes.new('ShaderNodeTexCoord')
+    links.new(bsdf.outputs['BSDF'], output.inputs['Surface'])
+
+    for socket_name in ('Base Color', 'Roughness', 'Metallic', 'Normal'):
+        image = bpy.data.images.new(socket_name, 1024, 1024, float_buffer=False)
+        image.generated_type = 'COLOR_GRID'
+
+        mapping = nodes.new('ShaderNodeMapping')
+        mapping.inputs['Scale'].default_value = (2.0, 2.0, 2.0)
+        mapping.inputs['Rotation'].default_value = (0.0, 0.0, 0.3)
+
+        texture = nodes.new('ShaderNodeTexImage')
+        texture.image = image
+
+        links.new(texcoord.outputs['UV'], mapping.inputs['Vector'])
+        links.new(mapping.outputs['Vector'], texture.inputs['Vector'])
+
+        if socket_name == 'Normal':
+            normal_map = nodes.new('ShaderNodeNormalMap')
+            links.new(texture.outputs['Color'], normal_map.inputs['Color'])
+            links.new(normal_map.outputs['Normal'], bsdf.inputs['Normal'])
+        else:
+            links.new(texture.outputs['Color'], bsdf.inputs[socket_name])
+
+
+def _build_layered_bsdf(nodes, links):
+    # Tree of mixed BSDFs driven by procedural masks, as used for layered materials.
+    output = nodes.new('ShaderNodeOutputMaterial')
+
+    previous = None
+    for i in range(6):
+        bsdf = nodes.new('ShaderNodeBsdfPrincipled')
+        bsdf.inputs['Base Color'].default_value = (0.1 * i, 0.5, 1.0 - 0.1 * i, 1.0)
+        bsdf.inputs['Roughness'].default_value = 0.1 + 0.1 * i
+
+        if previous is None:
+            previous = bsdf.outputs['BSDF']
+            continue
+
+        noise = nodes.new('ShaderNodeTexNoise')
+        noise.inputs['Scale'].default_value = 2.0 + i
+        ramp = nodes.new('ShaderNodeValToRGB')
+        mix = nodes.new('ShaderNodeMixShader')
+
+        links.new(noise.outputs['Fac'], ramp.inputs['Fac'])
+        links.new(ramp.outputs['Color'], mix.inputs['Fac'])
+        links.new(previous, mix.inputs[1])
+        links.new(bsdf.outputs['BSDF'], mix.inputs[2])
+        previous = mix.outputs['Shader']
+
+    links.new(previous, output.inputs['Surface'])
+
+
+def _build_procedural(nodes, links):
+    # Procedural textures with long math and color grading chains.
+    output = nodes.new('ShaderNodeOutputMaterial')
+    bsdf = nodes.new('ShaderNodeBsdfPrincipled')
+    links.new(bsdf.outputs['BSDF'], output.inputs['Surface'])
+
+    texcoord = nodes.new('ShaderNodeTexCoord')
+    mapping = nodes.new('ShaderNodeMapping')
+    voronoi = nodes.new('ShaderNodeTexVoronoi')
+    noise = nodes.new('ShaderNodeTexNoise')
+    links.new(texcoord.outputs['Object'], mapping.inputs['Vector'])
+    links.new(mapping.outputs['Vector'], voronoi.inputs['Vector'])
+    links.new(mapping.outputs['Vector'], noise.inputs['Vector'])
+
+    value = voronoi.outputs['Distance']
+    for i in range(8):
+        math = nodes.new('ShaderNodeMath')
+        math.operation = ('MULTIPLY_ADD', 'POWER', 'SINE', 'ADD')[i % 4]
+        links.new(value, math.inputs[0])
+        value = math.outputs['Value']
+
+    mix = nodes.new('ShaderNodeMix')
+    mix.data_type = 'RGBA'
+    links.new(value, mix.inputs['Factor'])
+    links.new(noise.outputs['Color'], mix.inputs['A'])
+
+    color = mix.outputs['Result']
+    for node_type in ('ShaderNodeHueSaturation', 'ShaderNodeGamma', 'ShaderNodeBrightContrast'):
+        grade = nodes.new(node_type)
+        links.new(color, grade.inputs['Color'])
+        color = grade.outputs['Color']
+
+    links.new(color, bsdf.inputs['Base Color'])
+    links.new(value, bsdf.inputs['Roughness'])
+
+
+MATERIALS = {
+    'image_mapping': _build_image_mapping,
+    'layered_bsdf': _build_layered_bsdf,
+    'procedural': _build_procedural,
+}
+
+
+def _run(args):
+    import bpy
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+
+    scene = bpy.context.scene
+    scene.render.engine = 'CYCLES'
+    scene.render.resolution_x = args['resolution']
+    scene.render.resolution_y = args['resolution']
+    scene.render.resolution_percentage = 100
+    scene.render.filepath = args['render_filepath']
+    scene.render.image_settings.file_format = 'PNG'
+
+    cscene = scene.cycles
+    cscene.device = 'CPU'
+    cscene.samples = args['samples']
+    cscene.use_adaptive_sampling = False
+    cscene.use_denoising = False
+    cscene.max_bounces = 0
+    cscene.transparent_max_bounces = 0
+
+    world = bpy.data.worlds.new("World")
+    world.color = (1.0, 1.0, 1.0)
+    scene.world = world
+
+    camera_data = bpy.data.cameras.new("Camera")
+    camera_data.type = 'ORTHO'
+    camera_data.ortho_scale = 2.0
+    camera = bpy.data.objects.new("Camera", camera_data)
+    camera.location = (0.0, 0.0, 1.0)
+    scene.collection.objects.link(camera)
+    scene.camera = camera
+
+    bpy.ops.mesh.primitive_plane_add(size=2.0)
+    plane = bpy.context.object
+
+    material = bpy.data.materials.new(MATERIAL_NAME)
+    material.use_nodes = True
+    material.node_tree.nodes.clear()
+    MATERIALS[args['material']](material.node_tree.nodes, material.node_tree.links)
+    plane.data.materials.append(material)
+
+    bpy.ops.render.render(write_still=True)
+
+    return None
+
+
+class CyclesSVMTest(api.Test):
+    def __init__(self, material):
+        self.material = material
+
+    def name(self):
+        return self.material
+
+    def category(self):
+        return "cycles_svm"
+
+    def run(self, env, device_id):
+        args = {'material': self.material,
+                'resolution': RESOLUTION,
+                'samples': SAMPLES,
+                'render_filepath': str(env.log_file.parent / (env.log_file.stem + '.png'))}
+
+        _, lines = env.run_in_blender(_run, args, ['--debug-cycles', '--verbose', '3'])
+
+        # Parse render time and compiled shader size from output.
+        prefix_time = "Render time (without synchronization): "
+        prefix_shader = "Shader name: "
+        prefix_nodes = "Number of SVM nodes: "
+        time = None
+        num_svm_nodes = None
+        in_benchmark_shader = False
+        for line in lines:
+            line = line.strip()
+            offset = line.find(prefix_time)
+            if offset != -1:
+                time = float(line[offset + len(prefix_time):])
+            offset = line.find(prefix_shader)
+            if offset != -1:
+                in_benchmark_shader = line[offset + len(prefix_shader):] == MATERIAL_NAME
+            offset = line.find(prefix_nodes)
+            if offset != -1 and in_benchmark_shader:
+                num_svm_nodes = int(line[offset + len(prefix_nodes):])
+
+        if not (time and num_svm_nodes):
+            raise Exception("Error parsing render time or SVM statistics output")
+
+        shader_evaluations = RESOLUTION * RESOLUTION * SAMPLES
+        return {'time': time,
+                'time_per_evaluation_ns': time * 1e9 / shader_evaluations,
+                'svm_nodes': num_svm_nodes}
+
+
+def generate(env):
+    return [CyclesSVMTest(material) for material in MATERIALS]
@@ -0,0 +1,213 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Benchmark for importing large binary STL and PLY files, and USD stages with many prims.
+#
+# The STL and PLY files are generated to look like the output of a 3D scanner, a noisy height
+# field whose triangles share their vertices, so that the STL importer has to weld all of them.
+# Note that the largest size needs about 5 GB of disk space for each file and a multiple of that
+# in memory during the import.
+#
+# The USD stages are generated with the USD Python API bundled with Blender, as a grid of small
+# mesh prims with normals, a color and a UV primvar each, which is typical for set dressing.
+#
+# Generating the files is not part of the timing.
+
+TRIANGLES = (1_000_000, 10_000_000, 100_000_000)
+MESH_FORMATS = ('stl', 'ply')
+
+USD_PRIMS = (1_000, 10_000, 100_000)
+
+# Number of grid rows that are generated at once, to limit the memory usage.
+ROWS_PER_BLOCK = 256
+
+# Size of the grid of vertices of every USD mesh prim.
+USD_MESH_SIZE = 16
+
+
+def _grid_size(triangles):
+    # A grid of n x n vertices has 2 * (n - 1)^2 triangles.
+    return int((triangles / 2) ** 0.5) + 1
+
+
+def _grid_positions(numpy, size, row_start, row_end):
+    x, y = numpy.meshgrid(numpy.arange(size, dtype=numpy.float32),
+                          numpy.arange(row_start, row_end, dtype=numpy.float32))
+    z = numpy.sin(x * 0.01) * numpy.cos(y * 0.013) * 20.0 + numpy.sin(x * y) * 0.1
+    return numpy.stack((x, y, z), axis=-1).astype(numpy.float32)
+
+
+def _grid_triangles(numpy, size, row_start, row_end):
+    # Vertex indices of the two triangles of every grid cell in the given rows.
+    x, y = numpy.meshgrid(numpy.arange(size - 1), numpy.arange(row_start, row_end))
+    v00 = (y * size + x).ravel()
+    v10 = v00 + 1
+    v01 = v00 + size
+    v11 = v01 + 1
+    return numpy.concatenate((numpy.stack((v00, v10, v11), axis=-1),
+                              numpy.stack((v00, v11, v01), axis=-1)), axis=-1).reshape(-1, 3)
+
+
+def _write_stl(numpy, filepath, size):
+    triangle_dtype = numpy.dtype([('normal', '<f4', 3), ('vertices', '<f4', (3, 3)),
+                                  ('attribute_byte_count', '<u2')])
+    assert triangle_dtype.itemsize == 50
+    triangles_num = 2 * (size - 1) ** 2
+    with open(filepath, 'wb') as file:
+        file.write(b'\0' * 80)
+        file.write(numpy.uint32(triangles_num).tobytes())
+        for row_start in range(0, size - 1, ROWS_PER_BLOCK):
+            row_end = min(row_start + ROWS_PER_BLOCK, size - 1)
+            positions = _grid_positions(numpy, size, row_start, row_end + 1).reshape(-1, 3)
+            tris = _grid_triangles(numpy, size, row_start, row_end) - row_start * size
+            corners = positions[tris]
+            normals = numpy.cross(corners[:, 1] - corners[:, 0], corners[:, 2] - corners[:, 0])
+            normals /= numpy.linalg.norm(normals, axis=-1, keepdims=True)
+            data = numpy.zeros(len(tris), dtype=triangle_dtype)
+            data['normal'] = normals
+            data['vertices'] = corners
+            file.write(data.tobytes())
+
+
+def _write_ply(numpy, filepath, size):
+    face_dtype = numpy.dtype([('count', 'u1'), ('vertex_indices', '<i4', 3)])
+    triangles_num = 2 * (size - 1) ** 2
+    with open(filepath, 'wb') as file:
+        file.write((f"ply\n"
+                    f"format binary_little_endian 1.0\n"
+                    f"element vertex {size * size}\n"
+                    f"property float x\n"
+                    f"property float y\n"
+                    f"property float z\n"
+                    f"element face {triangles_num}\n"
+                    f"property list uchar int vertex_indices\n"
+                    f"end_header\n").encode('ascii'))
+        for row_start in range(0, size, ROWS_PER_BLOCK):
+            row_end = min(row_start + ROWS_PER_BLOCK, size)
+            file.write(_grid_positions(numpy, size, row_start, row_end).tobytes())
+        for row_start in range(0, size - 1, ROWS_PER_BLOCK):
+            row_end = min(row_start + ROWS_PER_BLOCK, size - 1)
+            tris = _grid_triangles(numpy, size, row_start, row_end)
+            data = numpy.empty(len(tris), dtype=face_dtype)
+            data['count'] = 3
+            data['vertex_indices'] = tris
+            file.write(data.tobytes())
+
+
+def _write_usd(filepath, prims_num):
+    from pxr import Gf, Sdf, Usd, UsdGeom, Vt
+
+    positions = []
+    uvs = []
+    for y in range(USD_MESH_SIZE):
+        for x in range(USD_MESH_SIZE):
+            positions.append(Gf.Vec3f(x, y, ((x * 7 + y * 13) % 5) * 0.1))
+            uvs.append(Gf.Vec2f(x / (USD_MESH_SIZE - 1), y / (USD_MESH_SIZE - 1)))
+    counts = []
+    indices = []
+    for y in range(USD_MESH_SIZE - 1):
+        for x in range(USD_MESH_SIZE - 1):
+            v = y * USD_MESH_SIZE + x
+            counts.append(4)
+            indices += (v, v + 1, v + USD_MESH_SIZE + 1, v + USD_MESH_SIZE)
+    positions = Vt.Vec3fArray(positions)
+    normals = Vt.Vec3fArray([Gf.Vec3f(0.0, 0.0, 1.0)] * len(positions))
+    uvs = Vt.Vec2fArray(uvs)
+    counts = Vt.IntArray(counts)
+    indices = Vt.IntArray(indices)
+
+    stage = Usd.Stage.CreateNew(filepath)
+    UsdGeom.SetStageUpAxis(stage, UsdGeom.Tokens.z)
+    UsdGeom.Xform.Define(stage, "/root")
+    grid_size = int(prims_num ** 0.5) + 1
+    for i in range(prims_num):
+        mesh = UsdGeom.Mesh.Define(stage, f"/root/mesh_{i}")
+        mesh.AddTranslateOp().Set(Gf.Vec3d((i % grid_size) * USD_MESH_SIZE,
+                                           (i // grid_size) * USD_MESH_SIZE,
+                                           0.0))
+        mesh.CreatePointsAttr(positions)
+        mesh.CreateFaceVertexCountsAttr(counts)
+        mesh.CreateFaceVertexIndicesAttr(indices)
+        mesh.CreateNormalsAttr(normals)
+        mesh.SetNormalsInterpolation(UsdGeom.Tokens.vertex)
+        mesh.CreateDisplayColorAttr(Vt.Vec3fArray([Gf.Vec3f((i % 10) * 0.1, 0.5, 0.5)]))
+
+        primvars_api = UsdGeom.PrimvarsAPI(mesh)
+        primvars_api.CreatePrimvar("st", Sdf.ValueTypeNames.TexCoord2fArray,
+                                   UsdGeom.Tokens.vertex).Set(uvs)
+    stage.GetRootLayer().Save()
+
+
+def _run(args):
+    import bpy
+    import numpy
+    import os
+    import time
+
+    filepath = args['filepath']
+    file_format = args['format']
+    if file_format == 'stl':
+        _write_stl(numpy, filepath, _grid_size(args['size']))
+    elif file_format == 'ply':
+        _write_ply(numpy, filepath, _grid_size(args['size']))
+    else:
+        _write_usd(filepath, args['size'])
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+
+    try:
+        start_time = time.perf_counter()
+        if file_format == 'stl':
+            bpy.ops.wm.stl_import(filepath=filepath)
+        elif file_format == 'ply':
+            bpy.ops.wm.ply_import(filepath=filepath)
+        else:
+            bpy.ops.wm.usd_import(filepath=filepath)
+        import_time = time.perf_counter() - start_time
+    finally:
+        os.remove(filepath)
+
+    return {'time': import_time,
+            'objects': len(bpy.data.objects),
+            'vertices': sum(len(mesh.vertices) for mesh in bpy.data.meshes),
+            'faces': sum(len(mesh.polygons) for mesh in bpy.data.meshes)}
+
+
+class ImportTest(api.Test):
+    # The size is the number of triangles for STL and PLY, and the number of mesh prims for USD.
+    def __init__(self, file_format, size):
+        self.file_format = file_format
+        self.size = size
+
+    def name(self):
+        if self.file_format == 'usd':
+            return f"usd_{self.size}_prims"
+        return f"{self.file_format}_{self.size // 1_000_000}M_triangles"
+
+    def category(self):
+        return "io_import"
+
+    def run(self, env, device_id):
+        extension = 'usdc' if self.file_format == 'usd' else self.file_format
+        args = {'format': self.file_format,
+                'size': self.size,
+                'filepath': str(env.log_file.parent / f"{self.name()}.{extension}")}
+
+        result, _ = env.run_in_blender(_run, args)
+        if not result:
+            raise Exception("Error running import benchmark")
+
+        # Triangles or prims per second, to compare sizes.
+        result['throughput'] = self.size / max(result['time'], 1e-6)
+        return result
+
+
+def generate(env):
+    tests = [ImportTest(file_format, triangles)
+             for file_format in MESH_FORMATS
+             for triangles in TRIANGLES]
+    tests += [ImportTest('usd', prims) for prims in USD_PRIMS]
+    return tests
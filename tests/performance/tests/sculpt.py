@@ -4,6 +4,10 @@
 
 import api
 
+# Grid resolutions for the Expand benchmark, about 2 and 10 million vertices.
+EXPAND_GRID_SIZES = (1500, 3200)
+EXPAND_LOG_KEY = "SCULPT_EXPAND_PERFORMANCE: "
+
 
 def set_view3d_context_override(context_override):
     """
@@ -26,7 +30,7 @@ def set_view3d_context_override(context_override):
                 context_override["region"] = region
 
 
-def prepare_sculpt_scene(context):
+def prepare_sculpt_scene(context, size=1500):
     import bpy
     """
     Prepare a clean state of the scene suitable for benchmarking
@@ -48,8 +52,6 @@ def prepare_sculpt_scene(context):
     group.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
     group_output_node = group.nodes.new('NodeGroupOutput')
 
-    size = 1500
-
     grid_node = group.nodes.new('GeometryNodeMeshGrid')
     grid_node.inputs["Size X"].default_value = 2.0
     grid_node.inputs["Size Y"].default_value = 2.0
@@ -131,6 +133,44 @@ def _run(args):
     return result
 
 
+def _run_expand(args):
+    import bpy
+    import time
+    context = bpy.context
+
+    bpy.ops.ed.undo_push()
+
+    prepare_sculpt_scene(context, args['size'])
+
+    window = context.window_manager.windows[0]
+    context_override = context.copy()
+    context_override["window"] = window
+    context_override["screen"] = window.screen
+    set_view3d_context_override(context_override)
+    region = context_override["region"]
+
+    with context.temp_override(**context_override):
+        bpy.ops.view3d.view_axis(type='TOP')
+        bpy.ops.view3d.view_selected()
+
+        # Expand starts from the vertex under the mouse, use the center of the grid. Computing the
+        # geodesic falloff from there is the main part of starting the operator.
+        window.event_simulate(type='MOUSEMOVE',
+                              value='NOTHING',
+                              x=region.x + region.width // 2,
+                              y=region.y + region.height // 2)
+        start = time.perf_counter()
+        result = bpy.ops.sculpt.expand('INVOKE_DEFAULT', target='MASK', falloff_type='GEODESIC')
+        end = time.perf_counter()
+
+    if result == {'RUNNING_MODAL'}:
+        print(f"{EXPAND_LOG_KEY}{{'time': {end - start}}}")
+
+    # The operator keeps running, quit once the event loop started.
+    context.preferences.view.use_save_prompt = False
+    bpy.app.timers.register(lambda: bpy.ops.wm.quit_blender())
+
+
 class SculptBrushTest(api.Test):
     def __init__(self, filepath):
         self.filepath = filepath
@@ -149,6 +189,32 @@ class SculptBrushTest(api.Test):
         return result
 
 
+class SculptExpandTest(api.Test):
+    def __init__(self, size):
+        self.size = size
+
+    def name(self):
+        return f"expand_geodesic_{self.size}x{self.size}"
+
+    def category(self):
+        return "sculpt"
+
+    def use_background(self):
+        # Expand is a modal operator that needs a window to be invoked.
+        return False
+
+    def run(self, env, device_id):
+        args = {'size': self.size}
+
+        _, log = env.run_in_blender(_run_expand, args, ['--enable-event-simulate'], foreground=True)
+        for line in log:
+            if line.startswith(EXPAND_LOG_KEY):
+                return eval(line[len(EXPAND_LOG_KEY):])
+
+        raise Exception("Error running sculpt Expand benchmark")
+
+
 def generate(env):
     filepaths = env.find_blend_files('sculpt/*')
-    return [SculptBrushTest(filepath) for filepath in filepaths]
+    return ([SculptBrushTest(filepath) for filepath in filepaths] +
+            [SculptExpandTest(size) for size in EXPAND_GRID_SIZES])
@@ -18,6 +18,14 @@ except ImportError:
 SET_COMPOSITOR_DEVICE_SCRIPT = "import bpy; " \
     "bpy.data.scenes[0].render.compositor_device = 'CPU'"
 
+# Memory limit in megabytes rendering the compositor in tiles, 0 renders without limit.
+MEMORY_LIMIT = 0
+
+
+def get_memory_limit_script():
+    return "import bpy; " \
+        "bpy.data.scenes[0].render.compositor_memory_limit = {:d}".format(MEMORY_LIMIT)
+
 
 def get_arguments(filepath, output_filepath):
     return [
@@ -29,6 +37,7 @@ def get_arguments(filepath, output_filepath):
         filepath,
         "-P", os.path.realpath(__file__),
         "--python-expr", SET_COMPOSITOR_DEVICE_SCRIPT,
+        "--python-expr", get_memory_limit_script(),
         "-o", output_filepath,
         "-F", "PNG",
         "-f", "1"]
@@ -41,6 +50,7 @@ def create_argparse():
     parser.add_argument("-outdir", nargs=1)
     parser.add_argument("-oiiotool", nargs=1)
     parser.add_argument('--batch', default=False, action='store_true')
+    parser.add_argument('--memory-limit', type=int, default=0)
     return parser
 
 
@@ -53,8 +63,12 @@ def main():
     oiiotool = args.oiiotool[0]
     output_dir = args.outdir[0]
 
+    global MEMORY_LIMIT
+    MEMORY_LIMIT = args.memory_limit
+
     from modules import render_report
-    report = render_report.Report("Compositor CPU", output_dir, oiiotool)
+    title = "Compositor CPU Tiled" if MEMORY_LIMIT else "Compositor CPU"
+    report = render_report.Report(title, output_dir, oiiotool)
     report.set_pixelated(True)
     report.set_reference_dir("compositor_cpu_renders")
 